@@ -501,10 +501,12 @@ public:
     return 0;
   }
 
-  /// Create increment contents of target by 1 for Instrumentation
+  /// Create increment contents of target by 1 for Instrumentation. If
+  /// \p IsAtomic is false, the target may use a cheaper increment that can lose
+  /// updates when several threads hit the same counter.
   virtual InstructionListType
   createInstrIncMemory(const MCSymbol *Target, MCContext *Ctx, bool IsLeaf,
-                       unsigned CodePointerSize) const {
+                       unsigned CodePointerSize, bool IsAtomic = true) const {
     llvm_unreachable("not implemented");
     return InstructionListType();
   }
@@ -39,6 +39,12 @@ class BinaryFunction;
 /// optimized. The goal is to avoid special deployments of non-bolted binaries
 /// just for the purposes of data collection.
 ///
+/// The table only describes addresses, plus the function and basic block
+/// hashes recorded by saveMetadata(). It does not preserve CFGs, layout or
+/// function order decisions, so every optimization of the input binary with a
+/// new profile is a full BOLT run. The hashes are what allows such a profile to
+/// be matched against the input binary after its code changed.
+///
 /// The in-memory representation of the map is as follows. Each function has its
 /// own map. A function is identified by its output address. This is the key to
 /// retrieve a translation map. The translation map is a collection of ordered
@@ -51,7 +51,7 @@ namespace {
 /// A single thread pool that is used to run parallel tasks
 std::unique_ptr<DefaultThreadPool> ThreadPoolPtr;
 
-unsigned computeCostFor(const BinaryFunction &BF,
+uint64_t computeCostFor(const BinaryFunction &BF,
                         const PredicateTy &SkipPredicate,
                         const SchedulingPolicy &SchedPolicy) {
   if (SchedPolicy == SchedulingPolicy::SP_TRIVIAL)
@@ -66,23 +66,23 @@ unsigned computeCostFor(const BinaryFunction &BF,
   case SchedulingPolicy::SP_INST_LINEAR:
     return BF.getSize();
   case SchedulingPolicy::SP_INST_QUADRATIC:
-    return BF.getSize() * BF.getSize();
+    return uint64_t(BF.getSize()) * BF.getSize();
   case SchedulingPolicy::SP_BB_LINEAR:
     return BF.size();
   case SchedulingPolicy::SP_BB_QUADRATIC:
-    return BF.size() * BF.size();
+    return uint64_t(BF.size()) * BF.size();
   default:
     llvm_unreachable("unsupported scheduling policy");
   }
 }
 
-inline unsigned estimateTotalCost(const BinaryContext &BC,
+inline uint64_t estimateTotalCost(const BinaryContext &BC,
                                   const PredicateTy &SkipPredicate,
                                   SchedulingPolicy &SchedPolicy) {
   if (SchedPolicy == SchedulingPolicy::SP_TRIVIAL)
     return BC.getBinaryFunctions().size();
 
-  unsigned TotalCost = 0;
+  uint64_t TotalCost = 0;
   for (auto &BFI : BC.getBinaryFunctions()) {
     const BinaryFunction &BF = BFI.second;
     TotalCost += computeCostFor(BF, SkipPredicate, SchedPolicy);
@@ -139,21 +139,30 @@ void runOnEachFunction(BinaryContext &BC, SchedulingPolicy SchedPolicy,
   }
 
   // Estimate the overall runtime cost using the scheduling policy
-  const unsigned TotalCost = estimateTotalCost(BC, SkipPredicate, SchedPolicy);
-  const unsigned BlocksCount = TasksPerThread * opts::ThreadCount;
-  const unsigned BlockCost =
+  const uint64_t TotalCost = estimateTotalCost(BC, SkipPredicate, SchedPolicy);
+  const uint64_t BlocksCount = TasksPerThread * opts::ThreadCount;
+  const uint64_t BlockCost =
       TotalCost > BlocksCount ? TotalCost / BlocksCount : 1;
 
   // Divide work into blocks of equal cost
   ThreadPoolInterface &Pool = getThreadPool();
   auto BlockBegin = BC.getBinaryFunctions().begin();
-  unsigned CurrentCost = 0;
+  uint64_t CurrentCost = 0;
 
   for (auto It = BC.getBinaryFunctions().begin();
        It != BC.getBinaryFunctions().end(); ++It) {
     BinaryFunction &BF = It->second;
-    CurrentCost += computeCostFor(BF, SkipPredicate, SchedPolicy);
+    const uint64_t Cost = computeCostFor(BF, SkipPredicate, SchedPolicy);
 
+    // A function that is worth a whole block gets a block of its own, so that
+    // the functions before it don't wait behind it on the same thread.
+    if (Cost >= BlockCost && CurrentCost) {
+      Pool.async(runBlock, BlockBegin, It);
+      BlockBegin = It;
+      CurrentCost = 0;
+    }
+
+    CurrentCost += Cost;
     if (CurrentCost >= BlockCost) {
       Pool.async(runBlock, BlockBegin, std::next(It));
       BlockBegin = std::next(It);
@@ -196,43 +205,44 @@ void runOnEachFunctionWithUniqueAllocId(
   std::unique_lock<llvm::sys::RWMutex> Lock(MainLock);
 
   // Estimate the overall runtime cost using the scheduling policy
-  const unsigned TotalCost = estimateTotalCost(BC, SkipPredicate, SchedPolicy);
-  const unsigned BlocksCount = TasksPerThread * opts::ThreadCount;
-  const unsigned BlockCost =
+  const uint64_t TotalCost = estimateTotalCost(BC, SkipPredicate, SchedPolicy);
+  const uint64_t BlocksCount = TasksPerThread * opts::ThreadCount;
+  const uint64_t BlockCost =
       TotalCost > BlocksCount ? TotalCost / BlocksCount : 1;
 
   // Divide work into blocks of equal cost
   ThreadPoolInterface &Pool = getThreadPool();
   auto BlockBegin = BC.getBinaryFunctions().begin();
-  unsigned CurrentCost = 0;
+  uint64_t CurrentCost = 0;
   unsigned AllocId = 1;
+  auto scheduleBlock =
+      [&](std::map<uint64_t, BinaryFunction>::iterator BlockEnd) {
+        if (!BC.MIB->checkAllocatorExists(AllocId)) {
+          MCPlusBuilder::AllocatorIdTy Id =
+              BC.MIB->initializeNewAnnotationAllocator();
+          (void)Id;
+          assert(AllocId == Id && "unexpected allocator id created");
+        }
+        Pool.async(runBlock, BlockBegin, BlockEnd, AllocId);
+        AllocId++;
+        BlockBegin = BlockEnd;
+        CurrentCost = 0;
+      };
   for (auto It = BC.getBinaryFunctions().begin();
        It != BC.getBinaryFunctions().end(); ++It) {
     BinaryFunction &BF = It->second;
-    CurrentCost += computeCostFor(BF, SkipPredicate, SchedPolicy);
+    const uint64_t Cost = computeCostFor(BF, SkipPredicate, SchedPolicy);
 
-    if (CurrentCost >= BlockCost) {
-      if (!BC.MIB->checkAllocatorExists(AllocId)) {
-        MCPlusBuilder::AllocatorIdTy Id =
-            BC.MIB->initializeNewAnnotationAllocator();
-        (void)Id;
-        assert(AllocId == Id && "unexpected allocator id created");
-      }
-      Pool.async(runBlock, BlockBegin, std::next(It), AllocId);
-      AllocId++;
-      BlockBegin = std::next(It);
-      CurrentCost = 0;
-    }
-  }
+    // See runOnEachFunction.
+    if (Cost >= BlockCost && CurrentCost)
+      scheduleBlock(It);
 
-  if (!BC.MIB->checkAllocatorExists(AllocId)) {
-    MCPlusBuilder::AllocatorIdTy Id =
-        BC.MIB->initializeNewAnnotationAllocator();
-    (void)Id;
-    assert(AllocId == Id && "unexpected allocator id created");
+    CurrentCost += Cost;
+    if (CurrentCost >= BlockCost)
+      scheduleBlock(std::next(It));
   }
 
-  Pool.async(runBlock, BlockBegin, BC.getBinaryFunctions().end(), AllocId);
+  scheduleBlock(BC.getBinaryFunctions().end());
   Lock.unlock();
   Pool.wait();
 }
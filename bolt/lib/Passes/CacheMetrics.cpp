@@ -242,6 +242,35 @@ void CacheMetrics::printAll(raw_ostream &OS,
                100.0 * HotCodeSize / TotalCodeSize, HotCodeSize, TotalCodeSize,
                double(HotCodeSize) / HugePage2MB);
 
+  // The hot code is mapped onto whole huge pages, so report how much the last
+  // partially used page contributes. A page that holds few samples is a
+  // candidate for trimming the hot set to end at the previous page boundary.
+  // Without hot blocks the hot range is empty and its bounds are meaningless.
+  if (NumHotBlocks && HotCodeMaxAddr > HotCodeMinAddr) {
+    const size_t FirstPage = HotCodeMinAddr / HugePage2MB;
+    const size_t LastPage = (HotCodeMaxAddr - 1) / HugePage2MB;
+    uint64_t HotSamples = 0;
+    uint64_t LastPageSamples = 0;
+    for (BinaryFunction *BF : BFs) {
+      if (!BF->hasValidIndex())
+        continue;
+      for (const BinaryBasicBlock &BB : *BF) {
+        if (BB.isCold() || BB.getKnownExecutionCount() == 0)
+          continue;
+        HotSamples += BB.getKnownExecutionCount();
+        if (BB.getOutputAddressRange().first / HugePage2MB == LastPage)
+          LastPageSamples += BB.getKnownExecutionCount();
+      }
+    }
+    const size_t LastPageStart =
+        std::max<size_t>(HotCodeMinAddr, LastPage * HugePage2MB);
+    OS << format("  Hot code spans %zu huge pages; the last one holds "
+                 "%.2lf%% of hot block executions in %.2lf%% of its space\n",
+                 LastPage - FirstPage + 1,
+                 100.0 * LastPageSamples / std::max<uint64_t>(HotSamples, 1),
+                 100.0 * (HotCodeMaxAddr - LastPageStart) / HugePage2MB);
+  }
+
   // Stats related to expected cache performance
   std::unordered_map<BinaryBasicBlock *, uint64_t> BBAddr;
   std::unordered_map<BinaryBasicBlock *, uint64_t> BBSize;
@@ -78,6 +78,13 @@ cl::opt<bool>
                       cl::init(false), cl::Optional,
                       cl::cat(BoltInstrCategory));
 
+static cl::opt<bool> InstrumentationAtomicCounters(
+    "instrumentation-atomic-counters",
+    cl::desc("update counters with atomic increments. Plain increments are "
+             "cheaper in heavily multithreaded programs but may lose counts "
+             "(default: true)"),
+    cl::init(true), cl::Optional, cl::cat(BoltInstrCategory));
+
 cl::opt<bool> InstrumentCalls("instrument-calls",
                               cl::desc("record profile for inter-function "
                                        "control flow activity (default: true)"),
@@ -266,7 +273,8 @@ Instrumentation::createInstrumentationSnippet(BinaryContext &BC, bool IsLeaf) {
   MCSymbol *Label = BC.Ctx->createNamedTempSymbol("InstrEntry");
   Summary->Counters.emplace_back(Label);
   return BC.MIB->createInstrIncMemory(Label, BC.Ctx.get(), IsLeaf,
-                                      BC.AsmInfo->getCodePointerSize());
+                                      BC.AsmInfo->getCodePointerSize(),
+                                      opts::InstrumentationAtomicCounters);
 }
 
 // Helper instruction sequence insertion function
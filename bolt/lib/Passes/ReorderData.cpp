@@ -16,8 +16,12 @@
 // - estimate temporal locality by looking at CFG?
 
 #include "bolt/Passes/ReorderData.h"
+#include "bolt/Utils/NameResolver.h"
 #include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/StringSet.h"
 #include <algorithm>
+#include <fstream>
+#include <optional>
 
 #undef  DEBUG_TYPE
 #define DEBUG_TYPE "reorder-data"
@@ -87,6 +91,12 @@ SkipSymbols("reorder-skip-symbols",
   cl::Hidden,
   cl::cat(BoltCategory));
 
+static cl::opt<std::string> GenerateDataOrderFile(
+    "generate-data-order",
+    cl::desc("file to dump the ordered list of hot data symbols to, in a "
+             "format suitable for the linker's --symbol-ordering-file"),
+    cl::cat(BoltOptCategory));
+
 static cl::opt<bool> ReorderInplace("reorder-data-inplace",
                                     cl::desc("reorder data sections in place"),
 
@@ -129,6 +139,26 @@ bool filterSymbol(const BinaryData *BD) {
   return IsValid;
 }
 
+/// Return the name the linker knows \p BD by, or std::nullopt if all of its
+/// names were made up by BOLT.
+std::optional<StringRef> getLinkerSymbolName(BinaryContext &BC,
+                                             const BinaryData &BD) {
+  const std::string PrivatePrefix =
+      std::string("PG") + BC.AsmInfo->getPrivateGlobalPrefix();
+  for (const MCSymbol *Symbol : BD.getSymbols()) {
+    StringRef Name = Symbol->getName();
+    if (BC.isInternalSymbolName(Name) || Name.starts_with("ANONYMOUS"))
+      continue;
+    // Undo the "/N" suffix that makes local names unique and the "PG" prefix
+    // that globalizes private names.
+    Name = NameResolver::restore(Name);
+    if (Name.starts_with(PrivatePrefix))
+      Name = Name.drop_front(2);
+    return Name;
+  }
+  return std::nullopt;
+}
+
 } // namespace
 
 using DataOrder = ReorderData::DataOrder;
@@ -477,6 +507,18 @@ Error ReorderData::runOnFunctions(BinaryContext &BC) {
     Sections.push_back(&*Section);
   }
 
+  std::unique_ptr<std::ofstream> OrderFile;
+  StringSet<> OrderedNames;
+  if (!opts::GenerateDataOrderFile.empty()) {
+    OrderFile = std::make_unique<std::ofstream>(opts::GenerateDataOrderFile,
+                                                std::ios::out);
+    if (!*OrderFile) {
+      BC.errs() << "BOLT-ERROR: data order file "
+                << opts::GenerateDataOrderFile << " cannot be opened\n";
+      return createFatalBOLTError("");
+    }
+  }
+
   for (BinarySection *Section : Sections) {
     const bool FoundUnmoveable = markUnmoveableSymbols(BC, *Section);
 
@@ -496,6 +538,17 @@ Error ReorderData::runOnFunctions(BinaryContext &BC) {
     if (opts::PrintReorderedData)
       printOrder(BC, *Section, Order.begin(), SplitPoint);
 
+    // The linker can apply the same hot-first order when relinking with
+    // -fdata-sections, without going through BOLT.
+    // Local symbols with the same name are ordered together, so each name is
+    // only written once.
+    if (OrderFile)
+      for (auto It = Order.begin(); It != SplitPoint; ++It)
+        if (std::optional<StringRef> Name =
+                getLinkerSymbolName(BC, *It->first))
+          if (OrderedNames.insert(*Name).second)
+            *OrderFile << Name->str() << '\n';
+
     if (!opts::ReorderInplace || FoundUnmoveable) {
       if (opts::ReorderInplace && FoundUnmoveable)
         BC.outs() << "BOLT-INFO: Found unmoveable symbols in "
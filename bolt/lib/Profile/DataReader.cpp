@@ -839,10 +839,10 @@ ErrorOr<StringRef> DataReader::parseString(char EndChar, bool EndNl) {
     return make_error_code(llvm::errc::io_error);
   }
 
-  std::string EndChars(1, EndChar);
-  EndChars.push_back('\\');
-  if (EndNl)
-    EndChars.push_back('\n');
+  // This is called for every field of every sample, so avoid building a
+  // std::string for the set of terminators.
+  const char EndCharsBuf[] = {EndChar, '\\', '\n'};
+  StringRef EndChars(EndCharsBuf, EndNl ? 3 : 2);
 
   size_t StringEnd = 0;
   do {
@@ -795,6 +795,11 @@ void DWARFRewriter::updateDebugInfo() {
   if (!SingleThreadedMode)
     DIEBlder.buildCompileUnits();
   if (SingleThreadedMode) {
+    // Only one batch of DIE trees is alive at a time: building the next batch
+    // releases the previous one, so -cu-processing-batch-size bounds memory.
+    // The units of a batch are not updated in parallel because the range, loc
+    // and address writers hand out section offsets in processing order, which
+    // would make the output nondeterministic.
     CUPartitionVector PartVec = partitionCUs(*BC.DwCtx);
     for (std::vector<DWARFUnit *> &Vec : PartVec) {
       DIEBlder.buildCompileUnits(Vec);
@@ -35,6 +35,7 @@
 #include "bolt/Utils/Utils.h"
 #include "llvm/ADT/AddressRanges.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/DebugInfo/DWARF/DWARFDebugFrame.h"
 #include "llvm/MC/MCAsmBackend.h"
@@ -3104,6 +3105,15 @@ void RewriteInstance::selectFunctionsToProcess() {
     }
   }
 
+  // Ignored functions are only scanned for external references; they are not
+  // disassembled and get no CFG. Report how much of the binary that leaves.
+  auto ReportLite = make_scope_exit([&] {
+    if (opts::Lite)
+      BC->outs() << "BOLT-INFO: lite mode will process "
+                 << NumFunctionsToProcess << " out of "
+                 << BC->getBinaryFunctions().size() << " functions\n";
+  });
+
   if (!BC->HasSplitFunctions)
     return;
 
@@ -3490,6 +3500,14 @@ void RewriteInstance::emitAndLink() {
                      TimerGroupDesc, opts::TimeRewrite);
 
   SmallString<0> ObjectBuffer;
+  // The emitted code is at least about as large as the input code of the
+  // emitted functions. Reserve that up front so that the buffer isn't
+  // repeatedly reallocated and copied while emitting large binaries.
+  uint64_t EmittedCodeSize = 0;
+  for (const auto &BFI : BC->getBinaryFunctions())
+    if (BC->shouldEmit(BFI.second))
+      EmittedCodeSize += BFI.second.getSize();
+  ObjectBuffer.reserve(EmittedCodeSize);
   raw_svector_ostream OS(ObjectBuffer);
 
   // Implicitly MCObjectStreamer takes ownership of MCAsmBackend (MAB)
@@ -3508,12 +3526,16 @@ void RewriteInstance::emitAndLink() {
     }
   }
 
-  emitBinaryContext(*Streamer, *BC, getOrgSecPrefix());
+  {
+    NamedRegionTimer T("emit", "emit functions and data", TimerGroupName,
+                       TimerGroupDesc, opts::TimeRewrite);
+    emitBinaryContext(*Streamer, *BC, getOrgSecPrefix());
 
-  Streamer->finish();
-  if (Streamer->getContext().hadError()) {
-    BC->errs() << "BOLT-ERROR: Emission failed.\n";
-    exit(1);
+    Streamer->finish();
+    if (Streamer->getContext().hadError()) {
+      BC->errs() << "BOLT-ERROR: Emission failed.\n";
+      exit(1);
+    }
   }
 
   if (opts::KeepTmp) {
@@ -3548,8 +3570,13 @@ void RewriteInstance::emitAndLink() {
   EFMM->setOrgSecPrefix(getOrgSecPrefix());
 
   Linker = std::make_unique<JITLinkLinker>(*BC, std::move(EFMM));
-  Linker->loadObject(ObjectMemBuffer->getMemBufferRef(),
-                     [this](auto MapSection) { mapFileSections(MapSection); });
+  {
+    NamedRegionTimer T("link", "link emitted object", TimerGroupName,
+                       TimerGroupDesc, opts::TimeRewrite);
+    Linker->loadObject(
+        ObjectMemBuffer->getMemBufferRef(),
+        [this](auto MapSection) { mapFileSections(MapSection); });
+  }
 
   // Update output addresses based on the new section map and
   // layout. Only do this for the object created by ourselves.
@@ -1558,7 +1558,9 @@ public:
 
   InstructionListType
   createInstrIncMemory(const MCSymbol *Target, MCContext *Ctx, bool IsLeaf,
-                       unsigned CodePointerSize) const override {
+                       unsigned CodePointerSize, bool IsAtomic) const override {
+    // A plain load, add and store sequence would need another scratch
+    // register, so the atomic add is used regardless of IsAtomic.
     unsigned int I = 0;
     InstructionListType Instrs(IsLeaf ? 12 : 10);
 
@@ -63,10 +63,11 @@ bool isADDri(const MCInst &Inst) {
 
 // Create instruction to increment contents of target by 1
 static InstructionListType createIncMemory(const MCSymbol *Target,
-                                           MCContext *Ctx) {
+                                           MCContext *Ctx,
+                                           bool IsAtomic = true) {
   InstructionListType Insts;
   Insts.emplace_back();
-  Insts.back().setOpcode(X86::LOCK_INC64m);
+  Insts.back().setOpcode(IsAtomic ? X86::LOCK_INC64m : X86::INC64m);
   Insts.back().clear();
   Insts.back().addOperand(MCOperand::createReg(X86::RIP));        // BaseReg
   Insts.back().addOperand(MCOperand::createImm(1));               // ScaleAmt
@@ -3045,7 +3046,7 @@ public:
 
   InstructionListType
   createInstrIncMemory(const MCSymbol *Target, MCContext *Ctx, bool IsLeaf,
-                       unsigned CodePointerSize) const override {
+                       unsigned CodePointerSize, bool IsAtomic) const override {
     InstructionListType Instrs(IsLeaf ? 13 : 11);
     unsigned int I = 0;
 
@@ -3064,8 +3065,8 @@ public:
     createPushRegister(Instrs[I++], X86::RAX, 8);
     createClearRegWithNoEFlagsUpdate(Instrs[I++], X86::RAX, 8);
     createX86SaveOVFlagToRegister(Instrs[I++], X86::AL);
-    // LOCK INC
-    InstructionListType IncMem = createIncMemory(Target, Ctx);
+    // LOCK INC, or a plain INC if counters don't need to be exact.
+    InstructionListType IncMem = createIncMemory(Target, Ctx, IsAtomic);
     assert(IncMem.size() == 1 && "Invalid IncMem size");
     std::copy(IncMem.begin(), IncMem.end(), Instrs.begin() + I);
     I += IncMem.size();
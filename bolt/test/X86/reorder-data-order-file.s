@@ -0,0 +1,58 @@
+## Check that -generate-data-order writes the hot data in the new order, under
+## the names the linker knows it by, and that lld can apply the file.
+
+# REQUIRES: system-linux
+
+# RUN: llvm-mc -filetype=obj -triple x86_64-unknown-unknown %s -o %t.o
+# RUN: ld.lld -q %t.o -o %t.exe
+# RUN: llvm-bolt %t.exe -o %t.bolt -data %p/Inputs/reorder-data-order-file.fdata \
+# RUN:   -reorder-data=.data -generate-data-order=%t.order
+# RUN: FileCheck %s --check-prefix=ORDER < %t.order
+
+## The local symbol is uniquified as hot_local/1 inside BOLT, and must be
+## written under its original name.
+# ORDER:      {{^}}hot_global{{$}}
+# ORDER-NEXT: {{^}}hot_local{{$}}
+# ORDER-NOT:  {{.}}
+
+## lld warns about names in the ordering file that it can't find.
+# RUN: ld.lld %t.o -o %t.relinked --symbol-ordering-file=%t.order \
+# RUN:   --fatal-warnings
+# RUN: llvm-nm -n %t.relinked | FileCheck %s --check-prefix=NM
+
+# NM:      D hot_global
+# NM-NEXT: d hot_local
+# NM-NEXT: D cold_var
+
+  .text
+  .globl _start
+  .type _start, @function
+_start:
+  movl cold_var(%rip), %eax
+  movl hot_local(%rip), %eax
+  movl hot_global(%rip), %eax
+  retq
+  .size _start, .-_start
+
+  .section .data.cold_var,"aw",@progbits
+  .globl cold_var
+  .type cold_var, @object
+  .p2align 2
+cold_var:
+  .long 1
+  .size cold_var, 4
+
+  .section .data.hot_local,"aw",@progbits
+  .type hot_local, @object
+  .p2align 2
+hot_local:
+  .long 2
+  .size hot_local, 4
+
+  .section .data.hot_global,"aw",@progbits
+  .globl hot_global
+  .type hot_global, @object
+  .p2align 2
+hot_global:
+  .long 3
+  .size hot_global, 4
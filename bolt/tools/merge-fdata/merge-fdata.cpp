@@ -23,6 +23,7 @@
 #include "llvm/Support/ThreadPool.h"
 #include <algorithm>
 #include <mutex>
+#include <tuple>
 #include <unordered_map>
 
 using namespace llvm;
@@ -297,9 +298,11 @@ void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
       Profile = &Profiles[tid];
     }
 
-    SmallVector<StringRef> Lines;
-    SplitString(Buf, Lines, "\n");
-    for (StringRef Line : Lines) {
+    while (!Buf.empty()) {
+      StringRef Line;
+      std::tie(Line, Buf) = Buf.split('\n');
+      if (Line.empty())
+        continue;
       size_t Pos = Line.rfind(" ");
       if (Pos == StringRef::npos)
         report_error(Filename, "Malformed / corrupted profile");
@@ -307,8 +310,7 @@ void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
       uint64_t Count;
       if (Line.substr(Pos + 1, Line.size() - Pos).getAsInteger(10, Count))
         report_error(Filename, "Malformed / corrupted profile counter");
-      Count += Profile->lookup(Signature);
-      Profile->insert_or_assign(Signature, Count);
+      (*Profile)[Signature] += Count;
     }
   };
 
@@ -325,10 +327,8 @@ void mergeLegacyProfiles(const SmallVectorImpl<std::string> &Filenames) {
 
   ProfileTy MergedProfile;
   for (const auto &[Thread, Profile] : ParsedProfiles)
-    for (const auto &[Key, Value] : Profile) {
-      uint64_t Count = MergedProfile.lookup(Key) + Value;
-      MergedProfile.insert_or_assign(Key, Count);
-    }
+    for (const auto &[Key, Value] : Profile)
+      MergedProfile[Key] += Value;
 
   if (BoltedCollection.value_or(false))
     output() << "boltedcollection\n";
@@ -412,13 +412,10 @@ int main(int argc, char **argv) {
 
     // Do the function merge.
     for (BinaryFunctionProfile &BF : BP.Functions) {
-      if (!MergedBFs.count(BF.Name)) {
-        MergedBFs.insert(std::make_pair(BF.Name, BF));
-        continue;
-      }
-
-      BinaryFunctionProfile &MergedBF = MergedBFs.find(BF.Name)->second;
-      mergeFunctionProfile(MergedBF, std::move(BF));
+      // The key is copied before BF is moved into the map.
+      auto [It, Inserted] = MergedBFs.try_emplace(BF.Name, std::move(BF));
+      if (!Inserted)
+        mergeFunctionProfile(It->second, std::move(BF));
     }
   }
 
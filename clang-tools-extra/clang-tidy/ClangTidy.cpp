@@ -426,6 +426,7 @@ ClangTidyASTConsumerFactory::createASTConsumer(
     Profiling = std::make_unique<ClangTidyProfiling>(
         Context.getProfileStorageParams());
     FinderOptions.CheckProfiling.emplace(Profiling->Records);
+    FinderOptions.CheckProfiling->Evaluations = &Profiling->Evaluations;
   }
 
   std::unique_ptr<ast_matchers::MatchFinder> Finder(
@@ -7,13 +7,17 @@
 //===----------------------------------------------------------------------===//
 
 #include "ClangTidyProfiling.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <optional>
 #include <system_error>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #define DEBUG_TYPE "clang-tidy-profiling"
 
@@ -36,8 +40,28 @@ ClangTidyProfiling::StorageParams::StorageParams(llvm::StringRef ProfilePrefix,
                       .str();
 }
 
+std::vector<std::pair<llvm::StringRef, uint64_t>>
+ClangTidyProfiling::sortedEvaluations() const {
+  std::vector<std::pair<llvm::StringRef, uint64_t>> Result;
+  for (const auto &E : Evaluations)
+    Result.emplace_back(E.getKey(), E.getValue());
+  llvm::sort(Result, [](const auto &L, const auto &R) {
+    return std::tie(R.second, L.first) < std::tie(L.second, R.first);
+  });
+  return Result;
+}
+
 void ClangTidyProfiling::printUserFriendlyTable(llvm::raw_ostream &OS) {
   TG->print(OS);
+  if (!Evaluations.empty()) {
+    OS << "===" << std::string(73, '-') << "===\n"
+       << "                          Matcher evaluations\n"
+       << "===" << std::string(73, '-') << "===\n";
+    for (const auto &[Name, Count] : sortedEvaluations())
+      OS << llvm::format("%12llu", (unsigned long long)Count) << "  " << Name
+         << "\n";
+    OS << "\n";
+  }
   OS.flush();
 }
 
@@ -46,7 +70,11 @@ void ClangTidyProfiling::printAsJSON(llvm::raw_ostream &OS) {
   OS << R"("file": ")" << Storage->SourceFilename << "\",\n";
   OS << R"("timestamp": ")" << Storage->Timestamp << "\",\n";
   OS << "\"profile\": {\n";
-  TG->printJSONValues(OS, "");
+  const char *Delim = TG->printJSONValues(OS, "");
+  for (const auto &[Name, Count] : sortedEvaluations()) {
+    OS << Delim << "\t\"evaluations.clang-tidy." << Name << "\": " << Count;
+    Delim = ",\n";
+  }
   OS << "\n}\n";
   OS << "}\n";
   OS.flush();
@@ -14,6 +14,8 @@
 #include "llvm/Support/Timer.h"
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace llvm {
 class raw_ostream;
@@ -38,6 +40,7 @@ private:
 
   std::optional<StorageParams> Storage;
 
+  std::vector<std::pair<llvm::StringRef, uint64_t>> sortedEvaluations() const;
   void printUserFriendlyTable(llvm::raw_ostream &OS);
   void printAsJSON(llvm::raw_ostream &OS);
 
@@ -45,6 +48,8 @@ private:
 
 public:
   llvm::StringMap<llvm::TimeRecord> Records;
+  /// The number of times each check's matchers were evaluated against a node.
+  llvm::StringMap<uint64_t> Evaluations;
 
   ClangTidyProfiling() = default;
 
@@ -239,8 +239,8 @@ configuration of all checks.
                                 cl::init(false), cl::cat(ClangTidyCategory));
 
 static cl::opt<bool> EnableCheckProfile("enable-check-profile", desc(R"(
-Enable per-check timing profiles, and print a
-report to stderr.
+Enable per-check timing profiles and matcher
+evaluation counts, and print a report to stderr.
 )"),
                                         cl::init(false),
                                         cl::cat(ClangTidyCategory));
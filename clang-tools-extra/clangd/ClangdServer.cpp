@@ -309,7 +309,8 @@ void ClangdServer::addDocument(PathRef File, llvm::StringRef Contents,
   Inputs.ClangTidyProvider = ClangTidyProvider;
   Inputs.FeatureModules = FeatureModules;
   bool NewFile = WorkScheduler->update(File, Inputs, WantDiags);
-  // If we loaded Foo.h, we want to make sure Foo.cpp is indexed.
+  // If we loaded Foo.h or Foo.cpp, we want to make sure Foo.cpp is indexed
+  // soon, along with everything it includes.
   if (NewFile && BackgroundIdx)
     BackgroundIdx->boostRelated(File);
 }
@@ -462,6 +463,9 @@ void ClangdServer::codeComplete(PathRef File, Position Pos,
       std::lock_guard<std::mutex> Lock(CachedCompletionFuzzyFindRequestMutex);
       CachedCompletionFuzzyFindRequestByFile[File] = *SpecFuzzyFind->NewReq;
     }
+    // Completion is done, stop a speculative request that is still running.
+    if (SpecFuzzyFind && SpecFuzzyFind->Cancel)
+      SpecFuzzyFind->Cancel();
     // SpecFuzzyFind is only destroyed after speculative fuzzy find finishes.
     // We don't want `codeComplete` to wait for the async call if it doesn't use
     // the result (e.g. non-index completion, speculation fails), so that `CB`
@@ -1626,6 +1626,9 @@ public:
       assert(!SpecFuzzyFind->Result.valid());
       SpecReq = speculativeFuzzyFindRequestForCompletion(
           *SpecFuzzyFind->CachedReq, HeuristicPrefix);
+      auto Task = cancelableTask();
+      WithContext Cancelable(std::move(Task.first));
+      SpecFuzzyFind->Cancel = std::move(Task.second);
       SpecFuzzyFind->Result = startAsyncFuzzyFind(*Opts.Index, *SpecReq);
     }
 
@@ -1893,6 +1896,8 @@ private:
     }
 
     SPAN_ATTACH(Tracer, "Speculative results", false);
+    if (SpecFuzzyFind && SpecFuzzyFind->Cancel)
+      SpecFuzzyFind->Cancel();
 
     // Run the query against the index.
     SymbolSlab::Builder ResultsBuilder;
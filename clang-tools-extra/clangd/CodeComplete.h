@@ -22,6 +22,7 @@
 #include "index/Index.h"
 #include "index/Symbol.h"
 #include "index/SymbolOrigin.h"
+#include "support/Cancellation.h"
 #include "support/Markup.h"
 #include "support/Path.h"
 #include "clang/Sema/CodeCompleteConsumer.h"
@@ -270,6 +271,9 @@ struct SpeculativeFuzzyFind {
   /// The result is consumed by `codeComplete()` if speculation succeeded.
   /// NOTE: the destructor will wait for the async call to finish.
   std::future<std::pair<bool /*Incomplete*/, SymbolSlab>> Result;
+  /// Cancels the async call. Used once it is known that the result will not
+  /// be consumed, so that indexes that honor cancellation stop early.
+  Canceler Cancel;
 };
 
 /// Gets code completions at a specified \p Pos in \p FileName.
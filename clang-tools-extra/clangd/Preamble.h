@@ -148,6 +148,9 @@ struct PreambleBuildStats {
 /// Build a preamble for the new inputs unless an old one can be reused.
 /// If \p PreambleCallback is set, it will be run on top of the AST while
 /// building the preamble.
+/// Preambles are per file: the PCH records the main file it was built for, and
+/// PreambleData holds main-file specific includes, macros, pragma marks and
+/// diagnostics, so files with identical include prefixes do not share one.
 /// If Stats is not non-null, build statistics will be exported there.
 std::shared_ptr<const PreambleData>
 buildPreamble(PathRef FileName, CompilerInvocation CI,
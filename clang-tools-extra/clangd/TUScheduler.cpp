@@ -152,7 +152,9 @@ class TUScheduler::ASTCache {
 public:
   using Key = const ASTWorker *;
 
-  ASTCache(unsigned MaxRetainedASTs) : MaxRetainedASTs(MaxRetainedASTs) {}
+  ASTCache(const ASTRetentionPolicy &Policy)
+      : MaxRetainedASTs(Policy.MaxRetainedASTs),
+        MaxRetainedBytes(Policy.MaxRetainedBytes) {}
 
   /// Returns result of getUsedBytes() for the AST cached by \p K.
   /// If no AST is cached, 0 is returned.
@@ -164,8 +166,8 @@ public:
     return It->second->getUsedBytes();
   }
 
-  /// Store the value in the pool, possibly removing the last used AST.
-  /// The value should not be in the pool when this function is called.
+  /// Store the value in the pool, possibly removing the least recently used
+  /// ASTs. The value should not be in the pool when this function is called.
   void put(Key K, std::unique_ptr<ParsedAST> V) {
     std::unique_lock<std::mutex> Lock(Mut);
     assert(findByKey(K) == LRU.end());
@@ -173,12 +175,24 @@ public:
     LRU.insert(LRU.begin(), {K, std::move(V)});
     if (LRU.size() <= MaxRetainedASTs)
       return;
-    // We're past the limit, remove the last element.
-    std::unique_ptr<ParsedAST> ForCleanup = std::move(LRU.back().second);
-    LRU.pop_back();
-    // Run the expensive destructor outside the lock.
+    size_t UsedBytes = 0;
+    if (MaxRetainedBytes) {
+      for (const KVPair &P : LRU)
+        if (P.second)
+          UsedBytes += P.second->getUsedBytes();
+    }
+    // We're past the limit, remove the last elements.
+    std::vector<std::unique_ptr<ParsedAST>> ForCleanup;
+    while (LRU.size() > MaxRetainedASTs &&
+           (!MaxRetainedBytes || UsedBytes > MaxRetainedBytes)) {
+      if (LRU.back().second)
+        UsedBytes -= std::min(UsedBytes, LRU.back().second->getUsedBytes());
+      ForCleanup.push_back(std::move(LRU.back().second));
+      LRU.pop_back();
+    }
+    // Run the expensive destructors outside the lock.
     Lock.unlock();
-    ForCleanup.reset();
+    ForCleanup.clear();
   }
 
   /// Returns the cached value for \p K, or std::nullopt if the value is not in
@@ -214,6 +228,7 @@ private:
 
   std::mutex Mut;
   unsigned MaxRetainedASTs;
+  size_t MaxRetainedBytes;
   /// Items sorted in LRU order, i.e. first item is the most recently accessed
   /// one.
   std::vector<KVPair> LRU; /* GUARDED_BY(Mut) */
@@ -1631,8 +1646,7 @@ TUScheduler::TUScheduler(const GlobalCompilationDatabase &CDB,
       Callbacks(Callbacks ? std::move(Callbacks)
                           : std::make_unique<ParsingCallbacks>()),
       Barrier(Opts.AsyncThreadsCount), QuickRunBarrier(Opts.AsyncThreadsCount),
-      IdleASTs(
-          std::make_unique<ASTCache>(Opts.RetentionPolicy.MaxRetainedASTs)),
+      IdleASTs(std::make_unique<ASTCache>(Opts.RetentionPolicy)),
       HeaderIncluders(std::make_unique<HeaderIncluderCache>()) {
   // Avoid null checks everywhere.
   if (!Opts.ContextProvider) {
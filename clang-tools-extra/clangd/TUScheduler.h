@@ -64,6 +64,10 @@ struct ASTRetentionPolicy {
   /// Maximum number of ASTs to be retained in memory when there are no pending
   /// requests for them.
   unsigned MaxRetainedASTs = 3;
+  /// If non-zero, idle ASTs beyond MaxRetainedASTs are also kept as long as
+  /// all retained ASTs together use at most this many bytes. This avoids
+  /// rebuilding ASTs when switching between a handful of small files.
+  size_t MaxRetainedBytes = 0;
 };
 
 /// Clangd may wait after an update to see if another one comes along.
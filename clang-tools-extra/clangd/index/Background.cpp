@@ -176,8 +176,10 @@ BackgroundQueue::Task BackgroundIndex::indexFileTask(std::string Path) {
 }
 
 void BackgroundIndex::boostRelated(llvm::StringRef Path) {
-  if (isHeaderFile(Path))
-    Queue.boost(filenameWithoutExtension(Path), IndexBoostedFile);
+  // Tasks are tagged by the filename without extension, so this covers both
+  // the main files next to an opened header and an opened main file itself.
+  // Indexing such a TU also indexes all of its transitive includes.
+  Queue.boost(filenameWithoutExtension(Path), IndexBoostedFile);
 }
 
 /// Given index results from a TU, only update symbols coming from files that
@@ -162,7 +162,7 @@ public:
   }
 
   /// Boosts priority of indexing related to Path.
-  /// Typically used to index TUs when headers are opened.
+  /// Typically used to index TUs when they or their headers are opened.
   void boostRelated(llvm::StringRef Path);
 
   // Cause background threads to stop after ther current task, any remaining
@@ -299,14 +299,24 @@ FileSymbols::buildIndex(IndexType Type, DuplicateHandling DuplicateHandle,
   std::vector<Symbol> SymsStorage;
   switch (DuplicateHandle) {
   case DuplicateHandling::Merge: {
-    llvm::DenseMap<SymbolID, Symbol> Merged;
+    // Merge symbols directly into their final storage, so that we don't keep a
+    // second copy of every symbol around while building the index.
+    size_t NumSymbols = 0;
+    for (const auto &Slab : SymbolSlabs)
+      NumSymbols += Slab->size();
+    SymsStorage.reserve(NumSymbols);
+    llvm::DenseMap<SymbolID, size_t> Merged; // Index into SymsStorage.
+    Merged.reserve(NumSymbols);
     for (const auto &Slab : SymbolSlabs) {
       for (const auto &Sym : *Slab) {
         assert(Sym.References == 0 &&
                "Symbol with non-zero references sent to FileSymbols");
-        auto I = Merged.try_emplace(Sym.ID, Sym);
-        if (!I.second)
-          I.first->second = mergeSymbol(I.first->second, Sym);
+        auto I = Merged.try_emplace(Sym.ID, SymsStorage.size());
+        if (I.second)
+          SymsStorage.push_back(Sym);
+        else
+          SymsStorage[I.first->second] =
+              mergeSymbol(SymsStorage[I.first->second], Sym);
       }
     }
     for (const RefSlab *Refs : MainFileRefs)
@@ -315,13 +325,11 @@ FileSymbols::buildIndex(IndexType Type, DuplicateHandling DuplicateHandle,
         // This might happen while background-index is still running.
         if (It == Merged.end())
           continue;
-        It->getSecond().References += Sym.second.size();
+        SymsStorage[It->second].References += Sym.second.size();
       }
-    SymsStorage.reserve(Merged.size());
-    for (auto &Sym : Merged) {
-      SymsStorage.push_back(std::move(Sym.second));
-      AllSymbols.push_back(&SymsStorage.back());
-    }
+    AllSymbols.reserve(SymsStorage.size());
+    for (const Symbol &Sym : SymsStorage)
+      AllSymbols.push_back(&Sym);
     break;
   }
   case DuplicateHandling::PickOne: {
@@ -362,6 +370,10 @@ FileSymbols::buildIndex(IndexType Type, DuplicateHandling DuplicateHandle,
   }
 
   std::vector<Relation> AllRelations;
+  size_t NumRelations = 0;
+  for (const auto &RelationSlab : RelationSlabs)
+    NumRelations += RelationSlab->size();
+  AllRelations.reserve(NumRelations);
   for (const auto &RelationSlab : RelationSlabs) {
     for (const auto &R : *RelationSlab)
       AllRelations.push_back(R);
@@ -10,9 +10,11 @@
 
 #include "Client.h"
 #include "Feature.h"
+#include "LookupCache.h"
 #include "Service.grpc.pb.h"
 #include "index/Index.h"
 #include "marshalling/Marshalling.h"
+#include "support/Cancellation.h"
 #include "support/Logger.h"
 #include "support/Trace.h"
 #include "llvm/ADT/SmallString.h"
@@ -61,8 +63,8 @@ class IndexClient : public clangd::SymbolIndex {
   template <typename RequestT, typename ReplyT, typename ClangdRequestT,
             typename CallbackT>
   bool streamRPC(ClangdRequestT Request,
-                 StreamingCall<RequestT, ReplyT> RPCCall,
-                 CallbackT Callback) const {
+                 StreamingCall<RequestT, ReplyT> RPCCall, CallbackT Callback,
+                 bool *Succeeded = nullptr) const {
     updateConnectionStatus();
     // We initialize to true because stream might be broken before we see the
     // final message. In such a case there are actually more results on the
@@ -86,6 +88,12 @@ class IndexClient : public clangd::SymbolIndex {
     unsigned Successful = 0;
     unsigned FailedToParse = 0;
     while (Reader->Read(&Reply)) {
+      if (isCancelled()) {
+        // Drop the rest of the stream; the next Read() ends the loop.
+        Context.TryCancel();
+        HasMore = true;
+        continue;
+      }
       if (!Reply.has_stream_result()) {
         HasMore = Reply.final_result().has_more();
         continue;
@@ -106,7 +114,10 @@ class IndexClient : public clangd::SymbolIndex {
                       .count();
     vlog("Remote index [{0}]: {1} => {2} results in {3}ms.", ServerAddress,
          RequestT::descriptor()->name(), Successful, Millis);
-    SPAN_ATTACH(Tracer, "Status", Reader->Finish().ok());
+    bool OK = Reader->Finish().ok();
+    if (Succeeded)
+      *Succeeded = OK;
+    SPAN_ATTACH(Tracer, "Status", OK);
     SPAN_ATTACH(Tracer, "Successful", Successful);
     SPAN_ATTACH(Tracer, "Failed to parse", FailedToParse);
     updateConnectionStatus();
@@ -130,7 +141,24 @@ public:
   void lookup(const clangd::LookupRequest &Request,
               llvm::function_ref<void(const clangd::Symbol &)> Callback)
       const override {
-    streamRPC(Request, &remote::v1::SymbolIndex::Stub::Lookup, Callback);
+    std::string Key = LookupCache::key(Request);
+    if (auto Cached = LookupResults.get(Key)) {
+      for (const clangd::Symbol &Sym : *Cached)
+        Callback(Sym);
+      return;
+    }
+    SymbolSlab::Builder Results;
+    bool Succeeded = false;
+    streamRPC(
+        Request, &remote::v1::SymbolIndex::Stub::Lookup,
+        [&](const clangd::Symbol &Sym) { Results.insert(Sym); }, &Succeeded);
+    auto Symbols =
+        std::make_shared<const SymbolSlab>(std::move(Results).build());
+    for (const clangd::Symbol &Sym : *Symbols)
+      Callback(Sym);
+    // Don't remember the results of failed or cancelled requests.
+    if (Succeeded)
+      LookupResults.put(Key, std::move(Symbols));
   }
 
   bool fuzzyFind(const clangd::FuzzyFindRequest &Request,
@@ -178,6 +206,8 @@ private:
   std::unique_ptr<Marshaller> ProtobufMarshaller;
   // Each request will be terminated if it takes too long.
   std::chrono::milliseconds DeadlineWaitingTime;
+  mutable LookupCache LookupResults{/*Capacity=*/512,
+                                    /*Lifetime=*/std::chrono::seconds(30)};
 };
 
 } // namespace
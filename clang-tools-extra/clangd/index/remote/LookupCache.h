@@ -0,0 +1,99 @@
+//===--- LookupCache.h - Cache of remote index lookups -----------*- C++-*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_TOOLS_EXTRA_CLANGD_INDEX_REMOTE_LOOKUPCACHE_H
+#define LLVM_CLANG_TOOLS_EXTRA_CLANGD_INDEX_REMOTE_LOOKUPCACHE_H
+
+#include "index/Index.h"
+#include "index/Symbol.h"
+#include "index/SymbolID.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace clangd {
+namespace remote {
+
+/// A small LRU cache of recent lookup() results. Features like hover and
+/// go-to-definition look up the same few symbols over and over. The remote
+/// index is rebuilt rarely, so results are reused for a short time rather
+/// than invalidated by the server.
+class LookupCache {
+public:
+  /// Keeps the results of at most \p Capacity requests, each for at most
+  /// \p Lifetime.
+  LookupCache(size_t Capacity, std::chrono::steady_clock::duration Lifetime)
+      : Capacity(Capacity), Lifetime(Lifetime) {}
+
+  /// Returns the cached symbols for \p Key, or nullptr if there are none or
+  /// they have expired.
+  std::shared_ptr<const SymbolSlab> get(llvm::StringRef Key) {
+    std::lock_guard<std::mutex> Lock(Mu);
+    auto It = Index.find(Key);
+    if (It == Index.end())
+      return nullptr;
+    if (std::chrono::steady_clock::now() >= It->second->Expiry) {
+      Entries.erase(It->second);
+      Index.erase(It);
+      return nullptr;
+    }
+    Entries.splice(Entries.begin(), Entries, It->second);
+    return It->second->Symbols;
+  }
+
+  void put(llvm::StringRef Key, std::shared_ptr<const SymbolSlab> Symbols) {
+    std::lock_guard<std::mutex> Lock(Mu);
+    auto [It, Inserted] = Index.try_emplace(Key);
+    if (!Inserted)
+      Entries.erase(It->second);
+    Entries.push_front({It->first(), std::move(Symbols),
+                        std::chrono::steady_clock::now() + Lifetime});
+    It->second = Entries.begin();
+    if (Entries.size() > Capacity) {
+      Index.erase(Entries.back().Key);
+      Entries.pop_back();
+    }
+  }
+
+  /// Returns the key for \p Request, which does not depend on the order of
+  /// the requested IDs.
+  static std::string key(const clangd::LookupRequest &Request) {
+    std::vector<SymbolID> IDs(Request.IDs.begin(), Request.IDs.end());
+    llvm::sort(IDs);
+    std::string Key;
+    Key.reserve(IDs.size() * SymbolID::RawSize);
+    for (const SymbolID &ID : IDs)
+      Key += ID.raw();
+    return Key;
+  }
+
+private:
+  struct Entry {
+    llvm::StringRef Key; // Owned by Index.
+    std::shared_ptr<const SymbolSlab> Symbols;
+    std::chrono::steady_clock::time_point Expiry;
+  };
+  const size_t Capacity;
+  const std::chrono::steady_clock::duration Lifetime;
+  std::mutex Mu;
+  std::list<Entry> Entries; // Most recently used first.
+  llvm::StringMap<std::list<Entry>::iterator> Index;
+};
+
+} // namespace remote
+} // namespace clangd
+} // namespace clang
+
+#endif
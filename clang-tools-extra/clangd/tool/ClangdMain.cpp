@@ -352,6 +352,15 @@ opt<unsigned> WorkerThreadsCount{
     init(getDefaultAsyncThreadsCount()),
 };
 
+opt<unsigned> RetainedASTMemoryMB{
+    "retained-ast-memory-mb",
+    cat(Misc),
+    desc("Keep more than the default number of idle ASTs in memory, as long "
+         "as they use at most this many megabytes in total. 0 disables"),
+    init(0),
+    Hidden,
+};
+
 opt<Path> IndexFile{
     "index-file",
     cat(Misc),
@@ -897,6 +906,7 @@ clangd accepts flags on the commandline, and in the CLANGD_FLAGS environment var
   auto PAI = createProjectAwareIndex(loadExternalIndex, Sync);
   Opts.StaticIndex = PAI.get();
   Opts.AsyncThreadsCount = WorkerThreadsCount;
+  Opts.RetentionPolicy.MaxRetainedBytes = size_t(RetainedASTMemoryMB) << 20;
   Opts.MemoryCleanup = getMemoryCleanupFunction();
 
   Opts.CodeComplete.IncludeIneligibleResults = IncludeIneligibleResults;
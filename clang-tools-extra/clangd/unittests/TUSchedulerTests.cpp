@@ -643,6 +643,23 @@ TEST_F(TUSchedulerTests, EvictedAST) {
               UnorderedElementsAre(Foo, AnyOf(Bar, Baz)));
 }
 
+TEST_F(TUSchedulerTests, RetainedASTsWithinMemoryBudget) {
+  auto Opts = optsForTest();
+  Opts.RetentionPolicy.MaxRetainedASTs = 1;
+  Opts.RetentionPolicy.MaxRetainedBytes = size_t(1) << 30;
+  TUScheduler S(CDB, Opts);
+
+  auto Foo = testPath("foo.cpp");
+  auto Bar = testPath("bar.cpp");
+  auto Baz = testPath("baz.cpp");
+  for (PathRef File : {Foo, Bar, Baz})
+    S.update(File, getInputs(File, "int x;"), WantDiagnostics::Yes);
+  ASSERT_TRUE(S.blockUntilIdle(timeoutSeconds(60)));
+
+  // The ASTs are tiny, so all of them fit into the budget.
+  EXPECT_THAT(S.getFilesWithCachedAST(), UnorderedElementsAre(Foo, Bar, Baz));
+}
+
 // We send "empty" changes to TUScheduler when we think some external event
 // *might* have invalidated current state (e.g. a header was edited).
 // Verify that this doesn't evict our cache entries.
@@ -0,0 +1,87 @@
+//===--- LookupCacheTests.cpp ------------------------------------*- C++-*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "TestIndex.h"
+#include "index/remote/LookupCache.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace clang {
+namespace clangd {
+namespace remote {
+namespace {
+
+using ::testing::UnorderedElementsAre;
+
+std::shared_ptr<const SymbolSlab> slab(std::vector<std::string> Names) {
+  return std::make_shared<const SymbolSlab>(generateSymbols(std::move(Names)));
+}
+
+std::vector<std::string> names(const SymbolSlab &Slab) {
+  std::vector<std::string> Result;
+  for (const Symbol &Sym : Slab)
+    Result.push_back(getQualifiedName(Sym));
+  return Result;
+}
+
+LookupRequest request(std::vector<std::string> QNames) {
+  LookupRequest Req;
+  for (const std::string &QName : QNames)
+    Req.IDs.insert(symbol(QName).ID);
+  return Req;
+}
+
+TEST(RemoteLookupCache, KeyIgnoresOrder) {
+  LookupRequest AB = request({"a", "b"});
+  LookupRequest BA = request({"b", "a"});
+  EXPECT_EQ(LookupCache::key(AB), LookupCache::key(BA));
+  EXPECT_NE(LookupCache::key(AB), LookupCache::key(request({"a"})));
+}
+
+TEST(RemoteLookupCache, ReturnsCachedResults) {
+  LookupCache Cache(/*Capacity=*/2, /*Lifetime=*/std::chrono::hours(1));
+  std::string Key = LookupCache::key(request({"ns::foo"}));
+  EXPECT_EQ(Cache.get(Key), nullptr);
+
+  Cache.put(Key, slab({"ns::foo"}));
+  auto Cached = Cache.get(Key);
+  ASSERT_NE(Cached, nullptr);
+  EXPECT_THAT(names(*Cached), UnorderedElementsAre("ns::foo"));
+
+  // A newer result for the same request replaces the old one.
+  Cache.put(Key, slab({"ns::foo", "ns::bar"}));
+  Cached = Cache.get(Key);
+  ASSERT_NE(Cached, nullptr);
+  EXPECT_THAT(names(*Cached), UnorderedElementsAre("ns::foo", "ns::bar"));
+}
+
+TEST(RemoteLookupCache, EvictsLeastRecentlyUsed) {
+  LookupCache Cache(/*Capacity=*/2, /*Lifetime=*/std::chrono::hours(1));
+  Cache.put("a", slab({"a"}));
+  Cache.put("b", slab({"b"}));
+  // Using "a" makes "b" the least recently used entry.
+  EXPECT_NE(Cache.get("a"), nullptr);
+  Cache.put("c", slab({"c"}));
+  EXPECT_NE(Cache.get("a"), nullptr);
+  EXPECT_EQ(Cache.get("b"), nullptr);
+  EXPECT_NE(Cache.get("c"), nullptr);
+}
+
+TEST(RemoteLookupCache, ExpiresEntries) {
+  LookupCache Cache(/*Capacity=*/2, /*Lifetime=*/std::chrono::seconds(0));
+  Cache.put("a", slab({"a"}));
+  EXPECT_EQ(Cache.get("a"), nullptr);
+  // The expired entry was dropped, so it can be added again.
+  Cache.put("a", slab({"a"}));
+  EXPECT_EQ(Cache.get("a"), nullptr);
+}
+
+} // namespace
+} // namespace remote
+} // namespace clangd
+} // namespace clang
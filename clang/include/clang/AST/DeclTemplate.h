@@ -797,6 +797,13 @@ protected:
     ///
     /// The first value in the array is the number of specializations/partial
     /// specializations that follow.
+    ///
+    /// All of them are loaded on the first lookup of any specialization. They
+    /// are not keyed by their template arguments: a lookup finds a match by
+    /// profiling the canonical arguments, which requires the deserialized
+    /// declarations. A hash that is stable across the writer and the reader,
+    /// such as the ODR hash of the arguments, would have to be stored next to
+    /// each ID to load only the candidates.
     GlobalDeclID *LazySpecializations = nullptr;
 
     /// The set of "injected" template arguments used within this
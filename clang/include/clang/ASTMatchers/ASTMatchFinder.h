@@ -133,6 +133,10 @@ public:
 
       /// Per bucket timing information.
       llvm::StringMap<llvm::TimeRecord> &Records;
+
+      /// If set, receives the number of times each bucket's matchers were
+      /// evaluated against a node.
+      llvm::StringMap<uint64_t> *Evaluations = nullptr;
     };
 
     /// Enables per-check timers.
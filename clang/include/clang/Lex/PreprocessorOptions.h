@@ -194,6 +194,14 @@ public:
   ///
   /// Enables a client to cache the directives for a file and provide them
   /// across multiple compiler invocations.
+  ///
+  /// This is the only lexer output that is shared between invocations. The
+  /// directive tokens record offsets into the file rather than SourceLocations,
+  /// so they stay valid in any SourceManager, and they are used only when the
+  /// preprocessor skips everything but directives. Full token streams are not
+  /// shared: every Token carries a SourceLocation of the SourceManager that
+  /// lexed it, and whether a header even produces the same tokens depends on
+  /// the LangOptions and the macro state at its inclusion.
   /// FIXME: Allow returning an error.
   std::function<std::optional<ArrayRef<dependency_directives_scan::Directive>>(
       FileEntryRef)>
@@ -8814,6 +8814,11 @@ public:
   /// The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// The number of class and function template definitions instantiated in
+  /// this translation unit, reported by PrintStats().
+  unsigned NumInstantiatedClasses = 0;
+  unsigned NumInstantiatedFunctionDefinitions = 0;
+
   ArrayRef<sema::FunctionScopeInfo *> getFunctionScopes() const {
     return llvm::ArrayRef(FunctionScopes.begin() + FunctionScopesStart,
                           FunctionScopes.end());
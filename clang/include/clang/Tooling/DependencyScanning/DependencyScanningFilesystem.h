@@ -220,9 +220,17 @@ public:
   CacheShard &getShardForFilename(StringRef Filename) const;
   CacheShard &getShardForUID(llvm::sys::fs::UniqueID UID) const;
 
+  /// Sets the directory of a persistent cache of scanned directives. Entries
+  /// are keyed by the file contents and the compiler version, so the cache can
+  /// be shared by any number of scanner processes and never goes stale. An
+  /// empty path disables the persistent cache.
+  void setDirectiveCacheDir(StringRef Dir) { DirectiveCacheDir = Dir.str(); }
+  StringRef getDirectiveCacheDir() const { return DirectiveCacheDir; }
+
 private:
   std::unique_ptr<CacheShard[]> CacheShards;
   unsigned NumShards;
+  std::string DirectiveCacheDir;
 };
 
 /// This class is a local cache, that caches the 'stat' and 'open' calls to the
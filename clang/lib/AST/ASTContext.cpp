@@ -1006,6 +1006,9 @@ void ASTContext::PrintStats() const {
     ExternalSource->PrintStats();
   }
 
+  llvm::errs() << "\n" << getASTAllocatedMemory()
+               << " bytes allocated for AST nodes and types, "
+               << getSideTableAllocatedMemory() << " bytes in side tables\n";
   BumpAlloc.PrintStats();
 }
 
@@ -90,6 +90,12 @@ public:
                         const CXXRecordDecl *StaticDecl,
                         const CXXMethodDecl *InitialFunction) const;
 
+  /// Returns the bytecode of \p FD, compiling it on first use. Compiled
+  /// functions are cached in the Program for the lifetime of the ASTContext.
+  ///
+  /// The bytecode is not suitable for serialization into a PCH or module: it
+  /// embeds pointers to Decls, Records, Descriptors and global blocks of this
+  /// Program, all of which would have to be remapped when the AST is loaded.
   const Function *getOrCreateFunction(const FunctionDecl *FD);
 
   /// Returns whether we should create a global variable for the
@@ -427,6 +427,8 @@ public:
   ~MatchASTVisitor() override {
     if (Options.CheckProfiling) {
       Options.CheckProfiling->Records = std::move(TimeByBucket);
+      if (Options.CheckProfiling->Evaluations)
+        *Options.CheckProfiling->Evaluations = std::move(EvaluationsByBucket);
     }
   }
 
@@ -1024,8 +1026,10 @@ private:
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     for (const auto &MP : Matchers) {
-      if (EnableCheckProfiling)
+      if (EnableCheckProfiling) {
         Timer.setBucket(&TimeByBucket[MP.second->getID()]);
+        ++EvaluationsByBucket[MP.second->getID()];
+      }
       BoundNodesTreeBuilder Builder;
       CurMatchRAII RAII(*this, MP.second, Node);
       if (MP.first.matches(Node, this, &Builder)) {
@@ -1047,19 +1051,28 @@ private:
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
+    ParentMapContext &PMC = getASTContext().getParentMapContext();
+    // Whether the node is skipped under each traversal kind. This only depends
+    // on the node, so compute it once for all matchers using the same kind.
+    std::optional<bool> IsIgnored[TK_IgnoreUnlessSpelledInSource + 1];
     for (unsigned short I : Filter) {
       auto &MP = Matchers[I];
-      if (EnableCheckProfiling)
+      if (EnableCheckProfiling) {
         Timer.setBucket(&TimeByBucket[MP.second->getID()]);
-      BoundNodesTreeBuilder Builder;
+        ++EvaluationsByBucket[MP.second->getID()];
+      }
 
-      {
-        TraversalKindScope RAII(getASTContext(), MP.first.getTraversalKind());
-        if (getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
-            DynNode)
-          continue;
+      TraversalKind TK =
+          MP.first.getTraversalKind().value_or(PMC.getTraversalKind());
+      std::optional<bool> &Ignored = IsIgnored[TK];
+      if (!Ignored) {
+        TraversalKindScope RAII(getASTContext(), TK);
+        Ignored = PMC.traverseIgnored(DynNode) != DynNode;
       }
+      if (*Ignored)
+        continue;
 
+      BoundNodesTreeBuilder Builder;
       CurMatchRAII RAII(*this, MP.second, DynNode);
       if (MP.first.matches(DynNode, this, &Builder)) {
         MatchVisitor Visitor(*this, ActiveASTContext, MP.second);
@@ -1317,6 +1330,8 @@ private:
   ///
   /// Used to get the appropriate bucket for each matcher.
   llvm::StringMap<llvm::TimeRecord> TimeByBucket;
+  // Number of matcher evaluations per bucket, if profiling is enabled.
+  llvm::StringMap<uint64_t> EvaluationsByBucket;
 
   const MatchFinder::MatchersByType *Matchers;
 
@@ -3747,7 +3747,9 @@ reformat(const FormatStyle &Style, StringRef Code,
     if (NewCode) {
       Fixes = Fixes.merge(PassFixes.first);
       Penalty += PassFixes.second;
-      if (I + 1 < E) {
+      // A pass that made no changes leaves the environment valid for the next
+      // one, so don't copy and re-map the whole file again.
+      if (I + 1 < E && !PassFixes.first.empty()) {
         CurrentCode = std::move(*NewCode);
         Env = Environment::make(
             *CurrentCode, FileName,
@@ -49,6 +49,8 @@
 
 #ifdef __SSE4_2__
 #include <nmmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
 #endif
 
 using namespace clang;
@@ -1924,6 +1926,31 @@ fastParseASCIIIdentifier(const char *CurPtr,
       continue;
     return CurPtr;
   }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  constexpr ssize_t BytesPerRegister = 16;
+
+  while (LLVM_LIKELY(BufferEnd - CurPtr >= BytesPerRegister)) {
+    uint8x16_t Cv = vld1q_u8((const uint8_t *)CurPtr);
+
+    // Setting bit 5 maps 'A'-'Z' onto 'a'-'z' and nothing else onto that range.
+    uint8x16_t Lower = vorrq_u8(Cv, vdupq_n_u8(0x20));
+    uint8x16_t IsAlpha =
+        vcleq_u8(vsubq_u8(Lower, vdupq_n_u8('a')), vdupq_n_u8('z' - 'a'));
+    uint8x16_t IsDigit =
+        vcleq_u8(vsubq_u8(Cv, vdupq_n_u8('0')), vdupq_n_u8('9' - '0'));
+    uint8x16_t IsUnderscore = vceqq_u8(Cv, vdupq_n_u8('_'));
+    uint8x16_t NotIdent =
+        vmvnq_u8(vorrq_u8(vorrq_u8(IsAlpha, IsDigit), IsUnderscore));
+
+    if (vmaxvq_u8(NotIdent) == 0) {
+      CurPtr += BytesPerRegister;
+      continue;
+    }
+    // Narrow each comparison byte to a nibble to find the first mismatch.
+    uint64_t Mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(NotIdent), 4)), 0);
+    return CurPtr + llvm::countr_zero(Mask) / 4;
+  }
 #endif
 
   unsigned char C = *CurPtr;
@@ -2907,6 +2934,25 @@ bool Lexer::SkipBlockComment(Token &Result, const char *CurPtr,
         }
         CurPtr += 16;
       }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+      uint8x16_t Slashes = vdupq_n_u8('/');
+      while (CurPtr + 16 < BufferEnd) {
+        uint8x16_t Cv = vld1q_u8((const uint8_t *)CurPtr);
+        if (LLVM_UNLIKELY(vmaxvq_u8(Cv) >= 0x80))
+          goto MultiByteUTF8;
+        // look for slashes
+        uint8x16_t Eq = vceqq_u8(Cv, Slashes);
+        if (vmaxvq_u8(Eq) != 0) {
+          // Narrow each comparison byte to a nibble and adjust the pointer to
+          // point directly after the first slash, as in the SSE2 path.
+          uint64_t Mask = vget_lane_u64(
+              vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Eq), 4)),
+              0);
+          CurPtr += llvm::countr_zero(Mask) / 4 + 1;
+          goto FoundSlash;
+        }
+        CurPtr += 16;
+      }
 #elif __ALTIVEC__
       __vector unsigned char LongUTF = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
                                         0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
@@ -574,6 +574,9 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumInstantiatedClasses << " class templates instantiated.\n";
+  llvm::errs() << NumInstantiatedFunctionDefinitions
+               << " function template definitions instantiated.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
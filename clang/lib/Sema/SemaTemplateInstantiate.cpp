@@ -3522,6 +3522,7 @@ Sema::InstantiateClass(SourceLocation PointOfInstantiation,
                                      Pattern, PatternDef, TSK, Complain))
     return true;
 
+  ++NumInstantiatedClasses;
   llvm::TimeTraceScope TimeScope("InstantiateClass", [&]() {
     std::string Name;
     llvm::raw_string_ostream OS(Name);
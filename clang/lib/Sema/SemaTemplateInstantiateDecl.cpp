@@ -5024,6 +5024,7 @@ void Sema::InstantiateFunctionDefinition(SourceLocation PointOfInstantiation,
     return;
   }
 
+  ++NumInstantiatedFunctionDefinitions;
   llvm::TimeTraceScope TimeScope("InstantiateFunction", [&]() {
     std::string Name;
     llvm::raw_string_ostream OS(Name);
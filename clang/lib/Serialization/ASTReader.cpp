@@ -2867,6 +2867,7 @@ ASTReader::ReadControlBlock(ModuleFile &F,
             F.Kind == MK_ImplicitModule)
           N = NumUserInputs;
 
+        llvm::TimeTraceScope Scope("Validate input files", F.FileName);
         for (unsigned I = 0; I < N; ++I) {
           InputFile IF = getInputFile(F, I+1, Complain);
           if (!IF.getFile() || IF.isOutOfDate())
@@ -4747,6 +4748,9 @@ ASTReader::ReadASTCore(StringRef FileName,
 
   assert(M && "Missing module file");
 
+  // Covers this module file and, nested in it, the ones it imports.
+  llvm::TimeTraceScope Scope("Load AST file", FileName);
+
   bool ShouldFinalizePCM = false;
   auto FinalizeOrDropPCM = llvm::make_scope_exit([&]() {
     auto &MC = getModuleManager().getModuleCache();
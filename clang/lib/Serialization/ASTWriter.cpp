@@ -90,6 +90,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Bitstream/BitCodes.h"
 #include "llvm/Bitstream/BitstreamWriter.h"
+#include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/DJB.h"
@@ -101,7 +102,6 @@
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/OnDiskHashTable.h"
 #include "llvm/Support/Path.h"
-#include "llvm/Support/SHA1.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/VersionTuple.h"
 #include "llvm/Support/raw_ostream.h"
@@ -1157,9 +1157,9 @@ std::pair<ASTFileSignature, ASTFileSignature>
 ASTWriter::createSignature() const {
   StringRef AllBytes(Buffer.data(), Buffer.size());
 
-  llvm::SHA1 Hasher;
+  llvm::BLAKE3 Hasher;
   Hasher.update(AllBytes.slice(ASTBlockRange.first, ASTBlockRange.second));
-  ASTFileSignature ASTBlockHash = ASTFileSignature::create(Hasher.result());
+  ASTFileSignature ASTBlockHash = ASTFileSignature::create(Hasher.result<20>());
 
   // Add the remaining bytes:
   //  1. Before the unhashed control block.
@@ -1169,13 +1169,13 @@ ASTWriter::createSignature() const {
       AllBytes.slice(UnhashedControlBlockRange.second, ASTBlockRange.first));
   //  3. After the AST block.
   Hasher.update(AllBytes.slice(ASTBlockRange.second, StringRef::npos));
-  ASTFileSignature Signature = ASTFileSignature::create(Hasher.result());
+  ASTFileSignature Signature = ASTFileSignature::create(Hasher.result<20>());
 
   return std::make_pair(ASTBlockHash, Signature);
 }
 
 ASTFileSignature ASTWriter::createSignatureForNamedModule() const {
-  llvm::SHA1 Hasher;
+  llvm::BLAKE3 Hasher;
   Hasher.update(StringRef(Buffer.data(), Buffer.size()));
 
   assert(WritingModule);
@@ -1186,7 +1186,7 @@ ASTFileSignature ASTWriter::createSignatureForNamedModule() const {
   for (auto [ExportImported, _] : WritingModule->Exports)
     Hasher.update(ExportImported->Signature);
 
-  return ASTFileSignature::create(Hasher.result());
+  return ASTFileSignature::create(Hasher.result<20>());
 }
 
 static void BackpatchSignatureAt(llvm::BitstreamWriter &Stream,
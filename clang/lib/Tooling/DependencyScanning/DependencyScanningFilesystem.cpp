@@ -7,6 +7,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "clang/Tooling/DependencyScanning/DependencyScanningFilesystem.h"
+#include "clang/Basic/Version.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/Threading.h"
@@ -41,6 +46,126 @@ DependencyScanningWorkerFilesystem::readFile(StringRef Filename) {
   return TentativeEntry(Stat, std::move(Buffer));
 }
 
+/// The magic number at the start of an entry of the persistent directive cache.
+static constexpr char DirectiveCacheMagic[4] = {'C', 'D', 'D', '1'};
+
+/// Returns the path of the persistent directive cache entry for \p Contents.
+static std::string getDirectiveCachePath(StringRef CacheDir,
+                                         StringRef Contents) {
+  // The scanner output may change between compiler versions, so the version
+  // is part of the key.
+  llvm::BLAKE3 Hasher;
+  Hasher.update(getClangFullRepositoryVersion());
+  Hasher.update(StringRef(DirectiveCacheMagic, sizeof(DirectiveCacheMagic)));
+  Hasher.update(Contents);
+  SmallString<256> Path(CacheDir);
+  llvm::sys::path::append(Path,
+                          "directives-" + llvm::toHex(Hasher.final<16>(),
+                                                      /*LowerCase=*/true));
+  return std::string(Path);
+}
+
+/// Reads the persistent directive cache entry at \p Path for a file with
+/// \p Contents. Returns false if there is no valid entry.
+static bool loadCachedDirectives(
+    StringRef Path, StringRef Contents,
+    SmallVectorImpl<dependency_directives_scan::Token> &Tokens,
+    SmallVectorImpl<dependency_directives_scan::Directive> &Directives) {
+  auto MaybeBuffer =
+      llvm::MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                  /*RequiresNullTerminator=*/false);
+  if (!MaybeBuffer)
+    return false;
+  StringRef Data = (*MaybeBuffer)->getBuffer();
+  if (!Data.consume_front(
+          StringRef(DirectiveCacheMagic, sizeof(DirectiveCacheMagic))))
+    return false;
+
+  auto Read = [&Data](uint32_t &Value) {
+    if (Data.size() < sizeof(uint32_t))
+      return false;
+    Value = llvm::support::endian::read32le(Data.data());
+    Data = Data.drop_front(sizeof(uint32_t));
+    return true;
+  };
+
+  uint32_t NumTokens, NumDirectives;
+  if (!Read(NumTokens) || !Read(NumDirectives) ||
+      Data.size() != (uint64_t(NumTokens) * 4 + uint64_t(NumDirectives) * 3) *
+                          sizeof(uint32_t))
+    return false;
+
+  // The entry is keyed by the contents, but check that it is consistent with
+  // them rather than trusting whatever is on disk.
+  Tokens.reserve(NumTokens);
+  for (uint32_t I = 0; I != NumTokens; ++I) {
+    uint32_t Offset, Length, Kind, Flags;
+    Read(Offset);
+    Read(Length);
+    Read(Kind);
+    Read(Flags);
+    if (uint64_t(Offset) + Length > Contents.size() || Kind >= tok::NUM_TOKENS)
+      return false;
+    Tokens.emplace_back(Offset, Length, static_cast<tok::TokenKind>(Kind),
+                        static_cast<unsigned short>(Flags));
+  }
+  for (uint32_t I = 0; I != NumDirectives; ++I) {
+    uint32_t Kind, First, Count;
+    Read(Kind);
+    Read(First);
+    Read(Count);
+    if (Kind > dependency_directives_scan::pp_eof ||
+        uint64_t(First) + Count > Tokens.size())
+      return false;
+    Directives.emplace_back(
+        static_cast<dependency_directives_scan::DirectiveKind>(Kind),
+        ArrayRef(Tokens).slice(First, Count));
+  }
+  return true;
+}
+
+/// Writes the persistent directive cache entry at \p Path. Failures are
+/// ignored; the entry is simply recomputed by the next scan.
+static void storeCachedDirectives(
+    StringRef Path, ArrayRef<dependency_directives_scan::Token> Tokens,
+    ArrayRef<dependency_directives_scan::Directive> Directives) {
+  SmallString<0> Data;
+  llvm::raw_svector_ostream OS(Data);
+  llvm::support::endian::Writer W(OS, llvm::endianness::little);
+  OS.write(DirectiveCacheMagic, sizeof(DirectiveCacheMagic));
+  W.write<uint32_t>(Tokens.size());
+  W.write<uint32_t>(Directives.size());
+  for (const dependency_directives_scan::Token &T : Tokens) {
+    W.write<uint32_t>(T.Offset);
+    W.write<uint32_t>(T.Length);
+    W.write<uint32_t>(T.Kind);
+    W.write<uint32_t>(T.Flags);
+  }
+  for (const dependency_directives_scan::Directive &D : Directives) {
+    W.write<uint32_t>(D.Kind);
+    W.write<uint32_t>(D.Tokens.empty() ? 0 : D.Tokens.data() - Tokens.data());
+    W.write<uint32_t>(D.Tokens.size());
+  }
+
+  // Write to a temporary file and rename it into place, so that concurrent
+  // scanners never observe a partially written entry.
+  auto Temp = llvm::sys::fs::TempFile::create(Path + ".tmp-%%%%%%");
+  if (!Temp) {
+    llvm::consumeError(Temp.takeError());
+    return;
+  }
+  llvm::raw_fd_ostream TempOS(Temp->FD, /*shouldClose=*/false);
+  TempOS << Data;
+  TempOS.flush();
+  if (TempOS.has_error()) {
+    TempOS.clear_error();
+    llvm::consumeError(Temp->discard());
+    return;
+  }
+  if (llvm::Error E = Temp->keep(Path))
+    llvm::consumeError(std::move(E));
+}
+
 bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     EntryRef Ref) {
   auto &Entry = Ref.Entry;
@@ -62,10 +187,26 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return true;
 
   SmallVector<dependency_directives_scan::Directive, 64> Directives;
+  StringRef Buffer = Contents->Original->getBuffer();
+
+  // Reuse the directives of an earlier scanner process if there are some.
+  std::string CachePath;
+  if (!SharedCache.getDirectiveCacheDir().empty()) {
+    CachePath =
+        getDirectiveCachePath(SharedCache.getDirectiveCacheDir(), Buffer);
+    if (loadCachedDirectives(CachePath, Buffer, Contents->DepDirectiveTokens,
+                             Directives)) {
+      Contents->DepDirectives.store(
+          new std::optional<DependencyDirectivesTy>(std::move(Directives)));
+      return true;
+    }
+    Contents->DepDirectiveTokens.clear();
+    Directives.clear();
+  }
+
   // Scan the file for preprocessor directives that might affect the
   // dependencies.
-  if (scanSourceForDependencyDirectives(Contents->Original->getBuffer(),
-                                        Contents->DepDirectiveTokens,
+  if (scanSourceForDependencyDirectives(Buffer, Contents->DepDirectiveTokens,
                                         Directives)) {
     Contents->DepDirectiveTokens.clear();
     // FIXME: Propagate the diagnostic if desired by the client.
@@ -73,6 +214,9 @@ bool DependencyScanningWorkerFilesystem::ensureDirectiveTokensArePopulated(
     return false;
   }
 
+  if (!CachePath.empty())
+    storeCachedDirectives(CachePath, Contents->DepDirectiveTokens, Directives);
+
   // This function performed double-checked locking using `DepDirectives`.
   // Assigning it must be the last thing this function does, otherwise other
   // threads may skip the critical section (`DepDirectives != nullptr`), leading
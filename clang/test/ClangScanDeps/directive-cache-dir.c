@@ -0,0 +1,41 @@
+// Test that -directive-cache-dir persists the scanned directives of each file
+// and that a later scan reusing them reports the same dependencies.
+
+// RUN: rm -rf %t && split-file %s %t
+
+// RUN: clang-scan-deps -format make -- %clang -c %t/tu.c -o %t/tu.o \
+// RUN:   > %t/uncached.d
+// RUN: FileCheck %s --input-file=%t/uncached.d -DPREFIX=%/t
+
+// CHECK: tu.o:
+// CHECK: [[PREFIX]]/tu.c
+// CHECK: [[PREFIX]]/a.h
+// CHECK: [[PREFIX]]/b.h
+
+// The first scan populates the cache, the second one is served from it.
+// RUN: clang-scan-deps -format make -directive-cache-dir %t/cache \
+// RUN:   -- %clang -c %t/tu.c -o %t/tu.o > %t/cold.d
+// RUN: ls %t/cache | FileCheck %s --check-prefix=ENTRIES
+// RUN: clang-scan-deps -format make -directive-cache-dir %t/cache \
+// RUN:   -- %clang -c %t/tu.c -o %t/tu.o > %t/warm.d
+// RUN: diff %t/uncached.d %t/cold.d
+// RUN: diff %t/uncached.d %t/warm.d
+
+// ENTRIES: directives-{{[0-9a-f]+$}}
+// ENTRIES-NOT: .tmp-
+
+// RUN: not clang-scan-deps -format make -directive-cache-dir %t/tu.c/cache \
+// RUN:   -- %clang -c %t/tu.c -o %t/tu.o 2>&1 \
+// RUN:   | FileCheck %s --check-prefix=ERROR -DPREFIX=%/t
+// ERROR: Failed to create directive cache directory '[[PREFIX]]/tu.c/cache':
+
+//--- tu.c
+#include "a.h"
+
+//--- a.h
+#ifndef A_H
+#define A_H
+#include "b.h"
+#endif
+
+//--- b.h
@@ -0,0 +1,30 @@
+// RUN: rm -rf %t && mkdir -p %t && cd %t
+// RUN: %clangxx -S -no-canonical-prefixes -ftime-trace -ftime-trace-granularity=0 -ftime-trace-memory -o out %s
+// RUN: cat out.json \
+// RUN:   | %python -c 'import json, sys; json.dump(json.loads(sys.stdin.read()), sys.stdout, sort_keys=True, indent=2)' \
+// RUN:   | FileCheck %s
+
+// CHECK:      "traceEvents": [
+// CHECK:      "malloc delta bytes": {{-?[0-9]+}}
+// CHECK:      "malloc bytes": {{[0-9]+}}
+// CHECK-NEXT: },
+// CHECK-NEXT: "name": "Memory",
+// CHECK-NEXT: "ph": "C",
+
+/// The flag is only forwarded together with -ftime-trace.
+// RUN: %clang -### -c -ftime-trace -ftime-trace-memory %s 2>&1 | FileCheck %s --check-prefix=FORWARD
+// FORWARD: -cc1{{.*}} "-ftime-trace-memory"
+
+// RUN: %clang -### -c -ftime-trace-memory %s 2>&1 | FileCheck %s --check-prefix=UNUSED
+// UNUSED:     warning: argument unused during compilation: '-ftime-trace-memory'
+// UNUSED-NOT: "-ftime-trace-memory"
+
+template <typename T>
+struct Struct {
+  T Num;
+};
+
+int main() {
+  Struct<int> S{1};
+  return S.Num;
+}
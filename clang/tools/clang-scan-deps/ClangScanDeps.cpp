@@ -18,6 +18,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/JSON.h"
@@ -77,6 +78,7 @@ static ScanningMode ScanMode = ScanningMode::DependencyDirectivesScan;
 static ScanningOutputFormat Format = ScanningOutputFormat::Make;
 static ScanningOptimizations OptimizeArgs;
 static std::string ModuleFilesDir;
+static std::string DirectiveCacheDir;
 static bool EagerLoadModules;
 static unsigned NumThreads = 0;
 static std::string CompilationDB;
@@ -176,6 +178,9 @@ static void ParseArgs(int argc, char **argv) {
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_module_files_dir_EQ))
     ModuleFilesDir = A->getValue();
 
+  if (const llvm::opt::Arg *A = Args.getLastArg(OPT_directive_cache_dir_EQ))
+    DirectiveCacheDir = A->getValue();
+
   if (const llvm::opt::Arg *A = Args.getLastArg(OPT_o))
     OutputFileName = A->getValue();
 
@@ -985,6 +990,15 @@ int clang_scan_deps_main(int argc, char **argv, const llvm::ToolContext &) {
 
   DependencyScanningService Service(ScanMode, Format, OptimizeArgs,
                                     EagerLoadModules);
+  if (!DirectiveCacheDir.empty()) {
+    if (std::error_code EC =
+            llvm::sys::fs::create_directories(DirectiveCacheDir)) {
+      llvm::errs() << "Failed to create directive cache directory '"
+                   << DirectiveCacheDir << "': " << EC.message() << '\n';
+      return 1;
+    }
+    Service.getSharedCache().setDirectiveCacheDir(DirectiveCacheDir);
+  }
 
   llvm::Timer T;
   T.startTimer();
@@ -350,6 +350,12 @@ int clang_main(int Argc, char **Argv, const llvm::ToolContext &ToolContext) {
   if (!SetBackdoorDriverOutputsFromEnvVars(TheDriver))
     return 1;
 
+  // Running -cc1 in-process saves the process startup for each job of this
+  // driver invocation. Nothing is kept warm across driver invocations: the
+  // FileManager, HeaderSearch and target state of a CompilerInstance are owned
+  // by that instance, and global state such as cl::opt values is reset after
+  // each job (see ExecuteCC1Tool), so that every compilation observes the same
+  // state as a cold one.
   if (!UseNewCC1Process) {
     TheDriver.CC1Main = [ToolContext](SmallVectorImpl<const char *> &ArgV) {
       return ExecuteCC1Tool(ArgV, ToolContext);
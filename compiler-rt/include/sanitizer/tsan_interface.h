@@ -180,6 +180,10 @@ int SANITIZER_CDECL __tsan_on_finalize(int failed);
 // Release TSan internal memory in a best-effort manner.
 void SANITIZER_CDECL __tsan_flush_memory();
 
+// Check only the memory accesses to about 1 in `rate` application pages, or
+// all of them if `rate` is 1. Overrides the access_sampling_rate flag.
+void SANITIZER_CDECL __tsan_set_access_sampling_rate(int rate);
+
 // User-provided default TSAN options.
 const char *SANITIZER_CDECL __tsan_default_options(void);
 
@@ -136,7 +136,55 @@ static __inline Lock *lock_for_pointer(void *ptr) {
 #define IS_LOCK_FREE_2(p) ATOMIC_ALWAYS_LOCK_FREE_OR_ALIGNED_LOCK_FREE(2, p)
 #define IS_LOCK_FREE_4(p) ATOMIC_ALWAYS_LOCK_FREE_OR_ALIGNED_LOCK_FREE(4, p)
 #define IS_LOCK_FREE_8(p) ATOMIC_ALWAYS_LOCK_FREE_OR_ALIGNED_LOCK_FREE(8, p)
+
+// On x86-64, 16-byte atomics are only lock-free at compile time with -mcx16,
+// since the first CPUs lacked CMPXCHG16B. Without it, we check for the
+// instruction at run time and use it rather than the lock table, which makes
+// aligned 16-byte atomics lock-free on all current hardware.
+#if defined(__x86_64__) && defined(__SIZEOF_INT128__) &&                       \
+    !defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+#define ATOMIC_DISPATCH_CMPXCHG16B 1
+
+static bool has_cmpxchg16b(void) {
+  // 0 means unknown, 1 means unsupported and 2 means supported.
+  static _Atomic(int) state;
+  int s = __c11_atomic_load(&state, __ATOMIC_RELAXED);
+  if (s == 0) {
+    unsigned eax = 1, ebx, ecx = 0, edx;
+    __asm__("cpuid" : "+a"(eax), "=b"(ebx), "+c"(ecx), "=d"(edx));
+    s = (ecx & (1u << 13)) ? 2 : 1;
+    __c11_atomic_store(&state, s, __ATOMIC_RELAXED);
+  }
+  return s == 2;
+}
+
+/// Compares *ptr with *expected and stores desired on a match. Otherwise,
+/// stores the current value in *expected. This is a full barrier.
+__inline static bool cmpxchg16b(__uint128_t *ptr, __uint128_t *expected,
+                                __uint128_t desired) {
+  uint64_t lo = (uint64_t)*expected, hi = (uint64_t)(*expected >> 64);
+  bool ok;
+  __asm__ __volatile__("lock cmpxchg16b %1"
+                       : "=@ccz"(ok), "+m"(*ptr), "+a"(lo), "+d"(hi)
+                       : "b"((uint64_t)desired), "c"((uint64_t)(desired >> 64))
+                       : "memory");
+  *expected = ((__uint128_t)hi << 64) | lo;
+  return ok;
+}
+
+/// Returns a starting guess for a compare-and-swap loop. It may be torn, in
+/// which case the first cmpxchg16b fails and returns the actual value.
+__inline static __uint128_t load16_guess(__uint128_t *ptr) {
+  uint64_t lo = __c11_atomic_load((_Atomic(uint64_t) *)ptr, __ATOMIC_RELAXED);
+  uint64_t hi =
+      __c11_atomic_load((_Atomic(uint64_t) *)ptr + 1, __ATOMIC_RELAXED);
+  return ((__uint128_t)hi << 64) | lo;
+}
+
+#define IS_LOCK_FREE_16(p) (((uintptr_t)p % 16) == 0 && has_cmpxchg16b())
+#else
 #define IS_LOCK_FREE_16(p) ATOMIC_ALWAYS_LOCK_FREE_OR_ALIGNED_LOCK_FREE(16, p)
+#endif
 
 /// Macro that calls the compiler-generated lock-free versions of functions
 /// when they exist.
@@ -246,7 +294,7 @@ void __atomic_exchange_c(int size, void *ptr, void *val, void *old, int model) {
 // Where the size is known at compile time, the compiler may emit calls to
 // specialised versions of the above functions.
 ////////////////////////////////////////////////////////////////////////////////
-#ifdef __SIZEOF_INT128__
+#if defined(__SIZEOF_INT128__) && !defined(ATOMIC_DISPATCH_CMPXCHG16B)
 #define OPTIMISED_CASES                                                        \
   OPTIMISED_CASE(1, IS_LOCK_FREE_1, uint8_t)                                   \
   OPTIMISED_CASE(2, IS_LOCK_FREE_2, uint16_t)                                  \
@@ -371,3 +419,86 @@ OPTIMISED_CASES
 OPTIMISED_CASES
 #undef OPTIMISED_CASE
 #endif
+
+#ifdef ATOMIC_DISPATCH_CMPXCHG16B
+////////////////////////////////////////////////////////////////////////////////
+// The 16-byte variants, which use cmpxchg16b when it is available. The C11
+// builtins would call back into these functions, so they can't be used here.
+////////////////////////////////////////////////////////////////////////////////
+__uint128_t __atomic_load_16(__uint128_t *src, int model) {
+  if (IS_LOCK_FREE_16(src)) {
+    // This writes the value back if it happens to be zero, which is harmless.
+    __uint128_t val = 0;
+    cmpxchg16b(src, &val, 0);
+    return val;
+  }
+  Lock *l = lock_for_pointer(src);
+  lock(l);
+  __uint128_t val = *src;
+  unlock(l);
+  return val;
+}
+
+__uint128_t __atomic_exchange_16(__uint128_t *dest, __uint128_t val,
+                                 int model) {
+  if (IS_LOCK_FREE_16(dest)) {
+    __uint128_t old = load16_guess(dest);
+    while (!cmpxchg16b(dest, &old, val))
+      ;
+    return old;
+  }
+  Lock *l = lock_for_pointer(dest);
+  lock(l);
+  __uint128_t tmp = *dest;
+  *dest = val;
+  unlock(l);
+  return tmp;
+}
+
+void __atomic_store_16(__uint128_t *dest, __uint128_t val, int model) {
+  __atomic_exchange_16(dest, val, model);
+}
+
+bool __atomic_compare_exchange_16(__uint128_t *ptr, __uint128_t *expected,
+                                  __uint128_t desired, int success,
+                                  int failure) {
+  if (IS_LOCK_FREE_16(ptr))
+    return cmpxchg16b(ptr, expected, desired);
+  Lock *l = lock_for_pointer(ptr);
+  lock(l);
+  if (*ptr == *expected) {
+    *ptr = desired;
+    unlock(l);
+    return true;
+  }
+  *expected = *ptr;
+  unlock(l);
+  return false;
+}
+
+#define ATOMIC_RMW_16(opname, new_value)                                       \
+  __uint128_t __atomic_fetch_##opname##_16(__uint128_t *ptr, __uint128_t val,  \
+                                           int model) {                        \
+    __uint128_t tmp;                                                           \
+    if (IS_LOCK_FREE_16(ptr)) {                                                \
+      tmp = load16_guess(ptr);                                                 \
+      while (!cmpxchg16b(ptr, &tmp, new_value))                                \
+        ;                                                                      \
+      return tmp;                                                              \
+    }                                                                          \
+    Lock *l = lock_for_pointer(ptr);                                           \
+    lock(l);                                                                   \
+    tmp = *ptr;                                                                \
+    *ptr = new_value;                                                          \
+    unlock(l);                                                                 \
+    return tmp;                                                                \
+  }
+
+ATOMIC_RMW_16(add, tmp + val)
+ATOMIC_RMW_16(sub, tmp - val)
+ATOMIC_RMW_16(and, tmp & val)
+ATOMIC_RMW_16(or, tmp | val)
+ATOMIC_RMW_16(xor, tmp ^ val)
+ATOMIC_RMW_16(nand, ~(tmp & val))
+#undef ATOMIC_RMW_16
+#endif
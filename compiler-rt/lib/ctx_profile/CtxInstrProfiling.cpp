@@ -21,11 +21,18 @@ using namespace __ctx_profile;
 // FIXME(mtrofin): use malloc / mmap instead of sanitizer common APIs to reduce
 // the dependency on the latter.
 Arena *Arena::allocateNewArena(size_t Size, Arena *Prev) {
-  assert(!Prev || Prev->Next == nullptr);
   Arena *NewArena =
       new (__sanitizer::InternalAlloc(Size + sizeof(Arena))) Arena(Size);
-  if (Prev)
-    Prev->Next = NewArena;
+  // Several threads may run out of space in Prev at the same time. Rather than
+  // dropping the arenas that lose the race, chain them after the winner.
+  for (auto *Tail = Prev; Tail;) {
+    __sanitizer::uptr Expected = 0;
+    if (__sanitizer::atomic_compare_exchange_strong(
+            &Tail->Next, &Expected, reinterpret_cast<__sanitizer::uptr>(NewArena),
+            __sanitizer::memory_order_acq_rel))
+      break;
+    Tail = reinterpret_cast<Arena *>(Expected);
+  }
   return NewArena;
 }
 
@@ -33,7 +40,7 @@ void Arena::freeArenaList(Arena *&A) {
   assert(A);
   for (auto *I = A; I != nullptr;) {
     auto *Current = I;
-    I = I->Next;
+    I = I->next();
     __sanitizer::InternalFree(Current);
   }
   A = nullptr;
@@ -9,18 +9,20 @@
 #ifndef CTX_PROFILE_CTXINSTRPROFILING_H_
 #define CTX_PROFILE_CTXINSTRPROFILING_H_
 
+#include "sanitizer_common/sanitizer_atomic.h"
 #include <sanitizer/common_interface_defs.h>
 
 namespace __ctx_profile {
 
-/// Arena (bump allocator) forming a linked list. Intentionally not thread safe.
-/// Allocation and de-allocation happen using sanitizer APIs. We make that
-/// explicit.
+/// Arena (bump allocator) forming a linked list. Allocation from an arena, and
+/// appending to the list, are lock-free, so that threads sharing a context root
+/// don't serialize on it. Freeing the list is not thread safe. Allocation and
+/// de-allocation happen using sanitizer APIs. We make that explicit.
 class Arena final {
 public:
   // When allocating a new Arena, optionally specify an existing one to append
-  // to, assumed to be the last in the Arena list. We only need to support
-  // appending to the arena list.
+  // to. If another thread appended to |Prev| concurrently, the new arena goes
+  // after the one it added.
   static Arena *allocateNewArena(size_t Size, Arena *Prev = nullptr);
   static void freeArenaList(Arena *&A);
 
@@ -28,17 +30,26 @@ public:
 
   // Allocate S bytes or return nullptr if we don't have that many available.
   char *tryBumpAllocate(size_t S) {
-    if (Pos + S > Size)
-      return nullptr;
-    Pos += S;
-    return start() + (Pos - S);
+    __sanitizer::atomic_uint64_t::Type Old =
+        __sanitizer::atomic_load_relaxed(&Pos);
+    do {
+      if (Old + S > Size)
+        return nullptr;
+    } while (!__sanitizer::atomic_compare_exchange_weak(
+        &Pos, &Old, Old + S, __sanitizer::memory_order_relaxed));
+    return start() + Old;
   }
 
-  Arena *next() const { return Next; }
+  Arena *next() const {
+    return reinterpret_cast<Arena *>(
+        __sanitizer::atomic_load(&Next, __sanitizer::memory_order_acquire));
+  }
 
   // the beginning of allocatable memory.
   const char *start() const { return const_cast<Arena *>(this)->start(); }
-  const char *pos() const { return start() + Pos; }
+  const char *pos() const {
+    return start() + __sanitizer::atomic_load_relaxed(&Pos);
+  }
 
 private:
   explicit Arena(uint32_t Size) : Size(Size) {}
@@ -46,8 +57,8 @@ private:
 
   char *start() { return reinterpret_cast<char *>(&this[1]); }
 
-  Arena *Next = nullptr;
-  uint64_t Pos = 0;
+  __sanitizer::atomic_uintptr_t Next = {0};
+  __sanitizer::atomic_uint64_t Pos = {0};
   const uint64_t Size;
 };
 
@@ -0,0 +1,65 @@
+#include "../CtxInstrProfiling.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <vector>
+
+using namespace __ctx_profile;
+
+TEST(ArenaTest, Basic) {
+  Arena *A = Arena::allocateNewArena(1024);
+  EXPECT_EQ(A->size(), 1024U);
+  EXPECT_EQ(A->next(), nullptr);
+
+  auto *M1 = A->tryBumpAllocate(1020);
+  EXPECT_NE(M1, nullptr);
+  auto *M2 = A->tryBumpAllocate(4);
+  EXPECT_NE(M2, nullptr);
+  EXPECT_EQ(M1 + 1020, M2);
+  EXPECT_EQ(A->tryBumpAllocate(1), nullptr);
+  Arena *A2 = Arena::allocateNewArena(2024, A);
+  EXPECT_EQ(A->next(), A2);
+  EXPECT_EQ(A2->next(), nullptr);
+  Arena::freeArenaList(A);
+  EXPECT_EQ(A, nullptr);
+}
+
+TEST(ArenaTest, ConcurrentBumpAllocate) {
+  constexpr size_t NumThreads = 8;
+  constexpr size_t PerThread = 1000;
+  Arena *A = Arena::allocateNewArena(NumThreads * PerThread * sizeof(size_t));
+  std::vector<std::thread> Threads;
+  for (size_t I = 0; I < NumThreads; ++I)
+    Threads.emplace_back([A, I]() {
+      for (size_t J = 0; J < PerThread; ++J)
+        *reinterpret_cast<size_t *>(A->tryBumpAllocate(sizeof(size_t))) = I;
+    });
+  for (auto &T : Threads)
+    T.join();
+  // Every allocation succeeded, none overlapped, and the arena is now full.
+  const Arena *CA = A;
+  EXPECT_EQ(CA->pos(), CA->start() + CA->size());
+  EXPECT_EQ(A->tryBumpAllocate(1), nullptr);
+  std::vector<size_t> Counts(NumThreads);
+  for (auto *P = reinterpret_cast<const size_t *>(CA->start());
+       P != reinterpret_cast<const size_t *>(CA->pos()); ++P)
+    ++Counts[*P];
+  for (auto C : Counts)
+    EXPECT_EQ(C, PerThread);
+  Arena::freeArenaList(A);
+}
+
+TEST(ArenaTest, ConcurrentAppend) {
+  constexpr size_t NumThreads = 8;
+  Arena *A = Arena::allocateNewArena(16);
+  std::vector<std::thread> Threads;
+  for (size_t I = 0; I < NumThreads; ++I)
+    Threads.emplace_back([A]() { Arena::allocateNewArena(16, A); });
+  for (auto &T : Threads)
+    T.join();
+  // No appended arena is lost.
+  size_t Count = 0;
+  for (auto *I = A; I; I = I->next())
+    ++Count;
+  EXPECT_EQ(Count, NumThreads + 1);
+  Arena::freeArenaList(A);
+}
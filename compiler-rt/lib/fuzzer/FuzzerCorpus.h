@@ -155,6 +155,8 @@ struct EntropicOptions {
 
 class InputCorpus {
   static const uint32_t kFeatureSetSize = 1 << 21;
+  static_assert(kFeatureSetSize == SharedFeatureBitMap::kMapSizeInBits,
+                "The shared feature bit map must cover the feature space");
   static const uint8_t kMaxMutationFactor = 20;
   static const size_t kSparseEnergyUpdates = 100;
 
@@ -703,7 +703,9 @@ int FuzzerDriver(int *argc, char ***argv, UserCallback Callback) {
   Options.PreferSmall = Flags.prefer_small;
   Options.ReloadIntervalSec = Flags.reload;
   Options.OnlyASCII = Flags.only_ascii;
-  Options.DetectLeaks = Flags.detect_leaks;
+  Options.ForkServer = Flags.fork_server;
+  // The allocations of a unit are not visible once its process is gone.
+  Options.DetectLeaks = Flags.detect_leaks && !Flags.fork_server;
   Options.PurgeAllocatorIntervalSec = Flags.purge_allocator_interval;
   Options.TraceMalloc = Flags.trace_malloc;
   Options.RssLimitMb = Flags.rss_limit_mb;
@@ -766,6 +768,8 @@ int FuzzerDriver(int *argc, char ***argv, UserCallback Callback) {
     Options.FeaturesDir = Flags.features_dir;
     ValidateDirectoryExists(Options.FeaturesDir, Flags.create_missing_dirs);
   }
+  if (Flags.shared_features)
+    Options.SharedFeaturesFile = Flags.shared_features;
   if (Flags.mutation_graph_file)
     Options.MutationGraphFile = Flags.mutation_graph_file;
   if (Flags.collect_data_flow)
@@ -873,6 +877,7 @@ int FuzzerDriver(int *argc, char ***argv, UserCallback Callback) {
   }
 
   Options.ForkCorpusGroups = Flags.fork_corpus_groups;
+  Options.ForkSharedFeatures = Flags.fork_shared_features;
   if (Flags.fork)
     FuzzWithFork(F->GetMD().GetRand(), Options, Args, *Inputs, Flags.fork);
 
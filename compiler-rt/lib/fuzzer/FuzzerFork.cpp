@@ -92,6 +92,8 @@ struct GlobalEnv {
   std::string TempDir;
   std::string DFTDir;
   std::string DataFlowBinary;
+  std::string SharedFeaturesFile;
+  SharedFeatureBitMap SharedFeatures;
   std::set<uint32_t> Features, Cov;
   std::set<std::string> FilesWithDFT;
   std::vector<std::string> Files;
@@ -129,6 +131,8 @@ struct GlobalEnv {
     Cmd.addFlag("print_funcs", "0");  // no need to spend time symbolizing.
     Cmd.addFlag("max_total_time", std::to_string(std::min((size_t)300, JobId)));
     Cmd.addFlag("stop_file", StopFile());
+    if (!SharedFeaturesFile.empty())
+      Cmd.addFlag("shared_features", SharedFeaturesFile);
     if (!DataFlowBinary.empty()) {
       Cmd.addFlag("data_flow_trace", DFTDir);
       if (!Cmd.hasFlag("focus_function"))
@@ -252,6 +256,7 @@ struct GlobalEnv {
     }
     Features.insert(NewFeatures.begin(), NewFeatures.end());
     Cov.insert(NewCov.begin(), NewCov.end());
+    PublishFeatures(NewFeatures);
     for (auto Idx : NewCov)
       if (auto *TE = TPC.PCTableEntryByIdx(Idx))
         if (TPC.PcIsFuncEntry(TE))
@@ -259,6 +264,13 @@ struct GlobalEnv {
                   TPC.GetNextInstructionPc(TE->PC));
   }
 
+  void PublishFeatures(const std::set<uint32_t> &NewFeatures) {
+    if (!SharedFeatures.IsAttached())
+      return;
+    for (auto Ft : NewFeatures)
+      SharedFeatures.AddFeature(Ft);
+  }
+
   void CollectDFT(const std::string &InputPath) {
     if (DataFlowBinary.empty()) return;
     if (!FilesWithDFT.insert(InputPath).second) return;
@@ -358,6 +370,19 @@ void FuzzWithFork(Random &Rand, const FuzzingOptions &Options,
       Env.FilesSizes.push_back(FileSize(path));
   }
 
+  if (Options.ForkSharedFeatures) {
+    Env.SharedFeaturesFile = DirPlusFile(Env.TempDir, "features.bitmap");
+    if (void *Map = MapSharedFile(Env.SharedFeaturesFile,
+                                  SharedFeatureBitMap::kMapSizeInBytes)) {
+      Env.SharedFeatures.Attach(Map);
+      Env.PublishFeatures(Env.Features);
+    } else {
+      Printf("WARNING: -fork_shared_features is not supported on this "
+             "platform\n");
+      Env.SharedFeaturesFile.clear();
+    }
+  }
+
   Printf("INFO: -fork=%d: %zd seed inputs, starting to fuzz in %s\n", NumJobs,
          Env.Files.size(), Env.TempDir.c_str());
 
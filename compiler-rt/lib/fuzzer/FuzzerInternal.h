@@ -68,6 +68,8 @@ public:
   // Returns false if the input was rejected by the target (target returned -1),
   // and true otherwise.
   bool ExecuteCallback(const uint8_t *Data, size_t Size);
+  int ExecuteCallbackInChild(uint8_t *DataCopy, const uint8_t *Data,
+                             size_t Size);
   bool RunOne(const uint8_t *Data, size_t Size, bool MayDeleteFile = false,
               InputInfo *II = nullptr, bool ForceAddToCorpus = false,
               bool *FoundUniqFeatures = nullptr);
@@ -147,6 +149,14 @@ private:
 
   std::vector<uint32_t> UniqFeatureSetTmp;
 
+  // See -fork_shared_features.
+  SharedFeatureBitMap SharedFeatures;
+  bool LastUnitFoundByOtherJobs = false;
+
+  // See -fork_server.
+  uint8_t *ForkServerState = nullptr;
+  size_t ForkServerStateSize = 0;
+
   // Need to know our own thread.
   static thread_local bool IsMyThread;
 };
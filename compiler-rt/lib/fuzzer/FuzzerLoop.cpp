@@ -158,6 +158,11 @@ Fuzzer::Fuzzer(UserCallback CB, InputCorpus &Corpus, MutationDispatcher &MD,
   AllocateCurrentUnitData();
   CurrentUnitSize = 0;
   memset(BaseSha1, 0, sizeof(BaseSha1));
+  if (!Options.SharedFeaturesFile.empty()) {
+    if (void *Map = MapSharedFile(Options.SharedFeaturesFile,
+                                  SharedFeatureBitMap::kMapSizeInBytes))
+      SharedFeatures.Attach(Map);
+  }
 }
 
 void Fuzzer::AllocateCurrentUnitData() {
@@ -517,6 +522,7 @@ bool Fuzzer::RunOne(const uint8_t *Data, size_t Size, bool MayDeleteFile,
   auto TimeOfUnit = duration_cast<microseconds>(UnitStopTime - UnitStartTime);
 
   UniqFeatureSetTmp.clear();
+  LastUnitFoundByOtherJobs = false;
   size_t FoundUniqFeaturesOfII = 0;
   size_t NumUpdatesBefore = Corpus.NumFeatureUpdates();
   TPC.CollectFeatures([&](uint32_t Feature) {
@@ -539,8 +545,18 @@ bool Fuzzer::RunOne(const uint8_t *Data, size_t Size, bool MayDeleteFile,
         Corpus.AddToCorpus({Data, Data + Size}, NumNewFeatures, MayDeleteFile,
                            TPC.ObservedFocusFunction(), ForceAddToCorpus,
                            TimeOfUnit, UniqFeatureSetTmp, DFT, II);
-    WriteFeatureSetToFile(Options.FeaturesDir, Sha1ToString(NewII->Sha1),
-                          NewII->UniqFeatureSet);
+    // The unit is still kept in our corpus, but there is no need to save it if
+    // the other jobs have already found all of its new features. With -shrink
+    // the new features may be known ones reached by a smaller unit.
+    if (SharedFeatures.IsAttached() && !Options.Shrink && !ForceAddToCorpus) {
+      LastUnitFoundByOtherJobs = true;
+      for (auto Feature : NewII->UniqFeatureSet)
+        if (SharedFeatures.AddFeature(Feature))
+          LastUnitFoundByOtherJobs = false;
+    }
+    if (!LastUnitFoundByOtherJobs)
+      WriteFeatureSetToFile(Options.FeaturesDir, Sha1ToString(NewII->Sha1),
+                            NewII->UniqFeatureSet);
     WriteEdgeToMutationGraphFile(Options.MutationGraphFile, NewII, II,
                                  MD.MutationSequence());
     return true;
@@ -610,9 +626,13 @@ ATTRIBUTE_NOINLINE bool Fuzzer::ExecuteCallback(const uint8_t *Data,
     AllocTracer.Start(Options.TraceMalloc);
     UnitStartTime = system_clock::now();
     TPC.ResetMaps();
-    RunningUserCallback = true;
-    CBRes = CB(DataCopy, Size);
-    RunningUserCallback = false;
+    if (Options.ForkServer) {
+      CBRes = ExecuteCallbackInChild(DataCopy, Data, Size);
+    } else {
+      RunningUserCallback = true;
+      CBRes = CB(DataCopy, Size);
+      RunningUserCallback = false;
+    }
     UnitStopTime = system_clock::now();
     assert(CBRes == 0 || CBRes == -1);
     HasMoreMallocsThanFrees = AllocTracer.Stop();
@@ -624,6 +644,75 @@ ATTRIBUTE_NOINLINE bool Fuzzer::ExecuteCallback(const uint8_t *Data,
   return CBRes == 0;
 }
 
+// Runs the callback in a copy-on-write child process, so that the state left
+// by the unit is discarded with the child. The child reports crashes, timeouts
+// and OOMs itself, only the result and the coverage of the unit are passed back
+// through shared memory.
+int Fuzzer::ExecuteCallbackInChild(uint8_t *DataCopy, const uint8_t *Data,
+                                   size_t Size) {
+  // The result and the size of the state saved by the child precede the state.
+  struct ChildResult {
+    int CBRes;
+    size_t StateSize;
+  };
+  // The state grows when modules are loaded, so it is sized for every unit.
+  size_t Needed = sizeof(ChildResult) + TPC.ExecutionStateSize();
+  if (Needed > ForkServerStateSize) {
+    if (ForkServerState)
+      UnmapSharedMemory(ForkServerState, ForkServerStateSize);
+    ForkServerState = static_cast<uint8_t *>(MapSharedMemory(Needed));
+    if (!ForkServerState) {
+      Printf("ERROR: -fork_server is not supported on this platform\n");
+      exit(1);
+    }
+    ForkServerStateSize = Needed;
+  }
+  int ExitCode = RunInForkedChild([&]() {
+    RunningUserCallback = true;
+    ChildResult Res;
+    Res.CBRes = CB(DataCopy, Size);
+    RunningUserCallback = false;
+    if (!LooseMemeq(DataCopy, Data, Size))
+      CrashOnOverwrittenData();
+    // A module loaded by the unit can make the state too large for the
+    // buffer, in which case its coverage is not passed back.
+    Res.StateSize =
+        TPC.SaveExecutionState(ForkServerState + sizeof(ChildResult),
+                               ForkServerStateSize - sizeof(ChildResult));
+    memcpy(ForkServerState, &Res, sizeof(Res));
+  });
+  if (ExitCode == 0) {
+    ChildResult Res;
+    memcpy(&Res, ForkServerState, sizeof(Res));
+    if (!TPC.RestoreExecutionState(ForkServerState + sizeof(ChildResult),
+                                   Res.StateSize)) {
+      static bool Warned = false;
+      if (!Warned) {
+        Printf("WARNING: -fork_server: the coverage layout changed while "
+               "running a unit (was a module loaded?); its coverage is "
+               "ignored\n");
+        Warned = true;
+      }
+    }
+    return Res.CBRes;
+  }
+  if (ExitCode < 0) {
+    Printf("ERROR: libFuzzer: failed to fork a process for the unit\n");
+    exit(1);
+  }
+  if (ExitCode > 128) {
+    // Killed before it could report anything, e.g. by the OOM killer.
+    Printf("==%lu== ERROR: libFuzzer: the process running the unit was killed "
+           "by signal %d\n",
+           GetPid(), ExitCode - 128);
+    DumpCurrentUnit("crash-");
+    PrintFinalStats();
+    _Exit(Options.ErrorExitCode);
+  }
+  // The child has already reported the problem and saved the unit.
+  _Exit(ExitCode);
+}
+
 std::string Fuzzer::WriteToOutputCorpus(const Unit &U) {
   if (Options.OnlyASCII)
     assert(IsASCII(U));
@@ -664,7 +753,8 @@ void Fuzzer::ReportNewCoverage(InputInfo *II, const Unit &U) {
   II->NumSuccessfullMutations++;
   MD.RecordSuccessfulMutationSequence();
   PrintStatusForNewUnit(U, II->Reduced ? "REDUCE" : "NEW   ");
-  WriteToOutputCorpus(U);
+  if (!LastUnitFoundByOtherJobs)
+    WriteToOutputCorpus(U);
   NumberOfNewUnitsAdded++;
   CheckExitOnSrcPosOrItem(); // Check only after the unit is saved to corpus.
   LastCorpusUpdateRun = TotalNumberOfRuns;
@@ -48,6 +48,8 @@ struct FuzzingOptions {
   bool OnlyASCII = false;
   bool Entropic = true;
   bool ForkCorpusGroups = false;
+  bool ForkSharedFeatures = false;
+  bool ForkServer = false;
   size_t EntropicFeatureFrequencyThreshold = 0xFF;
   size_t EntropicNumberOfRarestFeatures = 100;
   bool EntropicScalePerExecTime = false;
@@ -60,6 +62,7 @@ struct FuzzingOptions {
   std::string DataFlowTrace;
   std::string CollectDataFlow;
   std::string FeaturesDir;
+  std::string SharedFeaturesFile;
   std::string MutationGraphFile;
   std::string StopFile;
   bool SaveArtifacts = true;
@@ -408,6 +408,39 @@ static size_t InternalStrnlen2(const char *S1, const char *S2) {
   return Len;
 }
 
+// Besides the coverage maps, the state includes the deepest stack reached by
+// the unit, which is tracked in a thread-local outside of TracePC.
+size_t TracePC::ExecutionStateSize() {
+  size_t Res = sizeof(__sancov_lowest_stack);
+  ForEachExecutionStateRange([&](void *, size_t Size) { Res += Size; });
+  return Res;
+}
+
+size_t TracePC::SaveExecutionState(uint8_t *Buf, size_t BufSize) {
+  size_t Size = ExecutionStateSize();
+  if (Size > BufSize)
+    return 0;
+  memcpy(Buf, &__sancov_lowest_stack, sizeof(__sancov_lowest_stack));
+  Buf += sizeof(__sancov_lowest_stack);
+  ForEachExecutionStateRange([&](void *Ptr, size_t Size) {
+    memcpy(Buf, Ptr, Size);
+    Buf += Size;
+  });
+  return Size;
+}
+
+bool TracePC::RestoreExecutionState(const uint8_t *Buf, size_t Size) {
+  if (Size != ExecutionStateSize())
+    return false;
+  memcpy(&__sancov_lowest_stack, Buf, sizeof(__sancov_lowest_stack));
+  Buf += sizeof(__sancov_lowest_stack);
+  ForEachExecutionStateRange([&](void *Ptr, size_t Size) {
+    memcpy(Ptr, Buf, Size);
+    Buf += Size;
+  });
+  return true;
+}
+
 void TracePC::ClearInlineCounters() {
   IterateCounterRegions([](const Module::Region &R){
     if (R.Enabled)
@@ -110,6 +110,15 @@ class TracePC {
   void RecordInitialStack();
   uintptr_t GetMaxStackOffset() const;
 
+  // Passes the coverage of a unit from the process which ran it back to the
+  // fuzzer, see -fork_server. SaveExecutionState returns the number of bytes
+  // written, or 0 if the state does not fit into BufSize bytes.
+  // RestoreExecutionState returns false and leaves the state alone if Size
+  // does not match the current state, e.g. because a module was loaded.
+  size_t ExecutionStateSize();
+  size_t SaveExecutionState(uint8_t *Buf, size_t BufSize);
+  bool RestoreExecutionState(const uint8_t *Buf, size_t Size);
+
   template<class CallBack>
   void ForEachObservedPC(CallBack CB) {
     for (auto PC : ObservedPCs)
@@ -165,6 +174,21 @@ private:
         CB(Modules[m].Regions[r]);
   }
 
+  template <class Callback> // void Callback(void *Ptr, size_t Size);
+  void ForEachExecutionStateRange(Callback CB) {
+    IterateCounterRegions([&](const Module::Region &R) {
+      if (R.Enabled)
+        CB(R.Start, R.Stop - R.Start);
+    });
+    CB(ExtraCountersBegin(), ExtraCountersEnd() - ExtraCountersBegin());
+    if (UseValueProfileMask)
+      CB(&ValueProfileMap, sizeof(ValueProfileMap));
+    CB(&TORC4, sizeof(TORC4));
+    CB(&TORC8, sizeof(TORC8));
+    CB(&TORCW, sizeof(TORCW));
+    CB(&MMT, sizeof(MMT));
+  }
+
   struct { const PCTableEntry *Start, *Stop; } ModulePCTable[4096];
   size_t NumPCTables;
   size_t NumPCsInPCTables;
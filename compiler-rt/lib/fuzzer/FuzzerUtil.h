@@ -15,6 +15,7 @@
 #include "FuzzerBuiltinsMsvc.h"
 #include "FuzzerCommand.h"
 #include "FuzzerDefs.h"
+#include <functional>
 
 namespace fuzzer {
 
@@ -98,6 +99,24 @@ inline size_t Log(size_t X) {
 
 size_t PageSize();
 
+// Maps Size bytes of the file at Path, which is created if needed, into memory
+// shared with the other processes mapping it. Returns nullptr on failure or if
+// the platform doesn't support it.
+void *MapSharedFile(const std::string &Path, size_t Size);
+
+// Allocates Size bytes of zeroed memory which stays shared with the child
+// processes forked afterwards. Returns nullptr on failure or if the platform
+// doesn't support it.
+void *MapSharedMemory(size_t Size);
+
+// Releases memory returned by MapSharedMemory.
+void UnmapSharedMemory(void *Ptr, size_t Size);
+
+// Runs Callback in a copy-on-write child process of this one and waits for it.
+// Returns the exit code of the child, 128 + the signal number if it was killed
+// by a signal, or -1 if it could not be created.
+int RunInForkedChild(const std::function<void()> &Callback);
+
 inline uint8_t *RoundUpByPage(uint8_t *P) {
   uintptr_t X = reinterpret_cast<uintptr_t>(P);
   size_t Mask = PageSize() - 1;
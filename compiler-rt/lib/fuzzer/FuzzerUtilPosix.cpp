@@ -16,6 +16,7 @@
 #include <chrono>
 #include <cstring>
 #include <errno.h>
+#include <fcntl.h>
 #include <iomanip>
 #include <signal.h>
 #include <stdio.h>
@@ -24,6 +25,7 @@
 #include <sys/syscall.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <thread>
 #include <unistd.h>
 
@@ -188,6 +190,50 @@ size_t PageSize() {
   return PageSizeCached;
 }
 
+void *MapSharedFile(const std::string &Path, size_t Size) {
+  int Fd = open(Path.c_str(), O_RDWR | O_CREAT, 0600);
+  if (Fd < 0)
+    return nullptr;
+  void *Res = nullptr;
+  if (ftruncate(Fd, Size) == 0) {
+    Res = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+    if (Res == MAP_FAILED)
+      Res = nullptr;
+  }
+  close(Fd);
+  return Res;
+}
+
+void *MapSharedMemory(size_t Size) {
+  void *Res = mmap(nullptr, Size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  return Res == MAP_FAILED ? nullptr : Res;
+}
+
+void UnmapSharedMemory(void *Ptr, size_t Size) { munmap(Ptr, Size); }
+
+int RunInForkedChild(const std::function<void()> &Callback) {
+  // The interval timer is not inherited by the child, it has to be rearmed
+  // for the child to detect timeouts.
+  struct itimerval Timer;
+  getitimer(ITIMER_REAL, &Timer);
+  pid_t Pid = fork();
+  if (Pid < 0)
+    return -1;
+  if (Pid == 0) {
+    setitimer(ITIMER_REAL, &Timer, nullptr);
+    Callback();
+    _Exit(0);
+  }
+  int Status;
+  while (waitpid(Pid, &Status, 0) < 0)
+    if (errno != EINTR)
+      return -1;
+  if (WIFSIGNALED(Status))
+    return 128 + WTERMSIG(Status);
+  return WEXITSTATUS(Status);
+}
+
 }  // namespace fuzzer
 
 #endif // LIBFUZZER_POSIX
@@ -238,6 +238,23 @@ size_t PageSize() {
   return PageSizeCached;
 }
 
+void *MapSharedFile(const std::string &Path, size_t Size) {
+  // TODO: Not yet supported.
+  return nullptr;
+}
+
+void *MapSharedMemory(size_t Size) {
+  // TODO: Not yet supported.
+  return nullptr;
+}
+
+void UnmapSharedMemory(void *Ptr, size_t Size) {}
+
+int RunInForkedChild(const std::function<void()> &Callback) {
+  // TODO: Not yet supported.
+  return -1;
+}
+
 void SetThreadName(std::thread &thread, const std::string &name) {
   typedef HRESULT(WINAPI * proc)(HANDLE, PCWSTR);
   HMODULE kbase = GetModuleHandleA("KernelBase.dll");
@@ -12,6 +12,7 @@
 #define LLVM_FUZZER_VALUE_BIT_MAP_H
 
 #include "FuzzerPlatform.h"
+#include <atomic>
 #include <cstdint>
 
 namespace fuzzer {
@@ -68,6 +69,39 @@ struct ValueBitMap {
   ATTRIBUTE_ALIGNED(512) uintptr_t Map[kMapSizeInWords];
 };
 
+// A bit map over the feature space (see kFeatureSetSize in FuzzerCorpus.h)
+// placed in memory shared by the processes of a -fork run. The main process
+// sets the features of its corpus and the jobs set the features of the inputs
+// they save, so a job does not save an input which only has features already
+// found by another job.
+struct SharedFeatureBitMap {
+  static const size_t kMapSizeInBits = 1 << 21;
+  static const size_t kBitsInWord = (sizeof(uintptr_t) * 8);
+  static const size_t kMapSizeInBytes = kMapSizeInBits / 8;
+ public:
+
+  // Uses kMapSizeInBytes of shared memory starting at Memory.
+  void Attach(void *Memory) {
+    Map = static_cast<std::atomic<uintptr_t> *>(Memory);
+  }
+
+  bool IsAttached() const { return Map != nullptr; }
+
+  // Sets the bit of Feature.
+  // Returns true if the bit was changed from 0 to 1.
+  inline bool AddFeature(uint32_t Feature) {
+    assert(IsAttached());
+    uintptr_t Idx = Feature % kMapSizeInBits;
+    uintptr_t Bit = (uintptr_t)1 << (Idx % kBitsInWord);
+    uintptr_t Old =
+        Map[Idx / kBitsInWord].fetch_or(Bit, std::memory_order_relaxed);
+    return !(Old & Bit);
+  }
+
+ private:
+  std::atomic<uintptr_t> *Map = nullptr;
+};
+
 }  // namespace fuzzer
 
 #endif  // LLVM_FUZZER_VALUE_BIT_MAP_H
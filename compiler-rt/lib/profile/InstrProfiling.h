@@ -59,6 +59,12 @@ typedef struct COMPILER_RT_ALIGNAS(INSTR_PROF_DATA_ALIGNMENT) VTableProfData {
  * \brief Return 1 if profile counters are continuously synced to the raw
  * profile via an mmap(). This is in contrast to the default mode, in which
  * the raw profile is written out at program exit time.
+ *
+ * In either mode, all threads increment the same counter array. Instrumented
+ * code addresses its counters directly (or through the counter bias on
+ * Linux), so the runtime cannot shard them per thread; contention on hot
+ * counters has to be reduced at instrumentation time, e.g. through counter
+ * promotion out of loops.
  */
 int __llvm_profile_is_continuous_mode_enabled(void);
 
@@ -19,6 +19,7 @@
 #include "sanitizer_common.h"
 #include "sanitizer_dense_map_info.h"
 #include "sanitizer_internal_defs.h"
+#include "sanitizer_placement_new.h"
 #include "sanitizer_type_traits.h"
 
 namespace __sanitizer {
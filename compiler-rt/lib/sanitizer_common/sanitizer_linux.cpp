@@ -800,6 +800,10 @@ uptr internal_lseek(fd_t fd, OFF_T offset, int whence) {
 uptr internal_prctl(int option, uptr arg2, uptr arg3, uptr arg4, uptr arg5) {
   return internal_syscall(SYSCALL(prctl), option, arg2, arg3, arg4, arg5);
 }
+
+uptr internal_mincore(void *addr, uptr length, unsigned char *vec) {
+  return internal_syscall(SYSCALL(mincore), (uptr)addr, length, (uptr)vec);
+}
 #      if defined(__x86_64__)
 #        include <asm/unistd_64.h>
 // Currently internal_arch_prctl() is only needed on x86_64.
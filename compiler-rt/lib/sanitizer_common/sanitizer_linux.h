@@ -70,6 +70,7 @@ uptr internal_clock_gettime(__sanitizer_clockid_t clk_id, void *tp);
 // Linux-only syscalls.
 #  if SANITIZER_LINUX
 uptr internal_prctl(int option, uptr arg2, uptr arg3, uptr arg4, uptr arg5);
+uptr internal_mincore(void *addr, uptr length, unsigned char *vec);
 #    if defined(__x86_64__)
 uptr internal_arch_prctl(int option, uptr arg2);
 #    endif
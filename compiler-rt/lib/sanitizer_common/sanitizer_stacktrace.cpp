@@ -14,6 +14,7 @@
 
 #include "sanitizer_common.h"
 #include "sanitizer_flags.h"
+#include "sanitizer_linux.h"
 #include "sanitizer_platform.h"
 #include "sanitizer_ptrauth.h"
 
@@ -148,6 +149,75 @@ void BufferedStackTrace::UnwindFast(uptr pc, uptr bp, uptr stack_top,
 
 #endif  // !defined(__sparc__)
 
+#if SANITIZER_LINUX && defined(__x86_64__)
+uptr GetShadowStackPointer() {
+  // RDSSPQ is encoded as a NOP on CPUs without CET and when the shadow stack
+  // is disabled for the thread, in which case the register stays zero. Emit the
+  // raw bytes of "rdsspq %rax" to support older assemblers.
+  uptr ssp = 0;
+  __asm__ __volatile__(".byte 0xf3, 0x48, 0x0f, 0x1e, 0xc8" : "+a"(ssp));
+  return ssp;
+}
+
+// Some of the frames on top of the shadow stack belong to the runtime itself.
+// We look for the first return address of the frame pointer chain among these.
+static const uptr kMaxShadowStackSkip = 32;
+
+bool BufferedStackTrace::UnwindShadowStack(uptr pc, uptr bp, uptr stack_top,
+                                           uptr stack_bottom,
+                                           const uhwptr *ssp, u32 max_depth) {
+  CHECK_GE(max_depth, 2);
+  if (!ssp || !IsValidFrame(bp, stack_top, stack_bottom) ||
+      !IsAligned(bp, sizeof(uhwptr)))
+    return false;
+  const uptr kPageSize = GetPageSizeCached();
+  // The shadow stack has no terminator, so we check that each new page is
+  // mapped before reading from it.
+  uptr readable_end = RoundUpTo((uptr)ssp + 1, kPageSize);
+  auto is_readable = [&](const uhwptr *entry) {
+    if ((uptr)entry < readable_end)
+      return true;
+    unsigned char vec;
+    if (internal_iserror(
+            internal_mincore((void *)readable_end, kPageSize, &vec)))
+      return false;
+    readable_end += kPageSize;
+    return true;
+  };
+
+  const uhwptr first_caller = ((uhwptr *)bp)[1];
+  const uhwptr *entry = ssp;
+  for (uptr i = 0;; ++i, ++entry) {
+    if (i == kMaxShadowStackSkip || !is_readable(entry))
+      return false;
+    if (*entry == first_caller)
+      break;
+  }
+
+  trace_buffer[0] = pc;
+  size = 1;
+  for (; size < max_depth && is_readable(entry); ++entry) {
+    uhwptr pc1 = *entry;
+    // Signal frames are marked with the top bit set, and are not return
+    // addresses.
+    if (pc1 >> (sizeof(uhwptr) * 8 - 1))
+      continue;
+    if (pc1 < kPageSize)
+      break;
+    trace_buffer[size++] = pc1;
+  }
+  return true;
+}
+#else
+uptr GetShadowStackPointer() { return 0; }
+
+bool BufferedStackTrace::UnwindShadowStack(uptr pc, uptr bp, uptr stack_top,
+                                           uptr stack_bottom,
+                                           const uhwptr *ssp, u32 max_depth) {
+  return false;
+}
+#endif
+
 void BufferedStackTrace::PopStackFrames(uptr count) {
   CHECK_LT(count, size);
   size -= count;
@@ -148,6 +148,12 @@ struct BufferedStackTrace : public StackTrace {
                   u32 max_depth);
   void UnwindSlow(uptr pc, u32 max_depth);
   void UnwindSlow(uptr pc, void *context, u32 max_depth);
+  // Copies the return addresses from the shadow stack at |ssp|, starting at
+  // the caller of the frame |bp|. Returns false if it can't do so. |bp| must
+  // be a valid frame pointer, since its return address is used to find the
+  // starting entry; only the frames above it may omit frame pointers.
+  bool UnwindShadowStack(uptr pc, uptr bp, uptr stack_top, uptr stack_bottom,
+                         const uhwptr *ssp, u32 max_depth);
 
   void PopStackFrames(uptr count);
   uptr LocatePcInTrace(uptr pc);
@@ -166,6 +172,10 @@ static const uptr kFrameSize = 96;
 static const uptr kFrameSize = 2 * sizeof(uhwptr);
 #endif
 
+// Returns the current hardware shadow stack pointer, or 0 if the thread does
+// not run with a shadow stack.
+uptr GetShadowStackPointer();
+
 // Check if given pointer points into allocated stack area.
 static inline bool IsValidFrame(uptr frame, uptr stack_top, uptr stack_bottom) {
   return frame > stack_bottom && frame < stack_top - kFrameSize;
@@ -164,6 +164,11 @@ void BufferedStackTrace::Unwind(u32 max_depth, uptr pc, uptr bp, void *context,
     UNREACHABLE("slow unwind requested but not available");
 #endif
   }
+  if (common_flags()->fast_unwind_via_shadow_stack &&
+      UnwindShadowStack(
+          pc, bp, stack_top, stack_bottom,
+          reinterpret_cast<const uhwptr *>(GetShadowStackPointer()), max_depth))
+    return;
   UnwindFast(pc, bp, stack_top, stack_bottom, max_depth);
 }
 
@@ -62,6 +62,24 @@ SymbolizedStack *SymbolizedStack::New(uptr addr) {
   return res;
 }
 
+SymbolizedStack *SymbolizedStack::Clone() const {
+  SymbolizedStack *first = nullptr;
+  SymbolizedStack **last = &first;
+  for (const SymbolizedStack *frame = this; frame; frame = frame->next) {
+    SymbolizedStack *copy = New(frame->info.address);
+    copy->info = frame->info;
+    copy->info.module =
+        frame->info.module ? internal_strdup(frame->info.module) : nullptr;
+    copy->info.function =
+        frame->info.function ? internal_strdup(frame->info.function) : nullptr;
+    copy->info.file =
+        frame->info.file ? internal_strdup(frame->info.file) : nullptr;
+    *last = copy;
+    last = &copy->next;
+  }
+  return first;
+}
+
 void SymbolizedStack::ClearAll() {
   info.Clear();
   if (next)
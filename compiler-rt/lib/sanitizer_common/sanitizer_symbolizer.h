@@ -19,6 +19,7 @@
 #define SANITIZER_SYMBOLIZER_H
 
 #include "sanitizer_common.h"
+#include "sanitizer_dense_map.h"
 #include "sanitizer_mutex.h"
 #include "sanitizer_vector.h"
 
@@ -56,6 +57,8 @@ struct SymbolizedStack {
   SymbolizedStack *next;
   AddressInfo info;
   static SymbolizedStack *New(uptr addr);
+  // Returns a deep copy of this frame and all subsequent frames.
+  SymbolizedStack *Clone() const;
   // Deletes current, and all subsequent frames in the linked list.
   // The object cannot be accessed after the call to this function.
   void ClearAll();
@@ -209,6 +212,12 @@ class Symbolizer final {
   // If stale, need to reload the modules before looking up addresses.
   bool modules_fresh_;
 
+  // Results of SymbolizePC() keyed by address, so that frames shared by many
+  // reports only go through the symbolizer tools once. Owns the stacks and is
+  // dropped whenever the module list is reloaded or Flush() is called.
+  DenseMap<uptr, SymbolizedStack *> pc_cache_;
+  void ClearPCCache();
+
   // Platform-specific default demangler, returns nullptr on failure.
   const char *PlatformDemangle(const char *name);
 
@@ -84,17 +84,26 @@ const char *ExtractTokenUpToDelimiter(const char *str, const char *delimiter,
 
 SymbolizedStack *Symbolizer::SymbolizePC(uptr addr) {
   Lock l(&mu_);
-  SymbolizedStack *res = SymbolizedStack::New(addr);
   auto *mod = FindModuleForAddress(addr);
   if (!mod)
-    return res;
+    return SymbolizedStack::New(addr);
+  // FindModuleForAddress() may have reloaded the modules and dropped the
+  // cache, so only look it up afterwards.
+  if (auto *cached = pc_cache_.find(addr))
+    return cached->second->Clone();
+  SymbolizedStack *res = SymbolizedStack::New(addr);
   // Always fill data about module name and offset.
   res->info.FillModuleInfo(*mod);
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
-    if (tool.SymbolizePC(addr, res)) {
-      return res;
-    }
+    if (tool.SymbolizePC(addr, res))
+      break;
+  }
+  uptr max_cached = common_flags()->symbolize_cache_size;
+  if (max_cached) {
+    if (pc_cache_.size() >= max_cached)
+      ClearPCCache();
+    pc_cache_[addr] = res->Clone();
   }
   return res;
 }
@@ -150,8 +159,17 @@ bool Symbolizer::GetModuleNameAndOffsetForPC(uptr pc, const char **module_name,
   return true;
 }
 
+void Symbolizer::ClearPCCache() {
+  pc_cache_.forEach([](auto &kv) {
+    kv.second->ClearAll();
+    return true;
+  });
+  pc_cache_.clear();
+}
+
 void Symbolizer::Flush() {
   Lock l(&mu_);
+  ClearPCCache();
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
     tool.Flush();
@@ -185,6 +203,8 @@ bool Symbolizer::FindModuleNameAndOffsetForAddress(uptr address,
 }
 
 void Symbolizer::RefreshModules() {
+  // Addresses may now belong to different modules.
+  ClearPCCache();
   modules_.init();
   fallback_modules_.fallbackInit();
   RAW_CHECK(modules_.size() > 0);
@@ -143,6 +143,33 @@ TEST_F(FastUnwindTest, SKIP_ON_SPARC(MisalignedFramePointer)) {
   }
 }
 
+#if SANITIZER_LINUX && defined(__x86_64__)
+TEST_F(FastUnwindTest, ShadowStack) {
+  size_t ps = GetPageSize();
+  uptr ss_mapping = (uptr)MmapOrDie(2 * ps, "FastUnwindTest");
+  UnmapOrDie((void *)(ss_mapping + ps), ps);
+  // Two runtime frames, then the return addresses of the fake stack up to the
+  // end of the mapping.
+  uhwptr *ssp = (uhwptr *)(ss_mapping + ps) - 8;
+  ssp[0] = PC(100);
+  ssp[1] = PC(101);
+  for (uptr i = 2; i < 8; i++)
+    ssp[i] = PC(i * 2 - 3);
+  EXPECT_TRUE(trace.UnwindShadowStack(start_pc, fake_bp, fake_top, fake_bottom,
+                                      ssp, kStackTraceMax));
+  EXPECT_EQ(7U, trace.size);
+  EXPECT_EQ(start_pc, trace.trace[0]);
+  for (uptr i = 1; i <= 6; i++)
+    EXPECT_EQ(PC(i * 2 - 1), trace.trace[i]);
+
+  // Without the caller of the top frame, we can't line up the stacks.
+  ssp[2] = PC(102);
+  EXPECT_FALSE(trace.UnwindShadowStack(start_pc, fake_bp, fake_top,
+                                       fake_bottom, ssp, kStackTraceMax));
+  UnmapOrDie((void *)ss_mapping, ps);
+}
+#endif
+
 TEST_F(FastUnwindTest, OneFrameStackTrace) {
   trace.Unwind(start_pc, fake_bp, nullptr, true, 1);
   EXPECT_EQ(1U, trace.size);
@@ -54,6 +54,44 @@ TEST(Symbolizer, ExtractTokenUpToDelimiter) {
   InternalFree(token);
 }
 
+TEST(Symbolizer, CloneSymbolizedStack) {
+  SymbolizedStack *stack = SymbolizedStack::New(0x1000);
+  stack->info.FillModuleInfo("module", 0x10, kModuleArchUnknown);
+  stack->info.function = internal_strdup("inlined");
+  stack->info.line = 7;
+  stack->next = SymbolizedStack::New(0x1000);
+  stack->next->info.function = internal_strdup("caller");
+
+  SymbolizedStack *copy = stack->Clone();
+  stack->ClearAll();
+  EXPECT_EQ(0x1000U, copy->info.address);
+  EXPECT_STREQ("module", copy->info.module);
+  EXPECT_EQ(0x10U, copy->info.module_offset);
+  EXPECT_STREQ("inlined", copy->info.function);
+  EXPECT_EQ(nullptr, copy->info.file);
+  EXPECT_EQ(7, copy->info.line);
+  ASSERT_NE(nullptr, copy->next);
+  EXPECT_STREQ("caller", copy->next->info.function);
+  EXPECT_EQ(nullptr, copy->next->next);
+  copy->ClearAll();
+}
+
+// Repeated lookups are served from the cache and must still hand out stacks
+// the caller owns.
+TEST(Symbolizer, SymbolizePCRepeatedly) {
+  uptr pc = reinterpret_cast<uptr>(&SymbolizedStack::New);
+  Symbolizer *symbolizer = Symbolizer::GetOrInit();
+  SymbolizedStackHolder first(symbolizer->SymbolizePC(pc));
+  SymbolizedStackHolder second(symbolizer->SymbolizePC(pc));
+  ASSERT_NE(first.get(), second.get());
+  EXPECT_EQ(pc, second.get()->info.address);
+  EXPECT_STREQ(first.get()->info.module, second.get()->info.module);
+  EXPECT_EQ(first.get()->info.module_offset, second.get()->info.module_offset);
+  symbolizer->Flush();
+  SymbolizedStackHolder third(symbolizer->SymbolizePC(pc));
+  EXPECT_STREQ(first.get()->info.module, third.get()->info.module);
+}
+
 #if !SANITIZER_WINDOWS
 TEST(Symbolizer, DemangleSwiftAndCXX) {
   // Swift names are not demangled in default llvm build because Swift
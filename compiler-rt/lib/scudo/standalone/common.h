@@ -148,6 +148,10 @@ inline uptr getPageSizeCached() {
 // Returns 0 if the number of CPUs could not be determined.
 u32 getNumberOfCPUs();
 
+// Returns the CPU the calling thread is currently running on, or -1 if that
+// cannot be determined. The result may be stale as soon as it is returned.
+s32 getCurrentCPU();
+
 const char *getEnv(const char *Name);
 
 u64 getMonotonicTime();
@@ -169,6 +173,9 @@ bool getRandom(void *Buffer, uptr Length, bool Blocking = false);
 #define MAP_RESIZABLE (1U << 2)
 #define MAP_MEMTAG (1U << 3)
 #define MAP_PRECOMMIT (1U << 4)
+// A hint that the mapping would benefit from being backed by transparent huge
+// pages. Platforms without such support ignore it.
+#define MAP_HUGEPAGE (1U << 5)
 
 // Our platform memory mapping use is restricted to 3 scenarios:
 // - reserve memory at a random address (MAP_NOACCESS);
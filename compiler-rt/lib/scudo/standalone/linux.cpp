@@ -167,6 +167,12 @@ u32 getNumberOfCPUs() {
   return static_cast<u32>(CPU_COUNT(&CPUs));
 }
 
+s32 getCurrentCPU() {
+  // With a recent libc, sched_getcpu reads the CPU number that the kernel
+  // maintains in the thread's restartable sequences area, or uses the vDSO.
+  return static_cast<s32>(sched_getcpu());
+}
+
 u32 getThreadID() {
 #if SCUDO_ANDROID
   return static_cast<u32>(gettid());
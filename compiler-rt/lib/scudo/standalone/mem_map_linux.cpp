@@ -74,6 +74,11 @@ static void *mmapWrapper(uptr Addr, uptr Size, const char *Name, uptr Flags) {
 #else
   (void)Name;
 #endif
+#if defined(MADV_HUGEPAGE)
+  // This is only advisory, a failure (e.g. THP disabled) is not an error.
+  if (Flags & MAP_HUGEPAGE)
+    madvise(P, Size, MADV_HUGEPAGE);
+#endif
 
   return P;
 }
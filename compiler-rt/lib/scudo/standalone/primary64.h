@@ -33,6 +33,10 @@ namespace scudo {
 // PrimaryEnableRandomOffset is set, each Region actually starts at a random
 // offset from its base.
 //
+// If PrimaryEnableHugePages is set, the Regions of the classes with blocks not
+// larger than a page are aligned and grown in 2MB units hinted to be backed by
+// transparent huge pages, and only whole huge pages are released from them.
+//
 // Regions are mapped incrementally on demand to fulfill allocation requests,
 // those mappings being split into equally sized Blocks based on the size class
 // they belong to. The Blocks created are shuffled to prevent predictable
@@ -56,6 +60,12 @@ public:
   static_assert(RegionSizeLog >= GroupSizeLog,
                 "Group size shouldn't be greater than the region size");
   static const uptr GroupScale = GroupSizeLog - CompactPtrScale;
+  static const uptr HugePageSizeLog = 21U;
+  static const uptr HugePageSize = 1UL << HugePageSizeLog;
+  // Leave room for the alignment and the random offset of the region.
+  static_assert(!Config::getEnableHugePages() ||
+                    RegionSizeLog >= HugePageSizeLog + 5U,
+                "Region is too small to be backed by huge pages");
   typedef SizeClassAllocator64<Config> ThisT;
   typedef SizeClassAllocatorLocalCache<ThisT> CacheT;
   typedef TransferBatch<ThisT> TransferBatchT;
@@ -355,6 +365,7 @@ public:
   void getStats(ScopedString *Str) {
     // TODO(kostyak): get the RSS per region.
     uptr TotalMapped = 0;
+    uptr TotalHugePageMapped = 0;
     uptr PoppedBlocks = 0;
     uptr PushedBlocks = 0;
     for (uptr I = 0; I < NumClasses; I++) {
@@ -362,6 +373,7 @@ public:
       {
         ScopedLock L(Region->MMLock);
         TotalMapped += Region->MemMapInfo.MappedUser;
+        TotalHugePageMapped += getHugePageMappedBytes(Region, I);
       }
       {
         ScopedLock L(Region->FLLock);
@@ -374,6 +386,11 @@ public:
                 "allocations; remains %zu; ReleaseToOsIntervalMs = %d\n",
                 TotalMapped >> 20, 0U, PoppedBlocks,
                 PoppedBlocks - PushedBlocks, IntervalMs >= 0 ? IntervalMs : -1);
+    if (Config::getEnableHugePages()) {
+      Str->append("Stats: SizeClassAllocator64: %zuK of %zuK mapped is in "
+                  "huge page aligned units\n",
+                  TotalHugePageMapped >> 10, TotalMapped >> 10);
+    }
 
     for (uptr I = 0; I < NumClasses; I++) {
       RegionInfo *Region = getRegionInfo(I);
@@ -603,6 +620,25 @@ private:
     return BlockSize > PageSize;
   }
 
+  // The regions of large blocks are sparsely used and frequently released, they
+  // don't benefit from huge pages.
+  ALWAYS_INLINE static bool useHugePages(uptr BlockSize) {
+    return Config::getEnableHugePages() && !isLargeBlock(BlockSize);
+  }
+
+  // Returns the mapped bytes of the region that span whole huge pages.
+  uptr getHugePageMappedBytes(RegionInfo *Region, uptr ClassId)
+      REQUIRES(Region->MMLock) {
+    if (!useHugePages(getSizeByClassId(ClassId)) ||
+        Region->MemMapInfo.MappedUser == 0) {
+      return 0;
+    }
+    const uptr Beg = roundUp(Region->RegionBeg, HugePageSize);
+    const uptr End = roundDown(
+        Region->RegionBeg + Region->MemMapInfo.MappedUser, HugePageSize);
+    return End > Beg ? End - Beg : 0;
+  }
+
   ALWAYS_INLINE void initRegion(RegionInfo *Region, uptr ClassId,
                                 MemMapT MemMap, bool EnableRandomOffset)
       REQUIRES(Region->MMLock) {
@@ -610,13 +646,16 @@ private:
     DCHECK(MemMap.isAllocated());
 
     const uptr PageSize = getPageSizeCached();
+    const bool UseHugePages = useHugePages(getSizeByClassId(ClassId));
 
     Region->MemMapInfo.MemMap = MemMap;
 
     Region->RegionBeg = MemMap.getBase();
+    if (UseHugePages)
+      Region->RegionBeg = roundUp(Region->RegionBeg, HugePageSize);
     if (EnableRandomOffset) {
-      Region->RegionBeg +=
-          (getRandomModN(&Region->RandState, 16) + 1) * PageSize;
+      Region->RegionBeg += (getRandomModN(&Region->RandState, 16) + 1) *
+                           (UseHugePages ? HugePageSize : PageSize);
     }
 
     // Releasing small blocks is expensive, set a higher threshold to avoid
@@ -1033,6 +1072,7 @@ private:
 
     DCHECK(Region->MemMapInfo.MemMap.isAllocated());
     const uptr Size = getSizeByClassId(ClassId);
+    const bool UseHugePages = useHugePages(Size);
     const u16 MaxCount = CacheT::getMaxCached(Size);
     const uptr RegionBeg = Region->RegionBeg;
     const uptr MappedUser = Region->MemMapInfo.MappedUser;
@@ -1041,8 +1081,9 @@ private:
     // Map more space for blocks, if necessary.
     if (TotalUserBytes > MappedUser) {
       // Do the mmap for the user memory.
-      const uptr MapSize =
-          roundUp(TotalUserBytes - MappedUser, MapSizeIncrement);
+      const uptr MapSize = roundUp(
+          TotalUserBytes - MappedUser,
+          UseHugePages ? Max(MapSizeIncrement, HugePageSize) : MapSizeIncrement);
       const uptr RegionBase = RegionBeg - getRegionBaseByClassId(ClassId);
       if (UNLIKELY(RegionBase + MappedUser + MapSize > RegionSize)) {
         Region->Exhausted = true;
@@ -1053,7 +1094,8 @@ private:
               RegionBeg + MappedUser, MapSize, "scudo:primary",
               MAP_ALLOWNOMEM | MAP_RESIZABLE |
                   (useMemoryTagging<Config>(Options.load()) ? MAP_MEMTAG
-                                                            : 0)))) {
+                                                            : 0) |
+                  (UseHugePages ? MAP_HUGEPAGE : 0)))) {
         return 0U;
       }
       Region->MemMapInfo.MappedUser += MapSize;
@@ -1259,9 +1301,15 @@ private:
     // ==================================================================== //
     // 4. Release the unused physical pages back to the OS.
     // ==================================================================== //
-    RegionReleaseRecorder<MemMapT> Recorder(&Region->MemMapInfo.MemMap,
-                                            Region->RegionBeg,
-                                            Context.getReleaseOffset());
+    // Releasing a part of a huge page splits it, so only whole huge pages are
+    // released unless everything was requested to be released.
+    const uptr ReleaseGranularity =
+        useHugePages(BlockSize) && ReleaseType != ReleaseToOS::ForceAll
+            ? HugePageSize
+            : 0;
+    RegionReleaseRecorder<MemMapT> Recorder(
+        &Region->MemMapInfo.MemMap, Region->RegionBeg,
+        Context.getReleaseOffset(), ReleaseGranularity);
     auto SkipRegion = [](UNUSED uptr RegionIndex) { return false; };
     releaseFreeMemoryToOS(Context, Recorder, SkipRegion);
     if (Recorder.getReleasedRangesCount() > 0) {
@@ -1312,6 +1360,10 @@ private:
     if (RegionPushedBytesDelta < PageSize)
       return false;
 
+    // Only whole huge pages are released, see releaseToOSMaybe().
+    if (useHugePages(BlockSize) && RegionPushedBytesDelta < HugePageSize)
+      return false;
+
     // Releasing smaller blocks is expensive, so we want to make sure that a
     // significant amount of bytes are free, and that there has been a good
     // amount of batches pushed to the freelist before attempting to release.
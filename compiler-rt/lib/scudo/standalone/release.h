@@ -19,8 +19,10 @@ namespace scudo {
 
 template <typename MemMapT> class RegionReleaseRecorder {
 public:
-  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0)
-      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset) {}
+  RegionReleaseRecorder(MemMapT *RegionMemMap, uptr Base, uptr Offset = 0,
+                        uptr Granularity = 0)
+      : RegionMemMap(RegionMemMap), Base(Base), Offset(Offset),
+        Granularity(Granularity) {}
 
   uptr getReleasedRangesCount() const { return ReleasedRangesCount; }
 
@@ -29,8 +31,16 @@ public:
   uptr getBase() const { return Base; }
 
   // Releases [From, To) range of pages back to OS. Note that `From` and `To`
-  // are offseted from `Base` + Offset.
+  // are offseted from `Base` + Offset. If `Granularity` is set, the range is
+  // shrunk to the `Granularity` aligned units it fully covers.
   void releasePageRangeToOS(uptr From, uptr To) {
+    if (Granularity != 0) {
+      const uptr Start = getBase() + Offset;
+      From = roundUp(Start + From, Granularity) - Start;
+      To = roundDown(Start + To, Granularity) - Start;
+      if (From >= To)
+        return;
+    }
     const uptr Size = To - From;
     RegionMemMap->releasePagesToOS(getBase() + Offset + From, Size);
     ReleasedRangesCount++;
@@ -45,6 +55,8 @@ private:
   // The release offset from Base. This is used when we know a given range after
   // Base will not be released.
   uptr Offset = 0;
+  // The unit of the released ranges, 0 means a page.
+  uptr Granularity = 0;
 };
 
 class ReleaseRecorder {
@@ -295,6 +295,62 @@ TEST(ScudoPrimaryTest, Primary64OOM) {
   Allocator.unmapTestOnly();
 }
 
+struct HugePagesConfig {
+  static const bool MaySupportMemoryTagging = false;
+  template <typename> using TSDRegistryT = void;
+  template <typename> using PrimaryT = void;
+  template <typename> using SecondaryT = void;
+
+  struct Primary {
+    using SizeClassMap = scudo::DefaultSizeClassMap;
+    static const scudo::uptr RegionSizeLog = 26U;
+    static const scudo::s32 MinReleaseToOsIntervalMs = INT32_MIN;
+    static const scudo::s32 MaxReleaseToOsIntervalMs = INT32_MAX;
+    typedef scudo::uptr CompactPtrT;
+    static const scudo::uptr CompactPtrScale = 0;
+    static const bool EnableRandomOffset = true;
+    static const bool EnableHugePages = true;
+    static const scudo::uptr MapSizeIncrement = 1UL << 18;
+    static const scudo::uptr GroupSizeLog = 20U;
+  };
+};
+
+TEST(ScudoPrimaryTest, Primary64HugePages) {
+  using Primary =
+      scudo::SizeClassAllocator64<scudo::PrimaryConfig<HugePagesConfig>>;
+  const scudo::uptr HugePageSize = 1UL << 21;
+  std::unique_ptr<Primary> Allocator(new Primary);
+  Allocator->init(/*ReleaseToOsInterval=*/-1);
+  typename Primary::CacheT Cache;
+  Cache.init(nullptr, Allocator.get());
+  const scudo::uptr Size = 64U;
+  const scudo::uptr ClassId = Primary::SizeClassMap::getClassIdBySize(Size);
+  std::vector<void *> Blocks;
+  scudo::uptr LowestBlock = ~static_cast<scudo::uptr>(0);
+  for (scudo::uptr I = 0; I < 3 * HugePageSize / Size; I++) {
+    void *P = Cache.allocate(ClassId);
+    ASSERT_NE(P, nullptr);
+    LowestBlock = std::min(LowestBlock, reinterpret_cast<scudo::uptr>(P));
+    Blocks.push_back(P);
+  }
+  // The lowest block is the beginning of the region.
+  EXPECT_EQ(LowestBlock % HugePageSize, 0U);
+
+  for (auto *P : Blocks)
+    Cache.deallocate(ClassId, P);
+  Cache.destroy(nullptr);
+  const scudo::uptr Released =
+      Allocator->releaseToOS(scudo::ReleaseToOS::Force);
+  EXPECT_GT(Released, 0U);
+  EXPECT_EQ(Released % HugePageSize, 0U);
+
+  scudo::ScopedString Str;
+  Allocator->getStats(&Str);
+  Str.output();
+  Allocator->verifyAllBlocksAreReleasedTestOnly();
+  Allocator->unmapTestOnly();
+}
+
 SCUDO_TYPED_TEST(ScudoPrimaryTest, PrimaryIterate) {
   using Primary = TestAllocator<TypeParam, scudo::DefaultSizeClassMap>;
   std::unique_ptr<Primary> Allocator(new Primary);
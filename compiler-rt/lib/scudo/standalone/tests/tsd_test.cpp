@@ -67,6 +67,12 @@ struct SharedCaches {
   using TSDRegistryT = scudo::TSDRegistrySharedT<Allocator, 16U, 8U>;
 };
 
+struct CPUAffineCaches {
+  template <class Allocator>
+  using TSDRegistryT =
+      scudo::TSDRegistrySharedT<Allocator, 16U, 8U, /*CPUAffine=*/true>;
+};
+
 struct ExclusiveCaches {
   template <class Allocator>
   using TSDRegistryT = scudo::TSDRegistryExT<Allocator>;
@@ -117,6 +123,7 @@ static void testRegistry() NO_THREAD_SAFETY_ANALYSIS {
 TEST(ScudoTSDTest, TSDRegistryBasic) {
   testRegistry<MockAllocator<OneCache>>();
   testRegistry<MockAllocator<SharedCaches>>();
+  testRegistry<MockAllocator<CPUAffineCaches>>();
 #if !SCUDO_FUCHSIA
   testRegistry<MockAllocator<ExclusiveCaches>>();
 #endif
@@ -178,6 +185,7 @@ template <class AllocatorT> static void testRegistryThreaded() {
 TEST(ScudoTSDTest, TSDRegistryThreaded) {
   testRegistryThreaded<MockAllocator<OneCache>>();
   testRegistryThreaded<MockAllocator<SharedCaches>>();
+  testRegistryThreaded<MockAllocator<CPUAffineCaches>>();
 #if !SCUDO_FUCHSIA
   testRegistryThreaded<MockAllocator<ExclusiveCaches>>();
 #endif
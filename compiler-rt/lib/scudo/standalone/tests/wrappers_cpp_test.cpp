@@ -27,6 +27,11 @@
 void operator delete(void *, size_t) noexcept;
 void operator delete[](void *, size_t) noexcept;
 
+enum class __hot_cold_t : uint8_t {};
+void *operator new(size_t, __hot_cold_t);
+void *operator new[](size_t, __hot_cold_t);
+void *operator new(size_t, std::align_val_t, __hot_cold_t);
+
 extern "C" {
 #ifndef SCUDO_ENABLE_HOOKS_TESTS
 #define SCUDO_ENABLE_HOOKS_TESTS 0
@@ -158,6 +163,31 @@ TEST_F(ScudoWrappersCppDeathTest, New) {
   testCxxNew<Pixel>();
 }
 
+TEST_F(ScudoWrappersCppTest, HotColdNew) {
+  // The hint does not change where the chunk comes from: the memory must be
+  // usable and released through the regular operator delete.
+  for (uint8_t Hint : {0, 128, 255}) {
+    void *P = operator new(64U, static_cast<__hot_cold_t>(Hint));
+    EXPECT_NE(P, nullptr);
+    verifyAllocHookPtr(P);
+    verifyAllocHookSize(64U);
+    memset(P, 0x42, 64U);
+    operator delete(P);
+    verifyDeallocHookPtr(P);
+
+    P = operator new[](128U, static_cast<__hot_cold_t>(Hint));
+    EXPECT_NE(P, nullptr);
+    memset(P, 0x42, 128U);
+    operator delete[](P);
+
+    P = operator new(64U, std::align_val_t(256U),
+                     static_cast<__hot_cold_t>(Hint));
+    EXPECT_NE(P, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(P) % 256U, 0U);
+    operator delete(P, std::align_val_t(256U));
+  }
+}
+
 static std::mutex Mutex;
 static std::condition_variable Cv;
 static bool Ready;
@@ -24,9 +24,15 @@
 
 namespace scudo {
 
-template <class Allocator, u32 TSDsArraySize, u32 DefaultTSDCount>
+// If CPUAffine is true, a thread always starts with the TSD of the CPU it is
+// running on, so that threads on different CPUs rarely contend for the same
+// TSD and each cache stays warm on one CPU, regardless of how many threads
+// there are. Otherwise a thread sticks to the TSD it last managed to lock.
+template <class Allocator, u32 TSDsArraySize, u32 DefaultTSDCount,
+          bool CPUAffine = false>
 struct TSDRegistrySharedT {
-  using ThisT = TSDRegistrySharedT<Allocator, TSDsArraySize, DefaultTSDCount>;
+  using ThisT = TSDRegistrySharedT<Allocator, TSDsArraySize, DefaultTSDCount,
+                                   CPUAffine>;
 
   struct ScopedTSD {
     ALWAYS_INLINE ScopedTSD(ThisT &TSDRegistry) {
@@ -117,8 +123,8 @@ struct TSDRegistrySharedT {
   void getStats(ScopedString *Str) EXCLUDES(MutexTSDs) {
     ScopedLock L(MutexTSDs);
 
-    Str->append("Stats: SharedTSDs: %u available; total %u\n", NumberOfTSDs,
-                TSDsArraySize);
+    Str->append("Stats: SharedTSDs: %u available; total %u%s\n", NumberOfTSDs,
+                TSDsArraySize, CPUAffine ? "; CPU affine" : "");
     for (uptr I = 0; I < NumberOfTSDs; ++I) {
       TSDs[I].lock();
       // Theoretically, we want to mark TSD::lock()/TSD::unlock() with proper
@@ -134,7 +140,7 @@ struct TSDRegistrySharedT {
 
 private:
   ALWAYS_INLINE TSD<Allocator> *getTSDAndLock() NO_THREAD_SAFETY_ANALYSIS {
-    TSD<Allocator> *TSD = getCurrentTSD();
+    TSD<Allocator> *TSD = CPUAffine ? getCPUTSD() : getCurrentTSD();
     DCHECK(TSD);
     // Try to lock the currently associated context.
     if (TSD->tryLock())
@@ -169,6 +175,21 @@ private:
     return reinterpret_cast<TSD<Allocator> *>(*getTlsPtr() & ~1ULL);
   }
 
+  // Returns the TSD of the current CPU, and makes it the current TSD. Falls
+  // back to the current TSD if the CPU is unknown.
+  ALWAYS_INLINE TSD<Allocator> *getCPUTSD() {
+    TSD<Allocator> *CurrentTSD = getCurrentTSD();
+    const s32 CPU = getCurrentCPU();
+    if (UNLIKELY(CPU < 0))
+      return CurrentTSD;
+    // NumberOfTSDs only ever grows, so a stale value is still a valid bound.
+    const u32 N = atomic_load_relaxed(&NumberOfCPUTSDs);
+    TSD<Allocator> *CPUTSD = &TSDs[static_cast<u32>(CPU) % N];
+    if (CPUTSD != CurrentTSD)
+      setCurrentTSD(CPUTSD);
+    return CPUTSD;
+  }
+
   bool setNumberOfTSDs(u32 N) EXCLUDES(MutexTSDs) {
     ScopedLock L(MutexTSDs);
     if (N < NumberOfTSDs)
@@ -176,6 +197,7 @@ private:
     if (N > TSDsArraySize)
       N = TSDsArraySize;
     NumberOfTSDs = N;
+    atomic_store_relaxed(&NumberOfCPUTSDs, N);
     NumberOfCoPrimes = 0;
     // Compute all the coprimes of NumberOfTSDs. This will be used to walk the
     // array of TSDs in a random order. For details, see:
@@ -255,6 +277,8 @@ private:
   }
 
   atomic_u32 CurrentIndex = {};
+  // A copy of NumberOfTSDs that can be read without holding MutexTSDs.
+  atomic_u32 NumberOfCPUTSDs = {};
   u32 NumberOfTSDs GUARDED_BY(MutexTSDs) = 0;
   u32 NumberOfCoPrimes GUARDED_BY(MutexTSDs) = 0;
   u32 CoPrimes[TSDsArraySize] GUARDED_BY(MutexTSDs) = {};
@@ -24,6 +24,10 @@ struct nothrow_t {};
 enum class align_val_t : size_t {};
 } // namespace std
 
+// Allocation hint passed by calls that MemProf rewrites to the hot/cold
+// operator new interfaces. Values range from 0 (coldest) to 255 (hottest).
+enum class __hot_cold_t : uint8_t {};
+
 static void reportAllocation(void *ptr, size_t size) {
   if (SCUDO_ENABLE_HOOKS)
     if (__scudo_allocate_hook && ptr)
@@ -84,6 +88,63 @@ INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
   return Ptr;
 }
 
+// The primary allocator has no separate cold region, so the hot/cold variants
+// allocate as their unhinted counterparts do. Providing them lets binaries
+// built with MemProf hot/cold hints link and run against Scudo; the memory is
+// released through the regular operator delete.
+INTERFACE WEAK void *operator new(size_t size, __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new(size_t size, std::nothrow_t const &,
+                                  __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, std::nothrow_t const &,
+                                    __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray);
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    __hot_cold_t) {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new(size_t size, std::align_val_t align,
+                                  std::nothrow_t const &,
+                                  __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::New,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+INTERFACE WEAK void *operator new[](size_t size, std::align_val_t align,
+                                    std::nothrow_t const &,
+                                    __hot_cold_t) NOEXCEPT {
+  void *Ptr = Allocator.allocate(size, scudo::Chunk::Origin::NewArray,
+                                 static_cast<scudo::uptr>(align));
+  reportAllocation(Ptr, size);
+  return Ptr;
+}
+
 INTERFACE WEAK void operator delete(void *ptr) NOEXCEPT {
   reportDeallocation(ptr);
   Allocator.deallocate(ptr, scudo::Chunk::Origin::New);
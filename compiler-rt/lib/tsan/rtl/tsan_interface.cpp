@@ -26,6 +26,8 @@ void __tsan_flush_memory() {
   FlushShadowMemory();
 }
 
+void __tsan_set_access_sampling_rate(int rate) { SetAccessSamplingRate(rate); }
+
 void __tsan_read16_pc(void *addr, void *pc) {
   uptr pc_no_pac = STRIP_PAC_PC(pc);
   ThreadState *thr = cur_thread();
@@ -37,6 +37,8 @@ __tsan_default_options();
 
 SANITIZER_INTERFACE_ATTRIBUTE void __tsan_flush_memory();
 
+SANITIZER_INTERFACE_ATTRIBUTE void __tsan_set_access_sampling_rate(int rate);
+
 SANITIZER_INTERFACE_ATTRIBUTE void __tsan_read1(void *addr);
 SANITIZER_INTERFACE_ATTRIBUTE void __tsan_read2(void *addr);
 SANITIZER_INTERFACE_ATTRIBUTE void __tsan_read4(void *addr);
@@ -52,6 +52,8 @@ THREADLOCAL char cur_thread_placeholder[sizeof(ThreadState)] ALIGNED(
 #endif
 static char ctx_placeholder[sizeof(Context)] ALIGNED(SANITIZER_CACHE_LINE_SIZE);
 Context *ctx;
+atomic_uint32_t access_sampling_threshold;
+u32 access_sampling_seed;
 
 // Can be overriden by a front-end.
 #ifdef TSAN_EXTERNAL_HOOKS
@@ -675,6 +677,11 @@ void CheckUnwind() {
   PrintCurrentStackSlow(StackTrace::GetCurrentPc());
 }
 
+void SetAccessSamplingRate(int rate) {
+  u32 threshold = rate > 1 ? static_cast<u32>((1ull << 32) / rate) : 0;
+  atomic_store_relaxed(&access_sampling_threshold, threshold);
+}
+
 bool is_initialized;
 
 void Initialize(ThreadState *thr) {
@@ -694,6 +701,11 @@ void Initialize(ThreadState *thr) {
   CacheBinaryName();
   CheckASLR();
   InitializeFlags(&ctx->flags, options, env_name);
+  // Check different pages in different processes.
+  if (!GetRandom(&access_sampling_seed, sizeof(access_sampling_seed),
+                 /*blocking=*/false))
+    access_sampling_seed = static_cast<u32>(internal_getpid());
+  SetAccessSamplingRate(flags()->access_sampling_rate);
   AvoidCVE_2016_2143();
   __sanitizer::InitializePlatformEarly();
   __tsan::InitializePlatformEarly();
@@ -386,6 +386,23 @@ ALWAYS_INLINE Flags *flags() {
   return &ctx->flags;
 }
 
+// Access sampling (see access_sampling_rate flag): if the threshold is not 0,
+// the accesses to an application page are checked only if the hash of the page
+// is below it.
+constexpr uptr kAccessSamplingPageShift = 12;
+extern atomic_uint32_t access_sampling_threshold;
+extern u32 access_sampling_seed;
+
+void SetAccessSamplingRate(int rate);
+
+ALWAYS_INLINE bool AccessIsSampledOut(uptr addr) {
+  u32 threshold = atomic_load_relaxed(&access_sampling_threshold);
+  if (LIKELY(threshold == 0))
+    return false;
+  u64 page = (addr >> kAccessSamplingPageShift) ^ access_sampling_seed;
+  return static_cast<u32>((page * 0x9e3779b97f4a7c15ull) >> 32) >= threshold;
+}
+
 struct ScopedIgnoreInterceptors {
   ScopedIgnoreInterceptors() {
 #if !SANITIZER_GO
@@ -419,6 +419,8 @@ NOINLINE void TraceRestartMemoryAccess(ThreadState* thr, uptr pc, uptr addr,
 
 ALWAYS_INLINE USED void MemoryAccess(ThreadState* thr, uptr pc, uptr addr,
                                      uptr size, AccessType typ) {
+  if (UNLIKELY(AccessIsSampledOut(addr)))
+    return;
   RawShadow* shadow_mem = MemToShadow(addr);
   UNUSED char memBuf[4][64];
   DPrintf2("#%d: Access: %d@%d %p/%zd typ=0x%x {%s, %s, %s, %s}\n", thr->tid,
@@ -455,7 +457,7 @@ ALWAYS_INLINE USED void MemoryAccess16(ThreadState* thr, uptr pc, uptr addr,
                                        AccessType typ) {
   const uptr size = 16;
   FastState fast_state = thr->fast_state;
-  if (UNLIKELY(fast_state.GetIgnoreBit()))
+  if (UNLIKELY(fast_state.GetIgnoreBit()) || UNLIKELY(AccessIsSampledOut(addr)))
     return;
   Shadow cur(fast_state, 0, 8, typ);
   RawShadow* shadow_mem = MemToShadow(addr);
@@ -492,7 +494,7 @@ ALWAYS_INLINE USED void UnalignedMemoryAccess(ThreadState* thr, uptr pc,
                                               AccessType typ) {
   DCHECK_LE(size, 8);
   FastState fast_state = thr->fast_state;
-  if (UNLIKELY(fast_state.GetIgnoreBit()))
+  if (UNLIKELY(fast_state.GetIgnoreBit()) || UNLIKELY(AccessIsSampledOut(addr)))
     return;
   RawShadow* shadow_mem = MemToShadow(addr);
   bool traced = false;
@@ -666,6 +668,11 @@ template <bool is_read>
 void MemoryAccessRangeT(ThreadState* thr, uptr pc, uptr addr, uptr size) {
   const AccessType typ =
       (is_read ? kAccessRead : kAccessWrite) | kAccessNoRodata;
+  // Ranges spanning several pages are always checked.
+  if (UNLIKELY(AccessIsSampledOut(addr)) &&
+      (addr >> kAccessSamplingPageShift) ==
+          ((addr + size - 1) >> kAccessSamplingPageShift))
+    return;
   RawShadow* shadow_mem = MemToShadow(addr);
   DPrintf2("#%d: MemoryAccessRange: @%p %p size=%d is_read=%d\n", thr->tid,
            (void*)pc, (void*)addr, (int)size, is_read);
@@ -14,6 +14,7 @@
 #include "gtest/gtest.h"
 
 #include <atomic>
+#include <cstring>
 #include <future>
 #include <thread>
 #include <unistd.h>
@@ -120,6 +121,53 @@ TEST(BufferQueueTest, Apply) {
   ASSERT_EQ(Count, 10);
 }
 
+TEST(BufferQueueTest, DrainInReleaseOrder) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 3, Success);
+  ASSERT_TRUE(Success);
+  char Dest[kSize];
+  uint64_t Extents = 0;
+  EXPECT_FALSE(Buffers.drainBuffer(Dest, Extents));
+
+  BufferQueue::Buffer B0, B1;
+  ASSERT_EQ(Buffers.getBuffer(B0), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.getBuffer(B1), BufferQueue::ErrorCode::Ok);
+  std::memset(B0.Data, 'a', 16);
+  atomic_store(B0.Extents, 16, memory_order_release);
+  std::memset(B1.Data, 'b', 8);
+  atomic_store(B1.Extents, 8, memory_order_release);
+  ASSERT_EQ(Buffers.releaseBuffer(B1), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.releaseBuffer(B0), BufferQueue::ErrorCode::Ok);
+
+  ASSERT_TRUE(Buffers.drainBuffer(Dest, Extents));
+  EXPECT_EQ(Extents, 8u);
+  EXPECT_EQ(Dest[0], 'b');
+  ASSERT_TRUE(Buffers.drainBuffer(Dest, Extents));
+  EXPECT_EQ(Extents, 16u);
+  EXPECT_EQ(Dest[15], 'a');
+  EXPECT_FALSE(Buffers.drainBuffer(Dest, Extents));
+
+  // Drained buffers are still visible to 'apply' until they are reused.
+  auto Count = 0;
+  Buffers.apply([&](const BufferQueue::Buffer &) { ++Count; });
+  EXPECT_EQ(Count, 2);
+}
+
+TEST(BufferQueueTest, DrainSkipsReusedBuffers) {
+  bool Success = false;
+  BufferQueue Buffers(kSize, 1, Success);
+  ASSERT_TRUE(Success);
+  BufferQueue::Buffer B;
+  ASSERT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+  ASSERT_EQ(Buffers.getBuffer(B), BufferQueue::ErrorCode::Ok);
+  char Dest[kSize];
+  uint64_t Extents = 0;
+  EXPECT_FALSE(Buffers.drainBuffer(Dest, Extents));
+  ASSERT_EQ(Buffers.releaseBuffer(B), BufferQueue::ErrorCode::Ok);
+  EXPECT_TRUE(Buffers.drainBuffer(Dest, Extents));
+}
+
 TEST(BufferQueueTest, GenerationalSupport) {
   bool Success = false;
   BufferQueue Buffers(kSize, 10, Success);
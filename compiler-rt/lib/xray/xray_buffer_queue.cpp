@@ -132,6 +132,7 @@ BufferQueue::ErrorCode BufferQueue::init(size_t BS, size_t BC) {
     Buf.ExtentsBackingStore = ExtentsBackingStore;
     Buf.Count = BufferCount;
     T.Used = false;
+    T.Pending = false;
   }
 
   Next = Buffers;
@@ -171,6 +172,7 @@ BufferQueue::ErrorCode BufferQueue::getBuffer(Buffer &Buf) {
     if (Next == (Buffers + BufferCount))
       Next = Buffers;
     ++LiveBuffers;
+    B->Pending = false;
   }
 
   incRefCount(BackingStore);
@@ -202,11 +204,15 @@ BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
     B = First++;
     if (First == (Buffers + BufferCount))
       First = Buffers;
+
+    // Now that the buffer has been released, we mark it as "used". We do this
+    // while holding the lock so that 'drainBuffer' never sees a pending buffer
+    // that is only partially updated.
+    B->Buff = Buf;
+    B->Used = true;
+    B->Pending = true;
   }
 
-  // Now that the buffer has been released, we mark it as "used".
-  B->Buff = Buf;
-  B->Used = true;
   decRefCount(Buf.BackingStore, Buf.Size, Buf.Count);
   decRefCount(Buf.ExtentsBackingStore, kExtentsSize, Buf.Count);
   atomic_store(B->Buff.Extents, atomic_load(Buf.Extents, memory_order_acquire),
@@ -215,6 +221,29 @@ BufferQueue::ErrorCode BufferQueue::releaseBuffer(Buffer &Buf) {
   return ErrorCode::Ok;
 }
 
+bool BufferQueue::drainBuffer(void *Dest, uint64_t &Extents) {
+  SpinMutexLock Guard(&Mutex);
+  if (Buffers == nullptr)
+    return false;
+
+  // The slot that will receive the next released buffer holds the oldest one,
+  // so we scan from there to drain buffers in the order they were released.
+  // We copy while holding the lock, since handing the buffer out again would
+  // let a thread overwrite it.
+  size_t Start = First - Buffers;
+  for (size_t I = 0; I < BufferCount; ++I) {
+    auto &R = Buffers[(Start + I) % BufferCount];
+    if (!R.Pending)
+      continue;
+    R.Pending = false;
+    Extents = atomic_load(R.Buff.Extents, memory_order_acquire);
+    DCHECK_LE(Extents, R.Buff.Size);
+    internal_memcpy(Dest, R.Buff.Data, Extents);
+    return true;
+  }
+  return false;
+}
+
 BufferQueue::ErrorCode BufferQueue::finalize() {
   if (atomic_exchange(&Finalizing, 1, memory_order_acq_rel))
     return ErrorCode::QueueFinalizing;
@@ -71,6 +71,10 @@ public:
     // This is true if the buffer has been returned to the available queue, and
     // is considered "used" by another thread.
     bool Used = false;
+
+    // This is true from the time the buffer is released until it is either
+    // drained through 'drainBuffer' or handed out again.
+    bool Pending = false;
   };
 
 private:
@@ -249,6 +253,17 @@ public:
   /// fail with ErrorCode::QueueFinalizing.
   ErrorCode finalize();
 
+  /// Copies the contents of the oldest buffer that has been released but not
+  /// yet drained into |Dest|, which must hold at least ConfiguredBufferSize()
+  /// bytes, and stores its extents in |Extents|. This lets a consumer stream
+  /// buffers out while the queue is live; a released buffer that is handed out
+  /// again before it is drained is overwritten, as in flight-recorder mode.
+  ///
+  /// Returns:
+  ///   - true when a buffer was copied.
+  ///   - false when no released buffer is pending.
+  bool drainBuffer(void *Dest, uint64_t &Extents);
+
   /// Applies the provided function F to each Buffer in the queue, only if the
   /// Buffer is marked 'used' (i.e. has been the result of getBuffer(...) and a
   /// releaseBuffer(...) operation).
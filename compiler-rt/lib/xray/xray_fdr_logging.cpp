@@ -90,6 +90,13 @@ static atomic_uint64_t TicksPerSec{0};
 static atomic_sint32_t LogFlushStatus = {
     XRayLogFlushStatus::XRAY_LOG_NOT_FLUSHING};
 
+// State of the streaming thread, which is only running when the
+// 'stream_interval_ms' flag is positive. The writer and thread are only
+// touched by init and flush.
+static LogWriter *StreamWriter = nullptr;
+static void *StreamThread = nullptr;
+static atomic_uint8_t StreamStop{0};
+
 // This function will initialize the thread-local data structure used by the FDR
 // logging implementation and return a reference to it. The implementation
 // details require a bit of care to maintain.
@@ -277,6 +284,85 @@ XRayBuffer fdrIterator(const XRayBuffer B) {
   return Result;
 }
 
+// Starting at version 2 of the FDR logging implementation, we only write the
+// records identified by the extents of the buffer. We use the Extents from the
+// Buffer and write that out as the first record in the buffer.  We still use a
+// Metadata record, but fill in the extents instead for the data.
+static void writeBufferRecords(LogWriter *LW, const void *Data,
+                               uint64_t BufferExtents) XRAY_NEVER_INSTRUMENT {
+  if (BufferExtents == 0)
+    return;
+  MetadataRecord ExtentsRecord;
+  ExtentsRecord.Type = uint8_t(RecordType::Metadata);
+  ExtentsRecord.RecordKind =
+      uint8_t(MetadataRecord::RecordKinds::BufferExtents);
+  internal_memcpy(ExtentsRecord.Data, &BufferExtents, sizeof(BufferExtents));
+  LW->WriteAll(reinterpret_cast<char *>(&ExtentsRecord),
+               reinterpret_cast<char *>(&ExtentsRecord) +
+                   sizeof(MetadataRecord));
+  LW->WriteAll(reinterpret_cast<const char *>(Data),
+               reinterpret_cast<const char *>(Data) + BufferExtents);
+}
+
+// Writes out all the buffers released since the last drain. Since the file
+// only ever grows by whole buffers, a reader can consume it while it is being
+// written.
+static void drainReleasedBuffers(unsigned char *Scratch) XRAY_NEVER_INSTRUMENT {
+  uint64_t Extents = 0;
+  while (BQ->drainBuffer(Scratch, Extents))
+    writeBufferRecords(StreamWriter, Scratch, Extents);
+}
+
+static void *fdrStreamThread(void *) XRAY_NEVER_INSTRUMENT {
+  auto Size = BQ->ConfiguredBufferSize();
+  auto *Scratch = allocateBuffer(Size);
+  if (Scratch == nullptr) {
+    Report("XRay FDR: Failed to allocate the streaming buffer.\n");
+    return nullptr;
+  }
+  while (!atomic_load(&StreamStop, memory_order_acquire)) {
+    drainReleasedBuffers(Scratch);
+    SleepForMillis(fdrFlags()->stream_interval_ms);
+  }
+  deallocateBuffer(Scratch, Size);
+  return nullptr;
+}
+
+// Opens the log and writes the file header up front, then starts the thread
+// that keeps appending released buffers to it.
+static void startStreaming() XRAY_NEVER_INSTRUMENT {
+  StreamWriter = LogWriter::Open();
+  if (StreamWriter == nullptr) {
+    Report("XRay FDR: Failed to open the log for streaming.\n");
+    return;
+  }
+  XRayFileHeader Header = fdrCommonHeaderInfo();
+  Header.FdrData = FdrAdditionalHeaderData{BQ->ConfiguredBufferSize()};
+  StreamWriter->WriteAll(reinterpret_cast<char *>(&Header),
+                         reinterpret_cast<char *>(&Header) + sizeof(Header));
+  atomic_store(&StreamStop, 0, memory_order_release);
+  StreamThread = internal_start_thread(fdrStreamThread, nullptr);
+  if (Verbosity())
+    Report("XRay FDR: Streaming buffers every %d ms.\n",
+           fdrFlags()->stream_interval_ms);
+}
+
+// Stops the streaming thread and writes out whatever it has not drained yet.
+static void finishStreaming() XRAY_NEVER_INSTRUMENT {
+  atomic_store(&StreamStop, 1, memory_order_release);
+  internal_join_thread(StreamThread);
+  StreamThread = nullptr;
+
+  auto Size = BQ->ConfiguredBufferSize();
+  if (auto *Scratch = allocateBuffer(Size)) {
+    drainReleasedBuffers(Scratch);
+    deallocateBuffer(Scratch, Size);
+  }
+  StreamWriter->Flush();
+  LogWriter::Close(StreamWriter);
+  StreamWriter = nullptr;
+}
+
 // Must finalize before flushing.
 XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
   if (atomic_load(&LoggingStatus, memory_order_acquire) !=
@@ -321,6 +407,17 @@ XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
       TLD.Controller->flush();
   });
 
+  if (StreamThread != nullptr) {
+    // Release the current thread's buffer so that it is drained as well.
+    auto &TLD = getThreadLocalData();
+    if (TLD.Controller != nullptr)
+      TLD.Controller->flush();
+    finishStreaming();
+    atomic_store(&LogFlushStatus, XRayLogFlushStatus::XRAY_LOG_FLUSHED,
+                 memory_order_release);
+    return XRayLogFlushStatus::XRAY_LOG_FLUSHED;
+  }
+
   if (fdrFlags()->no_file_flush) {
     if (Verbosity())
       Report("XRay FDR: Not flushing to file, 'no_file_flush=true'.\n");
@@ -359,25 +456,9 @@ XRayLogFlushStatus fdrLoggingFlush() XRAY_NEVER_INSTRUMENT {
     TLD.Controller->flush();
 
   BQ->apply([&](const BufferQueue::Buffer &B) {
-    // Starting at version 2 of the FDR logging implementation, we only write
-    // the records identified by the extents of the buffer. We use the Extents
-    // from the Buffer and write that out as the first record in the buffer.  We
-    // still use a Metadata record, but fill in the extents instead for the
-    // data.
-    MetadataRecord ExtentsRecord;
     auto BufferExtents = atomic_load(B.Extents, memory_order_acquire);
     DCHECK(BufferExtents <= B.Size);
-    ExtentsRecord.Type = uint8_t(RecordType::Metadata);
-    ExtentsRecord.RecordKind =
-        uint8_t(MetadataRecord::RecordKinds::BufferExtents);
-    internal_memcpy(ExtentsRecord.Data, &BufferExtents, sizeof(BufferExtents));
-    if (BufferExtents > 0) {
-      LW->WriteAll(reinterpret_cast<char *>(&ExtentsRecord),
-                   reinterpret_cast<char *>(&ExtentsRecord) +
-                       sizeof(MetadataRecord));
-      LW->WriteAll(reinterpret_cast<char *>(B.Data),
-                   reinterpret_cast<char *>(B.Data) + BufferExtents);
-    }
+    writeBufferRecords(LW, B.Data, BufferExtents);
   });
 
   atomic_store(&LogFlushStatus, XRayLogFlushStatus::XRAY_LOG_FLUSHED,
@@ -718,6 +799,9 @@ XRayLogInitStatus fdrLoggingInit(size_t, size_t, void *Options,
   // Install the buffer iterator implementation.
   __xray_log_set_buffer_iterator(fdrIterator);
 
+  if (fdrFlags()->stream_interval_ms > 0 && !fdrFlags()->no_file_flush)
+    startStreaming();
+
   atomic_store(&LoggingStatus, XRayLogInitStatus::XRAY_LOG_INITIALIZED,
                memory_order_release);
 
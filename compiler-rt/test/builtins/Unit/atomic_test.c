@@ -21,6 +21,9 @@
 #include <string.h>
 #undef NDEBUG
 #include <assert.h>
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
 
 // We directly test the library atomic functions, not using the C builtins. This
 // should avoid confounding factors, ensuring that we actually test the
@@ -654,6 +657,13 @@ void test_is_lock_free(void) {
     assert(__atomic_is_lock_free_c(16, NULL) && "aligned size=16 should always be lock-free");
     assert(__atomic_is_lock_free_c(16, (void *)16) && "aligned size=16 should always be lock-free");
   }
+#if defined(__x86_64__) && defined(TEST_16)
+  // Without -mcx16, the library checks for cmpxchg16b at run time.
+  unsigned eax, ebx, ecx, edx;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_CMPXCHG16B)) {
+    assert(__atomic_is_lock_free_c(16, (void *)16) && "aligned size=16 should be lock-free with cmpxchg16b");
+  }
+#endif
   assert(!__atomic_is_lock_free_c(16, (void *)15) && "unaligned size=16 should not be lock-free");
   assert(!__atomic_is_lock_free_c(16, (void *)8) && "unaligned size=16 should not be lock-free");
   assert(!__atomic_is_lock_free_c(16, (void *)4) && "unaligned size=16 should not be lock-free");
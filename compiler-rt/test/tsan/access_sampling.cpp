@@ -0,0 +1,41 @@
+// RUN: %clangxx_tsan -O1 %s -o %t
+// RUN: %env_tsan_opts=access_sampling_rate=1000000000 %run %t 2>&1 | FileCheck %s --check-prefix=SAMPLED
+// RUN: %env_tsan_opts=access_sampling_rate=1000000000 %deflake %run %t full 2>&1 | FileCheck %s --check-prefix=FULL
+#include "test.h"
+
+extern "C" void __tsan_set_access_sampling_rate(int rate);
+
+int Global;
+
+void *Thread1(void *x) {
+  barrier_wait(&barrier);
+  Global++;
+  return NULL;
+}
+
+void *Thread2(void *x) {
+  Global--;
+  barrier_wait(&barrier);
+  return NULL;
+}
+
+int main(int argc, char **argv) {
+  // With a rate of 1 in 10^9 pages the page of Global is almost certainly not
+  // checked, unless all the accesses are checked again.
+  if (argc > 1)
+    __tsan_set_access_sampling_rate(1);
+  barrier_init(&barrier, 2);
+  pthread_t t[2];
+  pthread_create(&t[0], NULL, Thread1, NULL);
+  pthread_create(&t[1], NULL, Thread2, NULL);
+  pthread_join(t[0], NULL);
+  pthread_join(t[1], NULL);
+  fprintf(stderr, "DONE\n");
+  return 0;
+}
+
+// SAMPLED-NOT: WARNING: ThreadSanitizer: data race
+// SAMPLED: DONE
+
+// FULL: WARNING: ThreadSanitizer: data race
+// FULL: DONE
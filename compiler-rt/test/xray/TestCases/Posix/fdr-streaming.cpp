@@ -0,0 +1,42 @@
+// RUN: %clangxx_xray -g -std=c++11 %s -o %t
+// RUN: rm -f fdr-streaming-*
+// RUN: XRAY_OPTIONS="patch_premain=false xray_logfile_base=fdr-streaming-" \
+// RUN:   XRAY_FDR_OPTIONS="func_duration_threshold_us=0 stream_interval_ms=10" \
+// RUN:   %run %t 2>&1
+// RUN: %llvm_xray convert --output-format=yaml --symbolize --instr_map=%t \
+// RUN:   "`ls fdr-streaming-* | head -n1`" | FileCheck %s
+// RUN: rm fdr-streaming-*
+
+// UNSUPPORTED: target=arm{{.*}}
+
+#include "xray/xray_log_interface.h"
+#include <cassert>
+#include <thread>
+#include <unistd.h>
+
+[[clang::xray_always_instrument]] void __attribute__((noinline)) streamed() {}
+[[clang::xray_always_instrument]] void __attribute__((noinline)) flushed() {}
+
+int main(int argc, char *argv[]) {
+  auto status = __xray_log_init_mode("xray-fdr", "");
+  assert(status == XRayLogInitStatus::XRAY_LOG_INITIALIZED);
+
+  __xray_patch();
+  // The buffer of this thread is released when it exits, and is written out
+  // by the streaming thread well before the log is flushed.
+  std::thread([] { streamed(); }).join();
+  usleep(100000);
+  flushed();
+  __xray_unpatch();
+  assert(__xray_log_finalize() == XRAY_LOG_FINALIZED);
+  assert(__xray_log_flushLog() == XRAY_LOG_FLUSHED);
+  return 0;
+}
+
+// Each buffer is written out exactly once, in the order it was released.
+// CHECK: records:
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*streamed.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*streamed.*}}, {{.*}} kind: function-exit,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*flushed.*}}, {{.*}} kind: function-enter,
+// CHECK-NEXT: - { type: 0, func-id: {{[0-9]+}}, function: {{.*flushed.*}}, {{.*}} kind: function-exit,
+// CHECK-NOT: function:
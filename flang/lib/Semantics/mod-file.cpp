@@ -1221,16 +1221,22 @@ std::optional<ModuleCheckSumType> ExtractCheckSum(const std::string_view &str) {
   return std::nullopt;
 }
 
+// If \p requiredHash is present, a file whose header records a different
+// checksum is rejected without computing the checksum of its contents.
 static std::optional<ModuleCheckSumType> VerifyHeader(
-    llvm::ArrayRef<char> content) {
+    llvm::ArrayRef<char> content,
+    std::optional<ModuleCheckSumType> requiredHash = std::nullopt) {
   std::string_view sv{content.data(), content.size()};
   if (sv.substr(0, ModHeader::magicLen) != ModHeader::magic) {
     return std::nullopt;
   }
-  ModuleCheckSumType checkSum{ComputeCheckSum(sv.substr(ModHeader::len))};
   std::string_view expectSum{sv.substr(ModHeader::magicLen, ModHeader::sumLen)};
-  if (auto extracted{ExtractCheckSum(expectSum)};
-      extracted && *extracted == checkSum) {
+  auto extracted{ExtractCheckSum(expectSum)};
+  if (!extracted || (requiredHash && *extracted != *requiredHash)) {
+    return std::nullopt;
+  }
+  ModuleCheckSumType checkSum{ComputeCheckSum(sv.substr(ModHeader::len))};
+  if (*extracted == checkSum) {
     return checkSum;
   } else {
     return std::nullopt;
@@ -1366,7 +1372,7 @@ Scope *ModFileReader::Read(SourceName name, std::optional<bool> isIntrinsic,
         parser::LocateSourceFileAll(path, options.searchDirectories)) {
       if (const auto *srcFile{context_.allCookedSources().allSources().OpenPath(
               maybe, llvm::errs())}) {
-        if (auto checkSum{VerifyHeader(srcFile->content())};
+        if (auto checkSum{VerifyHeader(srcFile->content(), requiredHash)};
             checkSum && *checkSum == *requiredHash) {
           path = maybe;
           break;
@@ -42,6 +42,12 @@ static cl::opt<std::string>
     SizeDistributionName("size-distribution-name",
                          cl::desc("The name of the distribution to use"));
 
+static cl::opt<std::string> SizeDistributionFile(
+    "size-distribution-file",
+    cl::desc("A file holding the distribution to use, in the format of the "
+             "files in the distributions/ directory"),
+    cl::value_desc("filename"));
+
 static cl::opt<bool> SweepMode(
     "sweep-mode",
     cl::desc(
@@ -260,16 +266,36 @@ void main() {
                        Twine(" must be a power of two or zero"));
 
   const bool HasDistributionName = !SizeDistributionName.empty();
-  if (SweepMode && HasDistributionName)
+  const bool HasDistributionFile = !SizeDistributionFile.empty();
+  if (SweepMode + HasDistributionName + HasDistributionFile > 1)
     report_fatal_error("Select only one of `--" + Twine(SweepMode.ArgStr) +
-                       "` or `--" + Twine(SizeDistributionName.ArgStr) + "`");
+                       "`, `--" + Twine(SizeDistributionName.ArgStr) +
+                       "` or `--" + Twine(SizeDistributionFile.ArgStr) + "`");
 
+  // Owns the probabilities of a distribution read from SizeDistributionFile.
+  std::vector<double> FileProbabilities;
   std::unique_ptr<MemfunctionBenchmarkBase> Benchmark;
-  if (SweepMode)
+  if (SweepMode) {
     Benchmark.reset(new MemfunctionBenchmarkSweep());
-  else
+  } else if (HasDistributionFile) {
+    auto Buffer = MemoryBuffer::getFile(SizeDistributionFile);
+    if (!Buffer)
+      report_fatal_error(Twine("Could not open file: ")
+                             .concat(Buffer.getError().message())
+                             .concat(", ")
+                             .concat(SizeDistributionFile));
+    auto Probabilities = parseMemorySizeDistribution((*Buffer)->getBuffer());
+    if (!Probabilities)
+      report_fatal_error(Twine(SizeDistributionFile)
+                             .concat(": ")
+                             .concat(toString(Probabilities.takeError())));
+    FileProbabilities = std::move(*Probabilities);
+    Benchmark.reset(new MemfunctionBenchmarkDistribution(
+        {SizeDistributionFile, FileProbabilities}));
+  } else {
     Benchmark.reset(new MemfunctionBenchmarkDistribution(getDistributionOrDie(
         BenchmarkSetup::getDistributions(), SizeDistributionName)));
+  }
   writeStudy(Benchmark->run());
 }
 
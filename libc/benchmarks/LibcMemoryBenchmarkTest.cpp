@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "LibcMemoryBenchmark.h"
+#include "MemorySizeDistributions.h"
 #include "llvm/Support/Alignment.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -102,6 +103,24 @@ TEST(MismatchOffsetDistribution, MismatchAt2) {
   }
 }
 
+TEST(MemorySizeDistribution, Parse) {
+  auto Probabilities = parseMemorySizeDistribution("0,1");
+  ASSERT_TRUE(static_cast<bool>(Probabilities));
+  EXPECT_THAT(*Probabilities, ElementsAre(0, 1));
+
+  Probabilities = parseMemorySizeDistribution(" 0.25, 0.5,0.25,\n");
+  ASSERT_TRUE(static_cast<bool>(Probabilities));
+  EXPECT_THAT(*Probabilities, ElementsAre(0.25, 0.5, 0.25));
+}
+
+TEST(MemorySizeDistribution, ParseErrors) {
+  for (StringRef Content : {"", "0,0", "0,-1", "0,x"}) {
+    auto Probabilities = parseMemorySizeDistribution(Content);
+    EXPECT_FALSE(static_cast<bool>(Probabilities)) << Content;
+    consumeError(Probabilities.takeError());
+  }
+}
+
 } // namespace
 } // namespace libc_benchmarks
 } // namespace llvm
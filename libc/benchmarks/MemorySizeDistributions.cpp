@@ -1,5 +1,6 @@
 #include "MemorySizeDistributions.h"
 
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/raw_ostream.h"
 
@@ -200,5 +201,30 @@ getDistributionOrDie(ArrayRef<MemorySizeDistribution> Distributions,
   report_fatal_error(Stream.str());
 }
 
+Expected<std::vector<double>> parseMemorySizeDistribution(StringRef Content) {
+  SmallVector<StringRef, 0> Fields;
+  Content.trim().split(Fields, ',');
+  // Allow a trailing comma.
+  if (!Fields.empty() && Fields.back().trim().empty())
+    Fields.pop_back();
+  std::vector<double> Probabilities;
+  Probabilities.reserve(Fields.size());
+  bool HasNonZero = false;
+  for (StringRef Field : Fields) {
+    double Probability;
+    if (Field.trim().getAsDouble(Probability) || Probability < 0)
+      return createStringError(inconvertibleErrorCode(),
+                               "invalid probability '%s' for size %zu",
+                               Field.trim().str().c_str(),
+                               Probabilities.size());
+    HasNonZero |= Probability > 0;
+    Probabilities.push_back(Probability);
+  }
+  if (!HasNonZero)
+    return createStringError(inconvertibleErrorCode(),
+                             "size distribution has no non-zero probability");
+  return Probabilities;
+}
+
 } // namespace libc_benchmarks
 } // namespace llvm
@@ -18,6 +18,9 @@
 
 #include <llvm/ADT/ArrayRef.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/Support/Error.h>
+
+#include <vector>
 
 namespace llvm {
 namespace libc_benchmarks {
@@ -47,6 +50,12 @@ MemorySizeDistribution
 getDistributionOrDie(ArrayRef<MemorySizeDistribution> Distributions,
                      StringRef Name);
 
+/// Parses a size distribution in the format of the files in `distributions/`:
+/// comma separated probabilities indexed by size. This allows benchmarking
+/// against distributions that are not part of this repository, e.g. ones
+/// gathered from production traces.
+Expected<std::vector<double>> parseMemorySizeDistribution(StringRef Content);
+
 } // namespace libc_benchmarks
 } // namespace llvm
 
@@ -15,7 +15,9 @@
 
 namespace LIBC_NAMESPACE::internal {
 
-// A simple quicksort implementation using the Hoare partition scheme.
+// An introsort implementation: quicksort using the Hoare partition scheme with
+// a median-of-three pivot, insertion sort for small ranges and heapsort once
+// the recursion gets too deep.
 
 using Compare = int(const void *, const void *);
 using CompareWithState = int(const void *, const void *, void *);
@@ -62,6 +64,14 @@ class Array {
   size_t elem_size;
   Comparator compare;
 
+  template <typename T> static void swap_chunk(uint8_t *a, uint8_t *b) {
+    T temp_a, temp_b;
+    __builtin_memcpy(&temp_a, a, sizeof(T));
+    __builtin_memcpy(&temp_b, b, sizeof(T));
+    __builtin_memcpy(a, &temp_b, sizeof(T));
+    __builtin_memcpy(b, &temp_a, sizeof(T));
+  }
+
 public:
   Array(uint8_t *a, size_t s, size_t e, Comparator c)
       : array(a), array_size(s), elem_size(e), compare(c) {}
@@ -71,11 +81,17 @@ public:
   void swap(size_t i, size_t j) const {
     uint8_t *elem_i = get(i);
     uint8_t *elem_j = get(j);
-    for (size_t b = 0; b < elem_size; ++b) {
-      uint8_t temp = elem_i[b];
-      elem_i[b] = elem_j[b];
-      elem_j[b] = temp;
+    // Swap word sized chunks first, most elements are a multiple of 4 or 8
+    // bytes large.
+    size_t b = 0;
+    for (; b + sizeof(uint64_t) <= elem_size; b += sizeof(uint64_t))
+      swap_chunk<uint64_t>(elem_i + b, elem_j + b);
+    if (b + sizeof(uint32_t) <= elem_size) {
+      swap_chunk<uint32_t>(elem_i + b, elem_j + b);
+      b += sizeof(uint32_t);
     }
+    for (; b < elem_size; ++b)
+      swap_chunk<uint8_t>(elem_i + b, elem_j + b);
   }
 
   int elem_compare(size_t i, const uint8_t *other) const {
@@ -94,8 +110,58 @@ public:
   }
 };
 
+// Ranges up to this size are sorted with insertion sort.
+constexpr size_t INSERTION_SORT_THRESHOLD = 16;
+
+LIBC_INLINE void insertion_sort(const Array &array) {
+  for (size_t i = 1; i < array.size(); ++i)
+    for (size_t j = i; j > 0 && array.elem_compare(j - 1, array.get(j)) > 0;
+         --j)
+      array.swap(j - 1, j);
+}
+
+LIBC_INLINE void sift_down(const Array &array, size_t root, size_t end) {
+  while (true) {
+    size_t child = 2 * root + 1;
+    if (child >= end)
+      return;
+    if (child + 1 < end && array.elem_compare(child, array.get(child + 1)) < 0)
+      ++child;
+    if (array.elem_compare(root, array.get(child)) >= 0)
+      return;
+    array.swap(root, child);
+    root = child;
+  }
+}
+
+LIBC_INLINE void heap_sort(const Array &array) {
+  size_t end = array.size();
+  for (size_t start = end / 2; start-- > 0;)
+    sift_down(array, start, end);
+  while (end > 1) {
+    --end;
+    array.swap(0, end);
+    sift_down(array, 0, end);
+  }
+}
+
+// Orders the first, middle and last elements so that the middle one is their
+// median. This avoids the quadratic behavior of a fixed pivot on sorted input.
+LIBC_INLINE void median_of_three(const Array &array) {
+  const size_t last = array.size() - 1;
+  const size_t mid = array.size() / 2;
+  if (array.elem_compare(mid, array.get(0)) < 0)
+    array.swap(mid, 0);
+  if (array.elem_compare(last, array.get(mid)) < 0) {
+    array.swap(last, mid);
+    if (array.elem_compare(mid, array.get(0)) < 0)
+      array.swap(mid, 0);
+  }
+}
+
 static size_t partition(const Array &array) {
   const size_t array_size = array.size();
+  median_of_three(array);
   size_t pivot_index = array_size / 2;
   uint8_t *pivot = array.get(pivot_index);
   size_t i = 0;
@@ -134,17 +200,41 @@ static size_t partition(const Array &array) {
   }
 }
 
-LIBC_INLINE void quicksort(const Array &array) {
-  const size_t array_size = array.size();
-  if (array_size <= 1)
-    return;
-  size_t split_index = partition(array);
-  if (array_size <= 2) {
-    // The partition operation sorts the two element array.
-    return;
+LIBC_INLINE void introsort(const Array &array, size_t depth_limit) {
+  size_t begin = 0;
+  size_t size = array.size();
+  while (true) {
+    const Array range = array.make_array(begin, size);
+    if (size <= INSERTION_SORT_THRESHOLD) {
+      insertion_sort(range);
+      return;
+    }
+    if (depth_limit == 0) {
+      heap_sort(range);
+      return;
+    }
+    --depth_limit;
+    size_t split_index = partition(range);
+    // Recurse into the smaller part and loop on the larger one to keep the
+    // stack depth logarithmic.
+    if (split_index < size - split_index) {
+      introsort(range.make_array(0, split_index), depth_limit);
+      begin += split_index;
+      size -= split_index;
+    } else {
+      introsort(range.make_array(split_index, size - split_index),
+                depth_limit);
+      size = split_index;
+    }
   }
-  quicksort(array.make_array(0, split_index));
-  quicksort(array.make_array(split_index, array.size() - split_index));
+}
+
+LIBC_INLINE void quicksort(const Array &array) {
+  // Fall back to heapsort after 2 * log2(size) levels of partitioning.
+  size_t depth_limit = 0;
+  for (size_t n = array.size(); n > 1; n >>= 1)
+    depth_limit += 2;
+  introsort(array, depth_limit);
 }
 
 } // namespace LIBC_NAMESPACE::internal
@@ -263,3 +263,62 @@ TEST(LlvmLibcQSortTest, SingleElementArray) {
 
   ASSERT_LE(array[0], ELEM);
 }
+
+TEST(LlvmLibcQsortTest, LargeArrayPatterns) {
+  constexpr size_t ARRAY_SIZE = 1000;
+  int array[ARRAY_SIZE];
+
+  // Organ pipe, sawtooth and a pseudo random permutation with duplicates.
+  for (size_t i = 0; i < ARRAY_SIZE; ++i)
+    array[i] = int(i < ARRAY_SIZE / 2 ? i : ARRAY_SIZE - i);
+  LIBC_NAMESPACE::qsort(array, ARRAY_SIZE, sizeof(int), int_compare);
+  for (size_t i = 0; i < ARRAY_SIZE - 1; ++i)
+    ASSERT_LE(array[i], array[i + 1]);
+
+  for (size_t i = 0; i < ARRAY_SIZE; ++i)
+    array[i] = int(i % 17);
+  LIBC_NAMESPACE::qsort(array, ARRAY_SIZE, sizeof(int), int_compare);
+  for (size_t i = 0; i < ARRAY_SIZE - 1; ++i)
+    ASSERT_LE(array[i], array[i + 1]);
+
+  for (size_t i = 0; i < ARRAY_SIZE; ++i)
+    array[i] = int((i * 7919) % 601);
+  LIBC_NAMESPACE::qsort(array, ARRAY_SIZE, sizeof(int), int_compare);
+  for (size_t i = 0; i < ARRAY_SIZE - 1; ++i)
+    ASSERT_LE(array[i], array[i + 1]);
+}
+
+// Elements whose size is not a multiple of the word size are swapped in
+// several chunks.
+// Only char members, so that the element size is not rounded up to a multiple
+// of a wider alignment.
+struct OddSizedElem {
+  unsigned char key;
+  char payload[12];
+};
+static_assert(sizeof(OddSizedElem) == 13, "expected an odd element size");
+
+static int odd_sized_compare(const void *l, const void *r) {
+  int a = reinterpret_cast<const OddSizedElem *>(l)->key;
+  int b = reinterpret_cast<const OddSizedElem *>(r)->key;
+  return int_compare(&a, &b);
+}
+
+TEST(LlvmLibcQsortTest, OddSizedElements) {
+  constexpr size_t ARRAY_SIZE = 100;
+  OddSizedElem array[ARRAY_SIZE];
+  for (size_t i = 0; i < ARRAY_SIZE; ++i) {
+    array[i].key = static_cast<unsigned char>((i * 37) % ARRAY_SIZE);
+    for (size_t j = 0; j < sizeof(array[i].payload); ++j)
+      array[i].payload[j] = char(array[i].key + j);
+  }
+
+  LIBC_NAMESPACE::qsort(array, ARRAY_SIZE, sizeof(OddSizedElem),
+                        odd_sized_compare);
+
+  for (size_t i = 0; i < ARRAY_SIZE; ++i) {
+    ASSERT_EQ(int(array[i].key), int(i));
+    for (size_t j = 0; j < sizeof(array[i].payload); ++j)
+      ASSERT_EQ(array[i].payload[j], char(i + j));
+  }
+}
@@ -74,6 +74,9 @@ rpc_status_t rpc_server_shutdown(rpc_device_t rpc_device, rpc_free_ty dealloc,
 
 /// Queries the RPC clients at least once and performs server-side work if there
 /// are any active requests. Runs until all work on the server is completed.
+/// Ports are locked individually, so several host threads may call this for
+/// the same device to service requests in parallel. Callbacks must be
+/// registered before the threads start and must be safe to run concurrently.
 rpc_status_t rpc_handle_server(rpc_device_t rpc_device);
 
 /// Register a callback to handle an opcode from the RPC client. The associated
@@ -203,15 +203,25 @@ rpc_status_t handle_server_impl(
     }
 
     port->recv_n(strs, sizes, [&](uint64_t size) { return new char[size]; });
+    // Lanes usually write to the same stream, keep it locked across
+    // consecutive lanes instead of locking it once per lane. Only one stream
+    // is locked at a time so this cannot deadlock with other server threads.
+    FILE *locked = nullptr;
     port->send([&](rpc::Buffer *buffer, uint32_t id) {
-      flockfile(files[id]);
+      if (files[id] != locked) {
+        if (locked)
+          funlockfile(locked);
+        locked = files[id];
+        flockfile(locked);
+      }
       buffer->data[0] = fwrite_unlocked(strs[id], 1, sizes[id], files[id]);
       if (port->get_opcode() == RPC_WRITE_TO_STDOUT_NEWLINE &&
           buffer->data[0] == sizes[id])
         buffer->data[0] += fwrite_unlocked("\n", 1, 1, files[id]);
-      funlockfile(files[id]);
       delete[] reinterpret_cast<uint8_t *>(strs[id]);
     });
+    if (locked)
+      funlockfile(locked);
     break;
   }
   case RPC_READ_FROM_STREAM: {
@@ -12,6 +12,8 @@
 
 #include <__algorithm/iterator_operations.h>
 #include <__algorithm/min.h>
+#include <__algorithm/simd_utils.h>
+#include <__algorithm/unwrap_iter.h>
 #include <__bit/invert_if.h>
 #include <__bit/popcount.h>
 #include <__config>
@@ -19,6 +21,11 @@
 #include <__functional/invoke.h>
 #include <__fwd/bit_reference.h>
 #include <__iterator/iterator_traits.h>
+#include <__type_traits/is_constant_evaluated.h>
+#include <__type_traits/is_equality_comparable.h>
+#include <__type_traits/is_integral.h>
+#include <__type_traits/is_volatile.h>
+#include <__type_traits/remove_cv.h>
 
 #if !defined(_LIBCPP_HAS_NO_PRAGMA_SYSTEM_HEADER)
 #  pragma GCC system_header
@@ -40,6 +47,50 @@ __count(_Iter __first, _Sent __last, const _Tp& __value, _Proj& __proj) {
   return __r;
 }
 
+#if _LIBCPP_VECTORIZE_ALGORITHMS
+template <class _AlgPolicy,
+          class _Tp,
+          class _Up,
+          class _Proj,
+          __enable_if_t<__is_identity<_Proj>::value && __libcpp_is_trivially_equality_comparable<_Tp, _Up>::value &&
+                            is_integral<_Tp>::value && !is_volatile<_Tp>::value,
+                        int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 typename _IterOps<_AlgPolicy>::template __difference_type<_Tp*>
+__count(_Tp* __first, _Tp* __last, const _Up& __value, _Proj&) {
+  using __value_type              = __remove_cv_t<_Tp>;
+  constexpr size_t __unroll_count = 4;
+  constexpr size_t __vec_size     = __native_vector_size<__value_type>;
+  using __vec                     = __simd_vector<__value_type, __vec_size>;
+
+  typename _IterOps<_AlgPolicy>::template __difference_type<_Tp*> __r(0);
+  if (!__libcpp_is_constant_evaluated()) {
+    const __value_type __needle = __value;
+    while (static_cast<size_t>(__last - __first) >= __unroll_count * __vec_size) {
+      __vec __vecs[__unroll_count];
+
+      for (size_t __i = 0; __i != __unroll_count; ++__i)
+        __vecs[__i] = std::__load_vector<__vec>(__first + __i * __vec_size);
+
+      for (size_t __i = 0; __i != __unroll_count; ++__i)
+        __r += std::__count_set(__vecs[__i] == __needle);
+
+      __first += __unroll_count * __vec_size;
+    }
+
+    // count the remaining 0-3 vectors
+    while (static_cast<size_t>(__last - __first) >= __vec_size) {
+      __r += std::__count_set(std::__load_vector<__vec>(__first) == __needle);
+      __first += __vec_size;
+    }
+  }
+
+  for (; __first != __last; ++__first)
+    if (*__first == __value)
+      ++__r;
+  return __r;
+}
+#endif // _LIBCPP_VECTORIZE_ALGORITHMS
+
 // __bit_iterator implementation
 template <bool _ToCount, class _Cp, bool _IsConst>
 _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 typename __bit_iterator<_Cp, _IsConst>::difference_type
@@ -82,7 +133,7 @@ template <class _InputIterator, class _Tp>
 _LIBCPP_NODISCARD inline _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX20 __iter_diff_t<_InputIterator>
 count(_InputIterator __first, _InputIterator __last, const _Tp& __value) {
   __identity __proj;
-  return std::__count<_ClassicAlgPolicy>(__first, __last, __value, __proj);
+  return std::__count<_ClassicAlgPolicy>(std::__unwrap_iter(__first), std::__unwrap_iter(__last), __value, __proj);
 }
 
 _LIBCPP_END_NAMESPACE_STD
@@ -12,6 +12,7 @@
 
 #include <__algorithm/find_segment_if.h>
 #include <__algorithm/min.h>
+#include <__algorithm/simd_utils.h>
 #include <__algorithm/unwrap_iter.h>
 #include <__bit/countr.h>
 #include <__bit/invert_if.h>
@@ -21,9 +22,12 @@
 #include <__fwd/bit_reference.h>
 #include <__iterator/segmented_iterator.h>
 #include <__string/constexpr_c_functions.h>
+#include <__type_traits/is_constant_evaluated.h>
 #include <__type_traits/is_integral.h>
 #include <__type_traits/is_same.h>
 #include <__type_traits/is_signed.h>
+#include <__type_traits/is_volatile.h>
+#include <__type_traits/remove_cv.h>
 #include <__utility/move.h>
 #include <limits>
 
@@ -77,6 +81,71 @@ _LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Tp* __find(_Tp* __first, _T
 }
 #endif // _LIBCPP_HAS_NO_WIDE_CHARACTERS
 
+#if _LIBCPP_VECTORIZE_ALGORITHMS
+// Element types which are already forwarded to memchr or wmemchr above
+template <class _Tp>
+inline constexpr bool __find_uses_libc =
+    sizeof(_Tp) == 1
+#  ifndef _LIBCPP_HAS_NO_WIDE_CHARACTERS
+    || (sizeof(_Tp) == sizeof(wchar_t) && _LIBCPP_ALIGNOF(_Tp) >= _LIBCPP_ALIGNOF(wchar_t))
+#  endif
+    ;
+
+template <class _Tp,
+          class _Up,
+          class _Proj,
+          __enable_if_t<__is_identity<_Proj>::value && __libcpp_is_trivially_equality_comparable<_Tp, _Up>::value &&
+                            is_integral<_Tp>::value && !is_volatile<_Tp>::value && !__find_uses_libc<_Tp>,
+                        int> = 0>
+_LIBCPP_HIDE_FROM_ABI _LIBCPP_CONSTEXPR_SINCE_CXX14 _Tp* __find(_Tp* __first, _Tp* __last, const _Up& __value, _Proj&) {
+  using __value_type              = __remove_cv_t<_Tp>;
+  constexpr size_t __unroll_count = 4;
+  constexpr size_t __vec_size     = __native_vector_size<__value_type>;
+  using __vec                     = __simd_vector<__value_type, __vec_size>;
+
+  if (!__libcpp_is_constant_evaluated()) {
+    const __value_type __needle = __value;
+    auto __orig_first           = __first;
+    while (static_cast<size_t>(__last - __first) >= __unroll_count * __vec_size) [[__unlikely__]] {
+      __vec __vecs[__unroll_count];
+
+      for (size_t __i = 0; __i != __unroll_count; ++__i)
+        __vecs[__i] = std::__load_vector<__vec>(__first + __i * __vec_size);
+
+      for (size_t __i = 0; __i != __unroll_count; ++__i) {
+        if (auto __cmp_res = __vecs[__i] == __needle; !std::__none_of(__cmp_res))
+          return __first + __i * __vec_size + std::__find_first_set(__cmp_res);
+      }
+
+      __first += __unroll_count * __vec_size;
+    }
+
+    // check the remaining 0-3 vectors
+    while (static_cast<size_t>(__last - __first) >= __vec_size) {
+      if (auto __cmp_res = std::__load_vector<__vec>(__first) == __needle; !std::__none_of(__cmp_res))
+        return __first + std::__find_first_set(__cmp_res);
+      __first += __vec_size;
+    }
+
+    if (__last - __first == 0)
+      return __first;
+
+    // If there are already checked elements in front of the current pointer, load a vector at (last - vector_size)
+    // to check the remaining elements. The overlapping elements are known not to match.
+    if (static_cast<size_t>(__first - __orig_first) >= __vec_size) {
+      __first       = __last - __vec_size;
+      auto __offset = std::__find_first_set(std::__load_vector<__vec>(__first) == __needle);
+      return __first + __offset;
+    } // else loop over the elements individually
+  }
+
+  for (; __first != __last; ++__first)
+    if (*__first == __value)
+      break;
+  return __first;
+}
+#endif // _LIBCPP_VECTORIZE_ALGORITHMS
+
 // TODO: This should also be possible to get right with different signedness
 // cast integral types to allow vectorization
 template <class _Tp,
@@ -28,6 +28,7 @@
 #include <__format/formatter_char.h>
 #include <__format/formatter_floating_point.h>
 #include <__format/formatter_integer.h>
+#include <__format/formatter_output.h>
 #include <__format/formatter_pointer.h>
 #include <__format/formatter_string.h>
 #include <__format/parser_std_format_spec.h>
@@ -35,6 +36,7 @@
 #include <__iterator/concepts.h>
 #include <__iterator/incrementable_traits.h>
 #include <__iterator/iterator_traits.h> // iter_value_t
+#include <__type_traits/is_constant_evaluated.h>
 #include <__variant/monostate.h>
 #include <array>
 #include <string>
@@ -331,7 +333,18 @@ _LIBCPP_HIDE_FROM_ABI constexpr typename _Ctx::iterator __vformat_to(_ParseCtx&&
     }
 
     // Copy the character to the output verbatim.
-    *__out_it++ = *__begin++;
+    if (__libcpp_is_constant_evaluated()) {
+      *__out_it++ = *__begin++;
+      continue;
+    }
+
+    // Copy the character and the literal text up to the next replacement
+    // field or escape sequence in one operation. This uses the mass output
+    // function of the buffer instead of pushing the characters one at a time.
+    auto __first = __begin++;
+    while (__begin != __end && *__begin != _CharT('{') && *__begin != _CharT('}'))
+      ++__begin;
+    __out_it = __formatter::__copy(__first, __begin, std::move(__out_it));
   }
   return __out_it;
 }
@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <bit>
 #include <memory>
 #include <memory_resource>
 
@@ -209,11 +210,18 @@ class unsynchronized_pool_resource::__fixed_pool {
   __chunk_footer* __first_chunk_     = nullptr;
   __vacancy_header* __first_vacancy_ = nullptr;
 
+  // The part of the newest chunk that hasn't been handed out yet. Blocks are
+  // carved from it on demand so that a new chunk isn't touched all at once.
+  char* __untouched_begin_ = nullptr;
+  char* __untouched_end_   = nullptr;
+
 public:
   explicit __fixed_pool() = default;
 
   void __release_ptr(memory_resource* upstream) {
-    __first_vacancy_ = nullptr;
+    __first_vacancy_   = nullptr;
+    __untouched_begin_ = nullptr;
+    __untouched_end_   = nullptr;
     while (__first_chunk_ != nullptr) {
       __chunk_footer* next = __first_chunk_->__next_;
       upstream->deallocate(__first_chunk_->__start_, __first_chunk_->__allocation_size(), __first_chunk_->__align_);
@@ -221,12 +229,17 @@ public:
     }
   }
 
-  void* __try_allocate_from_vacancies() {
+  void* __try_allocate_from_vacancies(size_t block_size) {
     if (__first_vacancy_ != nullptr) {
       void* result     = __first_vacancy_;
       __first_vacancy_ = __first_vacancy_->__next_vacancy_;
       return result;
     }
+    if (__untouched_begin_ != __untouched_end_) {
+      void* result = __untouched_begin_;
+      __untouched_begin_ += block_size;
+      return result;
+    }
     return nullptr;
   }
 
@@ -249,15 +262,11 @@ public:
     h->__align_       = __default_alignment;
     __first_chunk_    = h;
 
-    if (chunk_size > block_size) {
-      __vacancy_header* last_vh = this->__first_vacancy_;
-      for (size_t i = block_size; i != chunk_size; i += block_size) {
-        __vacancy_header* vh = (__vacancy_header*)((char*)result + i);
-        vh->__next_vacancy_  = last_vh;
-        last_vh              = vh;
-      }
-      this->__first_vacancy_ = last_vh;
-    }
+    // This is only called once the vacancies and the rest of the previous
+    // chunk are used up, so the remaining blocks of the new chunk replace the
+    // untouched range.
+    __untouched_begin_ = (char*)result + block_size;
+    __untouched_end_   = (char*)result + chunk_size;
     return result;
   }
 
@@ -280,15 +289,10 @@ int unsynchronized_pool_resource::__pool_index(size_t bytes, size_t align) const
   if (align > alignof(std::max_align_t) || bytes > (size_t(1) << __num_fixed_pools_))
     return __num_fixed_pools_;
   else {
-    int i = 0;
     bytes = (bytes > align) ? bytes : align;
-    bytes -= 1;
-    bytes >>= __log2_smallest_block_size;
-    while (bytes != 0) {
-      bytes >>= 1;
-      i += 1;
-    }
-    return i;
+    // The index of the smallest pool whose blocks are at least bytes large.
+    int width = std::bit_width(bytes - 1);
+    return width > __log2_smallest_block_size ? width - __log2_smallest_block_size : 0;
   }
 }
 
@@ -360,7 +364,7 @@ void* unsynchronized_pool_resource::do_allocate(size_t bytes, size_t align) {
       for (__fixed_pool* pool = first; pool != last; ++pool)
         ::new ((void*)pool) __fixed_pool;
     }
-    void* result = __fixed_pools_[i].__try_allocate_from_vacancies();
+    void* result = __fixed_pools_[i].__try_allocate_from_vacancies(__pool_block_size(i));
     if (result == nullptr) {
       auto min = [](size_t a, size_t b) { return a < b ? a : b; };
       auto max = [](size_t a, size_t b) { return a < b ? b : a; };
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+// UNSUPPORTED: c++03
+
+// Make sure the vectorized implementations of std::find and std::count return the right results for all lengths and
+// for matches at every position, including the unrolled loop, the remaining vectors and the tail.
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "test_macros.h"
+
+template <class T>
+TEST_CONSTEXPR_CXX20 bool test_constexpr() {
+  T a[] = {1, 2, 3, 2, 1};
+  assert(std::find(a, a + 5, T(3)) == a + 2);
+  assert(std::find(a, a + 5, T(4)) == a + 5);
+  assert(std::count(a, a + 5, T(2)) == 2);
+  return true;
+}
+
+template <class T>
+void test() {
+  for (std::size_t size = 0; size != 300; ++size) {
+    std::vector<T> vec(size, T(1));
+    const T* first = vec.data();
+    const T* last  = first + size;
+
+    assert(std::find(first, last, T(2)) == last);
+    assert(std::count(first, last, T(2)) == 0);
+    assert(std::count(first, last, T(1)) == static_cast<std::ptrdiff_t>(size));
+
+    for (std::size_t i = 0; i != size; ++i) {
+      vec[i] = T(2);
+      assert(std::find(first, last, T(2)) == first + i);
+      assert(std::find(vec.begin(), vec.end(), T(2)) == vec.begin() + i);
+      assert(std::count(first, last, T(2)) == 1);
+      assert(std::count(vec.begin(), vec.end(), T(2)) == 1);
+      vec[i] = T(1);
+    }
+
+    for (std::size_t i = 0; i < size; i += 3)
+      vec[i] = T(2);
+    assert(std::count(first, last, T(2)) == static_cast<std::ptrdiff_t>((size + 2) / 3));
+    if (size != 0)
+      assert(std::find(first + 1, last, T(2)) == (size > 3 ? first + 3 : last));
+  }
+}
+
+int main(int, char**) {
+  test<std::int16_t>();
+  test<std::uint16_t>();
+  test<std::int32_t>();
+  test<std::int64_t>();
+  test<std::uint64_t>();
+  test<long long>();
+
+  test_constexpr<short>();
+  test_constexpr<long long>();
+#if TEST_STD_VER >= 20
+  static_assert(test_constexpr<short>());
+  static_assert(test_constexpr<long long>());
+#endif
+
+  return 0;
+}
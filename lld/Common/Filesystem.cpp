@@ -15,12 +15,14 @@
 #include "llvm/Config/llvm-config.h"
 #include "llvm/Support/FileOutputBuffer.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/TimeProfiler.h"
 #if LLVM_ON_UNIX
 #include <unistd.h>
 #endif
+#include <chrono>
 #include <thread>
 
 using namespace llvm;
@@ -110,6 +112,59 @@ void lld::unlinkAsync(StringRef path) {
 #endif
 }
 
+// Makes an existing file at path have the given contents by overwriting only
+// the blocks that differ. Returns false if path is not a regular file of the
+// same size or cannot be opened for writing, in which case the file is left
+// untouched and the caller should write a new file as usual.
+//
+// In a compile-link-debug cycle, most of a large output (debug info in
+// particular) is often identical to what the previous link produced.
+// Comparing against the old file is much cheaper than writing all of it back
+// and having the kernel flush it to disk again.
+//
+// Note that the file is modified in place: other hard links to it observe the
+// new contents, and a crash halfway through leaves a partially updated file.
+bool lld::patchFile(StringRef path, ArrayRef<uint8_t> contents) {
+  llvm::TimeTraceScope timeScope("Patch output file");
+  sys::fs::file_status stat;
+  if (sys::fs::status(path, stat) || !sys::fs::is_regular_file(stat) ||
+      stat.getSize() != contents.size() || contents.empty())
+    return false;
+
+  int fd;
+  if (sys::fs::openFileForReadWrite(path, fd, sys::fs::CD_OpenExisting,
+                                    sys::fs::OF_None))
+    return false;
+  std::error_code ec;
+  sys::fs::mapped_file_region map(sys::fs::convertFDToNativeFile(fd),
+                                  sys::fs::mapped_file_region::readwrite,
+                                  contents.size(), 0, ec);
+  if (ec) {
+    sys::fs::closeFile(fd);
+    return false;
+  }
+
+  // Only store to blocks that changed so that unchanged pages stay clean.
+  const size_t blockSize = 64 * 1024;
+  uint8_t *dst = reinterpret_cast<uint8_t *>(map.data());
+  parallelFor(0, divideCeil(contents.size(), blockSize), [&](size_t i) {
+    size_t begin = i * blockSize;
+    size_t size = std::min(blockSize, contents.size() - begin);
+    if (memcmp(dst + begin, contents.data() + begin, size))
+      memcpy(dst + begin, contents.data() + begin, size);
+  });
+
+  // Build systems decide whether to relink or rerun dependent steps by
+  // comparing timestamps. If no block differed, nothing was stored and the
+  // mtime would not advance, so always bump it as writing the file would.
+  ec = sys::fs::setLastAccessAndModificationTime(
+      fd, std::chrono::system_clock::now());
+  sys::fs::closeFile(fd);
+  if (ec)
+    warn("cannot update the timestamp of " + path + ": " + ec.message());
+  return true;
+}
+
 // Simulate file creation to see if Path is writable.
 //
 // Determining whether a file is writable or not is amazingly hard,
@@ -270,11 +270,13 @@ struct Config {
   bool optEL = false;
   bool optimizeBBJumps;
   bool optRemarksWithHotness;
+  bool patchOutputFile;
   bool picThunk;
   bool pie;
   bool printGcSections;
   bool printIcfSections;
   bool printMemoryUsage;
+  bool releaseOutputMemory;
   bool rejectMismatch;
   bool relax;
   bool relaxGP;
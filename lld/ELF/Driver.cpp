@@ -281,13 +281,29 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
     return;
   case file_magic::archive: {
     auto members = getArchiveMembers(mbref);
+
+    // Reading and validating the ELF headers, section tables and symbol tables
+    // of the members touches every member of the archive, which is slow if the
+    // archive is not in the page cache. The files are created serially to keep
+    // their order, and initialized in parallel.
+    SmallVector<ELFFileBase *, 0> objs;
+    auto addObjFile = [&](MemoryBufferRef mb, bool lazy) {
+      ELFFileBase *f = createObjFile(mb, path, lazy, /*init=*/false);
+      files.push_back(f);
+      objs.push_back(f);
+    };
+    auto initObjFiles = [&] {
+      parallelForEach(objs, [](ELFFileBase *f) { f->init(); });
+    };
+
     if (inWholeArchive) {
       for (const std::pair<MemoryBufferRef, uint64_t> &p : members) {
         if (isBitcode(p.first))
           files.push_back(make<BitcodeFile>(p.first, path, p.second, false));
         else if (!tryAddFatLTOFile(p.first, path, p.second, false))
-          files.push_back(createObjFile(p.first, path));
+          addObjFile(p.first, false);
       }
+      initObjFiles();
       return;
     }
 
@@ -311,13 +327,14 @@ void LinkerDriver::addFile(StringRef path, bool withLOption) {
       auto magic = identify_magic(p.first.getBuffer());
       if (magic == file_magic::elf_relocatable) {
         if (!tryAddFatLTOFile(p.first, path, p.second, true))
-          files.push_back(createObjFile(p.first, path, true));
+          addObjFile(p.first, true);
       } else if (magic == file_magic::bitcode)
         files.push_back(make<BitcodeFile>(p.first, path, p.second, true));
       else
         warn(path + ": archive member '" + p.first.getBufferIdentifier() +
              "' is neither ET_REL nor LLVM bitcode");
     }
+    initObjFiles();
     InputFile::isInGroup = saved;
     if (!saved)
       ++InputFile::nextGroupId;
@@ -931,17 +948,41 @@ static void readCallGraph(MemoryBufferRef mb) {
   };
 
   for (StringRef line : args::getLines(mb)) {
-    SmallVector<StringRef, 3> fields;
+    SmallVector<StringRef, 8> fields;
     line.split(fields, ' ');
+    StringRef fromName, toName;
     uint64_t count;
 
-    if (fields.size() != 3 || !to_integer(fields[2], count)) {
+    // Besides "<from> <to> <count>", accept the branch records of BOLT profiles
+    // in the .fdata format, as produced by perf2bolt from perf samples:
+    //
+    //   <is-sym> <from> <from-off> <is-sym> <to> <to-off> <mispreds> <count>
+    //
+    // A branch to the start of another function is used as a call edge.
+    // Returns and other branches into the middle of a function, branches
+    // within a function and endpoints without a symbol are ignored.
+    if (fields.size() == 1 && fields[0] == "boltedcollection")
+      continue;
+    if (fields.size() == 8) {
+      if (!to_integer(fields[7], count)) {
+        error(mb.getBufferIdentifier() + ": parse error");
+        return;
+      }
+      if (fields[0] != "1" || fields[3] != "1" || fields[1] == fields[4] ||
+          fields[5] != "0")
+        continue;
+      fromName = fields[1];
+      toName = fields[4];
+    } else if (fields.size() == 3 && to_integer(fields[2], count)) {
+      fromName = fields[0];
+      toName = fields[1];
+    } else {
       error(mb.getBufferIdentifier() + ": parse error");
       return;
     }
 
-    if (InputSectionBase *from = findSection(fields[0]))
-      if (InputSectionBase *to = findSection(fields[1]))
+    if (InputSectionBase *from = findSection(fromName))
+      if (InputSectionBase *to = findSection(toName))
         config->callGraphProfile[std::make_pair(from, to)] += count;
   }
 }
@@ -1345,6 +1386,8 @@ static void readConfigs(opt::InputArgList &args) {
   config->orphanHandling = getOrphanHandling(args);
   config->outputFile = args.getLastArgValue(OPT_o);
   config->packageMetadata = args.getLastArgValue(OPT_package_metadata);
+  config->patchOutputFile =
+      args.hasFlag(OPT_patch_output_file, OPT_no_patch_output_file, false);
   config->pie = args.hasFlag(OPT_pie, OPT_no_pie, false);
   config->printIcfSections =
       args.hasFlag(OPT_print_icf_sections, OPT_no_print_icf_sections, false);
@@ -1357,6 +1400,8 @@ static void readConfigs(opt::InputArgList &args) {
   config->rejectMismatch = !args.hasArg(OPT_no_warn_mismatch);
   config->relax = args.hasFlag(OPT_relax, OPT_no_relax, true);
   config->relaxGP = args.hasFlag(OPT_relax_gp, OPT_no_relax_gp, false);
+  config->releaseOutputMemory = args.hasFlag(
+      OPT_release_output_memory, OPT_no_release_output_memory, false);
   config->rpath = getRpath(args);
   config->relocatable = args.hasArg(OPT_relocatable);
 
@@ -33,8 +33,9 @@
 // terminates are considered identical. Here are details:
 //
 // 1. First, we partition sections using their hash values as keys. Hash
-//    values contain section types, section contents and numbers of
-//    relocations. During this step, relocation targets are not taken into
+//    values contain section contents and the offsets, types and addends of
+//    relocations, as well as targets that are not input sections. During
+//    this step, relocation targets in input sections are not taken into
 //    account. We just put sections that apparently differ into different
 //    equivalence classes.
 //
@@ -80,6 +81,7 @@
 #include "SymbolTable.h"
 #include "Symbols.h"
 #include "SyntheticSections.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/BinaryFormat/ELF.h"
 #include "llvm/Object/ELF.h"
 #include "llvm/Support/Parallel.h"
@@ -437,6 +439,32 @@ void ICF<ELFT>::forEachClass(llvm::function_ref<void(size_t, size_t)> fn) {
   ++cnt;
 }
 
+// Fold the parts of the relocations that constantEq() compares directly into
+// the initial hash of a section, so that sections which differ only in their
+// relocations (e.g. calls to different external functions) start out in
+// different classes instead of being split by pairwise comparisons in
+// segregate(). Sections that are constantEq() must get the same hash.
+template <class ELFT, class RelTy>
+static uint64_t hashRelocs(uint64_t hash, const InputSection *isec,
+                           ArrayRef<RelTy> rels) {
+  for (const RelTy &rel : rels) {
+    uint64_t addend = getAddend<ELFT>(rel);
+    Symbol &s = isec->file->getRelocTargetSym(rel);
+    auto *d = dyn_cast<Defined>(&s);
+    uint64_t target = 0;
+    if (!d || d->scriptDefined || d->isPreemptible)
+      // Only equal to a relocation referencing the same symbol. Such symbols
+      // are global, so use the name rather than the address to keep the
+      // hash deterministic.
+      target = hash_combine(s.getName(), addend);
+    else if (!d->section || isa<InputSection>(d->section))
+      target = d->value + addend;
+    hash = hash_combine(hash, rel.r_offset, rel.getType(config->isMips64EL),
+                        target);
+  }
+  return hash;
+}
+
 // Combine the hashes of the sections referenced by the given section into its
 // hash.
 template <class RelTy>
@@ -493,10 +521,17 @@ template <class ELFT> void ICF<ELFT>::run() {
     }
   }
 
-  // Initially, we use hash values to partition sections.
+  // Initially, we use hash values of the contents and the constant parts of
+  // the relocations to partition sections.
   parallelForEach(sections, [&](InputSection *s) {
+    uint64_t hash = xxh3_64bits(s->content());
+    const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+    if (rels.areRelocsRel())
+      hash = hashRelocs<ELFT>(hash, s, rels.rels);
+    else
+      hash = hashRelocs<ELFT>(hash, s, rels.relas);
     // Set MSB to 1 to avoid collisions with unique IDs.
-    s->eqClass[0] = xxh3_64bits(s->content()) | (1U << 31);
+    s->eqClass[0] = hash | (1U << 31);
   });
 
   // Perform 2 rounds of relocation hash propagation. 2 is an empirical value to
@@ -26,6 +26,7 @@
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/RISCVAttributeParser.h"
 #include "llvm/Support/TarWriter.h"
@@ -333,6 +334,14 @@ extern template void ObjFile<ELF64BE>::importCmseSymbols();
 template <class ELFT>
 static void doParseFiles(const std::vector<InputFile *> &files,
                          InputFile *armCmseImpLib) {
+  // Symbol resolution has to visit files serially because archive member
+  // extraction depends on the order. Hashing symbol names does not, so do that
+  // (and bring the string tables into memory) in parallel beforehand.
+  parallelForEach(files, [](InputFile *file) {
+    if (file->kind() == InputFile::ObjKind && file->ekind == config->ekind)
+      cast<ObjFile<ELFT>>(file)->computeNameHashes();
+  });
+
   // Add all files to the symbol table. This will add almost all symbols that we
   // need to the symbol table. This process might add files to the link due to
   // addDependentLibrary.
@@ -1111,9 +1120,14 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
   }
 
   // Some entries have been filled by LazyObjFile.
-  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i)
-    if (!symbols[i])
-      symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    if (symbols[i])
+      continue;
+    StringRef name = CHECK(eSyms[i].getName(stringTable), this);
+    symbols[i] = nameHashes ? symtab.insert(name, nameHashes[i - firstGlobal])
+                            : symtab.insert(name);
+  }
+  nameHashes.reset();
 
   // Perform symbol resolution on non-local symbols.
   SmallVector<unsigned, 32> undefineds;
@@ -1164,6 +1178,25 @@ void ObjFile<ELFT>::initializeSymbols(const object::ELFFile<ELFT> &obj) {
   }
 }
 
+// Precompute the symbol table hashes of global symbol names. This may run in
+// parallel with other files, so it must not touch the symbol table. If a name
+// is malformed, leave nameHashes empty and let the serial path report it.
+template <class ELFT> void ObjFile<ELFT>::computeNameHashes() {
+  ArrayRef<Elf_Sym> eSyms = this->getELFSyms<ELFT>();
+  if (eSyms.size() <= firstGlobal)
+    return;
+  auto hashes = std::make_unique<uint32_t[]>(eSyms.size() - firstGlobal);
+  for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
+    Expected<StringRef> name = eSyms[i].getName(stringTable);
+    if (!name) {
+      consumeError(name.takeError());
+      return;
+    }
+    hashes[i - firstGlobal] = SymbolTable::hashName(*name);
+  }
+  nameHashes = std::move(hashes);
+}
+
 template <class ELFT>
 void ObjFile<ELFT>::initSectionsAndLocalSyms(bool ignoreComdats) {
   if (!justSymbols)
@@ -1837,7 +1870,7 @@ InputFile *elf::createInternalFile(StringRef name) {
 }
 
 ELFFileBase *elf::createObjFile(MemoryBufferRef mb, StringRef archiveName,
-                                bool lazy) {
+                                bool lazy, bool init) {
   ELFFileBase *f;
   switch (getELFKind(mb, archiveName)) {
   case ELF32LEKind:
@@ -1855,7 +1888,8 @@ ELFFileBase *elf::createObjFile(MemoryBufferRef mb, StringRef archiveName,
   default:
     llvm_unreachable("getELFKind");
   }
-  f->init();
+  if (init)
+    f->init();
   f->lazy = lazy;
   return f;
 }
@@ -1871,7 +1905,9 @@ template <class ELFT> void ObjFile<ELFT>::parseLazy() {
   for (size_t i = firstGlobal, end = eSyms.size(); i != end; ++i) {
     if (eSyms[i].st_shndx == SHN_UNDEF)
       continue;
-    symbols[i] = symtab.insert(CHECK(eSyms[i].getName(stringTable), this));
+    StringRef name = CHECK(eSyms[i].getName(stringTable), this);
+    symbols[i] = nameHashes ? symtab.insert(name, nameHashes[i - firstGlobal])
+                            : symtab.insert(name);
     symbols[i]->resolve(LazySymbol{*this});
     if (!lazy)
       break;
@@ -292,6 +292,7 @@ public:
   void initSectionsAndLocalSyms(bool ignoreComdats);
   void postParse();
   void importCmseSymbols();
+  void computeNameHashes();
 
 private:
   void initializeSections(bool ignoreComdats,
@@ -320,6 +321,11 @@ private:
   // If the section does not exist (which is common), the array is empty.
   ArrayRef<Elf_Word> shndxTable;
 
+  // SymbolTable::hashName() values of global symbol names, indexed from
+  // firstGlobal. They are computed in parallel by computeNameHashes() so that
+  // the serial symbol resolution does not have to hash. Null if not computed.
+  std::unique_ptr<uint32_t[]> nameHashes;
+
   // Debugging information to retrieve source file and line for error
   // reporting. Linker may find reasonable number of errors in a
   // single object file, so we cache debugging information in order to
@@ -383,8 +389,10 @@ public:
 };
 
 InputFile *createInternalFile(StringRef name);
+// Creates an object file. If init is false, the caller must call init() on the
+// returned file before it is parsed, which is safe to do in parallel.
 ELFFileBase *createObjFile(MemoryBufferRef mb, StringRef archiveName = "",
-                           bool lazy = false);
+                           bool lazy = false, bool init = true);
 
 std::string replaceThinLTOSuffix(StringRef path);
 
@@ -1606,6 +1606,20 @@ template <class ELFT> void elf::scanRelocations() {
   // for parallelism.
   bool serial = !config->zCombreloc || config->emachine == EM_MIPS ||
                 config->emachine == EM_PPC64;
+
+  // .eh_frame and .ARM.exidx normally have one input section per object file
+  // and are as numerous as the files themselves. Collect them so that they
+  // can be scanned in chunks instead of on a single thread.
+  SmallVector<InputSectionBase *, 0> unwindSections;
+  for (Partition &part : partitions) {
+    for (EhInputSection *sec : part.ehFrame->sections)
+      unwindSections.push_back(sec);
+    if (part.armExidx && part.armExidx->isLive())
+      for (InputSection *sec : part.armExidx->exidxSections)
+        if (sec->isLive())
+          unwindSections.push_back(sec);
+  }
+
   parallel::TaskGroup tg;
   for (ELFFileBase *f : ctx.objectFiles) {
     auto fn = [f]() {
@@ -1620,17 +1634,17 @@ template <class ELFT> void elf::scanRelocations() {
     tg.spawn(fn, serial);
   }
 
-  tg.spawn([] {
-    RelocationScanner scanner;
-    for (Partition &part : partitions) {
-      for (EhInputSection *sec : part.ehFrame->sections)
+  // Keep a single task in serial mode to retain the previous scanning order.
+  const size_t chunkSize = serial ? unwindSections.size() : 64;
+  for (size_t i = 0, e = unwindSections.size(); i < e; i += chunkSize) {
+    ArrayRef<InputSectionBase *> chunk =
+        ArrayRef(unwindSections).slice(i, std::min(chunkSize, e - i));
+    tg.spawn([chunk] {
+      RelocationScanner scanner;
+      for (InputSectionBase *sec : chunk)
         scanner.template scanSection<ELFT>(*sec);
-      if (part.armExidx && part.armExidx->isLive())
-        for (InputSection *sec : part.armExidx->exidxSections)
-          if (sec->isLive())
-            scanner.template scanSection<ELFT>(*sec);
-    }
-  });
+    });
+  }
 }
 
 static bool handleNonPreemptibleIfunc(Symbol &sym, uint16_t flags) {
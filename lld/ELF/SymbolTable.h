@@ -43,6 +43,13 @@ public:
   void wrap(Symbol *sym, Symbol *real, Symbol *wrap);
 
   Symbol *insert(StringRef name);
+  // Same as insert(StringRef), but takes a hash computed by hashName() in
+  // advance, possibly on another thread.
+  Symbol *insert(StringRef name, uint32_t hash);
+
+  // Returns the hash insert() uses to look up a symbol name. A versioned name
+  // <name>@@<version> hashes the same as <name>.
+  static uint32_t hashName(StringRef name);
 
   template <typename T> Symbol *addSymbol(const T &newSym) {
     Symbol *sym = insert(newSym.getName());
@@ -74,6 +74,7 @@ private:
   void checkSections();
   void fixSectionAlignments();
   void openFile();
+  void commitOutputFile();
   void writeTrapInstr();
   void writeHeader();
   void writeSections();
@@ -369,9 +370,7 @@ template <class ELFT> void Writer<ELFT>::run() {
     if (errorCount())
       return;
 
-    if (auto e = buffer->commit())
-      fatal("failed to write output '" + buffer->getPath() +
-            "': " + toString(std::move(e)));
+    commitOutputFile();
 
     if (!config->cmseOutputLib.empty())
       writeARMCmseImportLib<ELFT>();
@@ -2669,11 +2668,14 @@ template <class ELFT> void Writer<ELFT>::openFile() {
     return;
   }
 
-  unlinkAsync(config->outputFile);
+  // With --patch-output-file, the existing file may be reused. The contents
+  // are composed in memory and compared against it in commitOutputFile().
+  if (!config->patchOutputFile)
+    unlinkAsync(config->outputFile);
   unsigned flags = 0;
   if (!config->relocatable)
     flags |= FileOutputBuffer::F_executable;
-  if (!config->mmapOutputFile)
+  if (!config->mmapOutputFile || config->patchOutputFile)
     flags |= FileOutputBuffer::F_no_mmap;
   Expected<std::unique_ptr<FileOutputBuffer>> bufferOrErr =
       FileOutputBuffer::create(config->outputFile, fileSize, flags);
@@ -2687,6 +2689,23 @@ template <class ELFT> void Writer<ELFT>::openFile() {
   Out::bufferStart = buffer->getBufferStart();
 }
 
+template <class ELFT> void Writer<ELFT>::commitOutputFile() {
+  if (config->patchOutputFile) {
+    if (patchFile(config->outputFile,
+                  ArrayRef(buffer->getBufferStart(), buffer->getBufferSize()))) {
+      buffer->discard();
+      return;
+    }
+    // The file could not be updated in place (e.g. its size changed or it is
+    // a running executable). Replace it as we would have without the option.
+    unlinkAsync(config->outputFile);
+  }
+
+  if (auto e = buffer->commit())
+    fatal("failed to write output '" + buffer->getPath() +
+          "': " + toString(std::move(e)));
+}
+
 template <class ELFT> void Writer<ELFT>::writeSectionsBinary() {
   parallel::TaskGroup tg;
   for (OutputSection *sec : outputSections)
@@ -2743,12 +2762,28 @@ template <class ELFT> void Writer<ELFT>::writeSections() {
       if (isStaticRelSecType(sec->type))
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
   }
+  // With --release-output-memory, non-SHF_ALLOC sections (typically .debug_*)
+  // are written one at a time after the others and released right away, so
+  // that the peak RSS tracks the largest of them rather than the output size.
+  auto isReleased = [](OutputSection *sec) {
+    return config->releaseOutputMemory && !(sec->flags & SHF_ALLOC) &&
+           sec->type != SHT_NOBITS && !isStaticRelSecType(sec->type);
+  };
   {
     parallel::TaskGroup tg;
     for (OutputSection *sec : outputSections)
-      if (!isStaticRelSecType(sec->type))
+      if (!isStaticRelSecType(sec->type) && !isReleased(sec))
         sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
   }
+  for (OutputSection *sec : outputSections) {
+    if (!isReleased(sec))
+      continue;
+    {
+      parallel::TaskGroup tg;
+      sec->writeTo<ELFT>(Out::bufferStart + sec->offset, tg);
+    }
+    buffer->releaseRange(sec->offset, sec->size);
+  }
 
   // Finally, check that all dynamic relocation addends were written correctly.
   if (config->checkDynamicRelocs && config->writeAddends) {
@@ -1234,6 +1234,23 @@ static void createFiles(const InputArgList &args) {
   }
 }
 
+// Splitting cstring sections into pieces requires hashing every string when
+// literals are deduplicated, which is expensive enough for large links that it
+// is worth doing in parallel once all input files (including LTO objects) have
+// been loaded. Nothing looks at the pieces before the input sections are
+// gathered.
+static void splitCStringSections() {
+  TimeTraceScope timeScope("Split cstring sections");
+  std::vector<CStringInputSection *> cStringSections;
+  for (const InputFile *file : inputFiles)
+    for (const Section *section : file->sections)
+      for (const Subsection &subsection : section->subsections)
+        if (auto *isec = dyn_cast<CStringInputSection>(subsection.isec))
+          cStringSections.push_back(isec);
+  parallelForEach(cStringSections,
+                  [](CStringInputSection *isec) { isec->splitIntoPieces(); });
+}
+
 static void gatherInputSections() {
   TimeTraceScope timeScope("Gathering input sections");
   for (const InputFile *file : inputFiles) {
@@ -1958,6 +1975,7 @@ bool link(ArrayRef<const char *> argsArr, llvm::raw_ostream &stdoutOS,
       inputFiles.insert(make<OpaqueFile>(MemoryBufferRef(), segName, sectName));
     }
 
+    splitCStringSections();
     gatherInputSections();
     if (config->callGraphProfileSort)
       priorityBuilder.extractCallGraphProfile();
@@ -380,8 +380,8 @@ void ObjFile::parseSections(ArrayRef<SectionHeader> sectionHeaders) {
           name == section_names::objcMethname || config->dedupStrings;
       InputSection *isec =
           make<CStringInputSection>(section, data, align, dedupLiterals);
-      // FIXME: parallelize this?
-      cast<CStringInputSection>(isec)->splitIntoPieces();
+      // The section is split into pieces later, in parallel with all other
+      // cstring sections; see splitCStringSections() in Driver.cpp.
       section.subsections.push_back({0, isec});
     } else if (isWordLiteralSection(sec.flags)) {
       if (sec.nreloc)
@@ -16,6 +16,7 @@
 
 namespace lld {
 void unlinkAsync(StringRef path);
+bool patchFile(StringRef path, ArrayRef<uint8_t> contents);
 std::error_code tryCreateFile(StringRef path);
 std::unique_ptr<llvm::raw_fd_ostream> openFile(StringRef file);
 std::unique_ptr<llvm::raw_fd_ostream> openLTOOutputFile(StringRef file);
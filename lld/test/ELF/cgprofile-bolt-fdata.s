@@ -0,0 +1,63 @@
+# REQUIRES: x86
+## Test that --call-graph-ordering-file accepts BOLT .fdata branch records and
+## uses only calls, i.e. branches to the start of another function, as call
+## graph edges.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+
+## The .fdata profile must produce the same layout as the text call graph that
+## contains only its calls.
+# RUN: ld.lld -e A a.o --call-graph-ordering-file=profile.fdata \
+# RUN:   --print-symbol-order=fdata.order -o fdata.out
+# RUN: ld.lld -e A a.o --call-graph-ordering-file=calls.txt \
+# RUN:   --print-symbol-order=txt.order -o txt.out
+# RUN: diff fdata.order txt.order
+# RUN: cmp fdata.out txt.out
+
+# RUN: not ld.lld -e A a.o --call-graph-ordering-file=bad.fdata -o /dev/null \
+# RUN:   2>&1 | FileCheck %s --check-prefix=ERR
+# ERR: error: bad.fdata: parse error
+
+#--- a.s
+.section .text.A,"ax",@progbits
+.globl A
+A:
+  call B
+  call D
+  ret
+
+.section .text.B,"ax",@progbits
+.globl B
+B:
+  call C
+  ret
+
+.section .text.C,"ax",@progbits
+.globl C
+C:
+  ret
+
+.section .text.D,"ax",@progbits
+.globl D
+D:
+  ret
+
+#--- profile.fdata
+boltedcollection
+1 A 0 1 B 0 0 100
+1 A 5 1 D 0 1 20
+1 B 0 1 C 0 0 50
+1 B 5 1 A 5 0 1000
+1 C 0 1 A a 0 900
+1 D 0 1 B 2 0 800
+1 A 3 1 A 0 0 70
+0 [unknown] 0 1 C 0 0 60
+
+#--- calls.txt
+A B 100
+A D 20
+B C 50
+
+#--- bad.fdata
+1 A 0 1 B 0 0 many
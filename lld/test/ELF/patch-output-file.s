@@ -0,0 +1,55 @@
+# REQUIRES: x86
+## Test that --patch-output-file updates an existing output of the same size in
+## place, produces the same bytes as a regular link, and still advances the
+## output's modification time when no block differs.
+
+# RUN: rm -rf %t && split-file %s %t && cd %t
+# RUN: llvm-mc -filetype=obj -triple=x86_64 a.s -o a.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 b.s -o b.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 c.s -o c.o
+# RUN: ld.lld a.o -o ref.a
+# RUN: ld.lld b.o -o ref.b
+# RUN: ld.lld c.o -o ref.c
+
+## Identical contents: the file is kept, but its mtime must still move forward.
+# RUN: cp ref.a out && ln out out.link
+# RUN: touch -t 200001010000 out
+# RUN: ld.lld a.o -o out --patch-output-file
+# RUN: cmp ref.a out
+# RUN: %python -c "import os, sys; sys.exit(os.path.getmtime('out') < 1e9)"
+
+## Same size, different contents: only the output is rewritten in place, which
+## other hard links to it observe.
+# RUN: ld.lld b.o -o out --patch-output-file
+# RUN: cmp ref.b out
+# RUN: cmp ref.b out.link
+
+## Different size: the output is replaced, so the hard link keeps the old file.
+# RUN: ld.lld c.o -o out --patch-output-file
+# RUN: cmp ref.c out
+# RUN: cmp ref.b out.link
+
+## --no-patch-output-file replaces the file as usual.
+# RUN: rm -f out out.link && cp ref.b out && ln out out.link
+# RUN: ld.lld a.o -o out --patch-output-file --no-patch-output-file
+# RUN: cmp ref.a out
+# RUN: cmp ref.b out.link
+
+#--- a.s
+.globl _start
+_start:
+  movl $1, %eax
+  ret
+
+#--- b.s
+.globl _start
+_start:
+  movl $2, %eax
+  ret
+
+#--- c.s
+.globl _start
+_start:
+  movl $3, %eax
+  .space 4096
+  ret
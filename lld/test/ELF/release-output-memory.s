@@ -0,0 +1,39 @@
+# REQUIRES: x86
+## --release-output-memory writes non-SHF_ALLOC sections separately and drops
+## their pages from memory. Test that the output is byte-for-byte identical to
+## a regular link, including with --build-id, which reads the file back, and
+## for -r links, whose relocation sections for .debug_* are written first.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 %s -o %t.o
+
+# RUN: ld.lld %t.o -o %t.ref
+# RUN: ld.lld %t.o -o %t --release-output-memory
+# RUN: cmp %t.ref %t
+# RUN: ld.lld %t.o -o %t --release-output-memory --no-release-output-memory
+# RUN: cmp %t.ref %t
+
+# RUN: ld.lld %t.o -o %t.ref --build-id
+# RUN: ld.lld %t.o -o %t --build-id --release-output-memory
+# RUN: cmp %t.ref %t
+
+# RUN: ld.lld -r %t.o -o %t.ref
+# RUN: ld.lld -r %t.o -o %t --release-output-memory
+# RUN: cmp %t.ref %t
+# RUN: llvm-readelf -S %t | FileCheck %s
+
+# CHECK-DAG: .debug_info
+# CHECK-DAG: .rela.debug_info
+# CHECK-DAG: .debug_str
+
+.globl _start
+_start:
+  ret
+
+## Larger than a page, so that whole pages are released.
+.section .debug_info,"",@progbits
+  .quad _start
+  .fill 12288, 1, 0xab
+  .quad _start
+
+.section .debug_str,"MS",@progbits,1
+  .asciz "release"
@@ -10,6 +10,7 @@
 #define LLDB_BREAKPOINT_WATCHPOINT_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "lldb/Breakpoint/StoppointSite.h"
@@ -180,6 +181,27 @@ public:
   //     condition has been set.
   const char *GetConditionText() const;
 
+  /// Evaluate the condition expression in \a exe_ctx. The parsed expression
+  /// is kept and reused on later hits in the same context, so a watchpoint
+  /// with a condition that is hit in a loop is only parsed and JIT compiled
+  /// once.
+  ///
+  /// \param[in] exe_ctx
+  ///     The execution context of the watchpoint hit.
+  ///
+  /// \param[out] result_value_sp
+  ///     The value of the condition, if it could be evaluated.
+  ///
+  /// \param[out] error
+  ///     A description of the failure if the condition could not be parsed or
+  ///     evaluated.
+  ///
+  /// \return
+  ///     The result of executing the condition expression.
+  lldb::ExpressionResults EvaluateCondition(ExecutionContext &exe_ctx,
+                                            lldb::ValueObjectSP &result_value_sp,
+                                            Status &error);
+
   void TurnOnEphemeralMode();
 
   void TurnOffEphemeralMode();
@@ -227,6 +249,9 @@ private:
   WatchpointOptions m_options; // Settable watchpoint options, which is a
                                // delegate to handle the callback machinery.
   std::unique_ptr<UserExpression> m_condition_up; // The condition to test.
+  lldb::UserExpressionSP m_condition_expression_sp; // The parsed condition.
+  std::mutex m_condition_mutex; // Guards parsing and evaluation of the
+                                // condition.
 
   void SetID(lldb::watch_id_t id) { m_id = id; }
 
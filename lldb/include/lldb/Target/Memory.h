@@ -43,6 +43,10 @@ public:
   void AddL1CacheData(lldb::addr_t addr,
                       const lldb::DataBufferSP &data_buffer_sp);
 
+  /// The maximum number of L2 cache lines, including the requested one, that
+  /// are read at once when memory is being read sequentially.
+  static constexpr uint32_t g_L2_read_ahead_lines = 8;
+
 protected:
   typedef std::map<lldb::addr_t, lldb::DataBufferSP> BlockMap;
   typedef RangeVector<lldb::addr_t, lldb::addr_t, 4> InvalidRanges;
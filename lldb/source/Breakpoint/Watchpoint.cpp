@@ -14,6 +14,8 @@
 #include "lldb/Core/ValueObject.h"
 #include "lldb/Core/ValueObjectMemory.h"
 #include "lldb/DataFormatters/DumpValueObjectOptions.h"
+#include "lldb/Expression/DiagnosticManager.h"
+#include "lldb/Expression/ExpressionVariable.h"
 #include "lldb/Expression/UserExpression.h"
 #include "lldb/Symbol/TypeSystem.h"
 #include "lldb/Target/Process.h"
@@ -453,6 +455,10 @@ bool Watchpoint::InvokeCallback(StoppointCallbackContext *context) {
 }
 
 void Watchpoint::SetCondition(const char *condition) {
+  {
+    std::lock_guard<std::mutex> guard(m_condition_mutex);
+    m_condition_expression_sp.reset();
+  }
   if (condition == nullptr || condition[0] == '\0') {
     if (m_condition_up)
       m_condition_up.reset();
@@ -477,6 +483,65 @@ const char *Watchpoint::GetConditionText() const {
     return nullptr;
 }
 
+ExpressionResults Watchpoint::EvaluateCondition(ExecutionContext &exe_ctx,
+                                                ValueObjectSP &result_value_sp,
+                                                Status &error) {
+  std::lock_guard<std::mutex> guard(m_condition_mutex);
+
+  const char *condition_text = GetConditionText();
+  if (!condition_text) {
+    error.SetErrorString("watchpoint has no condition");
+    return eExpressionSetupError;
+  }
+
+  error.Clear();
+  DiagnosticManager diagnostics;
+
+  if (!m_condition_expression_sp ||
+      !m_condition_expression_sp->IsParseCacheable() ||
+      !m_condition_expression_sp->MatchesContext(exe_ctx)) {
+    m_condition_expression_sp.reset(m_target.GetUserExpressionForLanguage(
+        condition_text, {}, {}, UserExpression::eResultTypeAny,
+        EvaluateExpressionOptions(), nullptr, error));
+    if (error.Fail()) {
+      m_condition_expression_sp.reset();
+      return eExpressionSetupError;
+    }
+
+    if (!m_condition_expression_sp->Parse(diagnostics, exe_ctx,
+                                          eExecutionPolicyOnlyWhenNeeded, true,
+                                          false)) {
+      error.SetErrorStringWithFormat(
+          "Couldn't parse conditional expression:\n%s",
+          diagnostics.GetString().c_str());
+      m_condition_expression_sp.reset();
+      return eExpressionParseError;
+    }
+  }
+
+  EvaluateExpressionOptions options;
+  options.SetUnwindOnError(true);
+  options.SetIgnoreBreakpoints(true);
+  // Don't generate a user variable for condition expressions.
+  options.SetSuppressPersistentResult(true);
+
+  diagnostics.Clear();
+  ExpressionVariableSP result_variable_sp;
+  ExpressionResults result_code = m_condition_expression_sp->Execute(
+      diagnostics, exe_ctx, options, m_condition_expression_sp,
+      result_variable_sp);
+
+  if (result_code != eExpressionCompleted) {
+    error.SetErrorStringWithFormat("Couldn't execute expression:\n%s",
+                                   diagnostics.GetString().c_str());
+    return result_code;
+  }
+
+  if (result_variable_sp)
+    result_value_sp = result_variable_sp->GetValueObject();
+  return result_code;
+}
+
 void Watchpoint::SendWatchpointChangedEvent(
     lldb::WatchpointEventType eventKind) {
   if (GetTarget().EventTypeHasListeners(
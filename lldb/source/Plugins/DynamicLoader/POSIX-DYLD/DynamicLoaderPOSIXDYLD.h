@@ -11,6 +11,8 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 #include "DYLDRendezvous.h"
 #include "Plugins/Process/Utility/AuxVector.h"
@@ -88,8 +90,18 @@ protected:
   std::weak_ptr<lldb_private::Module> m_interpreter_module;
 
   /// Loaded module list. (link map for each module)
+  /// This may be accessed in a multi-threaded context. Use the accessor
+  /// methods below to access it safely.
   std::map<lldb::ModuleWP, lldb::addr_t, std::owner_less<lldb::ModuleWP>>
       m_loaded_modules;
+  std::mutex m_loaded_modules_mutex;
+
+  /// Threadsafe access to the loaded module list.
+  void SetLoadedModule(const lldb::ModuleSP &module_sp,
+                       lldb::addr_t link_map_addr);
+  void UnloadModule(const lldb::ModuleSP &module_sp);
+  std::optional<lldb::addr_t>
+  GetLoadedModuleLinkAddr(const lldb::ModuleSP &module_sp);
 
   /// Returns true if the process is for a core file.
   bool IsCoreFile() const;
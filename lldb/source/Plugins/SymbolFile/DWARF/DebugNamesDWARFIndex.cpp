@@ -10,10 +10,13 @@
 #include "Plugins/SymbolFile/DWARF/DWARFDebugInfo.h"
 #include "Plugins/SymbolFile/DWARF/DWARFDeclContext.h"
 #include "Plugins/SymbolFile/DWARF/SymbolFileDWARFDwo.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 #include "llvm/ADT/Sequence.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/ThreadPool.h"
 #include <optional>
 
 using namespace lldb_private;
@@ -48,23 +51,30 @@ DebugNamesDWARFIndex::GetUnits(const DebugNames &debug_names) {
   return result;
 }
 
-std::optional<DIERef>
-DebugNamesDWARFIndex::ToDIERef(const DebugNames::Entry &entry) const {
+DWARFUnit *
+DebugNamesDWARFIndex::GetNonSkeletonUnit(const DebugNames::Entry &entry) const {
   // Look for a DWARF unit offset (CU offset or local TU offset) as they are
   // both offsets into the .debug_info section.
   std::optional<uint64_t> unit_offset = entry.getCUOffset();
   if (!unit_offset) {
     unit_offset = entry.getLocalTUOffset();
     if (!unit_offset)
-      return std::nullopt;
+      return nullptr;
   }
 
   DWARFUnit *cu =
       m_debug_info.GetUnitAtOffset(DIERef::Section::DebugInfo, *unit_offset);
+  if (!cu)
+    return nullptr;
+  return &cu->GetNonSkeletonUnit();
+}
+
+std::optional<DIERef>
+DebugNamesDWARFIndex::ToDIERef(const DebugNames::Entry &entry) const {
+  DWARFUnit *cu = GetNonSkeletonUnit(entry);
   if (!cu)
     return std::nullopt;
 
-  cu = &cu->GetNonSkeletonUnit();
   if (std::optional<uint64_t> die_offset = entry.getDIEUnitOffset())
     return DIERef(cu->GetSymbolFileDWARF().GetFileIndex(),
                   DIERef::Section::DebugInfo, cu->GetOffset() + *die_offset);
@@ -86,6 +96,31 @@ bool DebugNamesDWARFIndex::ProcessEntry(
   return callback(die);
 }
 
+template <typename EntryRange, typename Predicate>
+void DebugNamesDWARFIndex::ExtractUnitsOfEntries(EntryRange &&entries,
+                                                 Predicate &&pred) {
+  // The lookup may stop at the first match, so only the units of the first
+  // few candidates are parsed ahead of time. Parsing every unit a common name
+  // occurs in would cost more than the lookup saves.
+  constexpr size_t max_eager_units = 16;
+  llvm::SetVector<DWARFUnit *> units;
+  for (const DebugNames::Entry &entry : entries) {
+    if (!pred(entry))
+      continue;
+    if (DWARFUnit *cu = GetNonSkeletonUnit(entry))
+      if (units.insert(cu) && units.size() == max_eager_units)
+        break;
+  }
+  // A single unit is parsed by the first GetDIE() call just as quickly.
+  if (units.size() < 2)
+    return;
+
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  for (DWARFUnit *cu : units)
+    task_group.async([cu]() { cu->ExtractDIEsIfNeeded(); });
+  task_group.wait();
+}
+
 void DebugNamesDWARFIndex::MaybeLogLookupError(llvm::Error error,
                                                const DebugNames::NameIndex &ni,
                                                llvm::StringRef name) {
@@ -323,6 +358,11 @@ bool DebugNamesDWARFIndex::SameParentChain(
 
 void DebugNamesDWARFIndex::GetTypes(
     ConstString name, llvm::function_ref<bool(DWARFDIE die)> callback) {
+  // A type name often has candidates in many units that have not been parsed
+  // yet. Parse them up front so the lookup below does not do it serially.
+  ExtractUnitsOfEntries(
+      m_debug_names_up->equal_range(name.GetStringRef()),
+      [](const DebugNames::Entry &entry) { return isType(entry.tag()); });
   for (const DebugNames::Entry &entry :
        m_debug_names_up->equal_range(name.GetStringRef())) {
     if (isType(entry.tag())) {
@@ -338,6 +378,10 @@ void DebugNamesDWARFIndex::GetTypes(
     const DWARFDeclContext &context,
     llvm::function_ref<bool(DWARFDIE die)> callback) {
   auto name = context[0].name;
+  ExtractUnitsOfEntries(m_debug_names_up->equal_range(name),
+                        [&](const DebugNames::Entry &entry) {
+                          return entry.tag() == context[0].tag;
+                        });
   for (const DebugNames::Entry &entry : m_debug_names_up->equal_range(name)) {
     if (entry.tag() == context[0].tag) {
       if (!ProcessEntry(entry, callback))
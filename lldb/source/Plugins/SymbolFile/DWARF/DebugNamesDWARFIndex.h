@@ -84,10 +84,19 @@ private:
   std::unique_ptr<DebugNames> m_debug_names_up;
   ManualDWARFIndex m_fallback;
 
+  DWARFUnit *GetNonSkeletonUnit(const DebugNames::Entry &entry) const;
   std::optional<DIERef> ToDIERef(const DebugNames::Entry &entry) const;
   bool ProcessEntry(const DebugNames::Entry &entry,
                     llvm::function_ref<bool(DWARFDIE die)> callback);
 
+  /// Extracts the DIEs of the units that the first `entries` point into
+  /// before they are handed out one by one. Units that still need parsing are
+  /// extracted in parallel on the debugger's thread pool. The number of units
+  /// is capped, so a name with candidates in many units does not parse all of
+  /// them up front.
+  template <typename EntryRange, typename Predicate>
+  void ExtractUnitsOfEntries(EntryRange &&entries, Predicate &&pred);
+
   /// Returns true if `parent_entries` have identical names to `parent_names`.
   bool SameParentChain(llvm::ArrayRef<llvm::StringRef> parent_names,
                        llvm::ArrayRef<DebugNames::Entry> parent_entries) const;
@@ -16,6 +16,7 @@
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 #include "lldb/Utility/StreamString.h"
+#include "llvm/ADT/DenseMap.h"
 #include <optional>
 
 using namespace lldb;
@@ -102,13 +103,21 @@ bool NameToDIE::Decode(const DataExtractor &data, lldb::offset_t *offset_ptr,
     return false;
   const uint32_t count = data.GetU32(offset_ptr);
   m_map.Reserve(count);
+  // Many DIEs share a name, and all of them refer to the same string table
+  // offset. Create the ConstString once per offset instead of hashing the
+  // name into the global string pool again for every entry.
+  llvm::DenseMap<uint32_t, ConstString> strings;
   for (uint32_t i = 0; i < count; ++i) {
-    llvm::StringRef str(strtab.Get(data.GetU32(offset_ptr)));
-    // No empty strings allowed in the name to DIE maps.
-    if (str.empty())
-      return false;
+    auto [it, inserted] = strings.try_emplace(data.GetU32(offset_ptr));
+    if (inserted) {
+      llvm::StringRef str(strtab.Get(it->first));
+      // No empty strings allowed in the name to DIE maps.
+      if (str.empty())
+        return false;
+      it->second = ConstString(str);
+    }
     if (std::optional<DIERef> die_ref = DIERef::Decode(data, offset_ptr))
-      m_map.Append(ConstString(str), *die_ref);
+      m_map.Append(it->second, *die_ref);
     else
       return false;
   }
@@ -133,16 +133,60 @@ lldb::DataBufferSP MemoryCache::GetL2CacheLine(lldb::addr_t line_base_addr,
   if (pos != m_L2_cache.end())
     return pos->second;
 
-  auto data_buffer_heap_sp =
-      std::make_shared<DataBufferHeap>(m_L2_cache_line_byte_size, 0);
+  // If the previous line is cached, memory is most likely being walked
+  // sequentially, e.g. when printing a large container. Fetch the lines that
+  // follow with the same read so that each of them does not cost another round
+  // trip to the inferior, which is expensive for remote targets.
+  uint32_t num_lines = 1;
+  if (line_base_addr >= m_L2_cache_line_byte_size &&
+      m_L2_cache.count(line_base_addr - m_L2_cache_line_byte_size)) {
+    while (num_lines < g_L2_read_ahead_lines) {
+      addr_t next_addr = line_base_addr + num_lines * m_L2_cache_line_byte_size;
+      if (next_addr < line_base_addr || m_L2_cache.count(next_addr) ||
+          m_invalid_ranges.FindEntryThatContains(next_addr))
+        break;
+      ++num_lines;
+    }
+  }
+
+  auto data_buffer_heap_sp = std::make_shared<DataBufferHeap>(
+      num_lines * m_L2_cache_line_byte_size, 0);
   size_t process_bytes_read = m_process.ReadMemoryFromInferior(
       line_base_addr, data_buffer_heap_sp->GetBytes(),
       data_buffer_heap_sp->GetByteSize(), error);
 
+  // Some stubs fail the whole read if any of it is unreadable. Don't let the
+  // lines we speculatively asked for cause the requested one to fail.
+  if (process_bytes_read == 0 && num_lines > 1) {
+    num_lines = 1;
+    error.Clear();
+    data_buffer_heap_sp->SetByteSize(m_L2_cache_line_byte_size);
+    process_bytes_read = m_process.ReadMemoryFromInferior(
+        line_base_addr, data_buffer_heap_sp->GetBytes(),
+        data_buffer_heap_sp->GetByteSize(), error);
+  }
+
   // If we failed a read, not much we can do.
   if (process_bytes_read == 0)
     return lldb::DataBufferSP();
 
+  // Cache the read-ahead lines that were read completely, and keep the first
+  // line in the buffer we return.
+  if (num_lines > 1) {
+    for (uint32_t i = 1; i < num_lines; ++i) {
+      size_t line_offset = i * m_L2_cache_line_byte_size;
+      if (process_bytes_read < line_offset + m_L2_cache_line_byte_size)
+        break;
+      m_L2_cache[line_base_addr + line_offset] =
+          std::make_shared<DataBufferHeap>(
+              data_buffer_heap_sp->GetBytes() + line_offset,
+              m_L2_cache_line_byte_size);
+    }
+    process_bytes_read =
+        std::min<size_t>(process_bytes_read, m_L2_cache_line_byte_size);
+    data_buffer_heap_sp->SetByteSize(m_L2_cache_line_byte_size);
+  }
+
   // If we didn't get a complete read, we can still cache what we did get.
   if (process_bytes_read < m_L2_cache_line_byte_size)
     data_buffer_heap_sp->SetByteSize(process_bytes_read);
@@ -15,7 +15,6 @@
 #include "lldb/Breakpoint/WatchpointResource.h"
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/ValueObject.h"
-#include "lldb/Expression/UserExpression.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/Target.h"
@@ -910,15 +909,10 @@ protected:
           // We need to make sure the user sees any parse errors in their
           // condition, so we'll hook the constructor errors up to the
           // debugger's Async I/O.
-          ExpressionResults result_code;
-          EvaluateExpressionOptions expr_options;
-          expr_options.SetUnwindOnError(true);
-          expr_options.SetIgnoreBreakpoints(true);
           ValueObjectSP result_value_sp;
           Status error;
-          result_code = UserExpression::Evaluate(
-              exe_ctx, expr_options, wp_sp->GetConditionText(),
-              llvm::StringRef(), result_value_sp, error);
+          ExpressionResults result_code =
+              wp_sp->EvaluateCondition(exe_ctx, result_value_sp, error);
 
           if (result_code == eExpressionCompleted) {
             if (result_value_sp) {
@@ -226,3 +226,58 @@ TEST_F(MemoryTest, TesetMemoryCacheRead) {
                                                        // instead of using an
                                                        // old cache
 }
+
+TEST_F(MemoryTest, TestMemoryCacheReadAhead) {
+  ArchSpec arch("x86_64-apple-macosx-");
+
+  Platform::SetHostPlatform(PlatformRemoteMacOSX::CreateInstance(true, &arch));
+
+  DebuggerSP debugger_sp = Debugger::CreateInstance();
+  ASSERT_TRUE(debugger_sp);
+
+  TargetSP target_sp = CreateTarget(debugger_sp, arch);
+  ASSERT_TRUE(target_sp);
+
+  ListenerSP listener_sp(Listener::MakeListener("dummy"));
+  ProcessSP process_sp = std::make_shared<DummyProcess>(target_sp, listener_sp);
+  ASSERT_TRUE(process_sp);
+
+  DummyProcess *process = static_cast<DummyProcess *>(process_sp.get());
+  MemoryCache &mem_cache = process->GetMemoryCache();
+  const uint64_t l2_cache_size = process->GetMemoryCacheLineSize();
+  const uint64_t read_ahead = MemoryCache::g_L2_read_ahead_lines;
+  Status error;
+  auto data_sp = std::make_shared<DataBufferHeap>(l2_cache_size, '\0');
+  size_t bytes_read = 0;
+
+  // The first line is read on its own.
+  process->SetMaxReadSize(l2_cache_size * read_ahead * 2);
+  bytes_read = mem_cache.Read(0x10000, data_sp->GetBytes(),
+                              data_sp->GetByteSize(), error);
+  ASSERT_EQ(bytes_read, l2_cache_size);
+  ASSERT_EQ(process->m_bytes_left, l2_cache_size * (read_ahead * 2 - 1));
+
+  // Reading the next line looks sequential and fetches the lines after it too.
+  bytes_read = mem_cache.Read(0x10000 + l2_cache_size, data_sp->GetBytes(),
+                              data_sp->GetByteSize(), error);
+  ASSERT_EQ(bytes_read, l2_cache_size);
+  ASSERT_EQ(process->m_bytes_left, l2_cache_size * (read_ahead - 1));
+
+  // The lines that were read ahead come from the cache.
+  for (uint64_t i = 2; i <= read_ahead; ++i) {
+    bytes_read = mem_cache.Read(0x10000 + i * l2_cache_size,
+                                data_sp->GetBytes(), data_sp->GetByteSize(),
+                                error);
+    ASSERT_EQ(bytes_read, l2_cache_size);
+  }
+  ASSERT_EQ(process->m_bytes_left, l2_cache_size * (read_ahead - 1));
+
+  // A read ahead that the inferior can only partly satisfy still returns the
+  // requested line.
+  process->SetMaxReadSize(l2_cache_size);
+  bytes_read = mem_cache.Read(0x10000 + (read_ahead + 1) * l2_cache_size,
+                              data_sp->GetBytes(), data_sp->GetByteSize(),
+                              error);
+  ASSERT_EQ(bytes_read, l2_cache_size);
+  ASSERT_EQ(process->m_bytes_left, 0u);
+}
@@ -0,0 +1,76 @@
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FlatHashMap.h"
+#include <vector>
+
+using namespace llvm;
+
+// Pointer-like keys, as used by most value maps in the compiler.
+static std::vector<uintptr_t> getKeys(unsigned N) {
+  std::vector<uintptr_t> Keys;
+  Keys.reserve(N);
+  for (unsigned I = 0; I != N; ++I)
+    Keys.push_back(0x10000 + uintptr_t(I) * 48);
+  return Keys;
+}
+
+template <typename MapT> static void BM_Insert(benchmark::State &State) {
+  std::vector<uintptr_t> Keys = getKeys(State.range(0));
+  for (auto _ : State) {
+    MapT Map;
+    for (uintptr_t K : Keys)
+      Map[K] = K;
+    benchmark::DoNotOptimize(Map.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT> static void BM_FindHit(benchmark::State &State) {
+  std::vector<uintptr_t> Keys = getKeys(State.range(0));
+  MapT Map;
+  for (uintptr_t K : Keys)
+    Map[K] = K;
+  for (auto _ : State)
+    for (uintptr_t K : Keys)
+      benchmark::DoNotOptimize(Map.find(K));
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT> static void BM_FindMiss(benchmark::State &State) {
+  std::vector<uintptr_t> Keys = getKeys(State.range(0));
+  MapT Map;
+  for (uintptr_t K : Keys)
+    Map[K] = K;
+  for (auto _ : State)
+    for (uintptr_t K : Keys)
+      benchmark::DoNotOptimize(Map.find(K + 8));
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+template <typename MapT> static void BM_Churn(benchmark::State &State) {
+  std::vector<uintptr_t> Keys = getKeys(State.range(0));
+  for (auto _ : State) {
+    MapT Map;
+    for (size_t I = 0, E = Keys.size(); I != E; ++I) {
+      Map[Keys[I]] = I;
+      if (I >= 64)
+        Map.erase(Keys[I - 64]);
+    }
+    benchmark::DoNotOptimize(Map.size());
+  }
+  State.SetItemsProcessed(State.iterations() * Keys.size());
+}
+
+using DenseMapT = DenseMap<uintptr_t, uintptr_t>;
+using FlatHashMapT = FlatHashMap<uintptr_t, uintptr_t>;
+
+#define MAP_BENCHMARK(Name)                                                    \
+  BENCHMARK_TEMPLATE(Name, DenseMapT)->Range(16, 1 << 20);                     \
+  BENCHMARK_TEMPLATE(Name, FlatHashMapT)->Range(16, 1 << 20);
+
+MAP_BENCHMARK(BM_Insert)
+MAP_BENCHMARK(BM_FindHit)
+MAP_BENCHMARK(BM_FindMiss)
+MAP_BENCHMARK(BM_Churn)
+
+BENCHMARK_MAIN();
@@ -31,9 +31,14 @@ namespace llvm {
 /// The number of resizings limited up to x2^31. This hashtable is
 /// useful to have efficient access to aggregate data(like strings,
 /// type descriptors...) and to keep only single copy of such
-/// an aggregate. The hashtable allows only concurrent insertions:
+/// an aggregate. The hashtable allows concurrent insertions, lookups and
+/// removals:
 ///
 /// KeyDataTy* = insert ( const KeyTy& );
+/// KeyDataTy* = find ( const KeyTy& );
+/// KeyDataTy* = erase ( const KeyTy& );
+///
+/// forEach() visits all entries, one bucket at a time.
 ///
 /// Data structure:
 ///
@@ -223,6 +228,97 @@ public:
     return {};
   }
 
+  /// \returns the entry for \p Key or nullptr if there is no such entry.
+  KeyDataTy *find(const KeyTy &Key) {
+    uint64_t Hash = Info::getHashValue(Key);
+    Bucket &CurBucket = BucketsArray[getBucketIdx(Hash)];
+    uint32_t ExtHashBits = getExtHashBits(Hash);
+
+#if LLVM_ENABLE_THREADS
+    std::lock_guard<std::mutex> Lock(CurBucket.Guard);
+#endif
+
+    uint32_t CurEntryIdx = findEntryIdx(CurBucket, Key, ExtHashBits);
+    if (CurEntryIdx == CurBucket.Size)
+      return nullptr;
+    return CurBucket.Entries[CurEntryIdx];
+  }
+
+  /// Remove the entry for \p Key. The entry data itself is owned by the
+  /// external allocator and is not freed.
+  ///
+  /// \returns the removed entry or nullptr if there is no such entry.
+  KeyDataTy *erase(const KeyTy &Key) {
+    uint64_t Hash = Info::getHashValue(Key);
+    Bucket &CurBucket = BucketsArray[getBucketIdx(Hash)];
+    uint32_t ExtHashBits = getExtHashBits(Hash);
+
+#if LLVM_ENABLE_THREADS
+    std::lock_guard<std::mutex> Lock(CurBucket.Guard);
+#endif
+
+    uint32_t HoleIdx = findEntryIdx(CurBucket, Key, ExtHashBits);
+    if (HoleIdx == CurBucket.Size)
+      return nullptr;
+
+    KeyDataTy *Removed = CurBucket.Entries[HoleIdx];
+    CurBucket.NumberOfEntries--;
+
+    // Close the hole with backward shifting, so that linear probing never
+    // needs tombstones: move back every following entry of the probe chain
+    // whose start position is not between the hole and the entry itself.
+    uint32_t Mask = CurBucket.Size - 1;
+    for (uint32_t CurEntryIdx = (HoleIdx + 1) & Mask;;
+         CurEntryIdx = (CurEntryIdx + 1) & Mask) {
+      uint32_t CurEntryHashBits = CurBucket.Hashes[CurEntryIdx];
+      if (CurEntryHashBits == 0 && CurBucket.Entries[CurEntryIdx] == nullptr)
+        break;
+
+      uint32_t StartIdx = getStartIdx(CurEntryHashBits, CurBucket.Size);
+      if (((CurEntryIdx - StartIdx) & Mask) < ((CurEntryIdx - HoleIdx) & Mask))
+        continue;
+
+      CurBucket.Hashes[HoleIdx] = CurEntryHashBits;
+      CurBucket.Entries[HoleIdx] = CurBucket.Entries[CurEntryIdx];
+      HoleIdx = CurEntryIdx;
+    }
+
+    CurBucket.Hashes[HoleIdx] = 0;
+    CurBucket.Entries[HoleIdx] = nullptr;
+    return Removed;
+  }
+
+  /// Call \p Fn for every entry of the table. Each bucket is locked while it
+  /// is visited, so the entries of one bucket are seen as a consistent
+  /// snapshot, while insertions into other buckets may proceed concurrently.
+  /// \p Fn must not modify the table.
+  void forEach(function_ref<void(KeyDataTy &)> Fn) {
+    for (uint32_t Idx = 0; Idx < NumberOfBuckets; Idx++) {
+      Bucket &CurBucket = BucketsArray[Idx];
+#if LLVM_ENABLE_THREADS
+      std::lock_guard<std::mutex> Lock(CurBucket.Guard);
+#endif
+      for (uint32_t CurEntryIdx = 0; CurEntryIdx < CurBucket.Size;
+           CurEntryIdx++)
+        if (KeyDataTy *EntryData = CurBucket.Entries[CurEntryIdx])
+          Fn(*EntryData);
+    }
+  }
+
+  /// \returns the number of entries of the table. The result is only exact
+  /// if no other thread modifies the table at the same time.
+  uint64_t size() {
+    uint64_t Result = 0;
+    for (uint32_t Idx = 0; Idx < NumberOfBuckets; Idx++) {
+      Bucket &CurBucket = BucketsArray[Idx];
+#if LLVM_ENABLE_THREADS
+      std::lock_guard<std::mutex> Lock(CurBucket.Guard);
+#endif
+      Result += CurBucket.NumberOfEntries;
+    }
+    return Result;
+  }
+
   /// Print information about current state of hash table structures.
   void printStatistic(raw_ostream &OS) {
     OS << "\n--- HashTable statistic:\n";
@@ -358,6 +454,27 @@ protected:
       delete[] SrcEntries;
   }
 
+  // Find the index of the entry for \p Key in \p CurBucket, or return the
+  // size of the bucket if there is no such entry. The bucket must be locked.
+  uint32_t findEntryIdx(Bucket &CurBucket, const KeyTy &Key,
+                        uint32_t ExtHashBits) {
+    uint32_t CurEntryIdx = getStartIdx(ExtHashBits, CurBucket.Size);
+    while (true) {
+      uint32_t CurEntryHashBits = CurBucket.Hashes[CurEntryIdx];
+      KeyDataTy *EntryData = CurBucket.Entries[CurEntryIdx];
+
+      if (CurEntryHashBits == 0 && EntryData == nullptr)
+        return CurBucket.Size;
+
+      if (CurEntryHashBits == ExtHashBits &&
+          Info::isEqual(Info::getKey(*EntryData), Key))
+        return CurEntryIdx;
+
+      CurEntryIdx++;
+      CurEntryIdx &= (CurBucket.Size - 1);
+    }
+  }
+
   uint32_t getBucketIdx(hash_code Hash) { return Hash & HashMask; }
 
   uint32_t getExtHashBits(uint64_t Hash) {
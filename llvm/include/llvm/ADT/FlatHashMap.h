@@ -0,0 +1,605 @@
+//===- llvm/ADT/FlatHashMap.h - Group probed hash table ---------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines the FlatHashMap class, an open addressing hash table in
+/// the style of a "Swiss table".
+///
+/// Next to the array of buckets the table keeps one control byte per bucket.
+/// A control byte records whether its bucket is empty, deleted or full and,
+/// for full buckets, 7 bits of the hash of the key stored in it. Lookups probe
+/// groups of 16 aligned control bytes at a time (with SSE2 or NEON when
+/// available) and only compare keys in buckets whose control byte matches.
+///
+/// The table uses the same DenseMapInfo traits as DenseMap, but never calls
+/// getEmptyKey() or getTombstoneKey(): any value of the key type can be stored.
+/// Erasing an element only leaves a deleted marker behind when its group has
+/// no empty bucket, which keeps probe sequences short in maps with a lot of
+/// churn.
+///
+/// Iterators and references are invalidated by every insertion.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_FLATHASHMAP_H
+#define LLVM_ADT_FLATHASHMAP_H
+
+#include "llvm/ADT/DenseMapInfo.h"
+#include "llvm/ADT/bit.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemAlloc.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LLVM_FLATHASHMAP_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define LLVM_FLATHASHMAP_NEON 1
+#endif
+
+namespace llvm {
+
+namespace detail {
+
+/// The value of a control byte. Full buckets store the low 7 bits of the
+/// hash, so their control byte is never negative.
+enum FlatHashMapCtrl : int8_t {
+  FlatHashMapEmpty = -128,  // 0b10000000
+  FlatHashMapDeleted = -2,  // 0b11111110
+};
+
+/// A set of bucket positions within a group, produced by matching the control
+/// bytes of the group. Every position is represented by the bit at
+/// Position << Shift.
+template <unsigned Shift> class FlatHashMapBitMask {
+  uint64_t Mask;
+
+public:
+  explicit FlatHashMapBitMask(uint64_t Mask) : Mask(Mask) {}
+
+  explicit operator bool() const { return Mask != 0; }
+  unsigned getLowest() const { return llvm::countr_zero(Mask) >> Shift; }
+
+  FlatHashMapBitMask &operator++() {
+    Mask &= Mask - 1;
+    return *this;
+  }
+  unsigned operator*() const { return getLowest(); }
+  FlatHashMapBitMask begin() const { return *this; }
+  FlatHashMapBitMask end() const { return FlatHashMapBitMask(0); }
+  bool operator!=(const FlatHashMapBitMask &RHS) const {
+    return Mask != RHS.Mask;
+  }
+};
+
+/// A view of the control bytes of one group.
+class FlatHashMapGroup {
+public:
+  static constexpr unsigned Width = 16;
+
+#if defined(LLVM_FLATHASHMAP_SSE2)
+  using BitMask = FlatHashMapBitMask<0>;
+
+  explicit FlatHashMapGroup(const int8_t *Pos)
+      : Ctrl(_mm_load_si128(reinterpret_cast<const __m128i *>(Pos))) {}
+
+  BitMask match(int8_t H2) const {
+    return BitMask(static_cast<uint16_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(Ctrl, _mm_set1_epi8(H2)))));
+  }
+  BitMask matchEmpty() const { return match(FlatHashMapEmpty); }
+  BitMask matchEmptyOrDeleted() const {
+    // Only empty and deleted control bytes have the sign bit set.
+    return BitMask(static_cast<uint16_t>(_mm_movemask_epi8(Ctrl)));
+  }
+
+private:
+  __m128i Ctrl;
+#elif defined(LLVM_FLATHASHMAP_NEON)
+  // NEON has no movemask; narrowing every 16-bit lane by 4 bits leaves one
+  // nibble per control byte, of which the top bit is kept.
+  using BitMask = FlatHashMapBitMask<2>;
+
+  explicit FlatHashMapGroup(const int8_t *Pos) : Ctrl(vld1q_s8(Pos)) {}
+
+  BitMask match(int8_t H2) const {
+    return toBitMask(vceqq_s8(Ctrl, vdupq_n_s8(H2)));
+  }
+  BitMask matchEmpty() const { return match(FlatHashMapEmpty); }
+  BitMask matchEmptyOrDeleted() const {
+    return toBitMask(vcltq_s8(Ctrl, vdupq_n_s8(0)));
+  }
+
+private:
+  static BitMask toBitMask(uint8x16_t Cmp) {
+    uint8x8_t Narrowed = vshrn_n_u16(vreinterpretq_u16_u8(Cmp), 4);
+    return BitMask(vget_lane_u64(vreinterpret_u64_u8(Narrowed), 0) &
+                   0x8888888888888888ULL);
+  }
+
+  int8x16_t Ctrl;
+#else
+  using BitMask = FlatHashMapBitMask<0>;
+
+  explicit FlatHashMapGroup(const int8_t *Pos) : Ctrl(Pos) {}
+
+  BitMask match(int8_t H2) const {
+    uint64_t Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= uint64_t(Ctrl[I] == H2) << I;
+    return BitMask(Mask);
+  }
+  BitMask matchEmpty() const { return match(FlatHashMapEmpty); }
+  BitMask matchEmptyOrDeleted() const {
+    uint64_t Mask = 0;
+    for (unsigned I = 0; I != Width; ++I)
+      Mask |= uint64_t(Ctrl[I] < 0) << I;
+    return BitMask(Mask);
+  }
+
+private:
+  const int8_t *Ctrl;
+#endif
+};
+
+template <typename KeyT, typename ValueT, bool IsConst>
+class FlatHashMapIterator;
+
+} // end namespace detail
+
+template <typename KeyT, typename ValueT,
+          typename KeyInfoT = DenseMapInfo<KeyT>>
+class FlatHashMap {
+  using Group = detail::FlatHashMapGroup;
+
+public:
+  using key_type = KeyT;
+  using mapped_type = ValueT;
+  using value_type = std::pair<KeyT, ValueT>;
+  using size_type = unsigned;
+  using iterator = detail::FlatHashMapIterator<KeyT, ValueT, false>;
+  using const_iterator = detail::FlatHashMapIterator<KeyT, ValueT, true>;
+
+  FlatHashMap() = default;
+
+  /// Create a map which can hold \p InitialReserve elements without growing.
+  explicit FlatHashMap(unsigned InitialReserve) { reserve(InitialReserve); }
+
+  FlatHashMap(const FlatHashMap &Other) {
+    reserve(Other.size());
+    for (const value_type &KV : Other)
+      insertUnique(KV.first, KV.second);
+  }
+
+  FlatHashMap(FlatHashMap &&Other) { swap(Other); }
+
+  FlatHashMap &operator=(const FlatHashMap &Other) {
+    if (&Other != this) {
+      FlatHashMap Copy(Other);
+      swap(Copy);
+    }
+    return *this;
+  }
+
+  FlatHashMap &operator=(FlatHashMap &&Other) {
+    if (&Other != this) {
+      destroyAll();
+      deallocateTable();
+      initEmpty();
+      swap(Other);
+    }
+    return *this;
+  }
+
+  ~FlatHashMap() {
+    destroyAll();
+    deallocateTable();
+  }
+
+  void swap(FlatHashMap &RHS) {
+    std::swap(Ctrl, RHS.Ctrl);
+    std::swap(Slots, RHS.Slots);
+    std::swap(NumBuckets, RHS.NumBuckets);
+    std::swap(NumEntries, RHS.NumEntries);
+    std::swap(GrowthLeft, RHS.GrowthLeft);
+  }
+
+  iterator begin() { return makeIterator(0).skipToFull(); }
+  iterator end() { return makeIterator(NumBuckets); }
+  const_iterator begin() const { return makeConstIterator(0).skipToFull(); }
+  const_iterator end() const { return makeConstIterator(NumBuckets); }
+
+  [[nodiscard]] bool empty() const { return NumEntries == 0; }
+  unsigned size() const { return NumEntries; }
+
+  /// Return the number of buckets in the table.
+  unsigned getNumBuckets() const { return NumBuckets; }
+
+  /// Grow the table so that it can hold \p NumElts elements without
+  /// rehashing.
+  void reserve(unsigned NumElts) {
+    unsigned NewNumBuckets = getMinBucketsToReserve(NumElts);
+    if (NewNumBuckets > NumBuckets)
+      rehash(NewNumBuckets);
+  }
+
+  void clear() {
+    if (NumEntries == 0 && GrowthLeft == getMaxLoad(NumBuckets))
+      return;
+    destroyAll();
+    std::memset(Ctrl, detail::FlatHashMapEmpty, NumBuckets);
+    NumEntries = 0;
+    GrowthLeft = getMaxLoad(NumBuckets);
+  }
+
+  /// Return true if the specified key is in the map.
+  bool contains(const KeyT &Key) const { return findSlot(Key) != NumBuckets; }
+
+  /// Return 1 if the specified key is in the map, 0 otherwise.
+  size_type count(const KeyT &Key) const { return contains(Key) ? 1 : 0; }
+
+  iterator find(const KeyT &Key) { return makeIterator(findSlot(Key)); }
+  const_iterator find(const KeyT &Key) const {
+    return makeConstIterator(findSlot(Key));
+  }
+
+  /// Return the entry for the specified key, or a default constructed value
+  /// if no such entry exists.
+  ValueT lookup(const KeyT &Key) const {
+    unsigned Idx = findSlot(Key);
+    if (Idx != NumBuckets)
+      return Slots[Idx].second;
+    return ValueT();
+  }
+
+  /// Return the entry for the specified key. Asserts that the entry exists.
+  const ValueT &at(const KeyT &Key) const {
+    unsigned Idx = findSlot(Key);
+    assert(Idx != NumBuckets && "FlatHashMap::at failed due to a missing key");
+    return Slots[Idx].second;
+  }
+
+  /// Insert \p KV into the map if its key is not already in the map. Returns
+  /// the iterator to the element with the key and whether the insertion took
+  /// place.
+  std::pair<iterator, bool> insert(const value_type &KV) {
+    return try_emplace(KV.first, KV.second);
+  }
+  std::pair<iterator, bool> insert(value_type &&KV) {
+    return try_emplace(std::move(KV.first), std::move(KV.second));
+  }
+
+  template <typename InputIt> void insert(InputIt I, InputIt E) {
+    for (; I != E; ++I)
+      insert(*I);
+  }
+
+  /// Construct a value from \p Args for \p Key if the key is not already in
+  /// the map.
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(const KeyT &Key, Ts &&...Args) {
+    auto [Idx, Inserted] = findOrPrepareInsert(Key);
+    if (Inserted)
+      ::new (&Slots[Idx]) value_type(std::piecewise_construct,
+                                     std::forward_as_tuple(Key),
+                                     std::forward_as_tuple(
+                                         std::forward<Ts>(Args)...));
+    return {makeIterator(Idx), Inserted};
+  }
+  template <typename... Ts>
+  std::pair<iterator, bool> try_emplace(KeyT &&Key, Ts &&...Args) {
+    auto [Idx, Inserted] = findOrPrepareInsert(Key);
+    if (Inserted)
+      ::new (&Slots[Idx]) value_type(std::piecewise_construct,
+                                     std::forward_as_tuple(std::move(Key)),
+                                     std::forward_as_tuple(
+                                         std::forward<Ts>(Args)...));
+    return {makeIterator(Idx), Inserted};
+  }
+
+  ValueT &operator[](const KeyT &Key) { return try_emplace(Key).first->second; }
+  ValueT &operator[](KeyT &&Key) {
+    return try_emplace(std::move(Key)).first->second;
+  }
+
+  /// Erase the element with \p Key. Returns true if an element was erased.
+  bool erase(const KeyT &Key) {
+    unsigned Idx = findSlot(Key);
+    if (Idx == NumBuckets)
+      return false;
+    eraseSlot(Idx);
+    return true;
+  }
+  void erase(iterator I) { eraseSlot(I.Ctrl - Ctrl); }
+
+private:
+  friend class detail::FlatHashMapIterator<KeyT, ValueT, false>;
+  friend class detail::FlatHashMapIterator<KeyT, ValueT, true>;
+
+  /// Control bytes, one per bucket. NumBuckets is a multiple of the group
+  /// width, and groups start at multiples of the group width.
+  int8_t *Ctrl = nullptr;
+  value_type *Slots = nullptr;
+  unsigned NumBuckets = 0;
+  unsigned NumEntries = 0;
+  /// The number of elements which can be inserted into empty buckets before
+  /// the table has to grow.
+  unsigned GrowthLeft = 0;
+
+  struct HashParts {
+    size_t H1;
+    int8_t H2;
+  };
+
+  /// DenseMapInfo hashes are often weak in their high and low bits, while the
+  /// table uses both: spread the hash over 64 bits first.
+  static HashParts getHashParts(const KeyT &Key) {
+    uint64_t H = uint64_t(KeyInfoT::getHashValue(Key)) * 0x9E3779B97F4A7C15ULL;
+    return {size_t(H >> 25), int8_t(H >> 57)};
+  }
+
+  static unsigned getMaxLoad(unsigned NumBuckets) {
+    return NumBuckets - NumBuckets / 8;
+  }
+
+  static unsigned getMinBucketsToReserve(unsigned NumElts) {
+    if (NumElts == 0)
+      return 0;
+    // Keep the load factor at or below 7/8.
+    uint64_t MinBuckets = uint64_t(NumElts) * 8 / 7 + 1;
+    return std::max<uint64_t>(Group::Width, PowerOf2Ceil(MinBuckets));
+  }
+
+  void initEmpty() {
+    Ctrl = nullptr;
+    Slots = nullptr;
+    NumBuckets = NumEntries = GrowthLeft = 0;
+  }
+
+  static size_t getSlotsOffset(unsigned NumBuckets) {
+    return alignTo(NumBuckets, alignof(value_type));
+  }
+  static size_t getAllocSize(unsigned NumBuckets) {
+    return getSlotsOffset(NumBuckets) + sizeof(value_type) * NumBuckets;
+  }
+  static constexpr size_t getAllocAlign() {
+    return std::max<size_t>(alignof(value_type), Group::Width);
+  }
+
+  void allocateTable(unsigned NewNumBuckets) {
+    char *Mem = static_cast<char *>(
+        allocate_buffer(getAllocSize(NewNumBuckets), getAllocAlign()));
+    Ctrl = reinterpret_cast<int8_t *>(Mem);
+    Slots = reinterpret_cast<value_type *>(Mem + getSlotsOffset(NewNumBuckets));
+    NumBuckets = NewNumBuckets;
+    std::memset(Ctrl, detail::FlatHashMapEmpty, NumBuckets);
+    GrowthLeft = getMaxLoad(NumBuckets) - NumEntries;
+  }
+
+  void deallocateTable() {
+    if (Ctrl)
+      deallocate_buffer(Ctrl, getAllocSize(NumBuckets), getAllocAlign());
+  }
+
+  void destroyAll() {
+    if (NumEntries == 0)
+      return;
+    for (unsigned I = 0; I != NumBuckets; ++I)
+      if (Ctrl[I] >= 0)
+        Slots[I].~value_type();
+  }
+
+  /// Calls \p Fn with the index of every group in the probe sequence of
+  /// \p H1 until it returns true. Triangular probing over a power of two
+  /// number of groups visits every group once.
+  template <typename FnT> void probe(size_t H1, FnT Fn) const {
+    size_t GroupMask = NumBuckets / Group::Width - 1;
+    size_t GroupIdx = H1 & GroupMask;
+    for (size_t Step = 1;; ++Step) {
+      if (Fn(GroupIdx * Group::Width))
+        return;
+      assert(Step <= GroupMask + 1 && "Full table in FlatHashMap!");
+      GroupIdx = (GroupIdx + Step) & GroupMask;
+    }
+  }
+
+  /// Return the bucket holding \p Key, or NumBuckets if there is none.
+  unsigned findSlot(const KeyT &Key) const {
+    if (NumBuckets == 0)
+      return 0;
+    HashParts Hash = getHashParts(Key);
+    unsigned Result = NumBuckets;
+    probe(Hash.H1, [&](size_t GroupStart) {
+      Group G(Ctrl + GroupStart);
+      for (unsigned I : G.match(Hash.H2)) {
+        if (KeyInfoT::isEqual(Slots[GroupStart + I].first, Key)) {
+          Result = GroupStart + I;
+          return true;
+        }
+      }
+      return bool(G.matchEmpty());
+    });
+    return Result;
+  }
+
+  /// Return the first empty or deleted bucket in the probe sequence of
+  /// \p H1.
+  unsigned findInsertSlot(size_t H1) const {
+    unsigned Result = 0;
+    probe(H1, [&](size_t GroupStart) {
+      if (auto Mask = Group(Ctrl + GroupStart).matchEmptyOrDeleted()) {
+        Result = GroupStart + Mask.getLowest();
+        return true;
+      }
+      return false;
+    });
+    return Result;
+  }
+
+  /// Return the bucket holding \p Key and false, or a bucket reserved for
+  /// \p Key and true. The caller has to construct the element in a reserved
+  /// bucket.
+  std::pair<unsigned, bool> findOrPrepareInsert(const KeyT &Key) {
+    unsigned Idx = findSlot(Key);
+    if (Idx != NumBuckets)
+      return {Idx, false};
+    return {prepareInsert(getHashParts(Key)), true};
+  }
+
+  unsigned prepareInsert(HashParts Hash) {
+    unsigned Idx = NumBuckets ? findInsertSlot(Hash.H1) : 0;
+    // Reusing a deleted bucket does not use up an empty one.
+    if (NumBuckets == 0 ||
+        (GrowthLeft == 0 && Ctrl[Idx] != detail::FlatHashMapDeleted)) {
+      // Grow unless most of the buckets in use are deleted markers, in which
+      // case rehashing in place is enough to get rid of them.
+      unsigned NewNumBuckets = NumBuckets;
+      if (NumBuckets == 0)
+        NewNumBuckets = Group::Width;
+      else if (NumEntries >= getMaxLoad(NumBuckets) / 2)
+        NewNumBuckets = NumBuckets * 2;
+      rehash(NewNumBuckets);
+      Idx = findInsertSlot(Hash.H1);
+    }
+    if (Ctrl[Idx] == detail::FlatHashMapEmpty)
+      --GrowthLeft;
+    Ctrl[Idx] = Hash.H2;
+    ++NumEntries;
+    return Idx;
+  }
+
+  /// Insert a key which is known not to be in the map.
+  void insertUnique(const KeyT &Key, const ValueT &Value) {
+    unsigned Idx = prepareInsert(getHashParts(Key));
+    ::new (&Slots[Idx]) value_type(Key, Value);
+  }
+
+  void eraseSlot(unsigned Idx) {
+    assert(Idx < NumBuckets && Ctrl[Idx] >= 0 && "Erasing an empty bucket!");
+    Slots[Idx].~value_type();
+    --NumEntries;
+    // Probe sequences only continue past groups without empty buckets. If
+    // this group already has one, no probe sequence depends on this bucket
+    // being occupied and it can be made empty again.
+    size_t GroupStart = Idx & ~size_t(Group::Width - 1);
+    if (Group(Ctrl + GroupStart).matchEmpty()) {
+      Ctrl[Idx] = detail::FlatHashMapEmpty;
+      ++GrowthLeft;
+    } else {
+      Ctrl[Idx] = detail::FlatHashMapDeleted;
+    }
+  }
+
+  void rehash(unsigned NewNumBuckets) {
+    int8_t *OldCtrl = Ctrl;
+    value_type *OldSlots = Slots;
+    unsigned OldNumBuckets = NumBuckets;
+
+    allocateTable(NewNumBuckets);
+    if (!OldCtrl)
+      return;
+
+    for (unsigned I = 0; I != OldNumBuckets; ++I) {
+      if (OldCtrl[I] < 0)
+        continue;
+      HashParts Hash = getHashParts(OldSlots[I].first);
+      unsigned Idx = findInsertSlot(Hash.H1);
+      Ctrl[Idx] = Hash.H2;
+      ::new (&Slots[Idx]) value_type(std::move(OldSlots[I]));
+      OldSlots[I].~value_type();
+    }
+
+    deallocate_buffer(OldCtrl, getAllocSize(OldNumBuckets), getAllocAlign());
+  }
+
+  iterator makeIterator(unsigned Idx) {
+    return iterator(Ctrl + Idx, Slots + Idx, Ctrl + NumBuckets);
+  }
+  const_iterator makeConstIterator(unsigned Idx) const {
+    return const_iterator(Ctrl + Idx, Slots + Idx, Ctrl + NumBuckets);
+  }
+};
+
+namespace detail {
+
+template <typename KeyT, typename ValueT, bool IsConst>
+class FlatHashMapIterator {
+  template <typename, typename, typename> friend class llvm::FlatHashMap;
+  friend class FlatHashMapIterator<KeyT, ValueT, true>;
+  friend class FlatHashMapIterator<KeyT, ValueT, false>;
+
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = std::pair<KeyT, ValueT>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+  using reference =
+      std::conditional_t<IsConst, const value_type &, value_type &>;
+
+  FlatHashMapIterator() = default;
+
+  // Allow conversion from iterator to const_iterator.
+  template <bool IsConstSrc,
+            typename = std::enable_if_t<!IsConstSrc && IsConst>>
+  FlatHashMapIterator(const FlatHashMapIterator<KeyT, ValueT, IsConstSrc> &I)
+      : Ctrl(I.Ctrl), Slot(I.Slot), End(I.End) {}
+
+  reference operator*() const { return *Slot; }
+  pointer operator->() const { return Slot; }
+
+  friend bool operator==(const FlatHashMapIterator &LHS,
+                         const FlatHashMapIterator &RHS) {
+    return LHS.Ctrl == RHS.Ctrl;
+  }
+  friend bool operator!=(const FlatHashMapIterator &LHS,
+                         const FlatHashMapIterator &RHS) {
+    return !(LHS == RHS);
+  }
+
+  FlatHashMapIterator &operator++() {
+    ++Ctrl;
+    ++Slot;
+    return skipToFull();
+  }
+  FlatHashMapIterator operator++(int) {
+    FlatHashMapIterator Tmp = *this;
+    ++*this;
+    return Tmp;
+  }
+
+private:
+  const int8_t *Ctrl = nullptr;
+  pointer Slot = nullptr;
+  const int8_t *End = nullptr;
+
+  FlatHashMapIterator(const int8_t *Ctrl, pointer Slot, const int8_t *End)
+      : Ctrl(Ctrl), Slot(Slot), End(End) {}
+
+  FlatHashMapIterator &skipToFull() {
+    while (Ctrl != End && *Ctrl < 0) {
+      ++Ctrl;
+      ++Slot;
+    }
+    return *this;
+  }
+};
+
+} // end namespace detail
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_FLATHASHMAP_H
@@ -156,6 +156,78 @@ public:
   void updateMax(uint64_t V) {}
 };
 
+/// A statistic that is always enabled and that is cheap to update from many
+/// threads at once. The counter is split into cache-line sized shards and each
+/// thread updates the shard it was assigned on first use, so parallel
+/// pipelines do not contend on a single atomic. Reading the value sums the
+/// shards. Only additive updates are supported.
+class ShardedStatistic {
+public:
+  static constexpr unsigned NumShards = 16;
+
+  const char *const DebugType;
+  const char *const Name;
+  const char *const Desc;
+
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> Value{0};
+  };
+  Shard Shards[NumShards] = {};
+  std::atomic<bool> Initialized;
+
+  constexpr ShardedStatistic(const char *DebugType, const char *Name,
+                             const char *Desc)
+      : DebugType(DebugType), Name(Name), Desc(Desc), Initialized(false) {}
+
+  const char *getDebugType() const { return DebugType; }
+  const char *getName() const { return Name; }
+  const char *getDesc() const { return Desc; }
+
+  uint64_t getValue() const {
+    uint64_t Sum = 0;
+    for (const Shard &S : Shards)
+      Sum += S.Value.load(std::memory_order_relaxed);
+    return Sum;
+  }
+
+  // Allow use of this class as the value itself.
+  operator uint64_t() const { return getValue(); }
+
+  const ShardedStatistic &operator++() { return *this += 1; }
+
+  const ShardedStatistic &operator--() { return *this -= 1; }
+
+  const ShardedStatistic &operator+=(uint64_t V) {
+    if (V == 0)
+      return *this;
+    Shards[getShardIndex()].Value.fetch_add(V, std::memory_order_relaxed);
+    return init();
+  }
+
+  // Shards may individually wrap around; their sum is still correct.
+  const ShardedStatistic &operator-=(uint64_t V) {
+    if (V == 0)
+      return *this;
+    Shards[getShardIndex()].Value.fetch_sub(V, std::memory_order_relaxed);
+    return init();
+  }
+
+private:
+  static unsigned getShardIndex() {
+    static thread_local unsigned Index = assignShardIndex();
+    return Index;
+  }
+  static unsigned assignShardIndex();
+
+  ShardedStatistic &init() {
+    if (!Initialized.load(std::memory_order_acquire))
+      RegisterStatistic();
+    return *this;
+  }
+
+  void RegisterStatistic();
+};
+
 #if LLVM_ENABLE_STATS
 using Statistic = TrackingStatistic;
 #else
@@ -172,6 +244,11 @@ using Statistic = NoopStatistic;
 #define ALWAYS_ENABLED_STATISTIC(VARNAME, DESC)                                \
   static llvm::TrackingStatistic VARNAME = {DEBUG_TYPE, #VARNAME, DESC}
 
+// SHARDED_STATISTIC - A macro to define an always enabled statistic that is
+// updated frequently from many threads. See ShardedStatistic.
+#define SHARDED_STATISTIC(VARNAME, DESC)                                       \
+  static llvm::ShardedStatistic VARNAME = {DEBUG_TYPE, #VARNAME, DESC}
+
 /// Enable the collection and printing of statistics.
 void EnableStatistics(bool DoPrintOnExit = true);
 
@@ -28,9 +28,11 @@
 #include "llvm/CodeGen/SlotIndexes.h"
 #include "llvm/CodeGen/TargetRegisterInfo.h"
 #include "llvm/MC/LaneBitmask.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Recycler.h"
 #include <cassert>
 #include <cstdint>
 #include <utility>
@@ -62,6 +64,11 @@ class VirtRegMap;
     /// Special pool allocator for VNInfo's (LiveInterval val#).
     VNInfo::Allocator VNInfoAllocator;
 
+    /// Pool for the virtual register LiveIntervals. Keeping them together
+    /// improves locality, and they are freed wholesale in releaseMemory().
+    BumpPtrAllocator LIAllocator;
+    Recycler<LiveInterval> LIRecycler;
+
     /// Live interval pointers for all the virtual registers.
     IndexedMap<LiveInterval*, VirtReg2IndexFunctor> VirtRegIntervals;
 
@@ -148,7 +155,7 @@ class VirtRegMap;
 
     /// Interval removal.
     void removeInterval(Register Reg) {
-      delete VirtRegIntervals[Reg];
+      destroyInterval(VirtRegIntervals[Reg]);
       VirtRegIntervals[Reg] = nullptr;
     }
 
@@ -463,7 +470,8 @@ class VirtRegMap;
     bool computeDeadValues(LiveInterval &LI,
                            SmallVectorImpl<MachineInstr*> *dead);
 
-    static LiveInterval *createInterval(Register Reg);
+    LiveInterval *createInterval(Register Reg);
+    void destroyInterval(LiveInterval *LI);
 
     void printInstrs(raw_ostream &O) const;
     void dumpInstrs() const;
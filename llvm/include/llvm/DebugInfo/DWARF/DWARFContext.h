@@ -396,6 +396,8 @@ public:
   getLocalsForAddress(object::SectionedAddress Address) override;
 
   bool isLittleEndian() const { return DObj->isLittleEndian(); }
+  /// Whether the context was created to be accessed from several threads.
+  bool isThreadSafe() const { return State->isThreadSafe(); }
   static unsigned getMaxSupportedVersion() { return 5; }
   static bool isSupportedVersion(unsigned version) {
     return version >= 2 && version <= getMaxSupportedVersion();
@@ -13,6 +13,7 @@
 #include "llvm/Support/DataExtractor.h"
 #include <cstdint>
 #include <map>
+#include <mutex>
 #include <vector>
 
 namespace llvm {
@@ -62,6 +63,9 @@ class DWARFDebugAbbrev {
   mutable DWARFAbbreviationDeclarationSetMap AbbrDeclSets;
   mutable DWARFAbbreviationDeclarationSetMap::const_iterator PrevAbbrOffsetPos;
   mutable std::optional<DataExtractor> Data;
+  /// Guards the lazily populated members above so that units of one context
+  /// can look up their abbreviation sets from several threads.
+  mutable std::mutex Mutex;
 
 public:
   DWARFDebugAbbrev(DataExtractor Data);
@@ -22,6 +22,7 @@
 #include "llvm/DebugInfo/DWARF/DWARFLocationExpression.h"
 #include "llvm/DebugInfo/DWARF/DWARFUnitIndex.h"
 #include "llvm/Support/DataExtractor.h"
+#include "llvm/Support/RWMutex.h"
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -241,6 +242,11 @@ class DWARFUnit {
   std::optional<object::SectionedAddress> BaseAddr;
   /// The compile unit debug information entry items.
   std::vector<DWARFDebugInfoEntry> DieArray;
+  /// Guards extraction and clearing of DieArray, so that several threads can
+  /// lazily extract the DIEs of different units, or race to extract the same
+  /// unit, without serializing on a context-wide lock. Readers only take it
+  /// to check whether the DIEs are already there.
+  llvm::sys::RWMutex DieArrayMutex;
 
   /// Map from range's start address to end address and corresponding DIE.
   /// IntervalMap does not support range removal, as a result, we use the
@@ -35,6 +35,7 @@
 #include <condition_variable>
 #include <optional>
 #include <queue>
+#include <vector>
 
 namespace llvm {
 
@@ -85,6 +86,12 @@ std::string getDebuginfodDebuginfoUrlPath(object::BuildIDRef ID);
 /// server URLs.
 Expected<std::string> getCachedOrDownloadDebuginfo(object::BuildIDRef ID);
 
+/// Fetches the debug binaries of several build IDs concurrently, using the
+/// default local cache directory and server URLs. The results are in the order
+/// of \p IDs. This can also be used to warm the local cache ahead of time.
+std::vector<Expected<std::string>>
+fetchDebuginfos(ArrayRef<object::BuildID> IDs);
+
 /// Fetches any debuginfod artifact using the default local cache directory and
 /// server URLs.
 Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
@@ -1492,6 +1492,15 @@ public:
   Platform *getPlatform() { return P.get(); }
 
   /// Run the given lambda with the session mutex locked.
+  ///
+  /// The session mutex guards the symbol tables of all JITDylibs together
+  /// with the materialization and query bookkeeping. One lock covers them
+  /// all because a single notifyResolved or notifyEmitted call can complete
+  /// emission units and queries spanning several JITDylibs. Every lookup,
+  /// including lookups of symbols that are already emitted, therefore takes
+  /// this lock. Clients that look up the same emitted symbols repeatedly from
+  /// many threads should cache the addresses: they stay valid until the
+  /// owning ResourceTracker is removed.
   template <typename Func> decltype(auto) runSessionLocked(Func &&F) {
     std::lock_guard<std::recursive_mutex> Lock(SessionMutex);
     return F();
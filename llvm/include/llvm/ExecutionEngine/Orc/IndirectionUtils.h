@@ -303,6 +303,10 @@ public:
   virtual ExecutorSymbolDef findPointer(StringRef Name) = 0;
 
   /// Change the value of the implementation pointer for the stub.
+  ///
+  /// Implementations must make the update a single atomic store, so that a
+  /// stub can be retargeted while other threads are calling through it, e.g.
+  /// to swap in a re-optimized body of a function compiled behind the stub.
   virtual Error updatePointer(StringRef Name, ExecutorAddr NewAddr) = 0;
 
 private:
@@ -424,10 +428,14 @@ public:
 
     std::lock_guard<std::mutex> Lock(StubsMutex);
     auto I = StubIndexes.find(Name);
-    assert(I != StubIndexes.end() && "No stub pointer for symbol");
+    if (I == StubIndexes.end())
+      return make_error<StringError>("Unknown stub name",
+                                     inconvertibleErrorCode());
     auto Key = I->second.first;
     AtomicIntPtr *AtomicStubPtr = reinterpret_cast<AtomicIntPtr *>(
         IndirectStubsInfos[Key.first].getPtr(Key.second));
+    // A single atomic store: a thread calling through the stub concurrently
+    // jumps either to the old or to the new body, never to a torn address.
     *AtomicStubPtr = static_cast<uintptr_t>(NewAddr.getValue());
     return Error::success();
   }
@@ -320,6 +320,7 @@ public:
   ProcessSymbolsJITDylibSetupFunction SetupProcessSymbolsJITDylib;
   ObjectLinkingLayerCreator CreateObjectLinkingLayer;
   CompileFunctionCreator CreateCompileFunction;
+  ObjectCache *ObjCache = nullptr;
   unique_function<Error(LLJIT &)> PrePlatformSetup;
   PlatformSetupFunction SetUpPlatform;
   NotifyCreatedFunction NotifyCreated;
@@ -421,6 +422,15 @@ public:
     return impl();
   }
 
+  /// Set an ObjectCache for the default compile function to query before
+  /// compiling a module, e.g. an OnDiskObjectCache. The cache is not owned by
+  /// the JIT and must outlive it. It is not used if a CompileFunctionCreator
+  /// is set.
+  SetterImpl &setObjectCache(ObjectCache *ObjCache) {
+    impl().ObjCache = ObjCache;
+    return impl();
+  }
+
   /// Set a setup function to be run just before the PlatformSetupFunction is
   /// run.
   ///
@@ -0,0 +1,71 @@
+//===- OnDiskObjectCache.h - Persistent object cache for ORC ----*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// An ObjectCache that persists compiled objects in a directory, keyed by the
+// content of the module and the code generation configuration.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+#define LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ExecutionEngine/ObjectCache.h"
+#include "llvm/Support/Error.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace llvm {
+namespace orc {
+
+class JITTargetMachineBuilder;
+
+/// A content-addressed object cache backed by a directory.
+///
+/// Objects are keyed by a BLAKE3 hash of the module's bitcode together with
+/// the target triple, CPU, subtarget features, relocation model, code model
+/// and optimization level of the JITTargetMachineBuilder the cache was created
+/// for. Cached objects are loaded with MemoryBuffer::getFile, which maps large
+/// files instead of copying them. Entries are written to a temporary file and
+/// renamed into place, so several processes can share one cache directory.
+///
+/// The cache can be used with SimpleCompiler, ConcurrentIRCompiler, or
+/// LLJITBuilder::setObjectCache.
+class OnDiskObjectCache : public ObjectCache {
+public:
+  /// Create a cache in \p CacheDir, creating the directory if it does not
+  /// exist. \p JTMB must describe the target machine that objects are
+  /// compiled with.
+  static Expected<std::unique_ptr<OnDiskObjectCache>>
+  Create(StringRef CacheDir, const JITTargetMachineBuilder &JTMB);
+
+  void notifyObjectCompiled(const Module *M, MemoryBufferRef Obj) override;
+  std::unique_ptr<MemoryBuffer> getObject(const Module *M) override;
+
+private:
+  OnDiskObjectCache(std::string CacheDir, std::string ConfigKey)
+      : CacheDir(std::move(CacheDir)), ConfigKey(std::move(ConfigKey)) {}
+
+  std::string getCachePath(const Module &M) const;
+
+  std::string CacheDir;
+  std::string ConfigKey;
+
+  // The path computed for a module on a cache miss. Code generation may
+  // modify the module, so the key has to be taken before compilation and
+  // reused when the compiled object is stored.
+  std::mutex PendingMutex;
+  DenseMap<const Module *, std::string> PendingPaths;
+};
+
+} // end namespace orc
+} // end namespace llvm
+
+#endif // LLVM_EXECUTIONENGINE_ORC_ONDISKOBJECTCACHE_H
@@ -93,6 +93,20 @@ public:
 
   void handleDisconnect(Error Err) override;
 
+  /// Create a memory manager that places linked code in memory shared with
+  /// the executor, so that segment content is not copied over the transport.
+  /// This requires the executor to run on the same host and to provide the
+  /// ExecutorSharedMemoryMapperService bootstrap symbols. It can be used as
+  /// Setup::CreateMemoryManager, e.g.:
+  ///
+  /// \code{.cpp}
+  ///   S.CreateMemoryManager = [](SimpleRemoteEPC &EPC) {
+  ///     return SimpleRemoteEPC::createSharedMemoryManager(EPC, SlabSize);
+  ///   };
+  /// \endcode
+  static Expected<std::unique_ptr<jitlink::JITLinkMemoryManager>>
+  createSharedMemoryManager(SimpleRemoteEPC &SREPC, size_t SlabSize);
+
 private:
   SimpleRemoteEPC(std::shared_ptr<SymbolStringPool> SSP,
                   std::unique_ptr<TaskDispatcher> D)
@@ -0,0 +1,150 @@
+//===- llvm/IR/FlatSummaryIndex.h - Flat combined summary index -*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+/// @file
+/// This file declares a flat, read-only encoding of the global value graph of
+/// a combined ModuleSummaryIndex. The encoding consists of a sorted GUID
+/// array, a packed summary array, packed call and reference edge arrays and a
+/// string table of module paths. It is designed to be memory-mapped and
+/// queried in place, without materializing a GlobalValueSummary object per
+/// summary.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_IR_FLATSUMMARYINDEX_H
+#define LLVM_IR_FLATSUMMARYINDEX_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/GlobalValue.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBufferRef.h"
+#include <cstdint>
+#include <optional>
+
+namespace llvm {
+
+class ModuleSummaryIndex;
+class raw_ostream;
+
+namespace flatsummary {
+
+const char Magic[8] = {'L', 'L', 'V', 'M', 'F', 'S', 'I', '\0'};
+const uint32_t Version = 1;
+
+/// The header at the start of the buffer. It is followed by, in order:
+///   ModuleEntry Modules[NumModules];
+///   ulittle64_t GUIDs[NumGUIDs];              // sorted
+///   ulittle32_t SummaryOffsets[NumGUIDs + 1]; // into Summaries
+///   SummaryEntry Summaries[NumSummaries];
+///   ulittle32_t EdgeOffsets[NumSummaries + 1]; // into Edges
+///   ulittle32_t Edges[NumEdges];               // indices into GUIDs
+///   char Strtab[StrtabSize];
+struct Header {
+  char Magic[8];
+  support::ulittle32_t Version;
+  support::ulittle32_t NumModules;
+  support::ulittle32_t NumGUIDs;
+  support::ulittle32_t NumSummaries;
+  support::ulittle32_t NumEdges;
+  support::ulittle32_t StrtabSize;
+};
+
+struct ModuleEntry {
+  support::ulittle32_t PathOffset;
+  support::ulittle32_t PathSize;
+};
+
+/// Bit layout of SummaryEntry::Flags.
+enum : uint32_t {
+  LinkageMask = 0xf,
+  KindShift = 4,
+  KindMask = 0x3 << KindShift,
+  LiveFlag = 1 << 6,
+  NotEligibleToImportFlag = 1 << 7,
+  DSOLocalFlag = 1 << 8,
+};
+
+/// A single summary of a global value. The edges of a summary are its calls
+/// followed by its references.
+struct SummaryEntry {
+  support::ulittle32_t Module;
+  support::ulittle32_t Flags;
+  support::ulittle32_t InstCount;
+  support::ulittle32_t NumCalls;
+
+  GlobalValue::LinkageTypes getLinkage() const {
+    return static_cast<GlobalValue::LinkageTypes>(Flags & LinkageMask);
+  }
+  /// Returns the GlobalValueSummary::SummaryKind of the summary.
+  unsigned getKind() const { return (Flags & KindMask) >> KindShift; }
+  bool isLive() const { return Flags & LiveFlag; }
+  bool notEligibleToImport() const { return Flags & NotEligibleToImportFlag; }
+  bool isDSOLocal() const { return Flags & DSOLocalFlag; }
+};
+
+} // end namespace flatsummary
+
+/// Writes the flat encoding of the global value graph of \p Index to \p OS.
+void writeFlatSummaryIndex(const ModuleSummaryIndex &Index, raw_ostream &OS);
+
+/// A read-only view of a flat summary index. The view does not own the
+/// underlying buffer, which is typically a memory-mapped file.
+class FlatSummaryIndex {
+  const flatsummary::Header *Hdr = nullptr;
+  ArrayRef<flatsummary::ModuleEntry> Modules;
+  ArrayRef<support::ulittle64_t> GUIDs;
+  ArrayRef<support::ulittle32_t> SummaryOffsets;
+  ArrayRef<flatsummary::SummaryEntry> Summaries;
+  ArrayRef<support::ulittle32_t> EdgeOffsets;
+  ArrayRef<support::ulittle32_t> Edges;
+  StringRef Strtab;
+
+  FlatSummaryIndex() = default;
+
+public:
+  /// Creates a view of \p Buffer. Only the header, the table sizes and the
+  /// module table are validated; the contents of the other tables are trusted.
+  static Expected<FlatSummaryIndex> create(MemoryBufferRef Buffer);
+
+  uint32_t getNumModules() const { return Modules.size(); }
+  StringRef getModulePath(uint32_t ModuleIdx) const {
+    const flatsummary::ModuleEntry &M = Modules[ModuleIdx];
+    return Strtab.substr(M.PathOffset, M.PathSize);
+  }
+
+  ArrayRef<support::ulittle64_t> guids() const { return GUIDs; }
+
+  /// Returns the position of \p GUID in guids(), if it is present.
+  std::optional<uint32_t> findGUID(GlobalValue::GUID GUID) const;
+
+  /// Returns the summaries of the GUID at position \p GUIDIdx as a half-open
+  /// range of summary indices.
+  std::pair<uint32_t, uint32_t> getSummaryRange(uint32_t GUIDIdx) const {
+    return {SummaryOffsets[GUIDIdx], SummaryOffsets[GUIDIdx + 1]};
+  }
+  const flatsummary::SummaryEntry &getSummary(uint32_t SummaryIdx) const {
+    return Summaries[SummaryIdx];
+  }
+
+  /// Returns the callees of a summary as positions in guids().
+  ArrayRef<support::ulittle32_t> calls(uint32_t SummaryIdx) const {
+    return Edges.slice(EdgeOffsets[SummaryIdx],
+                       Summaries[SummaryIdx].NumCalls);
+  }
+  /// Returns the values referenced by a summary as positions in guids().
+  ArrayRef<support::ulittle32_t> refs(uint32_t SummaryIdx) const {
+    uint32_t Begin = EdgeOffsets[SummaryIdx] + Summaries[SummaryIdx].NumCalls;
+    return Edges.slice(Begin, EdgeOffsets[SummaryIdx + 1] - Begin);
+  }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_IR_FLATSUMMARYINDEX_H
@@ -24,6 +24,12 @@ class Module;
 using IRHash = uint64_t;
 
 /// Returns a hash of the function \p F.
+///
+/// The hash is not a content hash: even with \p DetailedHash it ignores
+/// attributes, metadata, global variable operands and anything outside the
+/// function that passes may look at, so equal hashes do not imply equal
+/// optimization or codegen results. Do not use it as a cache key.
+///
 /// \param F The function to hash.
 /// \param DetailedHash Whether or not to encode additional information in the
 /// hash. The additional information added into the hash when this flag is set
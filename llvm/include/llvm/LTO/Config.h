@@ -99,6 +99,13 @@ struct Config {
   /// manager as the old one doesn't have this ability.
   std::string OptPipeline;
 
+  /// If this field is set, the passes specified by the string are run on each
+  /// partition of a regular LTO module that is split for parallel code
+  /// generation, after the partitions are split off and before code generation.
+  /// Together with an OptPipeline that only contains the IPO passes, this
+  /// allows running the function simplification pipeline in parallel.
+  std::string PartitionOptPipeline;
+
   // If this field is set, it has the same effect of specifying an AA pipeline
   // identified by the string. Only works with the new pass manager, in
   // conjunction OptPipeline.
@@ -215,6 +215,27 @@ ThinBackend createInProcessThinBackend(ThreadPoolStrategy Parallelism,
                                        bool ShouldEmitIndexFiles = false,
                                        bool ShouldEmitImportsFiles = false);
 
+/// This ThinBackend runs the individual backend jobs through an external
+/// distributor program, e.g. one that submits them to a remote execution
+/// service. For each module, the backend writes the module's individual summary
+/// index and the list of modules it imports from to temporary files and runs
+///
+///   <Distributor> <DistributorArgs...> <codegen options...>
+///                 <module> <index> <imports> <object>
+///
+/// The codegen options describe the configuration of the link in llc's
+/// spelling: -O<level>, and -mcpu=, -mattr=, -relocation-model= and
+/// -code-model= when they are set. The distributor must compile <module> with
+/// the given index and options (for instance with
+/// "clang -c -fthinlto-index=<index>") and write the resulting native object
+/// to <object>, which is then added to the link and to the cache. Up to
+/// \p Parallelism jobs are run at a time. Modules that are not files on disk,
+/// such as archive members, are compiled in-process.
+ThinBackend createOutOfProcessThinBackend(ThreadPoolStrategy Parallelism,
+                                          StringRef Distributor,
+                                          ArrayRef<StringRef> DistributorArgs,
+                                          IndexWriteCallback OnWrite = nullptr);
+
 /// This ThinBackend writes individual module indexes to files, instead of
 /// running the individual backend jobs. This backend is for distributed builds
 /// where separate processes will invoke the real backends.
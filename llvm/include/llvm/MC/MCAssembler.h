@@ -199,9 +199,9 @@ private:
   bool fragmentNeedsRelaxation(const MCRelaxableFragment *IF,
                                const MCAsmLayout &Layout) const;
 
-  /// Perform one layout iteration and return true if any offsets
-  /// were adjusted.
-  bool layoutOnce(MCAsmLayout &Layout);
+  /// Perform one layout iteration over \p Sections and return true if any
+  /// offsets were adjusted.
+  bool layoutOnce(MCAsmLayout &Layout, ArrayRef<MCSection *> Sections);
 
   /// Perform one layout iteration of the given section and return true
   /// if any offsets were adjusted.
@@ -95,6 +95,7 @@ class InstrBuilder {
   void populateWrites(InstrDesc &ID, const MCInst &MCI, unsigned SchedClassID);
   void populateReads(InstrDesc &ID, const MCInst &MCI, unsigned SchedClassID);
   Error verifyInstrDesc(const InstrDesc &ID, const MCInst &MCI) const;
+  void warnOnCallOrReturn(const MCInstrDesc &MCDesc);
 
 public:
   InstrBuilder(const MCSubtargetInfo &STI, const MCInstrInfo &MCII,
@@ -103,6 +104,14 @@ public:
 
   void clear() {
     Descriptors.clear();
+    clearRegionState();
+  }
+
+  /// Reset the state that is specific to one code region, but keep the
+  /// descriptors of non-variant instructions. Those only depend on the opcode
+  /// and the scheduling class, so they can be shared by all the regions that
+  /// are analyzed with this builder.
+  void clearRegionState() {
     VariantDescriptors.clear();
     FirstCallInst = true;
     FirstReturnInst = true;
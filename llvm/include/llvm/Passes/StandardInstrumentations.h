@@ -97,6 +97,23 @@ private:
   bool shouldRun(StringRef PassID, Any IR);
 };
 
+/// Skips expensive optional passes on functions with more instructions than
+/// -compile-time-budget-function-size, so that very large (usually
+/// machine-generated) functions fall back to a cheaper pipeline instead of
+/// hitting the superlinear behavior of those passes. An analysis remark is
+/// emitted for every skipped pass.
+class CompileTimeBudgetInstrumentation {
+public:
+  CompileTimeBudgetInstrumentation(bool DebugLogging)
+      : DebugLogging(DebugLogging) {}
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  bool DebugLogging;
+  StringSet<> BudgetedPasses;
+  bool shouldRun(StringRef PassName, Any IR);
+};
+
 class OptPassGateInstrumentation {
   LLVMContext &Context;
   bool HasWrittenIR = false;
@@ -585,6 +602,7 @@ class StandardInstrumentations {
   TimePassesHandler TimePasses;
   TimeProfilingPassesHandler TimeProfilingPasses;
   OptNoneInstrumentation OptNone;
+  CompileTimeBudgetInstrumentation CompileTimeBudget;
   OptPassGateInstrumentation OptPassGate;
   PreservedCFGCheckerInstrumentation PreservedCFGChecker;
   IRChangedPrinter PrintChangedIR;
@@ -74,6 +74,19 @@ Expected<FileCache> localCache(
     const Twine &CacheDirectoryPathRef,
     AddBufferFn AddBuffer = [](size_t Task, const Twine &ModuleName,
                                std::unique_ptr<MemoryBuffer> MB) {});
+
+/// Create a cache that is backed by a local cache in \p CacheDirectoryPathRef
+/// and by a directory shared between hosts, e.g. on a network file system, in
+/// \p SharedDirectoryPathRef. Entries missing from the local cache are looked
+/// up in the shared directory and copied into the local cache on a hit. Entries
+/// produced on a miss are published to the shared directory after they have
+/// been committed locally. Both directories use the localCache file naming, so
+/// either can be pruned with pruneCache() while the cache is in use.
+Expected<FileCache> sharedCache(
+    const Twine &CacheNameRef, const Twine &TempFilePrefixRef,
+    const Twine &CacheDirectoryPathRef, const Twine &SharedDirectoryPathRef,
+    AddBufferFn AddBuffer = [](size_t Task, const Twine &ModuleName,
+                               std::unique_ptr<MemoryBuffer> MB) {});
 } // namespace llvm
 
 #endif
@@ -230,6 +230,8 @@ public:
   StringRef getName() const { return Name; }
   StringRef getDescription() const { return Description; }
 
+  // Options created before the command line is first parsed or the registered
+  // options are first queried are only added to these lists at that point.
   SmallVector<Option *, 4> PositionalOpts;
   SmallVector<Option *, 4> SinkOpts;
   StringMap<Option *> OptionsMap;
@@ -2287,6 +2289,11 @@ void ResetAllOptionOccurrences();
 /// where no options are supported.
 void ResetCommandLineParser();
 
+/// Queue options created from now on instead of registering them, until the
+/// option tables are next needed, as happens for options created at program
+/// startup. Only intended for testing the deferred registration.
+void DeferOptionRegistrationForTesting();
+
 /// Parses `Arg` into the option handler `Handler`.
 bool ProvidePositionalOption(Option *Handler, StringRef Arg, int i);
 
@@ -76,6 +76,12 @@ public:
   /// but keeps the memory mapping alive.
   virtual void discard() {}
 
+  /// Hints that the range [Offset, Offset + Size) of the buffer has been
+  /// completely written and is not expected to be accessed again. Buffers
+  /// backed by a memory-mapped file drop those pages from the address space of
+  /// the process; the written data is kept and can still be read back.
+  virtual void releaseRange(size_t Offset, size_t Size) {}
+
 protected:
   FileOutputBuffer(StringRef Path) : FinalPath(Path) {}
 
@@ -13,7 +13,9 @@
 #ifndef LLVM_SUPPORT_MEMORY_H
 #define LLVM_SUPPORT_MEMORY_H
 
+#include "llvm/Support/AllocatorBase.h"
 #include "llvm/Support/DataTypes.h"
+#include <cassert>
 #include <system_error>
 
 namespace llvm {
@@ -168,6 +170,45 @@ namespace sys {
     MemoryBlock M;
   };
 
+  /// An allocator which maps its allocations directly from the OS and asks for
+  /// them to be backed by huge pages. It is meant to provide the slabs of
+  /// large, long-lived arenas, where it reduces TLB misses, e.g.:
+  ///
+  ///   BumpPtrAllocatorImpl<sys::MappedMemoryAllocator, 2 * 1024 * 1024>
+  ///
+  /// Every allocation is rounded up to whole pages, so it is not suitable for
+  /// small objects.
+  class MappedMemoryAllocator : public AllocatorBase<MappedMemoryAllocator> {
+  public:
+    void Reset() {}
+
+    LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t Size,
+                                                  size_t Alignment) {
+      std::error_code EC;
+      MemoryBlock MB = Memory::allocateMappedMemory(
+          Size, nullptr,
+          Memory::MF_READ | Memory::MF_WRITE | Memory::MF_HUGE_HINT, EC);
+      if (EC || !MB.base())
+        report_bad_alloc_error("Mapped memory allocation failed");
+      assert(reinterpret_cast<uintptr_t>(MB.base()) % Alignment == 0 &&
+             "Alignment is larger than the page size");
+      return MB.base();
+    }
+
+    // Pull in base class overloads.
+    using AllocatorBase<MappedMemoryAllocator>::Allocate;
+
+    void Deallocate(const void *Ptr, size_t Size, size_t /*Alignment*/) {
+      MemoryBlock MB(const_cast<void *>(Ptr), Size);
+      Memory::releaseMappedMemory(MB);
+    }
+
+    // Pull in base class overloads.
+    using AllocatorBase<MappedMemoryAllocator>::Deallocate;
+
+    void PrintStats() const {}
+  };
+
 #ifndef NDEBUG
   /// Debugging output for Memory::ProtectionFlags.
   raw_ostream &operator<<(raw_ostream &OS, const Memory::ProtectionFlags &PF);
@@ -24,6 +24,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace llvm {
 namespace sys {
@@ -99,6 +100,14 @@ public:
           bool RequiresNullTerminator = true, bool IsVolatile = false,
           std::optional<Align> Alignment = std::nullopt);
 
+  /// Open all of the specified files as MemoryBuffers, as if by getFile().
+  /// The files are opened and read concurrently, which hides the latency of
+  /// the individual system calls when many files are needed at once, e.g. on
+  /// network file systems. The result for Filenames[I] is at index I.
+  static std::vector<ErrorOr<std::unique_ptr<MemoryBuffer>>>
+  getFiles(ArrayRef<std::string> Filenames, bool IsText = false,
+           bool RequiresNullTerminator = true, bool IsVolatile = false);
+
   /// Read all of the specified file into a MemoryBuffer as a stream
   /// (i.e. until EOF reached). This is useful for special files that
   /// look like a regular file but have 0 size (e.g. /proc/cpuinfo on Linux).
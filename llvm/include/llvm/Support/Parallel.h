@@ -86,12 +86,18 @@ public:
 };
 } // namespace detail
 
+/// The priority of the tasks spawned by a TaskGroup. When a worker of the
+/// default executor picks its next task, tasks of High priority groups are
+/// taken before Normal ones. Sequential tasks are not affected.
+enum class TaskPriority { Normal, High };
+
 class TaskGroup {
   detail::Latch L;
   bool Parallel;
+  TaskPriority Priority;
 
 public:
-  TaskGroup();
+  explicit TaskGroup(TaskPriority Priority = TaskPriority::Normal);
   ~TaskGroup();
 
   // Spawn a task, but does not wait for it to finish.
@@ -104,6 +110,8 @@ public:
   void sync() const { L.sync(); }
 
   bool isParallel() const { return Parallel; }
+
+  TaskPriority getPriority() const { return Priority; }
 };
 
 namespace detail {
@@ -129,6 +129,13 @@ constexpr bool llvm_is_multithreaded() { return LLVM_ENABLE_THREADS; }
     // threads, or hardware cores.
     bool Limit = false;
 
+    // If set, apply_thread_strategy() pins each thread to the CPUs of one
+    // NUMA node, keeping its memory accesses node-local. Threads are spread
+    // over the nodes in contiguous blocks of thread pool numbers. Currently
+    // only implemented on Linux; on Windows threads are always distributed over
+    // the processor groups, regardless of this flag.
+    bool PinToNUMANodes = false;
+
     /// Retrieves the max available threads for the current strategy. This
     /// accounts for affinity masks and takes advantage of all CPU sockets.
     unsigned compute_thread_count() const;
@@ -55,6 +55,22 @@
 // Each new thread should begin with a timeTraceProfilerInitialize, and
 // finish with a timeTraceProfilerFinishThread call.
 //
+// A separate sampling mode is cheap enough to leave on for every invocation.
+// While it is active, TimeTraceScope only pushes an interned name onto a
+// fixed-size per-thread stack, and a background thread records the stacks of
+// all threads at a fixed interval. The result is written as aggregated
+// "folded" stacks, one line per distinct stack with its sample count, which
+// is the input format of flamegraph.pl and speedscope:
+//
+// \code
+//   timeTraceSamplingProfilerInitialize(/*SampleIntervalUs=*/1000);
+//   ...
+//   timeTraceSamplingProfilerWrite(OS);
+//   timeTraceSamplingProfilerCleanup();
+// \endcode
+//
+// Both modes may be active at the same time.
+//
 // Timestamps come from std::chrono::stable_clock. Note that threads need
 // not see the same time from that clock, and the resolution may not be
 // the best available.
@@ -78,9 +94,11 @@
 
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/Support/Error.h"
+#include <atomic>
 
 namespace llvm {
 
+class raw_ostream;
 class raw_pwrite_stream;
 
 struct TimeTraceProfiler;
@@ -90,9 +108,11 @@ struct TimeTraceProfilerEntry;
 
 /// Initialize the time trace profiler.
 /// This sets up the global \p TimeTraceProfilerInstance
-/// variable to be the profiler instance.
+/// variable to be the profiler instance. If \p TraceMemory is set, the heap
+/// usage at the start and end of each section is recorded as well, and
+/// emitted as a counter track and as the allocation delta of the section.
 void timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
-                                 StringRef ProcName);
+                                 StringRef ProcName, bool TraceMemory = false);
 
 /// Cleanup the time trace profiler, if it was initialized.
 void timeTraceProfilerCleanup();
@@ -140,10 +160,41 @@ TimeTraceProfilerEntry *timeTraceAsyncProfilerBegin(StringRef Name,
 void timeTraceProfilerEnd();
 void timeTraceProfilerEnd(TimeTraceProfilerEntry *E);
 
+/// Start the sampling profiler. The stacks of all threads that are inside a
+/// TimeTraceScope are sampled every \p SampleIntervalUs microseconds. This
+/// is a no-op if LLVM was built without thread support.
+void timeTraceSamplingProfilerInitialize(unsigned SampleIntervalUs = 1000);
+
+/// Stop the sampling profiler and discard the samples, if it was initialized.
+void timeTraceSamplingProfilerCleanup();
+
+namespace detail {
+/// Set while the sampling profiler is running. Checked by every
+/// TimeTraceScope, so it is exposed for the inline check below.
+extern std::atomic<bool> TimeTraceSamplingEnabled;
+} // namespace detail
+
+/// Is the sampling profiler running?
+inline bool timeTraceSamplingProfilerEnabled() {
+  return detail::TimeTraceSamplingEnabled.load(std::memory_order_relaxed);
+}
+
+/// Write the samples collected so far as folded stacks, i.e. lines of the
+/// form "outer;inner count", sorted by stack.
+void timeTraceSamplingProfilerWrite(raw_ostream &OS);
+
+/// Push \p Name onto, or pop the innermost name from, the sampled stack of
+/// the current thread. The name is interned, so it may point into a
+/// temporary. Pushes and pops must be balanced.
+void timeTraceSamplingPush(StringRef Name);
+void timeTraceSamplingPop();
+
 /// The TimeTraceScope is a helper class to call the begin and end functions
 /// of the time trace profiler.  When the object is constructed, it begins
-/// the section; and when it is destroyed, it stops it. If the time profiler
-/// is not initialized, the overhead is a single branch.
+/// the section; and when it is destroyed, it stops it. If neither the time
+/// profiler nor the sampling profiler is initialized, the overhead is a call
+/// to getTimeTraceProfilerInstance(), an inline relaxed load of the sampling
+/// flag and the branches on them.
 class TimeTraceScope {
 public:
   TimeTraceScope() = delete;
@@ -155,22 +206,35 @@ public:
   TimeTraceScope(StringRef Name) {
     if (getTimeTraceProfilerInstance() != nullptr)
       Entry = timeTraceProfilerBegin(Name, StringRef(""));
+    beginSampling(Name);
   }
   TimeTraceScope(StringRef Name, StringRef Detail) {
     if (getTimeTraceProfilerInstance() != nullptr)
       Entry = timeTraceProfilerBegin(Name, Detail);
+    beginSampling(Name);
   }
   TimeTraceScope(StringRef Name, llvm::function_ref<std::string()> Detail) {
     if (getTimeTraceProfilerInstance() != nullptr)
       Entry = timeTraceProfilerBegin(Name, Detail);
+    beginSampling(Name);
   }
   ~TimeTraceScope() {
     if (getTimeTraceProfilerInstance() != nullptr)
       timeTraceProfilerEnd(Entry);
+    if (Sampled)
+      timeTraceSamplingPop();
   }
 
 private:
+  void beginSampling(StringRef Name) {
+    if (timeTraceSamplingProfilerEnabled()) {
+      timeTraceSamplingPush(Name);
+      Sampled = true;
+    }
+  }
+
   TimeTraceProfilerEntry *Entry = nullptr;
+  bool Sampled = false;
 };
 
 } // end namespace llvm
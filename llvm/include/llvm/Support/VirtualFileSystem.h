@@ -17,6 +17,7 @@
 #include "llvm/ADT/IntrusiveRefCntPtr.h"
 #include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Chrono.h"
 #include "llvm/Support/Errc.h"
@@ -30,6 +31,7 @@
 #include <cstdint>
 #include <ctime>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stack>
 #include <string>
@@ -478,6 +480,46 @@ private:
   virtual void anchor() override;
 };
 
+/// A file system that caches the results of status() on the underlying file
+/// system, including failed lookups. Paths are cached by their absolute form,
+/// so the cache is independent of the working directory of its clients.
+///
+/// The cache is thread-safe, so one instance can be shared between many
+/// clients (e.g. all FileManagers of a multi-TU tool) to avoid stat'ing the
+/// same files over and over. Cached entries are trusted until they are
+/// invalidated, except that opening a file compares the status of the opened
+/// file against the cached one and refreshes the entry if the file was
+/// replaced or modified.
+class CachingStatFileSystem
+    : public RTTIExtends<CachingStatFileSystem, ProxyFileSystem> {
+public:
+  static const char ID;
+  explicit CachingStatFileSystem(IntrusiveRefCntPtr<FileSystem> FS)
+      : RTTIExtends(std::move(FS)) {}
+
+  llvm::ErrorOr<Status> status(const Twine &Path) override;
+  bool exists(const Twine &Path) override { return bool(status(Path)); }
+  llvm::ErrorOr<std::unique_ptr<File>>
+  openFileForRead(const Twine &Path) override;
+
+  /// Drop the cached status of \p Path, e.g. after a file watcher reported
+  /// that it changed.
+  void invalidate(const Twine &Path);
+  /// Drop all cached entries.
+  void invalidateAll();
+
+  /// \returns the number of cached entries.
+  size_t getNumCachedEntries() const;
+
+private:
+  /// Turns \p Path into the key of its cache entry. Returns false if the path
+  /// cannot be made absolute, in which case it is not cached.
+  bool getCacheKey(const Twine &Path, SmallVectorImpl<char> &Key) const;
+
+  mutable std::mutex Mutex;
+  StringMap<llvm::ErrorOr<Status>> StatCache;
+};
+
 namespace detail {
 
 class InMemoryDirectory;
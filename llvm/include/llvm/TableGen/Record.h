@@ -2019,6 +2019,9 @@ public:
                                           std::move(R))).second;
     (void)Ins;
     assert(Ins && "Record already exists");
+    // The lists cached by getAllDerivedDefinitions() miss the new def.
+    if (!ClassRecordsMap.empty())
+      DefsAddedAfterCaching = true;
   }
 
   void addExtraGlobal(StringRef Name, Init *I) {
@@ -2082,6 +2085,10 @@ private:
   std::string InputFilename;
   RecordMap Classes, Defs;
   mutable StringMap<std::vector<Record *>> ClassRecordsMap;
+  /// Set once a def is added after ClassRecordsMap was first filled. The
+  /// cached lists may be incomplete from then on, so multi-class queries no
+  /// longer use them.
+  bool DefsAddedAfterCaching = false;
   GlobalMap ExtraGlobals;
 
   // These members are for the phase timing feature. We need a timer group,
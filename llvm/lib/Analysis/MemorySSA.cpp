@@ -19,6 +19,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/iterator.h"
 #include "llvm/ADT/iterator_range.h"
@@ -59,6 +60,13 @@ using namespace llvm;
 
 #define DEBUG_TYPE "memoryssa"
 
+STATISTIC(NumClobberQueries, "Number of clobber queries to the caching walker");
+STATISTIC(NumCachedClobbers,
+          "Number of clobber queries answered from an optimized access");
+STATISTIC(NumClobberWalks, "Number of upward walks to find a clobber");
+STATISTIC(NumWalkLimitReached,
+          "Number of upward walks stopped by the walk limit");
+
 static cl::opt<std::string>
     DotCFGMSSA("dot-cfg-mssa",
                cl::value_desc("file name for generated dot file"),
@@ -574,8 +582,10 @@ class ClobberWalker {
         if (MSSA.isLiveOnEntryDef(MD))
           return {MD, true};
 
-        if (!--*UpwardWalkLimit)
+        if (!--*UpwardWalkLimit) {
+          ++NumWalkLimitReached;
           return {Current, true};
+        }
 
         if (instructionClobbersQuery(MD, Desc.Loc, Query->Inst, *AA))
           return {MD, true};
@@ -928,6 +938,7 @@ public:
   /// possible.
   MemoryAccess *findClobber(BatchAAResults &BAA, MemoryAccess *Start,
                             UpwardsMemoryQuery &Q, unsigned &UpWalkLimit) {
+    ++NumClobberWalks;
     AA = &BAA;
     Query = &Q;
     UpwardWalkLimit = &UpWalkLimit;
@@ -2496,6 +2507,7 @@ MemoryAccess *MemorySSA::ClobberWalkerBase::getClobberingMemoryAccessBase(
   // If this is a MemoryPhi, we can't do anything.
   if (!StartingAccess)
     return MA;
+  ++NumClobberQueries;
 
   if (UseInvariantGroup) {
     if (auto *I = getInvariantGroupClobberingInstruction(
@@ -2516,8 +2528,10 @@ MemoryAccess *MemorySSA::ClobberWalkerBase::getClobberingMemoryAccessBase(
   // Note: Currently, we store the optimized def result in a separate field,
   // since we can't use the defining access.
   if (StartingAccess->isOptimized()) {
-    if (!SkipSelf || !isa<MemoryDef>(StartingAccess))
+    if (!SkipSelf || !isa<MemoryDef>(StartingAccess)) {
+      ++NumCachedClobbers;
       return StartingAccess->getOptimized();
+    }
     IsOptimized = true;
   }
 
@@ -142,6 +142,14 @@ STATISTIC(NumExitCountsNotComputed,
           "Number of loop exits without predictable exit counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumSCEVCacheHits, "Number of getSCEV queries answered from cache");
+STATISTIC(NumSCEVCacheMisses, "Number of getSCEV queries computed");
+STATISTIC(NumBECountCacheHits,
+          "Number of backedge-taken count queries answered from cache");
+STATISTIC(NumBECountCacheMisses,
+          "Number of backedge-taken count queries computed");
+STATISTIC(NumRangeCacheHits, "Number of range queries answered from cache");
+STATISTIC(NumRangeCacheMisses, "Number of range queries computed");
 
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifySCEV = true;
@@ -4566,8 +4574,11 @@ void ScalarEvolution::insertValueToMap(Value *V, const SCEV *S) {
 const SCEV *ScalarEvolution::getSCEV(Value *V) {
   assert(isSCEVable(V->getType()) && "Value is not SCEVable!");
 
-  if (const SCEV *S = getExistingSCEV(V))
+  if (const SCEV *S = getExistingSCEV(V)) {
+    ++NumSCEVCacheHits;
     return S;
+  }
+  ++NumSCEVCacheMisses;
   return createSCEVIter(V);
 }
 
@@ -6618,8 +6629,11 @@ const ConstantRange &ScalarEvolution::getRangeRef(
 
   // See if we've computed this range already.
   DenseMap<const SCEV *, ConstantRange>::iterator I = Cache.find(S);
-  if (I != Cache.end())
+  if (I != Cache.end()) {
+    ++NumRangeCacheHits;
     return I->second;
+  }
+  ++NumRangeCacheMisses;
 
   if (const SCEVConstant *C = dyn_cast<SCEVConstant>(S))
     return setRange(C, SignHint, ConstantRange(C->getAPInt()));
@@ -8337,8 +8351,11 @@ ScalarEvolution::getBackedgeTakenInfo(const Loop *L) {
   // backedge-taken count, which could result in infinite recursion.
   std::pair<DenseMap<const Loop *, BackedgeTakenInfo>::iterator, bool> Pair =
       BackedgeTakenCounts.insert({L, BackedgeTakenInfo()});
-  if (!Pair.second)
+  if (!Pair.second) {
+    ++NumBECountCacheHits;
     return Pair.first->second;
+  }
+  ++NumBECountCacheMisses;
 
   // computeBackedgeTakenCount may allocate memory for its result. Inserting it
   // into the BackedgeTakenCounts map transfers ownership. Otherwise, the result
@@ -6945,7 +6945,11 @@ Error BitcodeReader::materializeModule() {
   WillMaterializeAllForwardRefs = true;
 
   // Iterate over the module, deserializing any functions that are still on
-  // disk.
+  // disk. This is done serially: function bodies are built directly in the
+  // module's LLVMContext, which is not thread-safe, and the order in which they
+  // are materialized determines the use-list order of the globals they use.
+  // Parsing bodies in parallel would first require decoding the records of each
+  // function block into a staging buffer independently of the context.
   for (Function &F : *TheModule) {
     if (Error Err = materialize(&F))
       return Err;
@@ -1771,12 +1771,20 @@ Error MetadataLoader::MetadataLoaderImpl::parseOneMetadata(
     // Ignore Record[0], which indicates whether this compile unit is
     // distinct.  It's always distinct.
     IsDistinct = true;
+    // When importing, the IRMover drops the enums, retained types, globals and
+    // macros listed on the compile unit (see prepareCompileUnitsForImport).
+    // Don't load them here either: as operands of a distinct node they would
+    // otherwise pull in most of the module's debug info for every function
+    // imported. Anything reachable from the imported IR is still loaded.
+    auto getCUListOrNull = [&](unsigned ID) -> Metadata * {
+      return IsImporting ? nullptr : getMDOrNull(ID);
+    };
     auto *CU = DICompileUnit::getDistinct(
         Context, Record[1], getMDOrNull(Record[2]), getMDString(Record[3]),
         Record[4], getMDString(Record[5]), Record[6], getMDString(Record[7]),
-        Record[8], getMDOrNull(Record[9]), getMDOrNull(Record[10]),
-        getMDOrNull(Record[12]), getMDOrNull(Record[13]),
-        Record.size() <= 15 ? nullptr : getMDOrNull(Record[15]),
+        Record[8], getCUListOrNull(Record[9]), getCUListOrNull(Record[10]),
+        getCUListOrNull(Record[12]), getMDOrNull(Record[13]),
+        Record.size() <= 15 ? nullptr : getCUListOrNull(Record[15]),
         Record.size() <= 14 ? 0 : Record[14],
         Record.size() <= 16 ? true : Record[16],
         Record.size() <= 17 ? false : Record[17],
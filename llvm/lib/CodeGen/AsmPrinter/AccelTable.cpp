@@ -21,6 +21,8 @@
 #include "llvm/CodeGen/DIE.h"
 #include "llvm/MC/MCStreamer.h"
 #include "llvm/MC/MCSymbol.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetLoweringObjectFile.h"
 #include <algorithm>
@@ -31,20 +33,29 @@
 
 using namespace llvm;
 
+static cl::opt<bool> ParallelFinalize(
+    "accel-tables-parallel-finalize", cl::Hidden, cl::init(false),
+    cl::desc("Sort and unique the entries of accelerator tables on the "
+             "parallel thread pool"));
+
 void AccelTableBase::computeBucketCount() {
   SmallVector<uint32_t, 0> Uniques;
   Uniques.reserve(Entries.size());
   for (const auto &E : Entries)
     Uniques.push_back(E.second.HashValue);
-  llvm::sort(Uniques);
+  if (ParallelFinalize)
+    parallelSort(Uniques);
+  else
+    llvm::sort(Uniques);
   UniqueHashCount = llvm::unique(Uniques) - Uniques.begin();
   BucketCount = dwarf::getDebugNamesBucketCount(UniqueHashCount);
 }
 
 void AccelTableBase::finalize(AsmPrinter *Asm, StringRef Prefix) {
-  // Create the individual hash data outputs.
-  for (auto &E : Entries) {
-    // Unique the entries.
+  // Create the individual hash data outputs. Each name is uniqued on its own,
+  // so large tables can be processed in parallel. That is opt-in: the emitter
+  // runs inside compilers that may already be using every thread.
+  auto UniqueEntries = [](StringEntries::value_type &E) {
     llvm::stable_sort(E.second.Values,
                       [](const AccelTableData *A, const AccelTableData *B) {
                         return *A < *B;
@@ -52,7 +63,11 @@ void AccelTableBase::finalize(AsmPrinter *Asm, StringRef Prefix) {
     E.second.Values.erase(
         std::unique(E.second.Values.begin(), E.second.Values.end()),
         E.second.Values.end());
-  }
+  };
+  if (ParallelFinalize)
+    parallelForEach(Entries, UniqueEntries);
+  else
+    llvm::for_each(Entries, UniqueEntries);
 
   // Figure out how many buckets we need, then compute the bucket contents and
   // the final ordering. The hashes and offsets can be emitted by walking these
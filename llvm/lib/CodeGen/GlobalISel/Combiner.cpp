@@ -13,6 +13,7 @@
 #include "llvm/CodeGen/GlobalISel/Combiner.h"
 #include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/GlobalISel/CSEInfo.h"
 #include "llvm/CodeGen/GlobalISel/CSEMIRBuilder.h"
 #include "llvm/CodeGen/GlobalISel/CombinerInfo.h"
@@ -27,6 +28,12 @@
 
 using namespace llvm;
 
+STATISTIC(NumCombinerIterations,
+          "Number of combiner iterations over a function");
+STATISTIC(NumCombinerInstsVisited,
+          "Number of instructions visited by the combiner");
+STATISTIC(NumCombinerInstsChanged, "Number of instructions combined");
+
 namespace llvm {
 cl::OptionCategory GICombinerOptionCategory(
     "GlobalISel Combiner",
@@ -136,6 +143,7 @@ bool Combiner::combineMachineInstrs() {
   bool Changed;
 
   do {
+    ++NumCombinerIterations;
     WorkList.clear();
 
     // Collect all instructions. Do a post order traversal for basic blocks and
@@ -162,7 +170,11 @@ bool Combiner::combineMachineInstrs() {
     while (!WorkList.empty()) {
       MachineInstr *CurrInst = WorkList.pop_back_val();
       LLVM_DEBUG(dbgs() << "\nTry combining " << *CurrInst;);
-      Changed |= tryCombineAll(*CurrInst);
+      ++NumCombinerInstsVisited;
+      if (tryCombineAll(*CurrInst)) {
+        ++NumCombinerInstsChanged;
+        Changed = true;
+      }
       WLObserver->reportFullyCreatedInstrs();
     }
     MFChanged |= Changed;
@@ -15,6 +15,7 @@
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/BranchProbabilityInfo.h"
@@ -97,6 +98,8 @@
 
 using namespace llvm;
 
+STATISTIC(NumIRInstsTranslated, "Number of IR instructions translated");
+
 static cl::opt<bool>
     EnableCSEInIRTranslator("enable-cse-in-irtranslator",
                             cl::desc("Should enable CSE in irtranslator"),
@@ -3951,6 +3954,7 @@ bool IRTranslator::runOnMachineFunction(MachineFunction &CurMF) {
         // Translate any debug-info attached to the instruction.
         translateDbgInfo(Inst, *CurBuilder.get());
 
+        ++NumIRInstsTranslated;
         if (translate(Inst))
           continue;
 
@@ -14,6 +14,7 @@
 
 #include "llvm/CodeGen/GlobalISel/Legalizer.h"
 #include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/CodeGen/GlobalISel/CSEInfo.h"
 #include "llvm/CodeGen/GlobalISel/CSEMIRBuilder.h"
@@ -35,6 +36,10 @@
 
 using namespace llvm;
 
+STATISTIC(NumLegalizerIterations, "Number of legalizer worklist iterations");
+STATISTIC(NumInstsLegalized, "Number of instructions legalized");
+STATISTIC(NumArtifactsCombined, "Number of legalization artifacts combined");
+
 static cl::opt<bool>
     EnableCSEInLegalizer("enable-cse-in-legalizer",
                          cl::desc("Should enable CSE in Legalizer"),
@@ -223,6 +228,7 @@ Legalizer::legalizeMachineFunction(MachineFunction &MF, const LegalizerInfo &LI,
   SmallVector<MachineInstr *, 128> RetryList;
   do {
     LLVM_DEBUG(dbgs() << "=== New Iteration ===\n");
+    ++NumLegalizerIterations;
     assert(RetryList.empty() && "Expected no instructions in RetryList");
     unsigned NumArtifacts = ArtifactList.size();
     while (!InstList.empty()) {
@@ -258,7 +264,10 @@ Legalizer::legalizeMachineFunction(MachineFunction &MF, const LegalizerInfo &LI,
       }
       WorkListObserver.printNewInstrs();
       LocObserver.checkpoint();
-      Changed |= Res == LegalizerHelper::Legalized;
+      if (Res == LegalizerHelper::Legalized) {
+        ++NumInstsLegalized;
+        Changed = true;
+      }
     }
     // Try to combine the instructions in RetryList again if there
     // are new artifacts. If not, stop legalizing.
@@ -286,6 +295,7 @@ Legalizer::legalizeMachineFunction(MachineFunction &MF, const LegalizerInfo &LI,
       LLVM_DEBUG(dbgs() << "Trying to combine: " << MI);
       if (ArtCombiner.tryCombineInstruction(MI, DeadInstructions,
                                             WrapperObserver)) {
+        ++NumArtifactsCombined;
         WorkListObserver.printNewInstrs();
         eraseInstrs(DeadInstructions, MRI, &LocObserver);
         LocObserver.checkpoint(
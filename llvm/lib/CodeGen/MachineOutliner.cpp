@@ -983,8 +983,12 @@ bool MachineOutliner::outline(Module &M,
 void MachineOutliner::populateMapper(InstructionMapper &Mapper, Module &M,
                                      MachineModuleInfo &MMI) {
   // Build instruction mappings for each function in the module. Start by
-  // iterating over each Function in M.
+  // iterating over each Function in M and collecting the blocks that are worth
+  // mapping, so that the mapping can be sized up front.
   LLVM_DEBUG(dbgs() << "*** Populating mapper ***\n");
+  SmallVector<std::pair<MachineBasicBlock *, const TargetInstrInfo *>>
+      MBBsToMap;
+  size_t NumInstrsToMap = 0;
   for (Function &F : M) {
     LLVM_DEBUG(dbgs() << "MAPPING FUNCTION: " << F.getName() << "\n");
 
@@ -1045,10 +1049,20 @@ void MachineOutliner::populateMapper(InstructionMapper &Mapper, Module &M,
         continue;
       }
 
-      // MBB is suitable for outlining. Map it to a list of unsigneds.
-      Mapper.convertToUnsignedVec(MBB, *TII);
+      // MBB is suitable for outlining.
+      MBBsToMap.push_back({&MBB, TII});
+      NumInstrsToMap += MBB.size();
     }
   }
+
+  // Every block contributes about one integer per instruction plus a
+  // sentinel. Reserve that much so that appending the per-block vectors does
+  // not repeatedly reallocate the module-wide ones.
+  Mapper.UnsignedVec.reserve(NumInstrsToMap + MBBsToMap.size());
+  Mapper.InstrList.reserve(NumInstrsToMap + MBBsToMap.size());
+  for (auto [MBB, TII] : MBBsToMap)
+    Mapper.convertToUnsignedVec(*MBB, *TII);
+
   // Statistics.
   UnsignedVecSize = Mapper.UnsignedVec.size();
 }
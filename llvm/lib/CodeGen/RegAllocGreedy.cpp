@@ -381,6 +381,12 @@ unsigned DefaultPriorityAdvisor::getPriority(const LiveInterval &LI) const {
   return Prio;
 }
 
+// All live ranges go through the one queue. Allocating register classes with
+// disjoint register files concurrently is not possible here: assignment,
+// eviction and splitting all update the shared LiveIntervals, LiveRegMatrix
+// and VirtRegMap, and the order of assignments is part of the result. Targets
+// that want separate allocation of such classes run one greedy pass per class
+// through a RegClassFilterFunc, as AMDGPU does for SGPRs and VGPRs.
 const LiveInterval *RAGreedy::dequeue() { return dequeue(Queue); }
 
 const LiveInterval *RAGreedy::dequeue(PQueue &CurQueue) {
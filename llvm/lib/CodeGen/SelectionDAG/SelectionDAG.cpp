@@ -1343,6 +1343,14 @@ void SelectionDAG::init(MachineFunction &NewMF,
   PSI = PSIin;
   BFI = BFIin;
   FnVarLocs = VarLocs;
+
+  // clear() keeps the operand storage of the previous function's blocks for
+  // reuse. Shuffle masks are never recycled though, so release everything
+  // here to keep memory bounded by the largest function rather than growing
+  // with the module.
+  assert(allnodes_size() == 1 && "Nodes left over from the previous function");
+  OperandRecycler.clear(OperandAllocator);
+  OperandAllocator.Reset();
 }
 
 SelectionDAG::~SelectionDAG() {
@@ -1408,10 +1416,21 @@ SDNode *SelectionDAG::FindNodeOrInsertPos(const FoldingSetNodeID &ID,
 }
 
 void SelectionDAG::clear() {
+  // Deallocating the nodes returns their operand lists to OperandRecycler.
+  // Keep them there for the next block instead of resetting the allocator,
+  // which would hand its slabs back to malloc only to request them again.
+  // The allocator is reset once per function, in init().
   allnodes_clear();
-  OperandRecycler.clear(OperandAllocator);
-  OperandAllocator.Reset();
-  CSEMap.clear();
+
+  // Clearing the CSE map touches every bucket. If the map was grown for a much
+  // larger block than the one just finished, start over with a map sized for
+  // that block so that a run of small blocks doesn't keep paying for the
+  // largest one.
+  unsigned NumCSENodes = CSEMap.size();
+  if (CSEMap.capacity() > 4096 && NumCSENodes * 16 < CSEMap.capacity())
+    CSEMap = FoldingSet<SDNode>(Log2_32_Ceil(std::max(NumCSENodes, 64u)));
+  else
+    CSEMap.clear();
 
   ExtendedValueTypeNodes.clear();
   ExternalSymbols.clear();
@@ -280,7 +280,6 @@ void CompileUnit::analyzeImportedModule(const DWARFDebugInfoEntry *DieEntry) {
       return;
     }
 
-    auto &Entry = (*GlobalData.getOptions().ParseableSwiftInterfaces)[*Name];
     // The prepend path is applied later when copying.
     SmallString<128> ResolvedPath;
     if (sys::path::is_relative(Path))
@@ -288,6 +287,9 @@ void CompileUnit::analyzeImportedModule(const DWARFDebugInfoEntry *DieEntry) {
           ResolvedPath,
           dwarf::toString(getUnitDIE().find(dwarf::DW_AT_comp_dir), ""));
     sys::path::append(ResolvedPath, Path);
+
+    std::lock_guard<std::mutex> Guard(GlobalData.getSwiftInterfacesMutex());
+    auto &Entry = (*GlobalData.getOptions().ParseableSwiftInterfaces)[*Name];
     if (!Entry.empty() && Entry != ResolvedPath) {
       DWARFDie Die = getDIE(DieEntry);
       warn(Twine("conflicting parseable interfaces for Swift Module ") + *Name +
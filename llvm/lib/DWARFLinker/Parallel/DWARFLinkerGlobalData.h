@@ -13,6 +13,7 @@
 #include "llvm/DWARFLinker/Parallel/DWARFLinker.h"
 #include "llvm/DWARFLinker/StringPool.h"
 #include "llvm/Support/PerThreadBumpPtrAllocator.h"
+#include <mutex>
 
 namespace llvm {
 
@@ -97,6 +98,10 @@ public:
   /// Returns linking options.
   const DWARFLinkerOptions &getOptions() const { return Options; }
 
+  /// Returns the mutex guarding Options.ParseableSwiftInterfaces. The map is
+  /// filled while compile units are analyzed in parallel.
+  std::mutex &getSwiftInterfacesMutex() { return SwiftInterfacesMutex; }
+
   /// Set warning handler.
   void setWarningHandler(MessageHandlerTy Handler) { WarningHandler = Handler; }
 
@@ -150,6 +155,7 @@ protected:
   DWARFLinkerOptions Options;
   MessageHandlerTy WarningHandler;
   MessageHandlerTy ErrorHandler;
+  std::mutex SwiftInterfacesMutex;
 
   /// Triple for output data. May be not set if generation of output
   /// data is not requested.
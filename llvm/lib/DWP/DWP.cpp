@@ -11,6 +11,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "llvm/DWP/DWP.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/DWP/DWPError.h"
 #include "llvm/MC/MCContext.h"
@@ -20,7 +21,9 @@
 #include "llvm/Object/ELFObjectFile.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Parallel.h"
 #include <limits>
+#include <optional>
 
 using namespace llvm;
 using namespace llvm::object;
@@ -638,8 +641,23 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   std::deque<SmallString<32>> UncompressedSections;
 
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
+  // Opening the inputs is dominated by file system latency for packages with
+  // many .dwo files, so open them all in parallel. They are still processed
+  // in input order below, which keeps the output deterministic.
+  std::vector<std::optional<Expected<OwningBinary<object::ObjectFile>>>>
+      OpenedInputs(Inputs.size());
+  parallelFor(0, Inputs.size(), [&](size_t I) {
+    OpenedInputs[I].emplace(object::ObjectFile::createObjectFile(Inputs[I]));
+  });
+  auto ConsumeOpenErrors = make_scope_exit([&] {
+    for (auto &ErrOrObj : OpenedInputs)
+      if (ErrOrObj && !*ErrOrObj)
+        consumeError(ErrOrObj->takeError());
+  });
+
+  for (size_t InputIdx = 0; InputIdx != Inputs.size(); ++InputIdx) {
+    const std::string &Input = Inputs[InputIdx];
+    auto &ErrOrObj = *OpenedInputs[InputIdx];
     if (!ErrOrObj) {
       return handleErrors(ErrOrObj.takeError(),
                           [&](std::unique_ptr<ECError> EC) -> Error {
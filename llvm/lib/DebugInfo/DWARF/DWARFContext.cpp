@@ -56,6 +56,7 @@
 #include <cstdint>
 #include <deque>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -628,6 +629,10 @@ public:
 
 class ThreadSafeState : public ThreadUnsafeDWARFContextState {
   std::recursive_mutex Mutex;
+  /// Line tables are parsed under their own lock, so that parsing a large line
+  /// table does not block threads that only need units, DIEs or other
+  /// sections.
+  std::mutex LineTableMutex;
 
 public:
   ThreadSafeState(DWARFContext &DC, std::string &DWP) :
@@ -675,11 +680,11 @@ public:
   }
   Expected<const DWARFDebugLine::LineTable *>
   getLineTableForUnit(DWARFUnit *U, function_ref<void(Error)> RecoverableErrorHandler) override {
-    std::unique_lock<std::recursive_mutex> LockGuard(Mutex);
+    std::unique_lock<std::mutex> LockGuard(LineTableMutex);
     return ThreadUnsafeDWARFContextState::getLineTableForUnit(U, RecoverableErrorHandler);
   }
   void clearLineTableForUnit(DWARFUnit *U) override {
-    std::unique_lock<std::recursive_mutex> LockGuard(Mutex);
+    std::unique_lock<std::mutex> LockGuard(LineTableMutex);
     return ThreadUnsafeDWARFContextState::clearLineTableForUnit(U);
   }
   Expected<const DWARFDebugFrame *> getDebugFrame() override {
@@ -106,6 +106,7 @@ DWARFDebugAbbrev::DWARFDebugAbbrev(DataExtractor Data)
     : AbbrDeclSets(), PrevAbbrOffsetPos(AbbrDeclSets.end()), Data(Data) {}
 
 Error DWARFDebugAbbrev::parse() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
   if (!Data)
     return Error::success();
   uint64_t Offset = 0;
@@ -143,6 +144,7 @@ void DWARFDebugAbbrev::dump(raw_ostream &OS) const {
 
 Expected<const DWARFAbbreviationDeclarationSet *>
 DWARFDebugAbbrev::getAbbreviationDeclarationSet(uint64_t CUAbbrOffset) const {
+  std::lock_guard<std::mutex> Lock(Mutex);
   const auto End = AbbrDeclSets.end();
   if (PrevAbbrOffsetPos != End && PrevAbbrOffsetPos->first == CUAbbrOffset) {
     return &PrevAbbrOffsetPos->second;
@@ -496,9 +496,24 @@ void DWARFUnit::extractDIEsIfNeeded(bool CUDieOnly) {
 }
 
 Error DWARFUnit::tryExtractDIEsIfNeeded(bool CUDieOnly) {
-  if ((CUDieOnly && !DieArray.empty()) ||
-      DieArray.size() > 1)
-    return Error::success(); // Already parsed.
+  // Other threads read DieArray without taking the lock once they have seen
+  // it populated, and may hold DWARFDies pointing into it. Appending the
+  // remaining DIEs to an earlier unit-DIE-only extraction could reallocate the
+  // array under them, so thread-safe contexts extract all DIEs at once.
+  if (Context.isThreadSafe())
+    CUDieOnly = false;
+
+  {
+    llvm::sys::ScopedReader Lock(DieArrayMutex);
+    if ((CUDieOnly && !DieArray.empty()) || DieArray.size() > 1)
+      return Error::success(); // Already parsed.
+  }
+
+  // The unit DIE attributes below are copied into the unit under the same
+  // lock, so that a thread which sees the DIEs also sees the unit bases.
+  llvm::sys::ScopedWriter Lock(DieArrayMutex);
+  if ((CUDieOnly && !DieArray.empty()) || DieArray.size() > 1)
+    return Error::success(); // Parsed by another thread.
 
   bool HasCUDie = !DieArray.empty();
   extractDIEsToVector(!HasCUDie, !CUDieOnly, DieArray);
@@ -653,6 +668,7 @@ bool DWARFUnit::parseDWO(StringRef DWOAlternativeLocation) {
 }
 
 void DWARFUnit::clearDIEs(bool KeepCUDie) {
+  llvm::sys::ScopedWriter Lock(DieArrayMutex);
   // Do not use resize() + shrink_to_fit() to free memory occupied by dies.
   // shrink_to_fit() is a *non-binding* request to reduce capacity() to size().
   // It depends on the implementation whether the request is fulfilled.
@@ -1158,7 +1174,11 @@ parseDWARFStringOffsetsTableHeader(DWARFDataExtractor &DA,
 Expected<std::optional<StrOffsetsContributionDescriptor>>
 DWARFUnit::determineStringOffsetsTableContribution(DWARFDataExtractor &DA) {
   assert(!IsDWO);
-  auto OptOffset = toSectionOffset(getUnitDIE().find(DW_AT_str_offsets_base));
+  // Called while the DIEs are being extracted, so the unit DIE is accessed
+  // directly rather than through getUnitDIE().
+  assert(!DieArray.empty());
+  DWARFDie UnitDie(this, &DieArray[0]);
+  auto OptOffset = toSectionOffset(UnitDie.find(DW_AT_str_offsets_base));
   if (!OptOffset)
     return std::nullopt;
   auto DescOrError =
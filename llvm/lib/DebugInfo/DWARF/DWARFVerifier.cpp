@@ -408,6 +408,10 @@ unsigned DWARFVerifier::verifyUnits(const DWARFUnitVector &Units) {
   unsigned NumDebugInfoErrors = 0;
   ReferenceMap CrossUnitReferences;
 
+  // Units are verified one at a time: extracting DIEs goes through the
+  // DWARFDebugAbbrev declaration set cache and the per-unit DIE arrays, none
+  // of which are synchronized, and errors are reported to the shared stream
+  // in unit order.
   unsigned Index = 1;
   for (const auto &Unit : Units) {
     OS << "Verifying unit: " << Index << " / " << Units.getNumUnits();
@@ -11,9 +11,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/DebugInfo/LogicalView/Core/LVCompare.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/DebugInfo/LogicalView/Core/LVOptions.h"
 #include "llvm/DebugInfo/LogicalView/Core/LVReader.h"
 #include <tuple>
+#include <type_traits>
 
 using namespace llvm;
 using namespace llvm::logicalview;
@@ -197,6 +200,25 @@ Error LVCompare::execute(LVReader *ReferenceReader, LVReader *TargetReader) {
                               LVComparePass Pass) -> Error {
       auto FindMatch = [&](auto &References, auto &Targets,
                            const char *Category) -> Error {
+        // Every equality test starts with 'LVElement::equals', which requires
+        // the same line number, level, name, qualified name and filename.
+        // Bucket the targets on those, so that each reference is only tested
+        // against the targets that can match it, rather than against all the
+        // targets in the reader. The buckets keep the targets in their
+        // original order, so the first match found is the same.
+        using LVTarget = typename std::decay_t<decltype(Targets)>::value_type;
+        using LVMatchKey =
+            std::tuple<uint32_t, LVLevel, size_t, size_t, size_t>;
+        auto GetMatchKey = [](const LVElement *Element) {
+          return LVMatchKey(Element->getLineNumber(), Element->getLevel(),
+                            Element->getNameIndex(),
+                            Element->getQualifiedNameIndex(),
+                            Element->getFilenameIndex());
+        };
+        DenseMap<LVMatchKey, SmallVector<LVTarget, 1>> TargetsByKey;
+        for (LVTarget Target : Targets)
+          TargetsByKey[GetMatchKey(Target)].push_back(Target);
+
         LVElements Elements;
         for (LVElement *Reference : References) {
           // Report elements that can be printed; ignore logical elements that
@@ -206,7 +228,9 @@ Error LVCompare::execute(LVReader *ReferenceReader, LVReader *TargetReader) {
               updateExpected(Reference);
             Reference->setIsInCompare();
             LVElement *CurrentTarget = nullptr;
-            if (llvm::any_of(Targets, [&](auto Target) -> bool {
+            auto Bucket = TargetsByKey.find(GetMatchKey(Reference));
+            if (Bucket != TargetsByKey.end() &&
+                llvm::any_of(Bucket->second, [&](auto Target) -> bool {
                   CurrentTarget = Target;
                   return Reference->equals(Target);
                 })) {
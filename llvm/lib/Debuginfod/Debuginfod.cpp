@@ -41,6 +41,7 @@
 #include "llvm/Support/xxhash.h"
 
 #include <atomic>
+#include <mutex>
 #include <optional>
 #include <thread>
 
@@ -52,8 +53,18 @@ namespace {
 std::optional<SmallVector<StringRef>> DebuginfodUrls;
 // Many Readers/Single Writer lock protecting the global debuginfod URL list.
 llvm::sys::RWMutex UrlsMutex;
+// One lock per cached artifact path, so that an artifact requested by several
+// threads at once is downloaded by one of them and then found in the cache by
+// the others.
+std::mutex ArtifactMutexesMutex;
+StringMap<std::mutex> ArtifactMutexes;
 } // namespace
 
+static std::mutex &getArtifactMutex(StringRef CachedArtifactPath) {
+  std::lock_guard<std::mutex> Guard(ArtifactMutexesMutex);
+  return ArtifactMutexes[CachedArtifactPath];
+}
+
 std::string getDebuginfodCacheKey(llvm::StringRef S) {
   return utostr(xxh3_64bits(S));
 }
@@ -159,6 +170,24 @@ Expected<std::string> getCachedOrDownloadDebuginfo(BuildIDRef ID) {
   return getCachedOrDownloadArtifact(getDebuginfodCacheKey(UrlPath), UrlPath);
 }
 
+std::vector<Expected<std::string>>
+fetchDebuginfos(ArrayRef<object::BuildID> IDs) {
+  std::vector<std::optional<Expected<std::string>>> Paths(IDs.size());
+  {
+    DefaultThreadPool Pool(optimal_concurrency(IDs.size()));
+    for (size_t I = 0, E = IDs.size(); I != E; ++I)
+      Pool.async(
+          [&, I] { Paths[I].emplace(getCachedOrDownloadDebuginfo(IDs[I])); });
+    Pool.wait();
+  }
+
+  std::vector<Expected<std::string>> Results;
+  Results.reserve(IDs.size());
+  for (std::optional<Expected<std::string>> &Path : Paths)
+    Results.push_back(std::move(*Path));
+  return Results;
+}
+
 // General fetching function.
 Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
                                                   StringRef UrlPath) {
@@ -255,6 +284,9 @@ Expected<std::string> getCachedOrDownloadArtifact(
   sys::path::append(AbsCachedArtifactPath, CacheDirectoryPath,
                     "llvmcache-" + UniqueKey);
 
+  std::lock_guard<std::mutex> ArtifactGuard(
+      getArtifactMutex(AbsCachedArtifactPath));
+
   Expected<FileCache> CacheOrErr =
       localCache("Debuginfod-client", ".debuginfod-client", CacheDirectoryPath);
   if (!CacheOrErr)
@@ -14,6 +14,9 @@
 #define LIB_EXECUTIONENGINE_JITLINK_JITLINKGENERIC_H
 
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
+
+#include <mutex>
 
 #define DEBUG_TYPE "jitlink"
 
@@ -129,52 +132,81 @@ private:
     return static_cast<const LinkerImpl &>(*this);
   }
 
+  Error fixUpBlock(LinkGraph &G, Block &B, bool NoAllocSection) const {
+    LLVM_DEBUG(dbgs() << "  " << B << ":\n");
+
+    // Copy Block data and apply fixups.
+    LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+    assert((!B.isZeroFill() || all_of(B.edges(),
+                                      [](const Edge &E) {
+                                        return E.getKind() == Edge::KeepAlive;
+                                      })) &&
+           "Non-KeepAlive edges in zero-fill block?");
+
+    for (auto &E : B.edges()) {
+
+      // Skip non-relocation edges.
+      if (!E.isRelocation())
+        continue;
+
+      // If B is a block in a Standard or Finalize section then make sure
+      // that no edges point to symbols in NoAlloc sections.
+      assert((NoAllocSection || !E.getTarget().isDefined() ||
+              E.getTarget().getBlock().getSection().getMemLifetime() !=
+                  orc::MemLifetime::NoAlloc) &&
+             "Block in allocated section has edge pointing to no-alloc "
+             "section");
+
+      // Dispatch to LinkerImpl for fixup.
+      if (auto Err = impl().applyFixup(G, B, E))
+        return Err;
+    }
+    return Error::success();
+  }
+
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    // Fixups only write to the content of the block they belong to, so large
+    // graphs are fixed up in parallel. Small graphs are not worth the thread
+    // synchronization.
+    constexpr size_t MinEdgesForParallelFixup = 1 << 16;
+
+    SmallVector<std::pair<Block *, bool>, 0> Blocks;
+    size_t NumEdges = 0;
     for (auto &Sec : G.sections()) {
       bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
 
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
-        assert((!B->isZeroFill() || all_of(B->edges(),
-                                           [](const Edge &E) {
-                                             return E.getKind() ==
-                                                    Edge::KeepAlive;
-                                           })) &&
-               "Non-KeepAlive edges in zero-fill block?");
-
         // If this is a no-alloc section then copy the block content into
         // memory allocated on the Graph's allocator (if it hasn't been
-        // already).
+        // already). The allocator is not thread-safe, so do this up front.
         if (NoAllocSection)
           (void)B->getMutableContent(G);
-
-        for (auto &E : B->edges()) {
-
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
-
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert((NoAllocSection || !E.getTarget().isDefined() ||
-                  E.getTarget().getBlock().getSection().getMemLifetime() !=
-                      orc::MemLifetime::NoAlloc) &&
-                 "Block in allocated section has edge pointing to no-alloc "
-                 "section");
-
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
-            return Err;
-        }
+        Blocks.push_back({B, NoAllocSection});
+        NumEdges += B->edges_size();
       }
     }
 
-    return Error::success();
+    bool Parallel = NumEdges >= MinEdgesForParallelFixup;
+    // Keep the debug output in order.
+    LLVM_DEBUG(Parallel = false);
+    if (!Parallel) {
+      for (auto &[B, NoAllocSection] : Blocks)
+        if (auto Err = fixUpBlock(G, *B, NoAllocSection))
+          return Err;
+      return Error::success();
+    }
+
+    std::mutex ErrMutex;
+    Error Err = Error::success();
+    parallelFor(0, Blocks.size(), [&](size_t I) {
+      if (auto E = fixUpBlock(G, *Blocks[I].first, Blocks[I].second)) {
+        std::lock_guard<std::mutex> Lock(ErrMutex);
+        Err = joinErrors(std::move(Err), std::move(E));
+      }
+    });
+    return Err;
   }
 };
 
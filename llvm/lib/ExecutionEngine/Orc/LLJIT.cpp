@@ -964,13 +964,13 @@ LLJIT::createCompileFunction(LLJITBuilderState &S,
 
   // If using a custom EPC then use a ConcurrentIRCompiler by default.
   if (*S.SupportConcurrentCompilation)
-    return std::make_unique<ConcurrentIRCompiler>(std::move(JTMB));
+    return std::make_unique<ConcurrentIRCompiler>(std::move(JTMB), S.ObjCache);
 
   auto TM = JTMB.createTargetMachine();
   if (!TM)
     return TM.takeError();
 
-  return std::make_unique<TMOwningSimpleCompiler>(std::move(*TM));
+  return std::make_unique<TMOwningSimpleCompiler>(std::move(*TM), S.ObjCache);
 }
 
 LLJIT::LLJIT(LLJITBuilderState &S, Error &Err)
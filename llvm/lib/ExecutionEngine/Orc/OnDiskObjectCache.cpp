@@ -0,0 +1,162 @@
+//===------ OnDiskObjectCache.cpp - Persistent object cache for ORC -------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/BLAKE3.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace llvm {
+namespace orc {
+
+/// Writes the TargetOptions that can change the generated code to \p OS.
+/// Options that only affect diagnostics or output file names are left out so
+/// that they do not defeat the cache.
+static void writeTargetOptionsKey(raw_ostream &OS, const TargetOptions &TO) {
+  auto Field = [&OS](auto Value) { OS << int64_t(Value) << ','; };
+  Field(TO.UnsafeFPMath);
+  Field(TO.NoInfsFPMath);
+  Field(TO.NoNaNsFPMath);
+  Field(TO.NoTrappingFPMath);
+  Field(TO.NoSignedZerosFPMath);
+  Field(TO.ApproxFuncFPMath);
+  Field(TO.HonorSignDependentRoundingFPMathOption);
+  Field(TO.NoZerosInBSS);
+  Field(TO.GuaranteedTailCallOpt);
+  Field(TO.StackSymbolOrdering);
+  Field(TO.EnableFastISel);
+  Field(TO.EnableGlobalISel);
+  Field(TO.GlobalISelAbort);
+  Field(TO.SwiftAsyncFramePointer);
+  Field(TO.UseInitArray);
+  Field(TO.FunctionSections);
+  Field(TO.DataSections);
+  Field(TO.UniqueSectionNames);
+  Field(TO.TrapUnreachable);
+  Field(TO.NoTrapAfterNoreturn);
+  Field(TO.TLSSize);
+  Field(TO.EmulatedTLS);
+  Field(TO.EnableTLSDESC);
+  Field(TO.EnableIPRA);
+  Field(TO.EmitStackSizeSection);
+  Field(TO.EnableMachineOutliner);
+  Field(TO.EnableMachineFunctionSplitter);
+  Field(TO.EmitAddrsig);
+  Field(TO.BBSections);
+  Field(TO.EmitCallSiteInfo);
+  Field(TO.EnableDebugEntryValues);
+  Field(TO.ForceDwarfFrameSection);
+  Field(TO.DebugStrictDwarf);
+  Field(TO.LoopAlignment);
+  Field(TO.FloatABIType);
+  Field(TO.AllowFPOpFusion);
+  Field(TO.ThreadModel);
+  Field(TO.EABIVersion);
+  Field(TO.DebuggerTuning);
+  Field(TO.getRawFPDenormalMode().Output);
+  Field(TO.getRawFPDenormalMode().Input);
+  Field(TO.getRawFP32DenormalMode().Output);
+  Field(TO.getRawFP32DenormalMode().Input);
+  Field(TO.ExceptionModel);
+  Field(TO.MCOptions.EmitDwarfUnwind);
+  OS << TO.MCOptions.ABIName;
+}
+
+Expected<std::unique_ptr<OnDiskObjectCache>>
+OnDiskObjectCache::Create(StringRef CacheDir,
+                          const JITTargetMachineBuilder &JTMB) {
+  if (std::error_code EC = sys::fs::create_directories(CacheDir))
+    return createFileError(CacheDir, EC);
+
+  // Everything besides the module that affects the generated code. The LLVM
+  // version is included so that an upgraded JIT does not reuse stale objects.
+  std::string ConfigKey;
+  raw_string_ostream OS(ConfigKey);
+  OS << LLVM_VERSION_STRING << '\0' << JTMB.getTargetTriple().str() << '\0'
+     << JTMB.getCPU() << '\0' << JTMB.getFeatures().getString() << '\0'
+     << (JTMB.getRelocationModel() ? int(*JTMB.getRelocationModel()) : -1)
+     << '\0' << (JTMB.getCodeModel() ? int(*JTMB.getCodeModel()) : -1) << '\0'
+     << int(JTMB.getCodeGenOptLevel()) << '\0';
+  writeTargetOptionsKey(OS, JTMB.getOptions());
+  OS.flush();
+
+  return std::unique_ptr<OnDiskObjectCache>(
+      new OnDiskObjectCache(CacheDir.str(), std::move(ConfigKey)));
+}
+
+std::string OnDiskObjectCache::getCachePath(const Module &M) const {
+  SmallVector<char, 0> Bitcode;
+  raw_svector_ostream OS(Bitcode);
+  WriteBitcodeToFile(M, OS);
+
+  BLAKE3 Hasher;
+  Hasher.update(ConfigKey);
+  Hasher.update(ArrayRef(reinterpret_cast<const uint8_t *>(Bitcode.data()),
+                         Bitcode.size()));
+
+  SmallString<256> Path(CacheDir);
+  sys::path::append(Path, toHex(Hasher.final(), /*LowerCase=*/true) + ".o");
+  return std::string(Path);
+}
+
+std::unique_ptr<MemoryBuffer> OnDiskObjectCache::getObject(const Module *M) {
+  std::string Path = getCachePath(*M);
+  auto ObjOrErr = MemoryBuffer::getFile(Path, /*IsText=*/false,
+                                        /*RequiresNullTerminator=*/false);
+  if (ObjOrErr)
+    return std::move(*ObjOrErr);
+
+  std::lock_guard<std::mutex> Lock(PendingMutex);
+  PendingPaths[M] = std::move(Path);
+  return nullptr;
+}
+
+void OnDiskObjectCache::notifyObjectCompiled(const Module *M,
+                                             MemoryBufferRef Obj) {
+  std::string Path;
+  {
+    std::lock_guard<std::mutex> Lock(PendingMutex);
+    auto I = PendingPaths.find(M);
+    // Without a key taken before compilation the module may already have
+    // been changed by code generation, so don't store anything.
+    if (I == PendingPaths.end())
+      return;
+    Path = std::move(I->second);
+    PendingPaths.erase(I);
+  }
+
+  // The cache is best effort: failing to store an object only means that it
+  // is compiled again next time.
+  int FD;
+  SmallString<256> TmpPath;
+  if (sys::fs::createUniqueFile(Path + ".tmp%%%%%%", FD, TmpPath))
+    return;
+  {
+    raw_fd_ostream OS(FD, /*shouldClose=*/true);
+    OS << Obj.getBuffer();
+    OS.close();
+    if (OS.has_error()) {
+      OS.clear_error();
+      sys::fs::remove(TmpPath);
+      return;
+    }
+  }
+  if (sys::fs::rename(TmpPath, Path))
+    sys::fs::remove(TmpPath);
+}
+
+} // end namespace orc
+} // end namespace llvm
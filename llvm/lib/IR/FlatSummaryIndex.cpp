@@ -0,0 +1,191 @@
+//===-- FlatSummaryIndex.cpp - Flat combined summary index ----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the writer and the reader of the flat summary index
+// encoding.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/IR/FlatSummaryIndex.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/IR/ModuleSummaryIndex.h"
+#include "llvm/Support/EndianStream.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace llvm;
+using namespace llvm::flatsummary;
+
+void llvm::writeFlatSummaryIndex(const ModuleSummaryIndex &Index,
+                                 raw_ostream &OS) {
+  // Number the modules in path order so that the output does not depend on the
+  // StringMap layout.
+  std::vector<StringRef> ModulePaths;
+  for (const auto &MPI : Index.modulePaths())
+    ModulePaths.push_back(MPI.getKey());
+  llvm::sort(ModulePaths);
+  DenseMap<StringRef, uint32_t> ModuleIds;
+  for (auto [I, Path] : enumerate(ModulePaths))
+    ModuleIds[Path] = I;
+
+  // The global value map is ordered by GUID, which gives the sorted GUID array.
+  DenseMap<GlobalValue::GUID, uint32_t> GUIDIds;
+  uint32_t NumSummaries = 0, NumEdges = 0;
+  for (const auto &[GUID, Info] : Index) {
+    uint32_t Id = GUIDIds.size();
+    GUIDIds[GUID] = Id;
+    NumSummaries += Info.SummaryList.size();
+    for (const auto &S : Info.SummaryList) {
+      if (auto *FS = dyn_cast<FunctionSummary>(S.get()))
+        NumEdges += FS->calls().size();
+      NumEdges += S->refs().size();
+    }
+  }
+
+  support::endian::Writer W(OS, llvm::endianness::little);
+  OS.write(Magic, sizeof(Magic));
+  W.write<uint32_t>(Version);
+  W.write<uint32_t>(ModulePaths.size());
+  W.write<uint32_t>(GUIDIds.size());
+  W.write<uint32_t>(NumSummaries);
+  W.write<uint32_t>(NumEdges);
+  uint32_t StrtabSize = 0;
+  for (StringRef Path : ModulePaths)
+    StrtabSize += Path.size();
+  W.write<uint32_t>(StrtabSize);
+
+  uint32_t PathOffset = 0;
+  for (StringRef Path : ModulePaths) {
+    W.write<uint32_t>(PathOffset);
+    W.write<uint32_t>(Path.size());
+    PathOffset += Path.size();
+  }
+
+  for (const auto &[GUID, Info] : Index)
+    W.write<uint64_t>(GUID);
+
+  uint32_t SummaryOffset = 0;
+  for (const auto &[GUID, Info] : Index) {
+    W.write<uint32_t>(SummaryOffset);
+    SummaryOffset += Info.SummaryList.size();
+  }
+  W.write<uint32_t>(SummaryOffset);
+
+  for (const auto &[GUID, Info] : Index) {
+    for (const auto &S : Info.SummaryList) {
+      auto *FS = dyn_cast<FunctionSummary>(S.get());
+      uint32_t Flags = S->linkage() | (S->getSummaryKind() << KindShift);
+      if (S->isLive())
+        Flags |= LiveFlag;
+      if (S->notEligibleToImport())
+        Flags |= NotEligibleToImportFlag;
+      if (S->isDSOLocal())
+        Flags |= DSOLocalFlag;
+      W.write<uint32_t>(ModuleIds.lookup(S->modulePath()));
+      W.write<uint32_t>(Flags);
+      W.write<uint32_t>(FS ? FS->instCount() : 0);
+      W.write<uint32_t>(FS ? FS->calls().size() : 0);
+    }
+  }
+
+  uint32_t EdgeOffset = 0;
+  for (const auto &[GUID, Info] : Index) {
+    for (const auto &S : Info.SummaryList) {
+      W.write<uint32_t>(EdgeOffset);
+      if (auto *FS = dyn_cast<FunctionSummary>(S.get()))
+        EdgeOffset += FS->calls().size();
+      EdgeOffset += S->refs().size();
+    }
+  }
+  W.write<uint32_t>(EdgeOffset);
+
+  // Every value that a summary refers to has an entry in the global value map.
+  auto WriteEdge = [&](ValueInfo VI) {
+    auto It = GUIDIds.find(VI.getGUID());
+    assert(It != GUIDIds.end() && "edge to a GUID without a ValueInfo");
+    W.write<uint32_t>(It->second);
+  };
+  for (const auto &[GUID, Info] : Index) {
+    for (const auto &S : Info.SummaryList) {
+      if (auto *FS = dyn_cast<FunctionSummary>(S.get()))
+        for (const auto &Edge : FS->calls())
+          WriteEdge(Edge.first);
+      for (ValueInfo VI : S->refs())
+        WriteEdge(VI);
+    }
+  }
+
+  for (StringRef Path : ModulePaths)
+    OS << Path;
+}
+
+template <typename T>
+static Error consume(StringRef &Data, uint64_t Count, ArrayRef<T> &Result,
+                     const char *What) {
+  if (Count > Data.size() / sizeof(T))
+    return createStringError(inconvertibleErrorCode(),
+                             "flat summary index: truncated %s table", What);
+  Result = ArrayRef(reinterpret_cast<const T *>(Data.data()), Count);
+  Data = Data.drop_front(Count * sizeof(T));
+  return Error::success();
+}
+
+Expected<FlatSummaryIndex> FlatSummaryIndex::create(MemoryBufferRef Buffer) {
+  StringRef Data = Buffer.getBuffer();
+  if (Data.size() < sizeof(Header) ||
+      memcmp(Data.data(), Magic, sizeof(Magic)) != 0)
+    return createStringError(inconvertibleErrorCode(),
+                             "flat summary index: invalid magic");
+
+  FlatSummaryIndex Result;
+  Result.Hdr = reinterpret_cast<const Header *>(Data.data());
+  if (Result.Hdr->Version != Version)
+    return createStringError(inconvertibleErrorCode(),
+                             "flat summary index: unsupported version %u",
+                             uint32_t(Result.Hdr->Version));
+  Data = Data.drop_front(sizeof(Header));
+
+  const Header &H = *Result.Hdr;
+  if (Error E = consume(Data, H.NumModules, Result.Modules, "module"))
+    return std::move(E);
+  if (Error E = consume(Data, H.NumGUIDs, Result.GUIDs, "GUID"))
+    return std::move(E);
+  if (Error E = consume(Data, uint64_t(H.NumGUIDs) + 1, Result.SummaryOffsets,
+                        "summary offset"))
+    return std::move(E);
+  if (Error E = consume(Data, H.NumSummaries, Result.Summaries, "summary"))
+    return std::move(E);
+  if (Error E = consume(Data, uint64_t(H.NumSummaries) + 1, Result.EdgeOffsets,
+                        "edge offset"))
+    return std::move(E);
+  if (Error E = consume(Data, H.NumEdges, Result.Edges, "edge"))
+    return std::move(E);
+  if (Data.size() < H.StrtabSize)
+    return createStringError(inconvertibleErrorCode(),
+                             "flat summary index: truncated string table");
+  Result.Strtab = Data.take_front(H.StrtabSize);
+
+  if (Result.SummaryOffsets.back() != H.NumSummaries ||
+      Result.EdgeOffsets.back() != H.NumEdges)
+    return createStringError(inconvertibleErrorCode(),
+                             "flat summary index: inconsistent offset tables");
+  for (const ModuleEntry &M : Result.Modules)
+    if (uint64_t(M.PathOffset) + M.PathSize > H.StrtabSize)
+      return createStringError(inconvertibleErrorCode(),
+                               "flat summary index: invalid module path");
+  return Result;
+}
+
+std::optional<uint32_t>
+FlatSummaryIndex::findGUID(GlobalValue::GUID GUID) const {
+  auto It = llvm::partition_point(
+      GUIDs, [&](support::ulittle64_t G) { return G < GUID; });
+  if (It == GUIDs.end() || *It != GUID)
+    return std::nullopt;
+  return It - GUIDs.begin();
+}
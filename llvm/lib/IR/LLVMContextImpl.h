@@ -1495,6 +1495,11 @@ public:
 
   DenseMap<const Value *, ValueName *> ValueNames;
 
+  // The uniquing tables below are not synchronized. Sharding them alone would
+  // not make concurrent IR construction safe: creating a constant also adds
+  // uses to its operands, and use lists, value names and metadata tracking are
+  // updated without locks as well. Clients needing concurrency use one context
+  // per thread (see orc::ThreadSafeContext).
   DenseMap<unsigned, std::unique_ptr<ConstantInt>> IntZeroConstants;
   DenseMap<unsigned, std::unique_ptr<ConstantInt>> IntOneConstants;
   DenseMap<APInt, std::unique_ptr<ConstantInt>> IntConstants;
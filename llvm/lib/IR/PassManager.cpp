@@ -109,6 +109,10 @@ PreservedAnalyses ModuleToFunctionPassAdaptor::run(Module &M,
   // instrumenting callbacks for the passes later.
   PassInstrumentation PI = AM.getResult<PassInstrumentationAnalysis>(M);
 
+  // Functions are visited one at a time. Even passes that only touch a single
+  // function create constants and types in the shared LLVMContext and update
+  // the use lists of globals, and the FunctionAnalysisManager and the
+  // instrumentation callbacks are not thread-safe either.
   PreservedAnalyses PA = PreservedAnalyses::all();
   for (Function &F : M) {
     if (F.isDeclaration())
@@ -35,13 +35,15 @@
 #include "llvm/Linker/IRMover.h"
 #include "llvm/MC/TargetRegistry.h"
 #include "llvm/Object/IRObjectFile.h"
+#include "llvm/Support/BLAKE3.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/ManagedStatic.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
-#include "llvm/Support/SHA1.h"
+#include "llvm/Support/Program.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/Threading.h"
@@ -69,6 +71,11 @@ static cl::opt<bool>
     DumpThinCGSCCs("dump-thin-cg-sccs", cl::init(false), cl::Hidden,
                    cl::desc("Dump the SCCs in the ThinLTO index's callgraph"));
 
+static cl::opt<bool> ThinLTOPinToNUMANodes(
+    "thinlto-pin-to-numa-nodes", cl::init(false), cl::Hidden,
+    cl::desc("Pin the in-process ThinLTO backend threads to the CPUs of one "
+             "NUMA node each"));
+
 namespace llvm {
 /// Enable global value internalization in LTO.
 cl::opt<bool> EnableLTOInternalization(
@@ -98,7 +105,9 @@ void llvm::computeLTOCacheKey(
   // This is based on the current compiler version, the module itself, the
   // export list, the hash for every single module in the import list, the
   // list of ResolvedODR for the module, and the list of preserved symbols.
-  SHA1 Hasher;
+  // This is not a security boundary, so use BLAKE3 for its speed; the key
+  // keeps the length of the SHA1 key it replaced.
+  BLAKE3 Hasher;
 
   // Start with the compiler revision
   Hasher.update(LLVM_VERSION_STRING);
@@ -343,7 +352,7 @@ void llvm::computeLTOCacheKey(
     }
   }
 
-  Key = toHex(Hasher.result());
+  Key = toHex(Hasher.result<20>());
 }
 
 static void thinLTOResolvePrevailingGUID(
@@ -1441,6 +1450,23 @@ public:
           GlobalValue::getGUID(GlobalValue::dropLLVMManglingEscape(Name)));
   }
 
+  // Optimizes and compiles one module, writing the object file to AddStream.
+  // This is only called on a cache miss.
+  virtual Error
+  runBackend(AddStreamFn AddStream, unsigned Task, BitcodeModule BM,
+             ModuleSummaryIndex &CombinedIndex,
+             const FunctionImporter::ImportMapTy &ImportList,
+             const GVSummaryMapTy &DefinedGlobals,
+             MapVector<StringRef, BitcodeModule> &ModuleMap) {
+    LTOLLVMContext BackendContext(Conf);
+    Expected<std::unique_ptr<Module>> MOrErr = BM.parseModule(BackendContext);
+    if (!MOrErr)
+      return MOrErr.takeError();
+
+    return thinBackend(Conf, Task, AddStream, **MOrErr, CombinedIndex,
+                       ImportList, DefinedGlobals, &ModuleMap);
+  }
+
   Error runThinLTOBackendThread(
       AddStreamFn AddStream, FileCache Cache, unsigned Task, BitcodeModule BM,
       ModuleSummaryIndex &CombinedIndex,
@@ -1450,13 +1476,8 @@ public:
       const GVSummaryMapTy &DefinedGlobals,
       MapVector<StringRef, BitcodeModule> &ModuleMap) {
     auto RunThinBackend = [&](AddStreamFn AddStream) {
-      LTOLLVMContext BackendContext(Conf);
-      Expected<std::unique_ptr<Module>> MOrErr = BM.parseModule(BackendContext);
-      if (!MOrErr)
-        return MOrErr.takeError();
-
-      return thinBackend(Conf, Task, AddStream, **MOrErr, CombinedIndex,
-                         ImportList, DefinedGlobals, &ModuleMap);
+      return runBackend(AddStream, Task, BM, CombinedIndex, ImportList,
+                        DefinedGlobals, ModuleMap);
     };
 
     auto ModuleID = BM.getModuleIdentifier();
@@ -1548,6 +1569,8 @@ ThinBackend lto::createInProcessThinBackend(ThreadPoolStrategy Parallelism,
                                             lto::IndexWriteCallback OnWrite,
                                             bool ShouldEmitIndexFiles,
                                             bool ShouldEmitImportsFiles) {
+  if (ThinLTOPinToNUMANodes)
+    Parallelism.PinToNUMANodes = true;
   return
       [=](const Config &Conf, ModuleSummaryIndex &CombinedIndex,
           const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries,
@@ -1559,6 +1582,150 @@ ThinBackend lto::createInProcessThinBackend(ThreadPoolStrategy Parallelism,
       };
 }
 
+/// Returns the spelling of \p RM in llc's -relocation-model option.
+static StringRef getRelocModelName(Reloc::Model RM) {
+  switch (RM) {
+  case Reloc::Static:
+    return "static";
+  case Reloc::PIC_:
+    return "pic";
+  case Reloc::DynamicNoPIC:
+    return "dynamic-no-pic";
+  case Reloc::ROPI:
+    return "ropi";
+  case Reloc::RWPI:
+    return "rwpi";
+  case Reloc::ROPI_RWPI:
+    return "ropi-rwpi";
+  }
+  llvm_unreachable("unknown relocation model");
+}
+
+/// Returns the spelling of \p CM in llc's -code-model option.
+static StringRef getCodeModelName(CodeModel::Model CM) {
+  switch (CM) {
+  case CodeModel::Tiny:
+    return "tiny";
+  case CodeModel::Small:
+    return "small";
+  case CodeModel::Kernel:
+    return "kernel";
+  case CodeModel::Medium:
+    return "medium";
+  case CodeModel::Large:
+    return "large";
+  }
+  llvm_unreachable("unknown code model");
+}
+
+namespace {
+class OutOfProcessThinBackend : public InProcessThinBackend {
+  std::string Distributor;
+  std::vector<std::string> DistributorArgs;
+
+public:
+  OutOfProcessThinBackend(
+      const Config &Conf, ModuleSummaryIndex &CombinedIndex,
+      ThreadPoolStrategy ThinLTOParallelism,
+      const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+      AddStreamFn AddStream, FileCache Cache, lto::IndexWriteCallback OnWrite,
+      std::string Distributor, std::vector<std::string> DistributorArgs)
+      : InProcessThinBackend(Conf, CombinedIndex, ThinLTOParallelism,
+                             ModuleToDefinedGVSummaries, std::move(AddStream),
+                             std::move(Cache), OnWrite,
+                             /*ShouldEmitIndexFiles=*/false,
+                             /*ShouldEmitImportsFiles=*/true),
+        Distributor(std::move(Distributor)),
+        DistributorArgs(std::move(DistributorArgs)) {}
+
+  Error runBackend(AddStreamFn AddStream, unsigned Task, BitcodeModule BM,
+                   ModuleSummaryIndex &CombinedIndex,
+                   const FunctionImporter::ImportMapTy &ImportList,
+                   const GVSummaryMapTy &DefinedGlobals,
+                   MapVector<StringRef, BitcodeModule> &ModuleMap) override {
+    // A remote job can only refer to the module by its path. Modules that are
+    // not files on disk, such as archive members, are compiled in-process.
+    StringRef ModulePath = BM.getModuleIdentifier();
+    if (!sys::fs::is_regular_file(ModulePath))
+      return InProcessThinBackend::runBackend(AddStream, Task, BM,
+                                              CombinedIndex, ImportList,
+                                              DefinedGlobals, ModuleMap);
+
+    SmallString<128> JobPath;
+    if (std::error_code EC =
+            sys::fs::createTemporaryFile("thinlto-job", "", JobPath))
+      return errorCodeToError(EC);
+    std::string IndexPath = (Twine(JobPath) + ".thinlto.bc").str();
+    std::string ImportsPath = (Twine(JobPath) + ".imports").str();
+    std::string ObjectPath = (Twine(JobPath) + ".o").str();
+    FileRemover JobRemover(JobPath), IndexRemover(IndexPath),
+        ImportsRemover(ImportsPath), ObjectRemover(ObjectPath);
+
+    // Write the individual summary index of the module and the list of
+    // modules it imports from, which the distributor has to ship along.
+    if (Error E = emitFiles(ImportList, ModulePath, JobPath.str().str()))
+      return E;
+
+    // The job is compiled outside of this process, so it has to be told the
+    // code generation settings of the link.
+    std::vector<std::string> CodeGenArgs;
+    CodeGenArgs.push_back("-O" + utostr(Conf.OptLevel));
+    if (!Conf.CPU.empty())
+      CodeGenArgs.push_back("-mcpu=" + Conf.CPU);
+    if (!Conf.MAttrs.empty())
+      CodeGenArgs.push_back("-mattr=" + join(Conf.MAttrs, ","));
+    if (Conf.RelocModel)
+      CodeGenArgs.push_back(
+          ("-relocation-model=" + getRelocModelName(*Conf.RelocModel)).str());
+    if (Conf.CodeModel)
+      CodeGenArgs.push_back(
+          ("-code-model=" + getCodeModelName(*Conf.CodeModel)).str());
+
+    SmallVector<StringRef, 16> Args = {Distributor};
+    append_range(Args, DistributorArgs);
+    append_range(Args, CodeGenArgs);
+    append_range(Args, ArrayRef<StringRef>{ModulePath, IndexPath, ImportsPath,
+                                           ObjectPath});
+    std::string ErrMsg;
+    if (sys::ExecuteAndWait(Distributor, Args, /*Env=*/std::nullopt,
+                            /*Redirects=*/{}, /*SecondsToWait=*/0,
+                            /*MemoryLimit=*/0, &ErrMsg) != 0)
+      return createStringError(inconvertibleErrorCode(),
+                               "ThinLTO distributor '" + Distributor +
+                                   "' failed for " + ModulePath + ": " +
+                                   ErrMsg);
+
+    ErrorOr<std::unique_ptr<MemoryBuffer>> ObjectOrErr =
+        MemoryBuffer::getFile(ObjectPath);
+    if (std::error_code EC = ObjectOrErr.getError())
+      return createFileError(ObjectPath, EC);
+    Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+        AddStream(Task, ModulePath);
+    if (Error E = StreamOrErr.takeError())
+      return E;
+    *(*StreamOrErr)->OS << (*ObjectOrErr)->getBuffer();
+    return Error::success();
+  }
+};
+} // end anonymous namespace
+
+ThinBackend
+lto::createOutOfProcessThinBackend(ThreadPoolStrategy Parallelism,
+                                   StringRef Distributor,
+                                   ArrayRef<StringRef> DistributorArgs,
+                                   IndexWriteCallback OnWrite) {
+  std::vector<std::string> Args(DistributorArgs.begin(), DistributorArgs.end());
+  return
+      [=, Distributor = Distributor.str()](
+          const Config &Conf, ModuleSummaryIndex &CombinedIndex,
+          const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries,
+          AddStreamFn AddStream, FileCache Cache) {
+        return std::make_unique<OutOfProcessThinBackend>(
+            Conf, CombinedIndex, Parallelism, ModuleToDefinedGVSummaries,
+            AddStream, Cache, OnWrite, Distributor, Args);
+      };
+}
+
 StringLiteral lto::getThinLTODefaultCPU(const Triple &TheTriple) {
   if (!TheTriple.isOSDarwin())
     return "";
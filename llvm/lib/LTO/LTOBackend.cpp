@@ -235,8 +235,8 @@ createTargetMachine(const Config &Conf, const Target *TheTarget, Module &M) {
 }
 
 static void runNewPMPasses(const Config &Conf, Module &Mod, TargetMachine *TM,
-                           unsigned OptLevel, bool IsThinLTO,
-                           ModuleSummaryIndex *ExportSummary,
+                           unsigned OptLevel, StringRef OptPipeline,
+                           bool IsThinLTO, ModuleSummaryIndex *ExportSummary,
                            const ModuleSummaryIndex *ImportSummary) {
   auto FS = vfs::getRealFileSystem();
   std::optional<PGOOptions> PGOOpt;
@@ -325,10 +325,10 @@ static void runNewPMPasses(const Config &Conf, Module &Mod, TargetMachine *TM,
   }
 
   // Parse a custom pipeline if asked to.
-  if (!Conf.OptPipeline.empty()) {
-    if (auto Err = PB.parsePassPipeline(MPM, Conf.OptPipeline)) {
+  if (!OptPipeline.empty()) {
+    if (auto Err = PB.parsePassPipeline(MPM, OptPipeline)) {
       report_fatal_error(Twine("unable to parse pass pipeline description '") +
-                         Conf.OptPipeline + "': " + toString(std::move(Err)));
+                         OptPipeline + "': " + toString(std::move(Err)));
     }
   } else if (IsThinLTO) {
     MPM.addPass(PB.buildThinLTODefaultPipeline(OL, ImportSummary));
@@ -364,8 +364,8 @@ bool lto::opt(const Config &Conf, TargetMachine *TM, unsigned Task, Module &Mod,
                                /*Cmdline*/ CmdArgs);
   }
   // FIXME: Plumb the combined index into the new pass manager.
-  runNewPMPasses(Conf, Mod, TM, Conf.OptLevel, IsThinLTO, ExportSummary,
-                 ImportSummary);
+  runNewPMPasses(Conf, Mod, TM, Conf.OptLevel, Conf.OptPipeline, IsThinLTO,
+                 ExportSummary, ImportSummary);
   return !Conf.PostOptModuleHook || Conf.PostOptModuleHook(Task, Mod);
 }
 
@@ -462,6 +462,12 @@ static void splitCodeGen(const Config &C, TargetMachine *TM,
               std::unique_ptr<TargetMachine> TM =
                   createTargetMachine(C, T, *MPartInCtx);
 
+              if (!C.CodeGenOnly && !C.PartitionOptPipeline.empty())
+                runNewPMPasses(C, *MPartInCtx, TM.get(), C.OptLevel,
+                               C.PartitionOptPipeline, /*IsThinLTO=*/false,
+                               /*ExportSummary=*/nullptr,
+                               /*ImportSummary=*/nullptr);
+
               codegen(C, TM.get(), AddStream, ThreadId, *MPartInCtx,
                       CombinedIndex);
             },
@@ -526,6 +532,10 @@ Error lto::backend(const Config &C, AddStreamFn AddStream,
   }
 
   if (ParallelCodeGenParallelismLevel == 1) {
+    if (!C.CodeGenOnly && !C.PartitionOptPipeline.empty())
+      runNewPMPasses(C, Mod, TM.get(), C.OptLevel, C.PartitionOptPipeline,
+                     /*IsThinLTO=*/false, /*ExportSummary=*/nullptr,
+                     /*ImportSummary=*/nullptr);
     codegen(C, TM.get(), AddStream, 0, Mod, CombinedIndex);
   } else {
     splitCodeGen(C, TM.get(), AddStream, ParallelCodeGenParallelismLevel, Mod,
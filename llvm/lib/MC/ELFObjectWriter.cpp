@@ -39,6 +39,7 @@
 #include "llvm/MC/StringTableBuilder.h"
 #include "llvm/Support/Alignment.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compression.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/EndianStream.h"
@@ -46,6 +47,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SMLoc.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/TargetParser/Host.h"
@@ -870,6 +872,40 @@ bool ELFWriter::maybeWriteCompression(
   return true;
 }
 
+static cl::opt<bool> ParallelDebugCompression(
+    "parallel-debug-compression", cl::Hidden, cl::init(false),
+    cl::desc("Compress large zstd debug sections in 1 MiB shards on the "
+             "parallel thread pool"));
+
+// Compress a debug section. With -parallel-debug-compression, large zstd
+// sections are split into 1 MiB shards that are compressed in parallel into
+// independent frames: a concatenation of zstd frames is a valid
+// ELFCOMPRESS_ZSTD payload, and the fixed shard size keeps the output
+// independent of the number of threads.
+static void compressDebugSection(DebugCompressionType CompressionType,
+                                 ArrayRef<uint8_t> Uncompressed,
+                                 SmallVectorImpl<uint8_t> &Compressed) {
+  constexpr size_t ShardSize = 1 << 20;
+  if (!ParallelDebugCompression ||
+      CompressionType != DebugCompressionType::Zstd ||
+      Uncompressed.size() <= ShardSize) {
+    compression::compress(compression::Params(CompressionType), Uncompressed,
+                          Compressed);
+    return;
+  }
+
+  size_t NumShards = divideCeil(Uncompressed.size(), ShardSize);
+  std::vector<SmallVector<uint8_t, 0>> Shards(NumShards);
+  parallelFor(0, NumShards, [&](size_t I) {
+    ArrayRef<uint8_t> Shard =
+        Uncompressed.slice(I * ShardSize).take_front(ShardSize);
+    compression::compress(compression::Params(CompressionType), Shard,
+                          Shards[I]);
+  });
+  for (const SmallVector<uint8_t, 0> &Shard : Shards)
+    Compressed.append(Shard.begin(), Shard.end());
+}
+
 void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
                                  const MCAsmLayout &Layout) {
   MCSectionELF &Section = static_cast<MCSectionELF &>(Sec);
@@ -903,8 +939,7 @@ void ELFWriter::writeSectionData(const MCAssembler &Asm, MCSection &Sec,
     ChType = ELF::ELFCOMPRESS_ZSTD;
     break;
   }
-  compression::compress(compression::Params(CompressionType), Uncompressed,
-                        Compressed);
+  compressDebugSection(CompressionType, Uncompressed, Compressed);
   if (!maybeWriteCompression(ChType, UncompressedData.size(), Compressed,
                              Sec.getAlign())) {
     W.OS << UncompressedData;
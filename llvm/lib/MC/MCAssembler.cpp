@@ -8,6 +8,7 @@
 
 #include "llvm/MC/MCAssembler.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
@@ -70,6 +71,8 @@ STATISTIC(FragmentLayouts, "Number of fragment layouts");
 STATISTIC(ObjectBytes, "Number of emitted object file bytes");
 STATISTIC(RelaxationSteps, "Number of assembler layout and relaxation steps");
 STATISTIC(RelaxedInstructions, "Number of relaxed instructions");
+STATISTIC(FixedSizeSections,
+          "Number of sections left out of relaxation as fixed-size");
 
 } // end namespace stats
 } // end anonymous namespace
@@ -840,15 +843,38 @@ void MCAssembler::layout(MCAsmLayout &Layout) {
       Frag.setLayoutOrder(FragmentIndex++);
   }
 
+  // Sections that only hold fragments whose size is known up front, e.g. code
+  // without relaxable branches, can never change during relaxation. Leave them
+  // out of the relaxation loop.
+  SmallVector<MCSection *, 16> RelaxableSections;
+  for (MCSection &Sec : *this) {
+    if (llvm::any_of(Sec, [](const MCFragment &F) {
+          switch (F.getKind()) {
+          case MCFragment::FT_Align:
+          case MCFragment::FT_Data:
+          case MCFragment::FT_CompactEncodedInst:
+          case MCFragment::FT_Nops:
+          case MCFragment::FT_SymbolId:
+          case MCFragment::FT_Dummy:
+            return false;
+          default:
+            return true;
+          }
+        }))
+      RelaxableSections.push_back(&Sec);
+    else
+      ++stats::FixedSizeSections;
+  }
+
   // Layout until everything fits.
-  while (layoutOnce(Layout)) {
+  while (layoutOnce(Layout, RelaxableSections)) {
     if (getContext().hadError())
       return;
     // Size of fragments in one section can depend on the size of fragments in
     // another. If any fragment has changed size, we have to re-layout (and
     // as a result possibly further relax) all.
-    for (MCSection &Sec : *this)
-      Layout.invalidateFragmentsFrom(&*Sec.begin());
+    for (MCSection *Sec : RelaxableSections)
+      Layout.invalidateFragmentsFrom(&*Sec->begin());
   }
 
   DEBUG_WITH_TYPE("mc-dump", {
@@ -1240,12 +1266,13 @@ bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec) {
   return false;
 }
 
-bool MCAssembler::layoutOnce(MCAsmLayout &Layout) {
+bool MCAssembler::layoutOnce(MCAsmLayout &Layout,
+                             ArrayRef<MCSection *> Sections) {
   ++stats::RelaxationSteps;
 
   bool WasRelaxed = false;
-  for (MCSection &Sec : *this) {
-    while (layoutSectionOnce(Layout, Sec))
+  for (MCSection *Sec : Sections) {
+    while (layoutSectionOnce(Layout, *Sec))
       WasRelaxed = true;
   }
 
@@ -554,20 +554,7 @@ InstrBuilder::createInstrDescImpl(const MCInst &MCI,
   ID->NumMicroOps = SCDesc.NumMicroOps;
   ID->SchedClassID = SchedClassID;
 
-  if (MCDesc.isCall() && FirstCallInst) {
-    // We don't correctly model calls.
-    WithColor::warning() << "found a call in the input assembly sequence.\n";
-    WithColor::note() << "call instructions are not correctly modeled. "
-                      << "Assume a latency of 100cy.\n";
-    FirstCallInst = false;
-  }
-
-  if (MCDesc.isReturn() && FirstReturnInst) {
-    WithColor::warning() << "found a return instruction in the input"
-                         << " assembly sequence.\n";
-    WithColor::note() << "program counter updates are ignored.\n";
-    FirstReturnInst = false;
-  }
+  warnOnCallOrReturn(MCDesc);
 
   initializeUsedResources(*ID, SCDesc, STI, ProcResourceMasks);
   computeMaxLatency(*ID, MCDesc, SCDesc, STI);
@@ -598,6 +585,23 @@ InstrBuilder::createInstrDescImpl(const MCInst &MCI,
   return *VariantDescriptors[VDKey];
 }
 
+void InstrBuilder::warnOnCallOrReturn(const MCInstrDesc &MCDesc) {
+  if (MCDesc.isCall() && FirstCallInst) {
+    // We don't correctly model calls.
+    WithColor::warning() << "found a call in the input assembly sequence.\n";
+    WithColor::note() << "call instructions are not correctly modeled. "
+                      << "Assume a latency of 100cy.\n";
+    FirstCallInst = false;
+  }
+
+  if (MCDesc.isReturn() && FirstReturnInst) {
+    WithColor::warning() << "found a return instruction in the input"
+                         << " assembly sequence.\n";
+    WithColor::note() << "program counter updates are ignored.\n";
+    FirstReturnInst = false;
+  }
+}
+
 Expected<const InstrDesc &>
 InstrBuilder::getOrCreateInstrDesc(const MCInst &MCI,
                                    const SmallVector<Instrument *> &IVec) {
@@ -605,8 +609,11 @@ InstrBuilder::getOrCreateInstrDesc(const MCInst &MCI,
   unsigned SchedClassID = IM.getSchedClassID(MCII, MCI, IVec);
 
   auto DKey = std::make_pair(MCI.getOpcode(), SchedClassID);
-  if (Descriptors.find_as(DKey) != Descriptors.end())
-    return *Descriptors[DKey];
+  if (auto It = Descriptors.find(DKey); It != Descriptors.end()) {
+    // The descriptor may have been created for an earlier code region.
+    warnOnCallOrReturn(MCII.get(MCI.getOpcode()));
+    return *It->second;
+  }
 
   unsigned CPUID = STI.getSchedModel().getProcessorID();
   SchedClassID = STI.resolveVariantSchedClass(SchedClassID, &MCI, &MCII, CPUID);
@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorOr.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -220,6 +221,7 @@ Error Object::compressOrDecompressSections(const CommonConfig &Config) {
   // because it would mutate the sections array.
   SmallVector<std::pair<SectionBase *, std::function<SectionBase *()>>, 0>
       ToReplace;
+  SmallVector<std::pair<SectionBase *, DebugCompressionType>, 0> ToCompress;
   for (SectionBase &Sec : sections()) {
     std::optional<DebugCompressionType> CType;
     for (auto &[Matcher, T] : Config.compressSections)
@@ -247,16 +249,25 @@ Error Object::compressOrDecompressSections(const CommonConfig &Config) {
         ToReplace.emplace_back(
             &Sec, [=] { return &addSection<DecompressedSection>(*CS); });
     } else if (*CType != DebugCompressionType::None) {
-      ToReplace.emplace_back(&Sec, [=, S = &Sec] {
-        return &addSection<CompressedSection>(
-            CompressedSection(*S, *CType, Is64Bits));
-      });
+      ToCompress.emplace_back(&Sec, *CType);
     }
   }
 
+  // Compressing large debug sections dominates the run time, and each section
+  // is compressed independently, so do it concurrently before adding the
+  // results to the object.
+  std::vector<std::optional<CompressedSection>> Compressed(ToCompress.size());
+  parallelFor(0, ToCompress.size(), [&](size_t I) {
+    auto [S, CType] = ToCompress[I];
+    Compressed[I].emplace(*S, CType, Is64Bits);
+  });
+
   DenseMap<SectionBase *, SectionBase *> FromTo;
   for (auto [S, Func] : ToReplace)
     FromTo[S] = Func();
+  for (auto [I, Entry] : enumerate(ToCompress))
+    FromTo[Entry.first] =
+        &addSection<CompressedSection>(std::move(*Compressed[I]));
   return replaceSections(FromTo);
 }
 
@@ -31,6 +31,7 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/Format.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -704,10 +705,28 @@ bool isImportDescriptor(StringRef Name) {
           Name.ends_with(NullThunkDataSuffix));
 }
 
-static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
-                                                  uint16_t Index,
-                                                  raw_ostream &SymNames,
-                                                  SymMap *SymMap) {
+// Returns the names of the symbols of Obj that go into the archive symbol
+// table. This only reads Obj, so it may run concurrently for distinct objects.
+static Expected<std::vector<std::string>>
+getArchiveSymbolNames(SymbolicFile *Obj) {
+  std::vector<std::string> Ret;
+  if (Obj == nullptr)
+    return Ret;
+
+  for (const object::BasicSymbolRef &S : Obj->symbols()) {
+    if (!isArchiveSymbol(S))
+      continue;
+    raw_string_ostream NameStream(Ret.emplace_back());
+    if (Error E = S.printName(NameStream))
+      return std::move(E);
+  }
+  return Ret;
+}
+
+static std::vector<unsigned> getSymbols(SymbolicFile *Obj,
+                                        ArrayRef<std::string> Names,
+                                        uint16_t Index, raw_ostream &SymNames,
+                                        SymMap *SymMap) {
   std::vector<unsigned> Ret;
 
   if (Obj == nullptr)
@@ -717,14 +736,8 @@ static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
   if (SymMap)
     Map = SymMap->UseECMap && isECObject(*Obj) ? &SymMap->ECMap : &SymMap->Map;
 
-  for (const object::BasicSymbolRef &S : Obj->symbols()) {
-    if (!isArchiveSymbol(S))
-      continue;
+  for (const std::string &Name : Names) {
     if (Map) {
-      std::string Name;
-      raw_string_ostream NameStream(Name);
-      if (Error E = S.printName(NameStream))
-        return std::move(E);
       if (Map->find(Name) != Map->end())
         continue; // ignore duplicated symbol
       (*Map)[Name] = Index;
@@ -738,9 +751,7 @@ static Expected<std::vector<unsigned>> getSymbols(SymbolicFile *Obj,
       }
     } else {
       Ret.push_back(SymNames.tell());
-      if (Error E = S.printName(SymNames))
-        return std::move(E);
-      SymNames << '\0';
+      SymNames << Name << '\0';
     }
   }
   return Ret;
@@ -851,6 +862,37 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
     }
   }
 
+  // Reading the symbol names of every member dominates the time it takes to
+  // write a large archive. Object files are independent of each other, so
+  // extract their names concurrently. Bitcode files share Context, which is
+  // not thread-safe, so they are handled serially.
+  std::vector<std::vector<std::string>> SymbolNames(SymFiles.size());
+  if (NeedSymbols != SymtabWritingMode::NoSymtab) {
+    SmallVector<size_t, 0> ObjectIndices, BitcodeIndices;
+    for (size_t I = 0, E = SymFiles.size(); I != E; ++I) {
+      if (!SymFiles[I])
+        continue;
+      if (isa<IRObjectFile>(*SymFiles[I]))
+        BitcodeIndices.push_back(I);
+      else
+        ObjectIndices.push_back(I);
+    }
+    auto ExtractNames = [&](size_t I) -> Error {
+      Expected<std::vector<std::string>> NamesOrErr =
+          getArchiveSymbolNames(SymFiles[I].get());
+      if (!NamesOrErr)
+        return createFileError(NewMembers[I].MemberName,
+                               NamesOrErr.takeError());
+      SymbolNames[I] = std::move(*NamesOrErr);
+      return Error::success();
+    };
+    if (Error E = parallelForEachError(ObjectIndices, ExtractNames))
+      return std::move(E);
+    for (size_t I : BitcodeIndices)
+      if (Error E = ExtractNames(I))
+        return std::move(E);
+  }
+
   // The big archive format needs to know the offset of the previous member
   // header.
   uint64_t PrevOffset = 0;
@@ -933,11 +975,8 @@ computeMemberData(raw_ostream &StringTable, raw_ostream &SymNames,
 
     std::vector<unsigned> Symbols;
     if (NeedSymbols != SymtabWritingMode::NoSymtab) {
-      Expected<std::vector<unsigned>> SymbolsOrErr =
-          getSymbols(CurSymFile.get(), Index + 1, SymNames, SymMap);
-      if (!SymbolsOrErr)
-        return createFileError(M->MemberName, SymbolsOrErr.takeError());
-      Symbols = std::move(*SymbolsOrErr);
+      Symbols = getSymbols(CurSymFile.get(), SymbolNames[Index], Index + 1,
+                           SymNames, SymMap);
       if (CurSymFile)
         HasObject = true;
     }
@@ -1162,12 +1201,14 @@ writeArchiveToStream(raw_ostream &Out, ArrayRef<NewArchiveMember> NewMembers,
     if (ShouldWriteSymtab && NumSyms)
       // Generate the symbol names for the members.
       for (const auto &M : Data) {
-        Expected<std::vector<unsigned>> SymbolsOrErr = getSymbols(
-            M.SymFile.get(), 0,
-            is64BitSymbolicFile(M.SymFile.get()) ? SymNames64 : SymNames32,
-            nullptr);
-        if (!SymbolsOrErr)
-          return SymbolsOrErr.takeError();
+        Expected<std::vector<std::string>> NamesOrErr =
+            getArchiveSymbolNames(M.SymFile.get());
+        if (!NamesOrErr)
+          return NamesOrErr.takeError();
+        getSymbols(M.SymFile.get(), *NamesOrErr, 0,
+                   is64BitSymbolicFile(M.SymFile.get()) ? SymNames64
+                                                        : SymNames32,
+                   nullptr);
       }
 
     uint64_t MemberTableEndOffset =
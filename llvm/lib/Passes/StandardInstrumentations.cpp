@@ -19,6 +19,7 @@
 #include "llvm/Analysis/CallGraphSCCPass.h"
 #include "llvm/Analysis/LazyCallGraph.h"
 #include "llvm/Analysis/LoopInfo.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/CodeGen/MIRPrinter.h"
 #include "llvm/CodeGen/MachineFunction.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
@@ -137,6 +138,17 @@ static cl::opt<std::string> IRDumpDirectory(
              "files in this directory rather than written to stderr"),
     cl::Hidden, cl::value_desc("filename"));
 
+static cl::opt<unsigned> CompileTimeBudgetFunctionSize(
+    "compile-time-budget-function-size", cl::init(0), cl::Hidden,
+    cl::desc("Skip the passes listed by -compile-time-budget-passes on "
+             "functions with more instructions than this (0 = no limit)"));
+
+static cl::list<std::string> CompileTimeBudgetPasses(
+    "compile-time-budget-passes", cl::CommaSeparated, cl::Hidden,
+    cl::desc("Passes skipped on functions over "
+             "-compile-time-budget-function-size (defaults to a set of "
+             "passes that scale superlinearly with the function size)"));
+
 template <typename IRUnitT> static const IRUnitT *unwrapIR(Any IR) {
   const IRUnitT **IRPtr = llvm::any_cast<const IRUnitT *>(&IR);
   return IRPtr ? *IRPtr : nullptr;
@@ -1053,6 +1065,55 @@ bool OptNoneInstrumentation::shouldRun(StringRef PassID, Any IR) {
   return ShouldRun;
 }
 
+void CompileTimeBudgetInstrumentation::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (!CompileTimeBudgetFunctionSize)
+    return;
+
+  static const char *const DefaultBudgetedPasses[] = {
+      "gvn",       "newgvn",         "instcombine",    "dse",
+      "memcpyopt", "loop-vectorize", "slp-vectorizer", "loop-distribute",
+      "loop-load-elim"};
+  if (CompileTimeBudgetPasses.empty())
+    BudgetedPasses.insert(std::begin(DefaultBudgetedPasses),
+                          std::end(DefaultBudgetedPasses));
+  else
+    BudgetedPasses.insert(CompileTimeBudgetPasses.begin(),
+                          CompileTimeBudgetPasses.end());
+
+  PIC.registerShouldRunOptionalPassCallback([this, &PIC](StringRef P, Any IR) {
+    return this->shouldRun(PIC.getPassNameForClassName(P), IR);
+  });
+}
+
+bool CompileTimeBudgetInstrumentation::shouldRun(StringRef PassName, Any IR) {
+  if (!BudgetedPasses.contains(PassName))
+    return true;
+  const auto *F = unwrapIR<Function>(IR);
+  if (!F) {
+    if (const auto *L = unwrapIR<Loop>(IR))
+      F = L->getHeader()->getParent();
+  }
+  if (!F)
+    return true;
+  unsigned Size = F->getInstructionCount();
+  if (Size <= CompileTimeBudgetFunctionSize)
+    return true;
+
+  if (DebugLogging)
+    errs() << "Skipping pass " << PassName << " on " << F->getName()
+           << " due to its size (" << Size << " instructions)\n";
+  LLVMContext &Ctx = F->getContext();
+  if (Ctx.getDiagHandlerPtr()->isAnalysisRemarkEnabled("compile-time-budget"))
+    Ctx.diagnose(OptimizationRemarkAnalysis("compile-time-budget",
+                                            "PassSkipped", F)
+                 << "skipped " << PassName << " on a function with "
+                 << ore::NV("NumInstructions", Size)
+                 << " instructions, over the budget of "
+                 << ore::NV("Budget", unsigned(CompileTimeBudgetFunctionSize)));
+  return false;
+}
+
 bool OptPassGateInstrumentation::shouldRun(StringRef PassName, Any IR) {
   if (isIgnored(PassName))
     return true;
@@ -2425,7 +2486,7 @@ StandardInstrumentations::StandardInstrumentations(
     LLVMContext &Context, bool DebugLogging, bool VerifyEach,
     PrintPassOptions PrintPassOpts)
     : PrintPass(DebugLogging, PrintPassOpts),
-      OptNone(DebugLogging),
+      OptNone(DebugLogging), CompileTimeBudget(DebugLogging),
       OptPassGate(Context),
       PrintChangedIR(PrintChanged == ChangePrinter::Verbose),
       PrintChangedDiff(PrintChanged == ChangePrinter::DiffVerbose ||
@@ -2499,6 +2560,7 @@ void StandardInstrumentations::registerCallbacks(
   PrintPass.registerCallbacks(PIC);
   TimePasses.registerCallbacks(PIC);
   OptNone.registerCallbacks(PIC);
+  CompileTimeBudget.registerCallbacks(PIC);
   OptPassGate.registerCallbacks(PIC);
   PrintChangedIR.registerCallbacks(PIC);
   PseudoProbeVerification.registerCallbacks(PIC);
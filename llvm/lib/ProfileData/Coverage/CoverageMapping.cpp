@@ -843,6 +843,16 @@ Error CoverageMapping::loadFunctionRecord(
       Record.MappingRegions[0].Count.isZero() && Counts[0] > 0)
     return Error::success();
 
+  // Don't create records for (filenames, function) pairs we've already seen.
+  // Functions defined in headers show up in every object that uses them, so
+  // check this before evaluating the regions of the duplicate.
+  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
+                                          Record.Filenames.end());
+  auto &SeenFunctions = RecordProvenance[FilenamesHash];
+  auto FuncNameHash = hash_value(OrigFuncName);
+  if (SeenFunctions.contains(FuncNameHash))
+    return Error::success();
+
   MCDCDecisionRecorder MCDCDecisions;
   FunctionRecord Function(OrigFuncName, Record.Filenames);
   for (const auto &Region : Record.MappingRegions) {
@@ -896,12 +906,7 @@ Error CoverageMapping::loadFunctionRecord(
     Function.pushMCDCRecord(std::move(*Record));
   }
 
-  // Don't create records for (filenames, function) pairs we've already seen.
-  auto FilenamesHash = hash_combine_range(Record.Filenames.begin(),
-                                          Record.Filenames.end());
-  if (!RecordProvenance[FilenamesHash].insert(hash_value(OrigFuncName)).second)
-    return Error::success();
-
+  SeenFunctions.insert(FuncNameHash);
   Functions.push_back(std::move(Function));
 
   // Performance optimization: keep track of the indices of the function records
@@ -991,18 +991,20 @@ std::vector<BPFunctionNode> TemporalProfTraceTy::createBPFunctionNodes(
   // TODO: We need to use the Trace.Weight field to give more weight to more
   // important utilities
   DenseMap<IDT, SmallVector<UtilityNodeT, 4>> FuncGroups;
+  FuncGroups.reserve(FunctionIds.size());
   for (size_t TraceIdx = 0; TraceIdx < Traces.size(); TraceIdx++) {
     auto &Trace = Traces[TraceIdx].FunctionNameRefs;
     for (size_t Timestamp = 0; Timestamp < Trace.size(); Timestamp++) {
+      auto &Groups = FuncGroups[Trace[Timestamp]];
       for (int I = Log2_64(Timestamp + 1); I < N; I++) {
-        auto FunctionId = Trace[Timestamp];
         UtilityNodeT GroupId = TraceIdx * N + I;
-        FuncGroups[FunctionId].push_back(GroupId);
+        Groups.push_back(GroupId);
       }
     }
   }
 
   std::vector<BPFunctionNode> Nodes;
+  Nodes.reserve(FunctionIds.size());
   for (auto Id : FunctionIds) {
     auto &UNs = FuncGroups[Id];
     llvm::sort(UNs);
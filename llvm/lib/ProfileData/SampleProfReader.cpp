@@ -1800,9 +1800,13 @@ SampleProfileReaderItaniumRemapper::lookUpNameInProfile(StringRef Fname) {
 ///
 /// \returns an error code indicating the status of the buffer.
 static ErrorOr<std::unique_ptr<MemoryBuffer>>
-setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS) {
-  auto BufferOrErr = Filename.str() == "-" ? MemoryBuffer::getSTDIN()
-                                           : FS.getBufferForFile(Filename);
+setupMemoryBuffer(const Twine &Filename, vfs::FileSystem &FS,
+                  bool RequiresNullTerminator = true) {
+  auto BufferOrErr =
+      Filename.str() == "-"
+          ? MemoryBuffer::getSTDIN()
+          : FS.getBufferForFile(Filename, /*FileSize=*/-1,
+                                RequiresNullTerminator);
   if (std::error_code EC = BufferOrErr.getError())
     return EC;
   auto Buffer = std::move(BufferOrErr.get());
@@ -1825,9 +1829,22 @@ ErrorOr<std::unique_ptr<SampleProfileReader>>
 SampleProfileReader::create(const std::string Filename, LLVMContext &C,
                             vfs::FileSystem &FS, FSDiscriminatorPass P,
                             const std::string RemapFilename) {
-  auto BufferOrError = setupMemoryBuffer(Filename, FS);
+  // The binary formats do not need a null terminator. Requiring one would
+  // force a heap copy of the whole profile whenever its size is a multiple of
+  // the page size, instead of a mapping that concurrent compiles can share.
+  // The text format is parsed with line_iterator, which does need it.
+  auto BufferOrError =
+      setupMemoryBuffer(Filename, FS, /*RequiresNullTerminator=*/false);
   if (std::error_code EC = BufferOrError.getError())
     return EC;
+  const MemoryBuffer &Buffer = *BufferOrError.get();
+  if (Filename != "-" && !SampleProfileReaderRawBinary::hasFormat(Buffer) &&
+      !SampleProfileReaderExtBinary::hasFormat(Buffer) &&
+      !SampleProfileReaderGCC::hasFormat(Buffer)) {
+    BufferOrError = setupMemoryBuffer(Filename, FS);
+    if (std::error_code EC = BufferOrError.getError())
+      return EC;
+  }
   return create(BufferOrError.get(), C, FS, P, RemapFilename);
 }
 
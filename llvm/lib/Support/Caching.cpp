@@ -9,6 +9,7 @@
 // This file implements the localCache function, which simplifies creating,
 // adding to, and querying a local file system cache. localCache takes care of
 // periodically pruning older files from the cache using a CachePruningPolicy.
+// sharedCache layers a directory shared between hosts on top of a local cache.
 //
 //===----------------------------------------------------------------------===//
 
@@ -168,3 +169,90 @@ Expected<FileCache> llvm::localCache(const Twine &CacheNameRef,
     };
   };
 }
+
+Expected<FileCache> llvm::sharedCache(const Twine &CacheNameRef,
+                                      const Twine &TempFilePrefixRef,
+                                      const Twine &CacheDirectoryPathRef,
+                                      const Twine &SharedDirectoryPathRef,
+                                      AddBufferFn AddBuffer) {
+  Expected<FileCache> LocalOrErr = localCache(
+      CacheNameRef, TempFilePrefixRef, CacheDirectoryPathRef, AddBuffer);
+  if (!LocalOrErr)
+    return LocalOrErr.takeError();
+  FileCache Local = std::move(*LocalOrErr);
+
+  SmallString<64> TempFilePrefix, SharedDirectoryPath;
+  TempFilePrefixRef.toVector(TempFilePrefix);
+  SharedDirectoryPathRef.toVector(SharedDirectoryPath);
+
+  // This file stream publishes the entry to the shared directory once the
+  // wrapped local cache stream has committed it.
+  struct PublishStream : CachedFileStream {
+    std::unique_ptr<CachedFileStream> Local;
+    std::string SharedPath;
+    SmallString<64> TempFilenameModel;
+
+    PublishStream(std::unique_ptr<CachedFileStream> Local,
+                  std::string SharedPath, SmallString<64> TempFilenameModel)
+        : CachedFileStream(std::move(Local->OS), Local->ObjectPathName),
+          Local(std::move(Local)), SharedPath(std::move(SharedPath)),
+          TempFilenameModel(std::move(TempFilenameModel)) {}
+
+    ~PublishStream() {
+      Local->OS = std::move(OS);
+      Local.reset();
+
+      // Publishing is best effort: a failure only means that other hosts miss.
+      // Copy to a temporary first so that readers never see a partial entry.
+      if (sys::fs::create_directories(sys::path::parent_path(SharedPath),
+                                      /*IgnoreExisting=*/true))
+        return;
+      int FD;
+      SmallString<64> TempPath;
+      if (sys::fs::createUniqueFile(TempFilenameModel, FD, TempPath))
+        return;
+      sys::fs::closeFile(FD);
+      if (sys::fs::copy_file(ObjectPathName, TempPath) ||
+          sys::fs::rename(TempPath, SharedPath))
+        sys::fs::remove(TempPath);
+    }
+  };
+
+  return [=](unsigned Task, StringRef Key,
+             const Twine &ModuleName) -> Expected<AddStreamFn> {
+    Expected<AddStreamFn> AddStreamOrErr = Local(Task, Key, ModuleName);
+    if (!AddStreamOrErr || !*AddStreamOrErr)
+      return AddStreamOrErr;
+    AddStreamFn LocalAddStream = std::move(*AddStreamOrErr);
+
+    SmallString<64> SharedPath;
+    sys::path::append(SharedPath, SharedDirectoryPath, "llvmcache-" + Key);
+    ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+        MemoryBuffer::getFile(SharedPath, /*IsText=*/false,
+                              /*RequiresNullTerminator=*/false);
+    if (MBOrErr) {
+      // Copy the shared entry into the local cache. Committing the local
+      // stream adds the file to the link.
+      Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+          LocalAddStream(Task, ModuleName);
+      if (!StreamOrErr)
+        return StreamOrErr.takeError();
+      *(*StreamOrErr)->OS << (*MBOrErr)->getBuffer();
+      return AddStreamFn();
+    }
+
+    SmallString<64> TempFilenameModel;
+    sys::path::append(TempFilenameModel, SharedDirectoryPath,
+                      TempFilePrefix + "-%%%%%%.tmp.o");
+    return [=](size_t Task, const Twine &ModuleName)
+               -> Expected<std::unique_ptr<CachedFileStream>> {
+      Expected<std::unique_ptr<CachedFileStream>> StreamOrErr =
+          LocalAddStream(Task, ModuleName);
+      if (!StreamOrErr)
+        return StreamOrErr.takeError();
+      return std::make_unique<PublishStream>(std::move(*StreamOrErr),
+                                             std::string(SharedPath),
+                                             TempFilenameModel);
+    };
+  };
+}
@@ -41,7 +41,9 @@
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
+#include <atomic>
 #include <cstdlib>
+#include <mutex>
 #include <optional>
 #include <string>
 using namespace llvm;
@@ -164,8 +166,45 @@ public:
   // This collects the different subcommands that have been registered.
   SmallPtrSet<SubCommand *, 4> RegisteredSubCommands;
 
+  // Options are queued here until the option tables are first needed, which
+  // normally happens when the command line is parsed. Most options are
+  // registered from static constructors, and inserting each of them into the
+  // OptionsMap of its subcommands at load time is a measurable part of the
+  // startup cost of short-lived tools and of libLLVM users that never parse a
+  // command line at all. Once the queue has been drained, options register
+  // immediately.
+  //
+  // The queue may be drained by the first query of the option tables from any
+  // thread (e.g. getRegisteredOptions() called concurrently by two users of
+  // libLLVM), so draining is guarded by MaterializeMutex. Creating or
+  // destroying options concurrently with other command line operations is not
+  // supported, as before.
+  std::vector<Option *> PendingOptions;
+  std::atomic<bool> DeferRegistration = true;
+  std::mutex MaterializeMutex;
+
   CommandLineParser() { registerSubCommand(&SubCommand::getTopLevel()); }
 
+  /// Register all queued options with their subcommands.
+  void materializeOptions() {
+    if (!DeferRegistration.load(std::memory_order_acquire))
+      return;
+    std::lock_guard<std::mutex> Lock(MaterializeMutex);
+    if (!DeferRegistration.load(std::memory_order_relaxed))
+      return;
+    for (Option *O : PendingOptions)
+      registerOption(O);
+    PendingOptions = std::vector<Option *>();
+    DeferRegistration.store(false, std::memory_order_release);
+  }
+
+  /// Queue options created from now on until the option tables are next
+  /// needed. Only used by tests.
+  void deferRegistration() {
+    materializeOptions();
+    DeferRegistration.store(true, std::memory_order_release);
+  }
+
   void ResetAllOptionOccurrences();
 
   bool ParseCommandLineOptions(int argc, const char *const *argv,
@@ -242,6 +281,15 @@ public:
   }
 
   void addOption(Option *O, bool ProcessDefaultOption = false) {
+    if (!ProcessDefaultOption &&
+        DeferRegistration.load(std::memory_order_relaxed)) {
+      PendingOptions.push_back(O);
+      return;
+    }
+    registerOption(O, ProcessDefaultOption);
+  }
+
+  void registerOption(Option *O, bool ProcessDefaultOption = false) {
     if (!ProcessDefaultOption && O->isDefaultOption()) {
       DefaultOptions.push_back(O);
       return;
@@ -283,6 +331,12 @@ public:
   }
 
   void removeOption(Option *O) {
+    // Options are usually removed in the reverse order of their creation.
+    auto It = llvm::find(llvm::reverse(PendingOptions), O);
+    if (It != PendingOptions.rend())
+      PendingOptions.erase(std::next(It).base());
+    // Literal option values are registered immediately, so the option may
+    // still have entries in OptionsMap.
     forEachSubCommand(*O, [&](SubCommand &SC) { removeOption(O, &SC); });
   }
 
@@ -319,6 +373,7 @@ public:
   }
 
   void updateArgStr(Option *O, StringRef NewName) {
+    materializeOptions();
     forEachSubCommand(*O,
                       [&](SubCommand &SC) { updateArgStr(O, NewName, &SC); });
   }
@@ -369,6 +424,7 @@ public:
   }
 
   void reset() {
+    materializeOptions();
     ActiveSubCommand = nullptr;
     ProgramName.clear();
     ProgramOverview = StringRef();
@@ -1454,6 +1510,7 @@ bool cl::ParseCommandLineOptions(int argc, const char *const *argv,
 
 /// Reset all options at least once, so that we can parse different options.
 void CommandLineParser::ResetAllOptionOccurrences() {
+  materializeOptions();
   // Reset all option values to look like they have never been seen before.
   // Options might be reset twice (they can be reference in both OptionsMap
   // and one of the other members), but that does not harm.
@@ -1474,6 +1531,7 @@ bool CommandLineParser::ParseCommandLineOptions(int argc,
                                                 StringRef Overview,
                                                 raw_ostream *Errs,
                                                 bool LongOptionsUseDoubleDash) {
+  materializeOptions();
   assert(hasOptions() && "No options specified!");
 
   ProgramOverview = Overview;
@@ -2350,6 +2408,7 @@ public:
   }
 
   void printHelp() {
+    GlobalParser->materializeOptions();
     SubCommand *Sub = GlobalParser->getActiveSubCommand();
     auto &OptionsMap = Sub->OptionsMap;
     auto &PositionalOpts = Sub->PositionalOpts;
@@ -2710,6 +2769,7 @@ void CommandLineParser::printOptionValues() {
   if (!CommonOptions->PrintOptions && !CommonOptions->PrintAllOptions)
     return;
 
+  materializeOptions();
   SmallVector<std::pair<const char *, Option *>, 128> Opts;
   sortOpts(ActiveSubCommand->OptionsMap, Opts, /*ShowHidden*/ true);
 
@@ -2795,6 +2855,7 @@ void cl::AddExtraVersionPrinter(VersionPrinterTy func) {
 
 StringMap<Option *> &cl::getRegisteredOptions(SubCommand &Sub) {
   initCommonOptions();
+  GlobalParser->materializeOptions();
   auto &Subs = GlobalParser->RegisteredSubCommands;
   (void)Subs;
   assert(Subs.contains(&Sub));
@@ -2808,6 +2869,7 @@ cl::getRegisteredSubcommands() {
 
 void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
   initCommonOptions();
+  GlobalParser->materializeOptions();
   for (auto &I : Sub.OptionsMap) {
     bool Unrelated = true;
     for (auto &Cat : I.second->Categories) {
@@ -2822,6 +2884,7 @@ void cl::HideUnrelatedOptions(cl::OptionCategory &Category, SubCommand &Sub) {
 void cl::HideUnrelatedOptions(ArrayRef<const cl::OptionCategory *> Categories,
                               SubCommand &Sub) {
   initCommonOptions();
+  GlobalParser->materializeOptions();
   for (auto &I : Sub.OptionsMap) {
     bool Unrelated = true;
     for (auto &Cat : I.second->Categories) {
@@ -2835,6 +2898,9 @@ void cl::HideUnrelatedOptions(ArrayRef<const cl::OptionCategory *> Categories,
 }
 
 void cl::ResetCommandLineParser() { GlobalParser->reset(); }
+void cl::DeferOptionRegistrationForTesting() {
+  GlobalParser->deferRegistration();
+}
 void cl::ResetAllOptionOccurrences() {
   GlobalParser->ResetAllOptionOccurrences();
 }
@@ -11,14 +11,20 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/FileOutputBuffer.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/Memory.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <system_error>
 
 #if !defined(_MSC_VER) && !defined(__MINGW32__)
 #include <unistd.h>
+#if defined(LLVM_ON_UNIX)
+#include <sys/mman.h>
+#endif
 #else
 #include <io.h>
 #endif
@@ -66,6 +72,18 @@ public:
     consumeError(Temp.discard());
   }
 
+  void releaseRange(size_t Offset, size_t Size) override {
+#if defined(LLVM_ON_UNIX) && !defined(__MVS__) && !defined(_AIX)
+    // Only whole pages inside the range can be released. The mapping is
+    // shared, so the kernel keeps the dirty pages and writes them back.
+    uint64_t PageSize = Process::getPageSizeEstimate();
+    uint64_t Begin = alignTo(Offset, PageSize);
+    uint64_t End = alignDown(std::min(Offset + Size, Buffer.size()), PageSize);
+    if (Begin < End)
+      ::madvise(Buffer.data() + Begin, End - Begin, MADV_DONTNEED);
+#endif
+  }
+
 private:
   fs::mapped_file_region Buffer;
   fs::TempFile Temp;
@@ -23,6 +23,7 @@
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
 #include <algorithm>
 #include <cassert>
 #include <cstring>
@@ -258,6 +259,42 @@ MemoryBuffer::getFile(const Twine &Filename, bool IsText,
                                   Alignment);
 }
 
+std::vector<ErrorOr<std::unique_ptr<MemoryBuffer>>>
+MemoryBuffer::getFiles(ArrayRef<std::string> Filenames, bool IsText,
+                       bool RequiresNullTerminator, bool IsVolatile) {
+  // ErrorOr's move constructor is not noexcept, so growing a std::vector of
+  // them would copy, which unique_ptr does not allow. SmallVector always moves.
+  SmallVector<ErrorOr<std::unique_ptr<MemoryBuffer>>, 0> Results;
+  Results.reserve(Filenames.size());
+  for (size_t I = 0, E = Filenames.size(); I != E; ++I)
+    Results.emplace_back(std::make_error_code(std::errc::operation_canceled));
+  auto TakeResults = [&Results] {
+    return std::vector<ErrorOr<std::unique_ptr<MemoryBuffer>>>(
+        std::make_move_iterator(Results.begin()),
+        std::make_move_iterator(Results.end()));
+  };
+
+  auto GetFile = [&](size_t I) {
+    Results[I] = getFile(Filenames[I], IsText, RequiresNullTerminator,
+                         IsVolatile);
+  };
+  if (Filenames.size() <= 1) {
+    if (!Filenames.empty())
+      GetFile(0);
+    return TakeResults();
+  }
+
+  // Reading files is dominated by waiting for the file system rather than by
+  // computation, so use more threads than there are hardware threads.
+  unsigned NumThreads = std::min<size_t>(
+      Filenames.size(), 4 * hardware_concurrency().compute_thread_count());
+  DefaultThreadPool Pool(hardware_concurrency(NumThreads));
+  for (size_t I = 0, E = Filenames.size(); I != E; ++I)
+    Pool.async(GetFile, I);
+  Pool.wait();
+  return TakeResults();
+}
+
 template <typename MB>
 static ErrorOr<std::unique_ptr<MB>>
 getOpenFileImpl(sys::fs::file_t FD, const Twine &Filename, uint64_t FileSize,
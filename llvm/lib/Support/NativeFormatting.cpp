@@ -22,15 +22,37 @@
 
 using namespace llvm;
 
+// The decimal representation of all two digit numbers, used to convert
+// integers two digits at a time.
+static const char TwoDigits[] = "00010203040506070809"
+                                "10111213141516171819"
+                                "20212223242526272829"
+                                "30313233343536373839"
+                                "40414243444546474849"
+                                "50515253545556575859"
+                                "60616263646566676869"
+                                "70717273747576777879"
+                                "80818283848586878889"
+                                "90919293949596979899";
+
 template<typename T, std::size_t N>
 static int format_to_buffer(T Value, char (&Buffer)[N]) {
   char *EndPtr = std::end(Buffer);
   char *CurPtr = EndPtr;
 
-  do {
-    *--CurPtr = '0' + char(Value % 10);
-    Value /= 10;
-  } while (Value);
+  while (Value >= 100) {
+    unsigned Idx = unsigned(Value % 100) * 2;
+    Value /= 100;
+    *--CurPtr = TwoDigits[Idx + 1];
+    *--CurPtr = TwoDigits[Idx];
+  }
+  if (Value >= 10) {
+    unsigned Idx = unsigned(Value) * 2;
+    *--CurPtr = TwoDigits[Idx + 1];
+    *--CurPtr = TwoDigits[Idx];
+  } else {
+    *--CurPtr = '0' + char(Value);
+  }
   return EndPtr - CurPtr;
 }
 
@@ -60,6 +82,18 @@ static void write_unsigned_impl(raw_ostream &S, T N, size_t MinDigits,
   char NumberBuffer[128];
   size_t Len = format_to_buffer(N, NumberBuffer);
 
+  // Emit the common case of a plain, reasonably padded integer with a single
+  // write.
+  if (Style != IntegerStyle::Number &&
+      std::max(Len, MinDigits) < std::size(NumberBuffer)) {
+    for (; Len < MinDigits; ++Len)
+      *(std::end(NumberBuffer) - Len - 1) = '0';
+    if (IsNegative)
+      *(std::end(NumberBuffer) - ++Len) = '-';
+    S.write(std::end(NumberBuffer) - Len, Len);
+    return;
+  }
+
   if (IsNegative)
     S << '-';
 
@@ -148,15 +182,15 @@ void llvm::write_hex(raw_ostream &S, uint64_t N, HexPrintStyle Style,
       std::max(static_cast<unsigned>(W), std::max(1u, Nibbles) + PrefixChars);
 
   char NumberBuffer[kMaxWidth];
-  ::memset(NumberBuffer, '0', std::size(NumberBuffer));
+  ::memset(NumberBuffer, '0', NumChars);
   if (Prefix)
     NumberBuffer[1] = 'x';
+  const char *Digits = Upper ? "0123456789ABCDEF" : "0123456789abcdef";
   char *EndPtr = NumberBuffer + NumChars;
   char *CurPtr = EndPtr;
   while (N) {
-    unsigned char x = static_cast<unsigned char>(N) % 16;
-    *--CurPtr = hexdigit(x, !Upper);
-    N /= 16;
+    *--CurPtr = Digits[N & 15];
+    N >>= 4;
   }
 
   S.write(NumberBuffer, NumChars);
@@ -39,7 +39,8 @@ namespace {
 class Executor {
 public:
   virtual ~Executor() = default;
-  virtual void add(std::function<void()> func, bool Sequential = false) = 0;
+  virtual void add(std::function<void()> func, bool Sequential = false,
+                   TaskPriority Priority = TaskPriority::Normal) = 0;
   virtual size_t getThreadCount() const = 0;
 
   static Executor *getDefaultExecutor();
@@ -98,11 +99,14 @@ public:
     static void call(void *Ptr) { ((ThreadPoolExecutor *)Ptr)->stop(); }
   };
 
-  void add(std::function<void()> F, bool Sequential = false) override {
+  void add(std::function<void()> F, bool Sequential = false,
+           TaskPriority Priority = TaskPriority::Normal) override {
     {
       std::lock_guard<std::mutex> Lock(Mutex);
       if (Sequential)
         WorkQueueSequential.emplace_front(std::move(F));
+      else if (Priority == TaskPriority::High)
+        WorkQueueHigh.emplace_back(std::move(F));
       else
         WorkQueue.emplace_back(std::move(F));
     }
@@ -116,7 +120,9 @@ private:
     return !WorkQueueSequential.empty() && !SequentialQueueIsLocked;
   }
 
-  bool hasGeneralTasks() const { return !WorkQueue.empty(); }
+  bool hasGeneralTasks() const {
+    return !WorkQueueHigh.empty() || !WorkQueue.empty();
+  }
 
   void work(ThreadPoolStrategy S, unsigned ThreadID) {
     threadIndex = ThreadID;
@@ -134,7 +140,9 @@ private:
       else
         assert(hasGeneralTasks());
 
-      auto &Queue = Sequential ? WorkQueueSequential : WorkQueue;
+      auto &Queue = Sequential               ? WorkQueueSequential
+                    : !WorkQueueHigh.empty() ? WorkQueueHigh
+                                             : WorkQueue;
       auto Task = std::move(Queue.back());
       Queue.pop_back();
       Lock.unlock();
@@ -147,6 +155,7 @@ private:
   std::atomic<bool> Stop{false};
   std::atomic<bool> SequentialQueueIsLocked{false};
   std::deque<std::function<void()>> WorkQueue;
+  std::deque<std::function<void()>> WorkQueueHigh;
   std::deque<std::function<void()>> WorkQueueSequential;
   std::mutex Mutex;
   std::condition_variable Cond;
@@ -192,12 +201,13 @@ size_t getThreadCount() {
 // lock if all threads in the default executor are blocked. To prevent the dead
 // lock, only allow the root TaskGroup to run tasks parallelly. In the scenario
 // of nested parallel_for_each(), only the outermost one runs parallelly.
-TaskGroup::TaskGroup()
+TaskGroup::TaskGroup(TaskPriority Priority)
 #if LLVM_ENABLE_THREADS
     : Parallel((parallel::strategy.ThreadsRequested != 1) &&
-               (threadIndex == UINT_MAX)) {}
+               (threadIndex == UINT_MAX)),
+      Priority(Priority) {}
 #else
-    : Parallel(false) {}
+    : Parallel(false), Priority(Priority) {}
 #endif
 TaskGroup::~TaskGroup() {
   // We must ensure that all the workloads have finished before decrementing the
@@ -214,7 +224,7 @@ void TaskGroup::spawn(std::function<void()> F, bool Sequential) {
           F();
           L.dec();
         },
-        Sequential);
+        Sequential, Priority);
     return;
   }
 #endif
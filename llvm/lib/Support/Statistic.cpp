@@ -24,6 +24,7 @@
 
 #include "DebugOptions.h"
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
@@ -65,13 +66,22 @@ namespace {
 /// use LLVM.
 class StatisticInfo {
   std::vector<TrackingStatistic *> Stats;
+  std::vector<ShardedStatistic *> ShardedStats;
 
   friend void llvm::PrintStatistics();
   friend void llvm::PrintStatistics(raw_ostream &OS);
   friend void llvm::PrintStatisticsJSON(raw_ostream &OS);
 
-  /// Sort statistics by debugtype,name,description.
-  void sort();
+  /// A snapshot of a registered statistic of either kind.
+  struct Entry {
+    const char *DebugType;
+    const char *Name;
+    const char *Desc;
+    uint64_t Value;
+  };
+
+  /// Return all registered statistics sorted by debugtype,name,description.
+  std::vector<Entry> getSortedEntries() const;
 public:
   using const_iterator = std::vector<TrackingStatistic *>::const_iterator;
 
@@ -79,12 +89,17 @@ public:
   ~StatisticInfo();
 
   void addStatistic(TrackingStatistic *S) { Stats.push_back(S); }
+  void addStatistic(ShardedStatistic *S) { ShardedStats.push_back(S); }
+  bool empty() const { return Stats.empty() && ShardedStats.empty(); }
 
   const_iterator begin() const { return Stats.begin(); }
   const_iterator end() const { return Stats.end(); }
   iterator_range<const_iterator> statistics() const {
     return {begin(), end()};
   }
+  ArrayRef<ShardedStatistic *> shardedStatistics() const {
+    return ShardedStats;
+  }
 
   void reset();
 };
@@ -119,6 +134,27 @@ void TrackingStatistic::RegisterStatistic() {
   }
 }
 
+void ShardedStatistic::RegisterStatistic() {
+  // See TrackingStatistic::RegisterStatistic for the locking order.
+  if (!Initialized.load(std::memory_order_relaxed)) {
+    sys::SmartMutex<true> &Lock = *StatLock;
+    StatisticInfo &SI = *StatInfo;
+    sys::SmartScopedLock<true> Writer(Lock);
+    if (Initialized.load(std::memory_order_relaxed))
+      return;
+    if (EnableStats || Enabled)
+      SI.addStatistic(this);
+    Initialized.store(true, std::memory_order_release);
+  }
+}
+
+unsigned ShardedStatistic::assignShardIndex() {
+  // Hand out shards round-robin so that the first NumShards threads never
+  // share a cache line.
+  static std::atomic<unsigned> NextShard{0};
+  return NextShard.fetch_add(1, std::memory_order_relaxed) % NumShards;
+}
+
 StatisticInfo::StatisticInfo() {
   // Ensure that necessary timer global objects are created first so they are
   // destructed after us.
@@ -138,17 +174,26 @@ void llvm::EnableStatistics(bool DoPrintOnExit) {
 
 bool llvm::AreStatisticsEnabled() { return Enabled || EnableStats; }
 
-void StatisticInfo::sort() {
-  llvm::stable_sort(
-      Stats, [](const TrackingStatistic *LHS, const TrackingStatistic *RHS) {
-        if (int Cmp = std::strcmp(LHS->getDebugType(), RHS->getDebugType()))
-          return Cmp < 0;
-
-        if (int Cmp = std::strcmp(LHS->getName(), RHS->getName()))
-          return Cmp < 0;
-
-        return std::strcmp(LHS->getDesc(), RHS->getDesc()) < 0;
-      });
+std::vector<StatisticInfo::Entry> StatisticInfo::getSortedEntries() const {
+  std::vector<Entry> Entries;
+  Entries.reserve(Stats.size() + ShardedStats.size());
+  for (const TrackingStatistic *Stat : Stats)
+    Entries.push_back({Stat->getDebugType(), Stat->getName(), Stat->getDesc(),
+                       Stat->getValue()});
+  for (const ShardedStatistic *Stat : ShardedStats)
+    Entries.push_back({Stat->getDebugType(), Stat->getName(), Stat->getDesc(),
+                       Stat->getValue()});
+
+  llvm::stable_sort(Entries, [](const Entry &LHS, const Entry &RHS) {
+    if (int Cmp = std::strcmp(LHS.DebugType, RHS.DebugType))
+      return Cmp < 0;
+
+    if (int Cmp = std::strcmp(LHS.Name, RHS.Name))
+      return Cmp < 0;
+
+    return std::strcmp(LHS.Desc, RHS.Desc) < 0;
+  });
+  return Entries;
 }
 
 void StatisticInfo::reset() {
@@ -164,6 +209,11 @@ void StatisticInfo::reset() {
     Stat->Initialized = false;
     Stat->Value = 0;
   }
+  for (auto *Stat : ShardedStats) {
+    Stat->Initialized = false;
+    for (auto &Shard : Stat->Shards)
+      Shard.Value = 0;
+  }
 
   // Clear the registration list and release the lock once we're done. Any
   // pending updates from other threads will safely take effect after we return.
@@ -171,30 +221,30 @@ void StatisticInfo::reset() {
   // but it's their responsibility to prevent concurrent compilations to make
   // a single compilation measurable.
   Stats.clear();
+  ShardedStats.clear();
 }
 
 void llvm::PrintStatistics(raw_ostream &OS) {
   StatisticInfo &Stats = *StatInfo;
+  auto Entries = Stats.getSortedEntries();
 
   // Figure out how long the biggest Value and Name fields are.
   unsigned MaxDebugTypeLen = 0, MaxValLen = 0;
-  for (TrackingStatistic *Stat : Stats.Stats) {
-    MaxValLen = std::max(MaxValLen, (unsigned)utostr(Stat->getValue()).size());
+  for (const auto &Stat : Entries) {
+    MaxValLen = std::max(MaxValLen, (unsigned)utostr(Stat.Value).size());
     MaxDebugTypeLen =
-        std::max(MaxDebugTypeLen, (unsigned)std::strlen(Stat->getDebugType()));
+        std::max(MaxDebugTypeLen, (unsigned)std::strlen(Stat.DebugType));
   }
 
-  Stats.sort();
-
   // Print out the statistics header...
   OS << "===" << std::string(73, '-') << "===\n"
      << "                          ... Statistics Collected ...\n"
      << "===" << std::string(73, '-') << "===\n\n";
 
   // Print all of the statistics.
-  for (TrackingStatistic *Stat : Stats.Stats)
-    OS << format("%*" PRIu64 " %-*s - %s\n", MaxValLen, Stat->getValue(),
-                 MaxDebugTypeLen, Stat->getDebugType(), Stat->getDesc());
+  for (const auto &Stat : Entries)
+    OS << format("%*" PRIu64 " %-*s - %s\n", MaxValLen, Stat.Value,
+                 MaxDebugTypeLen, Stat.DebugType, Stat.Desc);
 
   OS << '\n';  // Flush the output stream.
   OS.flush();
@@ -204,19 +254,16 @@ void llvm::PrintStatisticsJSON(raw_ostream &OS) {
   sys::SmartScopedLock<true> Reader(*StatLock);
   StatisticInfo &Stats = *StatInfo;
 
-  Stats.sort();
-
   // Print all of the statistics.
   OS << "{\n";
   const char *delim = "";
-  for (const TrackingStatistic *Stat : Stats.Stats) {
+  for (const auto &Stat : Stats.getSortedEntries()) {
     OS << delim;
-    assert(yaml::needsQuotes(Stat->getDebugType()) == yaml::QuotingType::None &&
+    assert(yaml::needsQuotes(Stat.DebugType) == yaml::QuotingType::None &&
            "Statistic group/type name is simple.");
-    assert(yaml::needsQuotes(Stat->getName()) == yaml::QuotingType::None &&
+    assert(yaml::needsQuotes(Stat.Name) == yaml::QuotingType::None &&
            "Statistic name is simple");
-    OS << "\t\"" << Stat->getDebugType() << '.' << Stat->getName() << "\": "
-       << Stat->getValue();
+    OS << "\t\"" << Stat.DebugType << '.' << Stat.Name << "\": " << Stat.Value;
     delim = ",\n";
   }
   // Print timers.
@@ -227,12 +274,24 @@ void llvm::PrintStatisticsJSON(raw_ostream &OS) {
 }
 
 void llvm::PrintStatistics() {
-#if LLVM_ENABLE_STATS
   sys::SmartScopedLock<true> Reader(*StatLock);
   StatisticInfo &Stats = *StatInfo;
 
-  // Statistics not enabled?
-  if (Stats.Stats.empty()) return;
+  // Always enabled and sharded statistics are tracked in every build.
+  if (Stats.empty()) {
+#if !LLVM_ENABLE_STATS
+    // Check if the -stats option is set instead of relying on the statistics
+    // list alone. In release builds, Statistic operators do nothing, so stats
+    // are never Registered.
+    if (EnableStats) {
+      // Get the stream to write to.
+      std::unique_ptr<raw_ostream> OutStream = CreateInfoOutputFile();
+      (*OutStream) << "Statistics are disabled.  "
+                   << "Build with asserts or with -DLLVM_FORCE_ENABLE_STATS\n";
+    }
+#endif
+    return;
+  }
 
   // Get the stream to write to.
   std::unique_ptr<raw_ostream> OutStream = CreateInfoOutputFile();
@@ -240,18 +299,6 @@ void llvm::PrintStatistics() {
     PrintStatisticsJSON(*OutStream);
   else
     PrintStatistics(*OutStream);
-
-#else
-  // Check if the -stats option is set instead of checking
-  // !Stats.Stats.empty().  In release builds, Statistics operators
-  // do nothing, so stats are never Registered.
-  if (EnableStats) {
-    // Get the stream to write to.
-    std::unique_ptr<raw_ostream> OutStream = CreateInfoOutputFile();
-    (*OutStream) << "Statistics are disabled.  "
-                 << "Build with asserts or with -DLLVM_FORCE_ENABLE_STATS\n";
-  }
-#endif
 }
 
 std::vector<std::pair<StringRef, uint64_t>> llvm::GetStatistics() {
@@ -260,6 +307,8 @@ std::vector<std::pair<StringRef, uint64_t>> llvm::GetStatistics() {
 
   for (const auto &Stat : StatInfo->statistics())
     ReturnStats.emplace_back(Stat->getName(), Stat->getValue());
+  for (const auto &Stat : StatInfo->shardedStatistics())
+    ReturnStats.emplace_back(Stat->getName(), Stat->getValue());
   return ReturnStats;
 }
 
@@ -19,11 +19,15 @@
 #include "llvm/Support/Process.h"
 #include "llvm/Support/Threading.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace llvm;
@@ -75,6 +79,10 @@ struct llvm::TimeTraceProfilerEntry {
   const std::string Name;
   const std::string Detail;
   const bool AsyncEvent = false;
+  // Heap usage in bytes at the start and the end of the section, if memory is
+  // traced.
+  size_t StartMemory = 0;
+  size_t EndMemory = 0;
   TimeTraceProfilerEntry(TimePointType &&S, TimePointType &&E, std::string &&N,
                          std::string &&Dt, bool Ae)
       : Start(std::move(S)), End(std::move(E)), Name(std::move(N)),
@@ -97,10 +105,12 @@ struct llvm::TimeTraceProfilerEntry {
 };
 
 struct llvm::TimeTraceProfiler {
-  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "")
+  TimeTraceProfiler(unsigned TimeTraceGranularity = 0, StringRef ProcName = "",
+                    bool TraceMemory = false)
       : BeginningOfTime(system_clock::now()), StartTime(ClockType::now()),
         ProcName(ProcName), Pid(sys::Process::getProcessId()),
-        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity) {
+        Tid(llvm::get_threadid()), TimeTraceGranularity(TimeTraceGranularity),
+        TraceMemory(TraceMemory) {
     llvm::get_thread_name(ThreadName);
   }
 
@@ -110,6 +120,8 @@ struct llvm::TimeTraceProfiler {
     Stack.emplace_back(std::make_unique<TimeTraceProfilerEntry>(
         ClockType::now(), TimePointType(), std::move(Name), Detail(),
         AsyncEvent));
+    if (TraceMemory)
+      Stack.back()->StartMemory = sys::Process::GetMallocUsage();
     return Stack.back().get();
   }
 
@@ -121,6 +133,8 @@ struct llvm::TimeTraceProfiler {
   void end(TimeTraceProfilerEntry &E) {
     assert(!Stack.empty() && "Must call begin() first");
     E.End = ClockType::now();
+    if (TraceMemory)
+      E.EndMemory = sys::Process::GetMallocUsage();
 
     // Calculate duration at full precision for overall counts.
     DurationType Duration = E.End - E.Start;
@@ -184,11 +198,34 @@ struct llvm::TimeTraceProfiler {
           J.attribute("dur", DurUs);
         }
         J.attribute("name", E.Name);
-        if (!E.Detail.empty()) {
-          J.attributeObject("args", [&] { J.attribute("detail", E.Detail); });
+        if (!E.Detail.empty() || TraceMemory) {
+          J.attributeObject("args", [&] {
+            if (!E.Detail.empty())
+              J.attribute("detail", E.Detail);
+            if (TraceMemory)
+              J.attribute("malloc delta bytes",
+                          int64_t(E.EndMemory) - int64_t(E.StartMemory));
+          });
         }
       });
 
+      // Emit the heap usage at both ends of the section as a counter track.
+      if (TraceMemory) {
+        auto writeCounter = [&](int64_t Ts, size_t Bytes) {
+          J.object([&] {
+            J.attribute("pid", Pid);
+            J.attribute("tid", int64_t(Tid));
+            J.attribute("ts", Ts);
+            J.attribute("ph", "C");
+            J.attribute("name", "Memory");
+            J.attributeObject(
+                "args", [&] { J.attribute("malloc bytes", int64_t(Bytes)); });
+          });
+        };
+        writeCounter(StartUs, E.StartMemory);
+        writeCounter(StartUs + DurUs, E.EndMemory);
+      }
+
       if (E.AsyncEvent) {
         J.object([&] {
           J.attribute("pid", Pid);
@@ -307,14 +344,17 @@ struct llvm::TimeTraceProfiler {
 
   // Minimum time granularity (in microseconds)
   const unsigned TimeTraceGranularity;
+
+  // Whether to record the heap usage at the start and end of each entry.
+  const bool TraceMemory;
 };
 
 void llvm::timeTraceProfilerInitialize(unsigned TimeTraceGranularity,
-                                       StringRef ProcName) {
+                                       StringRef ProcName, bool TraceMemory) {
   assert(TimeTraceProfilerInstance == nullptr &&
          "Profiler should not be initialized");
   TimeTraceProfilerInstance = new TimeTraceProfiler(
-      TimeTraceGranularity, llvm::sys::path::filename(ProcName));
+      TimeTraceGranularity, llvm::sys::path::filename(ProcName), TraceMemory);
 }
 
 // Removes all TimeTraceProfilerInstances.
@@ -398,3 +438,174 @@ void llvm::timeTraceProfilerEnd(TimeTraceProfilerEntry *E) {
   if (TimeTraceProfilerInstance != nullptr)
     TimeTraceProfilerInstance->end(*E);
 }
+
+//===----------------------------------------------------------------------===//
+// Sampling profiler
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// The sampled scope stack of one thread. Only the owning thread updates it,
+/// while the sampler thread reads it concurrently. A sample may therefore see
+/// a stack in the middle of a push or a pop, which is acceptable for a
+/// statistical profile.
+struct SampledStack {
+  static constexpr unsigned MaxDepth = 64;
+
+  /// The number of open scopes. Scopes nested deeper than MaxDepth are
+  /// counted but not recorded.
+  std::atomic<unsigned> Depth{0};
+  std::atomic<uint32_t> NameIds[MaxDepth];
+  /// Interned names already seen by this thread, so that a push does not
+  /// have to take the global lock.
+  StringMap<uint32_t> NameIdCache;
+
+  SampledStack();
+  ~SampledStack();
+};
+
+struct SamplingProfiler {
+  /// Guards everything below.
+  std::mutex Lock;
+  std::condition_variable Wakeup;
+  bool Running = false;
+  std::thread Sampler;
+  std::vector<SampledStack *> Threads;
+  /// Interned scope names. The ids index Names, whose strings are owned by
+  /// the keys of NameIds.
+  StringMap<uint32_t> NameIds;
+  std::vector<StringRef> Names;
+  /// Sample counts keyed by the raw bytes of a stack of name ids.
+  StringMap<uint64_t> Samples;
+
+  ~SamplingProfiler() { stop(); }
+
+  uint32_t intern(StringRef Name) {
+    std::lock_guard<std::mutex> Guard(Lock);
+    auto [It, Inserted] = NameIds.try_emplace(Name, Names.size());
+    if (Inserted)
+      Names.push_back(It->getKey());
+    return It->second;
+  }
+
+  void run(microseconds Interval) {
+    std::unique_lock<std::mutex> Guard(Lock);
+    while (!Wakeup.wait_for(Guard, Interval, [&] { return !Running; })) {
+      for (const SampledStack *S : Threads) {
+        unsigned Depth = std::min(S->Depth.load(std::memory_order_acquire),
+                                  SampledStack::MaxDepth);
+        if (Depth == 0)
+          continue;
+        uint32_t Ids[SampledStack::MaxDepth];
+        for (unsigned I = 0; I != Depth; ++I)
+          Ids[I] = S->NameIds[I].load(std::memory_order_relaxed);
+        ++Samples[StringRef(reinterpret_cast<const char *>(Ids),
+                            Depth * sizeof(uint32_t))];
+      }
+    }
+  }
+
+  void stop();
+};
+
+} // anonymous namespace
+
+// Checked by every TimeTraceScope, so keep it out of the function-local
+// static below.
+std::atomic<bool> llvm::detail::TimeTraceSamplingEnabled{false};
+
+static SamplingProfiler &getSamplingProfiler() {
+  static SamplingProfiler Profiler;
+  return Profiler;
+}
+
+static SampledStack &getSampledStack() {
+  static thread_local SampledStack Stack;
+  return Stack;
+}
+
+SampledStack::SampledStack() {
+  SamplingProfiler &P = getSamplingProfiler();
+  std::lock_guard<std::mutex> Guard(P.Lock);
+  P.Threads.push_back(this);
+}
+
+SampledStack::~SampledStack() {
+  SamplingProfiler &P = getSamplingProfiler();
+  std::lock_guard<std::mutex> Guard(P.Lock);
+  llvm::erase(P.Threads, this);
+}
+
+void SamplingProfiler::stop() {
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    if (!Running)
+      return;
+    Running = false;
+    detail::TimeTraceSamplingEnabled.store(false, std::memory_order_relaxed);
+  }
+  Wakeup.notify_all();
+  Sampler.join();
+}
+
+void llvm::timeTraceSamplingProfilerInitialize(unsigned SampleIntervalUs) {
+#if LLVM_ENABLE_THREADS
+  SamplingProfiler &P = getSamplingProfiler();
+  std::lock_guard<std::mutex> Guard(P.Lock);
+  assert(!P.Running && "Sampling profiler should not be initialized");
+  P.Running = true;
+  microseconds Interval(std::max(SampleIntervalUs, 1u));
+  P.Sampler = std::thread([&P, Interval] { P.run(Interval); });
+  detail::TimeTraceSamplingEnabled.store(true, std::memory_order_relaxed);
+#endif
+}
+
+void llvm::timeTraceSamplingProfilerCleanup() {
+  SamplingProfiler &P = getSamplingProfiler();
+  P.stop();
+  std::lock_guard<std::mutex> Guard(P.Lock);
+  P.Samples.clear();
+}
+
+void llvm::timeTraceSamplingProfilerWrite(raw_ostream &OS) {
+  SamplingProfiler &P = getSamplingProfiler();
+  std::vector<std::pair<std::string, uint64_t>> Stacks;
+  {
+    std::lock_guard<std::mutex> Guard(P.Lock);
+    Stacks.reserve(P.Samples.size());
+    for (const auto &Sample : P.Samples) {
+      StringRef Key = Sample.getKey();
+      std::string Stack;
+      for (size_t I = 0; I < Key.size(); I += sizeof(uint32_t)) {
+        uint32_t Id;
+        std::memcpy(&Id, Key.data() + I, sizeof(Id));
+        if (I != 0)
+          Stack += ';';
+        Stack += P.Names[Id];
+      }
+      Stacks.emplace_back(std::move(Stack), Sample.getValue());
+    }
+  }
+  llvm::sort(Stacks);
+  for (const auto &[Stack, Count] : Stacks)
+    OS << Stack << ' ' << Count << '\n';
+}
+
+void llvm::timeTraceSamplingPush(StringRef Name) {
+  SampledStack &S = getSampledStack();
+  unsigned Depth = S.Depth.load(std::memory_order_relaxed);
+  if (Depth < SampledStack::MaxDepth) {
+    auto [It, Inserted] = S.NameIdCache.try_emplace(Name, 0);
+    if (Inserted)
+      It->second = getSamplingProfiler().intern(Name);
+    S.NameIds[Depth].store(It->second, std::memory_order_relaxed);
+  }
+  S.Depth.store(Depth + 1, std::memory_order_release);
+}
+
+void llvm::timeTraceSamplingPop() {
+  SampledStack &S = getSampledStack();
+  unsigned Depth = S.Depth.load(std::memory_order_relaxed);
+  assert(Depth != 0 && "Must call timeTraceSamplingPush() first");
+  S.Depth.store(Depth - 1, std::memory_order_relaxed);
+}
@@ -601,6 +601,84 @@ directory_iterator OverlayFileSystem::dir_begin(const Twine &Dir,
 
 void ProxyFileSystem::anchor() {}
 
+bool CachingStatFileSystem::getCacheKey(const Twine &Path,
+                                        SmallVectorImpl<char> &Key) const {
+  Path.toVector(Key);
+  if (makeAbsolute(Key))
+    return false;
+  sys::path::remove_dots(Key, /*remove_dot_dot=*/false);
+  return true;
+}
+
+ErrorOr<Status> CachingStatFileSystem::status(const Twine &Path) {
+  SmallString<256> Key;
+  if (!getCacheKey(Path, Key))
+    return ProxyFileSystem::status(Path);
+
+  {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    auto It = StatCache.find(Key);
+    if (It != StatCache.end()) {
+      // A nested VFS may have mapped the path to an external name, which must
+      // not be replaced with the requested one.
+      if (!It->second || It->second->ExposesExternalVFSPath)
+        return It->second;
+      return Status::copyWithNewName(*It->second, Path);
+    }
+  }
+
+  // Query the underlying file system without holding the lock. Concurrent
+  // queries for the same path may both miss, which is harmless.
+  ErrorOr<Status> Result = ProxyFileSystem::status(Path);
+  std::lock_guard<std::mutex> Lock(Mutex);
+  StatCache.insert_or_assign(Key, Result);
+  return Result;
+}
+
+ErrorOr<std::unique_ptr<File>>
+CachingStatFileSystem::openFileForRead(const Twine &Path) {
+  ErrorOr<std::unique_ptr<File>> Result = ProxyFileSystem::openFileForRead(Path);
+  if (!Result)
+    return Result;
+
+  SmallString<256> Key;
+  if (!getCacheKey(Path, Key))
+    return Result;
+  ErrorOr<Status> FileStatus = (*Result)->status();
+  if (!FileStatus)
+    return Result;
+
+  // Refresh the cache if the file was replaced (new inode) or modified since
+  // it was last queried.
+  std::lock_guard<std::mutex> Lock(Mutex);
+  auto It = StatCache.find(Key);
+  if (It == StatCache.end() || !It->second ||
+      It->second->getUniqueID() != FileStatus->getUniqueID() ||
+      It->second->getLastModificationTime() !=
+          FileStatus->getLastModificationTime() ||
+      It->second->getSize() != FileStatus->getSize())
+    StatCache.insert_or_assign(Key, *FileStatus);
+  return Result;
+}
+
+void CachingStatFileSystem::invalidate(const Twine &Path) {
+  SmallString<256> Key;
+  if (!getCacheKey(Path, Key))
+    return;
+  std::lock_guard<std::mutex> Lock(Mutex);
+  StatCache.erase(Key);
+}
+
+void CachingStatFileSystem::invalidateAll() {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  StatCache.clear();
+}
+
+size_t CachingStatFileSystem::getNumCachedEntries() const {
+  std::lock_guard<std::mutex> Lock(Mutex);
+  return StatCache.size();
+}
+
 namespace llvm {
 namespace vfs {
 
@@ -2936,5 +3014,6 @@ recursive_directory_iterator::increment(std::error_code &EC) {
 const char FileSystem::ID = 0;
 const char OverlayFileSystem::ID = 0;
 const char ProxyFileSystem::ID = 0;
+const char CachingStatFileSystem::ID = 0;
 const char InMemoryFileSystem::ID = 0;
 const char RedirectingFileSystem::ID = 0;
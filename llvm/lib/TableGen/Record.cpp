@@ -3244,6 +3244,19 @@ std::vector<Record *> RecordKeeper::getAllDerivedDefinitions(
     ClassRecs.push_back(Class);
   }
 
+  // Defs derived from several classes are a subset of the (cached) defs
+  // derived from the first one, which are already sorted. Filtering those is
+  // much cheaper than scanning and sorting all the defs again. Backends may
+  // add defs while emitting, though, and the cache is not updated for them.
+  if (ClassRecs.size() > 1 && !DefsAddedAfterCaching) {
+    for (Record *Def : getAllDerivedDefinitions(ClassNames.front()))
+      if (all_of(drop_begin(ClassRecs), [Def](const Record *Class) {
+            return Def->isSubClassOf(Class);
+          }))
+        Defs.push_back(Def);
+    return Defs;
+  }
+
   for (const auto &OneDef : getDefs()) {
     if (all_of(ClassRecs, [&OneDef](const Record *Class) {
                             return OneDef.second->isSubClassOf(Class);
@@ -81,6 +81,8 @@ STATISTIC(NumAttributesValidFixpoint,
           "Number of abstract attributes in a valid fixpoint state");
 STATISTIC(NumAttributesManifested,
           "Number of abstract attributes manifested in IR");
+STATISTIC(NumFixpointIterations,
+          "Number of fixpoint iterations performed by the Attributor");
 
 // TODO: Determine a good default value.
 //
@@ -95,6 +97,12 @@ static cl::opt<unsigned>
                           cl::desc("Maximal number of fixpoint iterations."),
                           cl::init(32));
 
+static cl::opt<unsigned> SetCGSCCFixpointIterations(
+    "attributor-max-cgscc-iterations", cl::Hidden,
+    cl::desc("Maximal number of fixpoint iterations when the Attributor runs "
+             "on a single SCC (defaults to -attributor-max-iterations)."),
+    cl::init(32));
+
 static cl::opt<unsigned>
     MaxSpecializationPerCB("attributor-max-specializations-per-call-base",
                            cl::Hidden,
@@ -2214,6 +2222,7 @@ void Attributor::runTillFixpoint() {
     QueryAAsAwaitingUpdate.clear();
 
   } while (!Worklist.empty() && (IterationCounter++ < MaxIterations));
+  NumFixpointIterations += std::min(IterationCounter, MaxIterations);
 
   if (IterationCounter > MaxIterations && !Functions.empty()) {
     auto Remark = [&](OptimizationRemarkMissed ORM) {
@@ -3830,6 +3839,10 @@ static bool runAttributorOnFunctions(InformationCache &InfoCache,
   AttributorConfig AC(CGUpdater);
   AC.IsModulePass = IsModulePass;
   AC.DeleteFns = DeleteFns;
+  // Each SCC is a separate fixpoint problem, so it can be given its own, more
+  // aggressive, iteration cap than a whole-module run.
+  if (!IsModulePass && SetCGSCCFixpointIterations.getNumOccurrences())
+    AC.MaxFixpointIterations = SetCGSCCFixpointIterations;
 
   /// Tracking callback for specialization of indirect calls.
   DenseMap<CallBase *, std::unique_ptr<SmallPtrSet<Function *, 8>>>
@@ -38,6 +38,8 @@
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/JSON.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/IPO/Internalize.h"
@@ -120,6 +122,10 @@ static cl::opt<bool> PrintImportFailures(
     "print-import-failures", cl::init(false), cl::Hidden,
     cl::desc("Print information for functions rejected for importing"));
 
+static cl::opt<bool> ParallelImportComputation(
+    "thinlto-parallel-import-computation", cl::init(false), cl::Hidden,
+    cl::desc("Compute the import lists of ThinLTO modules in parallel"));
+
 static cl::opt<bool> ComputeDead("compute-dead", cl::init(true), cl::Hidden,
                                  cl::desc("Compute dead symbols"));
 
@@ -996,14 +1002,47 @@ void llvm::ComputeCrossModuleImport(
         isPrevailing,
     DenseMap<StringRef, FunctionImporter::ImportMapTy> &ImportLists,
     DenseMap<StringRef, FunctionImporter::ExportSetTy> &ExportLists) {
-  auto MIS = ModuleImportsManager::create(isPrevailing, Index, &ExportLists);
-  // For each module that has function defined, compute the import/export lists.
-  for (const auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
-    auto &ImportList = ImportLists[DefinedGVSummaries.first];
-    LLVM_DEBUG(dbgs() << "Computing import for Module '"
-                      << DefinedGVSummaries.first << "'\n");
-    MIS->computeImportForModule(DefinedGVSummaries.second,
-                                DefinedGVSummaries.first, ImportList);
+  // The workload imports manager and the import failure printing are not
+  // thread-safe, so keep those on the serial path.
+  if (ParallelImportComputation && WorkloadDefinitions.empty() &&
+      !PrintImportFailures) {
+    // Create every import list up front so that ImportLists is not modified
+    // while the lists are computed concurrently.
+    std::vector<const std::pair<StringRef, GVSummaryMapTy> *> Modules;
+    for (const auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
+      ImportLists[DefinedGVSummaries.first];
+      Modules.push_back(&DefinedGVSummaries);
+    }
+
+    // Each shard of modules collects its exports separately. The shards do
+    // not depend on the thread count and are merged in order, so the result
+    // is deterministic.
+    constexpr size_t ModulesPerShard = 64;
+    size_t NumShards = divideCeil(Modules.size(), ModulesPerShard);
+    std::vector<DenseMap<StringRef, FunctionImporter::ExportSetTy>>
+        ShardExportLists(NumShards);
+    parallelFor(0, NumShards, [&](size_t Shard) {
+      auto MIS = ModuleImportsManager::create(isPrevailing, Index,
+                                              &ShardExportLists[Shard]);
+      size_t End = std::min(Modules.size(), (Shard + 1) * ModulesPerShard);
+      for (size_t I = Shard * ModulesPerShard; I != End; ++I)
+        MIS->computeImportForModule(Modules[I]->second, Modules[I]->first,
+                                    ImportLists.find(Modules[I]->first)->second);
+    });
+    for (auto &ShardExports : ShardExportLists)
+      for (auto &[ModName, Exports] : ShardExports)
+        ExportLists[ModName].insert(Exports.begin(), Exports.end());
+  } else {
+    auto MIS = ModuleImportsManager::create(isPrevailing, Index, &ExportLists);
+    // For each module that has function defined, compute the import/export
+    // lists.
+    for (const auto &DefinedGVSummaries : ModuleToDefinedGVSummaries) {
+      auto &ImportList = ImportLists[DefinedGVSummaries.first];
+      LLVM_DEBUG(dbgs() << "Computing import for Module '"
+                        << DefinedGVSummaries.first << "'\n");
+      MIS->computeImportForModule(DefinedGVSummaries.second,
+                                  DefinedGVSummaries.first, ImportList);
+    }
   }
 
   // When computing imports we only added the variables and functions being
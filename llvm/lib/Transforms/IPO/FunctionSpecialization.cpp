@@ -12,6 +12,8 @@
 #include "llvm/Analysis/ConstantFolding.h"
 #include "llvm/Analysis/InlineCost.h"
 #include "llvm/Analysis/InstructionSimplify.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
+#include "llvm/Analysis/ProfileSummaryInfo.h"
 #include "llvm/Analysis/TargetTransformInfo.h"
 #include "llvm/Analysis/ValueLattice.h"
 #include "llvm/Analysis/ValueLatticeUtils.h"
@@ -93,6 +95,11 @@ static cl::opt<bool> SpecializeLiteralConstant(
     "Enable specialization of functions that take a literal constant as an "
     "argument"));
 
+static cl::opt<bool> SkipColdCallSites(
+    "funcspec-skip-cold-call-sites", cl::init(false), cl::Hidden, cl::desc(
+    "Don't specialize functions for call sites which the profile summary "
+    "deems cold"));
+
 bool InstCostVisitor::canEliminateSuccessor(BasicBlock *BB, BasicBlock *Succ,
                                          DenseSet<BasicBlock *> &DeadBlocks) {
   unsigned I = 0;
@@ -728,6 +735,16 @@ bool FunctionSpecializer::run() {
     Spec &S = AllSpecs[BestSpecs[I]];
     S.Clone = createSpecialization(S.F, S.Sig);
 
+    OptimizationRemarkEmitter ORE(S.F);
+    ORE.emit([&]() {
+      return OptimizationRemark(DEBUG_TYPE, "Specialized", S.F)
+             << "specialized " << ore::NV("Function", S.F) << " as "
+             << ore::NV("Clone", S.Clone) << " with score "
+             << ore::NV("Score", S.Score) << " for "
+             << ore::NV("NumCallSites", unsigned(S.CallSites.size()))
+             << " call sites";
+    });
+
     // Update the known call sites to call the clone.
     for (CallBase *Call : S.CallSites) {
       LLVM_DEBUG(dbgs() << "FnSpecialization: Redirecting " << *Call
@@ -821,6 +838,22 @@ bool FunctionSpecializer::findSpecializations(Function *F, unsigned FuncSize,
   if (Args.empty())
     return false;
 
+  // Profile information, if available and requested, is used to avoid
+  // growing code for call sites which are rarely executed. Module analyses
+  // can only be read from the cache here; IPSCCP computes the profile summary
+  // before running the specializer, but other users of the specializer may
+  // not have done so.
+  ProfileSummaryInfo *PSI = nullptr;
+  if (SkipColdCallSites && FAM) {
+    PSI = FAM->getResult<ModuleAnalysisManagerFunctionProxy>(*F)
+              .getCachedResult<ProfileSummaryAnalysis>(M);
+    if (!PSI)
+      LLVM_DEBUG(dbgs() << "FnSpecialization: No cached profile summary, "
+                        << "not skipping cold call sites\n");
+    else if (!PSI->hasProfileSummary())
+      PSI = nullptr;
+  }
+
   for (User *U : F->users()) {
     if (!isa<CallInst>(U) && !isa<InvokeInst>(U))
       continue;
@@ -840,6 +873,12 @@ bool FunctionSpecializer::findSpecializations(Function *F, unsigned FuncSize,
     if (!Solver.isBlockExecutable(CS.getParent()))
       continue;
 
+    if (PSI && PSI->isColdCallSite(CS, &GetBFI(*CS.getFunction()))) {
+      LLVM_DEBUG(dbgs() << "FnSpecialization: Skipping cold call site " << CS
+                        << "\n");
+      continue;
+    }
+
     // Examine arguments and create a specialisation candidate from the
     // constant operands of this call site.
     SpecSig S;
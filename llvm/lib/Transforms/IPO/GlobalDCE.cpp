@@ -272,6 +272,11 @@ PreservedAnalyses GlobalDCEPass::run(Module &M, ModuleAnalysisManager &MAM) {
     if (Comdat *C = GA.getComdat())
       ComdatMembers.insert(std::make_pair(C, &GA));
 
+  // Every global value may end up with an entry in the dependency graph; size
+  // the map up front so that building it on large modules does not rehash.
+  GVDependencies.reserve(M.global_size() + M.size() + M.alias_size() +
+                         M.ifunc_size());
+
   // Add dependencies between virtual call sites and the virtual functions they
   // might call, if we have that information.
   AddVirtualFunctionDependencies(M);
@@ -315,7 +320,12 @@ PreservedAnalyses GlobalDCEPass::run(Module &M, ModuleAnalysisManager &MAM) {
                                            AliveGlobals.end()};
   while (!NewLiveGVs.empty()) {
     GlobalValue *LGV = NewLiveGVs.pop_back_val();
-    for (auto *GVD : GVDependencies[LGV])
+    // Most live globals have no dependents; look them up without inserting an
+    // empty entry for each of them.
+    auto It = GVDependencies.find(LGV);
+    if (It == GVDependencies.end())
+      continue;
+    for (auto *GVD : It->second)
       MarkLive(*GVD, &NewLiveGVs);
   }
 
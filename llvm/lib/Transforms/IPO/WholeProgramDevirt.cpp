@@ -737,7 +737,7 @@ struct DevirtIndex {
   }
 
   bool tryFindVirtualCallTargets(std::vector<ValueInfo> &TargetsForSlot,
-                                 const TypeIdCompatibleVtableInfo TIdInfo,
+                                 const TypeIdCompatibleVtableInfo &TIdInfo,
                                  uint64_t ByteOffset);
 
   bool trySingleImplDevirt(MutableArrayRef<ValueInfo> TargetsForSlot,
@@ -1100,7 +1100,7 @@ bool DevirtModule::tryFindVirtualCallTargets(
 
 bool DevirtIndex::tryFindVirtualCallTargets(
     std::vector<ValueInfo> &TargetsForSlot,
-    const TypeIdCompatibleVtableInfo TIdInfo, uint64_t ByteOffset) {
+    const TypeIdCompatibleVtableInfo &TIdInfo, uint64_t ByteOffset) {
   for (const TypeIdOffsetVtableInfo &P : TIdInfo) {
     // Find a representative copy of the vtable initializer.
     // We can have multiple available_externally, linkonce_odr and weak_odr
@@ -139,6 +139,8 @@ STATISTIC(NumOfPGOSplit, "Number of critical edge splits.");
 STATISTIC(NumOfPGOFunc, "Number of functions having valid profile counts.");
 STATISTIC(NumOfPGOMismatch, "Number of functions having mismatch profile.");
 STATISTIC(NumOfPGOMissing, "Number of functions without profile.");
+STATISTIC(NumOfPGOStaleZero,
+          "Number of functions with a stale profile treated as never run.");
 STATISTIC(NumOfPGOICall, "Number of indirect call value instrumentations.");
 STATISTIC(NumOfCSPGOInstrument, "Number of edges instrumented in CSPGO.");
 STATISTIC(NumOfCSPGOSelectInsts,
@@ -195,6 +197,14 @@ static cl::opt<bool> DoComdatRenaming(
     cl::desc("Append function hash to the name of COMDAT function to avoid "
              "function hash mismatch due to the preinliner"));
 
+// Command line option to salvage stale profiles that carry no counts. A CFG
+// change invalidates the mapping of counters to edges, but if every record of
+// the function is all zeros, the function was not executed under any version.
+static cl::opt<bool> PGOSalvageStaleZeroProfile(
+    "pgo-salvage-stale-zero-profile", cl::init(false), cl::Hidden,
+    cl::desc("Treat a function whose profile only mismatches on the CFG hash "
+             "and has no counts in any record as never executed"));
+
 namespace llvm {
 // Command line option to enable/disable the warning about missing profile
 // information.
@@ -1318,6 +1328,24 @@ bool PGOUseFunc::readCounters(IndexedInstrProfReader *PGOReader, bool &AllZeros,
       FuncInfo.FuncName, FuncInfo.FunctionHash, FuncInfo.DeprecatedFuncName,
       &MismatchedFuncSum);
   if (Error E = Result.takeError()) {
+    if (PGOSalvageStaleZeroProfile && MismatchedFuncSum == 0) {
+      // Only a hash mismatch is salvaged; any other error is still reported
+      // below. handleErrors returns success iff every error was handled.
+      E = handleErrors(std::move(E),
+                       [&](std::unique_ptr<InstrProfError> IPE) -> Error {
+                         if (IPE->get() != instrprof_error::hash_mismatch)
+                           return Error(std::move(IPE));
+                         return Error::success();
+                       });
+      if (!E) {
+        LLVM_DEBUG(dbgs() << "stale profile with zero counts for "
+                          << FuncInfo.FuncName << "\n");
+        NumOfPGOStaleZero++;
+        AllZeros = true;
+        ProgramMaxCount = PGOReader->getMaximumFunctionCount(IsCS);
+        return true;
+      }
+    }
     handleInstrProfError(std::move(E), MismatchedFuncSum);
     return false;
   }
@@ -1601,6 +1601,7 @@ public:
     CallWideningDecisions.clear();
     Uniforms.clear();
     Scalars.clear();
+    ScalarInstructionCosts.clear();
   }
 
   /// The vectorization cost is a combination of the cost itself and a boolean
@@ -1745,6 +1746,11 @@ private:
   /// scalarized.
   DenseMap<ElementCount, SmallPtrSet<Instruction *, 4>> ForcedScalars;
 
+  /// Holds the scalar (VF = 1) cost of the instructions whose cost has been
+  /// computed. It does not depend on the candidate VF, but it is needed for
+  /// every candidate VF that keeps an instruction uniform or scalarizes it.
+  DenseMap<Instruction *, VectorizationCostTy> ScalarInstructionCosts;
+
   /// PHINodes of the reductions that should be expanded in-loop.
   SmallPtrSet<PHINode *, 4> InLoopReductions;
 
@@ -6400,6 +6406,12 @@ LoopVectorizationCostModel::getInstructionCost(Instruction *I,
   if (isUniformAfterVectorization(I, VF))
     VF = ElementCount::getFixed(1);
 
+  if (VF.isScalar()) {
+    auto It = ScalarInstructionCosts.find(I);
+    if (It != ScalarInstructionCosts.end())
+      return It->second;
+  }
+
   if (VF.isVector() && isProfitableToScalarize(I, VF))
     return VectorizationCostTy(InstsToScalarize[VF][I], false);
 
@@ -6432,7 +6444,10 @@ LoopVectorizationCostModel::getInstructionCost(Instruction *I,
     } else
       C = InstructionCost::getInvalid();
   }
-  return VectorizationCostTy(C, TypeNotScalarized);
+  VectorizationCostTy Cost(C, TypeNotScalarized);
+  if (VF.isScalar())
+    ScalarInstructionCosts[I] = Cost;
+  return Cost;
 }
 
 InstructionCost LoopVectorizationCostModel::getScalarizationOverhead(
@@ -84,6 +84,7 @@
 #include "llvm/Support/InstructionCost.h"
 #include "llvm/Support/KnownBits.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/InjectTLIMappings.h"
 #include "llvm/Transforms/Utils/Local.h"
@@ -108,6 +109,8 @@ using namespace slpvectorizer;
 #define DEBUG_TYPE "SLP"
 
 STATISTIC(NumVectorInstructions, "Number of vector instructions generated");
+STATISTIC(NumTreesBuilt, "Number of trees built");
+STATISTIC(NumBundlesVisited, "Number of bundles visited while building trees");
 
 static cl::opt<bool>
     RunSLPVectorization("vectorize-slp", cl::init(true), cl::Hidden,
@@ -5758,6 +5761,7 @@ void BoUpSLP::buildTree(ArrayRef<Value *> Roots,
   UserIgnoreList = &UserIgnoreLst;
   if (!allSameType(Roots))
     return;
+  ++NumTreesBuilt;
   buildTree_rec(Roots, 0, EdgeInfo());
 }
 
@@ -5765,6 +5769,7 @@ void BoUpSLP::buildTree(ArrayRef<Value *> Roots) {
   deleteTree();
   if (!allSameType(Roots))
     return;
+  ++NumTreesBuilt;
   buildTree_rec(Roots, 0, EdgeInfo());
 }
 
@@ -6310,6 +6315,7 @@ BoUpSLP::TreeEntry::EntryState BoUpSLP::getScalarsVectorizationState(
 void BoUpSLP::buildTree_rec(ArrayRef<Value *> VL, unsigned Depth,
                             const EdgeInfo &UserTreeIdx) {
   assert((allConstant(VL) || allSameType(VL)) && "Invalid types!");
+  ++NumBundlesVisited;
 
   SmallVector<int> ReuseShuffleIndicies;
   SmallVector<Value *> UniqueValues;
@@ -15292,11 +15298,15 @@ bool SLPVectorizerPass::runImpl(Function &F, ScalarEvolution *SE_,
     if (!Stores.empty()) {
       LLVM_DEBUG(dbgs() << "SLP: Found stores for " << Stores.size()
                         << " underlying objects.\n");
+      TimeTraceScope TimeScope("SLPVectorizeStoreChains", F.getName());
       Changed |= vectorizeStoreChains(R);
     }
 
     // Vectorize trees that end at reductions.
-    Changed |= vectorizeChainsInBlock(BB, R);
+    {
+      TimeTraceScope TimeScope("SLPVectorizeChainsInBlock", F.getName());
+      Changed |= vectorizeChainsInBlock(BB, R);
+    }
 
     // Vectorize the index computations of getelementptr instructions. This
     // is primarily intended to catch gather-like idioms ending at
@@ -15304,6 +15314,7 @@ bool SLPVectorizerPass::runImpl(Function &F, ScalarEvolution *SE_,
     if (!GEPs.empty()) {
       LLVM_DEBUG(dbgs() << "SLP: Found GEPs for " << GEPs.size()
                         << " underlying objects.\n");
+      TimeTraceScope TimeScope("SLPVectorizeGEPIndices", F.getName());
       Changed |= vectorizeGEPIndices(BB, R);
     }
   }
@@ -0,0 +1,44 @@
+; Test that -partition-opt-pipeline runs on every partition split off for
+; parallel code generation, and on the merged module without splitting.
+
+; RUN: llvm-as %s -o %t.bc
+
+; RUN: llvm-lto2 run %t.bc -o %t.split -lto-partitions=2 \
+; RUN:   -opt-pipeline=no-op-module \
+; RUN:   -partition-opt-pipeline='function(instsimplify)' \
+; RUN:   -debug-pass-manager -r %t.bc,f,px -r %t.bc,g,px 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=PASSES
+; RUN: llvm-nm %t.split.0 %t.split.1 | FileCheck %s --check-prefix=SPLIT
+
+; RUN: llvm-lto2 run %t.bc -o %t.merged \
+; RUN:   -opt-pipeline=no-op-module \
+; RUN:   -partition-opt-pipeline='function(instsimplify)' \
+; RUN:   -debug-pass-manager -r %t.bc,f,px -r %t.bc,g,px 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=PASSES
+
+; Without the option only the main pipeline runs.
+; RUN: llvm-lto2 run %t.bc -o %t.none -lto-partitions=2 \
+; RUN:   -opt-pipeline=no-op-module \
+; RUN:   -debug-pass-manager -r %t.bc,f,px -r %t.bc,g,px 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=NONE
+
+; PASSES-DAG: Running pass: InstSimplifyPass on f
+; PASSES-DAG: Running pass: InstSimplifyPass on g
+
+; SPLIT-DAG: T f
+; SPLIT-DAG: T g
+
+; NONE-NOT: InstSimplifyPass
+
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @f(i32 %x) {
+  %a = add i32 %x, 0
+  ret i32 %a
+}
+
+define i32 @g(i32 %x) {
+  %a = mul i32 %x, 1
+  ret i32 %a
+}
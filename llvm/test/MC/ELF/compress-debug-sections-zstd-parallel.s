@@ -0,0 +1,30 @@
+# REQUIRES: zstd, x86-registered-target
+
+## -parallel-debug-compression compresses large zstd debug sections as a
+## sequence of independent frames. The result must not depend on the number of
+## threads and must decompress to the same bytes as the single-frame default.
+
+# RUN: llvm-mc -filetype=obj -triple=x86_64 --compress-debug-sections=zstd %s \
+# RUN:   -o %t.serial.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 --compress-debug-sections=zstd %s \
+# RUN:   -parallel-debug-compression -o %t.parallel1.o
+# RUN: llvm-mc -filetype=obj -triple=x86_64 --compress-debug-sections=zstd %s \
+# RUN:   -parallel-debug-compression -o %t.parallel2.o
+
+## Sharding is deterministic.
+# RUN: cmp %t.parallel1.o %t.parallel2.o
+
+# RUN: llvm-readelf -S %t.parallel1.o | FileCheck %s
+# CHECK: .debug_str PROGBITS {{.*}} MSC
+
+## Both layouts decompress to identical objects.
+# RUN: llvm-objcopy --decompress-debug-sections %t.serial.o %t.serial.dec.o
+# RUN: llvm-objcopy --decompress-debug-sections %t.parallel1.o %t.parallel.dec.o
+# RUN: cmp %t.serial.dec.o %t.parallel.dec.o
+
+## 3 MiB of strings, i.e. several shards with a partial last one.
+  .section .debug_str,"MS",@progbits,1
+  .rept 3 * 1024 + 7
+  .fill 1023, 1, 0x61
+  .byte 0
+  .endr
@@ -0,0 +1,51 @@
+; Test that -compile-time-budget-function-size skips the budgeted passes on
+; functions over the budget only, and reports each skip.
+
+; RUN: opt -passes=instcombine -compile-time-budget-function-size=4 \
+; RUN:   -pass-remarks-analysis=compile-time-budget -S %s 2>%t.remarks \
+; RUN:   | FileCheck %s --check-prefix=IR
+; RUN: FileCheck %s --check-prefix=REMARK --input-file=%t.remarks
+
+; IR-LABEL: define i32 @small(
+; IR-NEXT:    ret i32 %x
+; IR-LABEL: define i32 @big(
+; IR-NEXT:    %a = add i32 %x, 0
+
+; REMARK: remark: {{.*}}skipped instcombine on a function with 6 instructions, over the budget of 4
+; REMARK-NOT: remark:
+
+;; Passes that are not budgeted still run on big functions.
+; RUN: opt -passes=instcombine -compile-time-budget-function-size=4 \
+; RUN:   -compile-time-budget-passes=gvn -S %s | FileCheck %s --check-prefix=OTHER
+; OTHER-LABEL: define i32 @big(
+; OTHER-NEXT:    ret i32 %x
+
+;; With --debug-pass-manager, the skip is logged next to the pass manager's
+;; own record of the skipped pass. Nothing is logged without a budget.
+; RUN: opt -passes=instcombine -compile-time-budget-function-size=4 \
+; RUN:   --debug-pass-manager -disable-output %s 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=DEBUG
+; RUN: opt -passes=instcombine --debug-pass-manager -disable-output %s 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=NOBUDGET
+
+; DEBUG:      Running pass: InstCombinePass on small
+; DEBUG:      Skipping pass instcombine on big due to its size (6 instructions)
+; DEBUG-NEXT: Skipping pass: InstCombinePass on big
+
+; NOBUDGET-NOT: Skipping pass
+; NOBUDGET:     Running pass: InstCombinePass on big
+; NOBUDGET-NOT: Skipping pass
+
+define i32 @small(i32 %x) {
+  %a = add i32 %x, 0
+  ret i32 %a
+}
+
+define i32 @big(i32 %x) {
+  %a = add i32 %x, 0
+  %b = add i32 %a, 0
+  %c = add i32 %b, 0
+  %d = add i32 %c, 0
+  %e = add i32 %d, 0
+  ret i32 %e
+}
@@ -0,0 +1,66 @@
+; Test that importing a function with debug info does not bring along the
+; enums, retained types and globals listed on its compile unit, whose loading
+; the metadata loader skips when importing, while the metadata reachable from
+; the imported function is still loaded.
+
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: opt -module-summary main.ll -o main.bc
+; RUN: opt -module-summary foo.ll -o foo.bc
+; RUN: llvm-lto -thinlto-action=thinlink -o index.bc main.bc foo.bc
+; RUN: llvm-lto -thinlto-action=import -thinlto-index index.bc main.bc \
+; RUN:   -o - | llvm-dis -o - | FileCheck %s
+
+; CHECK:     define available_externally i32 @foo(i32 %x) {{.*}}!dbg
+; CHECK:     distinct !DICompileUnit({{.*}}producer: "foo producer"
+; CHECK-NOT: enums:
+; CHECK-NOT: retainedTypes:
+; CHECK-NOT: globals:
+; CHECK:     distinct !DISubprogram(name: "foo"
+; CHECK:     !DIBasicType(name: "int"
+; CHECK-NOT: DW_TAG_enumeration_type
+; CHECK-NOT: name: "Retained"
+; CHECK-NOT: name: "unused_global"
+
+;--- main.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare i32 @foo(i32)
+
+define i32 @main() {
+  %r = call i32 @foo(i32 1)
+  ret i32 %r
+}
+
+;--- foo.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+@unused_global = global i32 0, !dbg !20
+
+define i32 @foo(i32 %x) !dbg !10 {
+  %r = add i32 %x, 1, !dbg !14
+  ret i32 %r, !dbg !14
+}
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!8, !9}
+
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, producer: "foo producer", isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug, enums: !2, retainedTypes: !6, globals: !19)
+!1 = !DIFile(filename: "foo.c", directory: "/")
+!2 = !{!3}
+!3 = !DICompositeType(tag: DW_TAG_enumeration_type, name: "Color", file: !1, line: 1, baseType: !13, size: 32, elements: !4)
+!4 = !{!5}
+!5 = !DIEnumerator(name: "Red", value: 0)
+!6 = !{!7}
+!7 = !DICompositeType(tag: DW_TAG_structure_type, name: "Retained", file: !1, line: 2, size: 32, elements: !{})
+!8 = !{i32 7, !"Dwarf Version", i32 5}
+!9 = !{i32 2, !"Debug Info Version", i32 3}
+!10 = distinct !DISubprogram(name: "foo", scope: !1, file: !1, line: 3, type: !11, scopeLine: 3, spFlags: DISPFlagDefinition, unit: !0)
+!11 = !DISubroutineType(types: !12)
+!12 = !{!13, !13}
+!13 = !DIBasicType(name: "int", size: 32, encoding: DW_ATE_signed)
+!14 = !DILocation(line: 4, column: 3, scope: !10)
+!19 = !{!20}
+!20 = !DIGlobalVariableExpression(var: !21, expr: !DIExpression())
+!21 = distinct !DIGlobalVariable(name: "unused_global", scope: !0, file: !1, line: 5, type: !13, isLocal: false, isDefinition: true)
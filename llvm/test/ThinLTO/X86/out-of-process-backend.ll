@@ -0,0 +1,59 @@
+; Test that llvm-lto2 -thinlto-distributor runs each backend job through the
+; distributor program, passing it the code generation settings of the link,
+; the module, its individual index and imports files and the object path.
+
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: opt -module-summary main.ll -o main.bc
+; RUN: opt -module-summary foo.ll -o foo.bc
+
+; RUN: llvm-lto2 run main.bc foo.bc -o out -O3 -mcpu=x86-64-v2 -mattr=+avx \
+; RUN:   -relocation-model=static -thinlto-distributor=%python \
+; RUN:   -thinlto-distributor-arg=%t/distributor.py \
+; RUN:   -r main.bc,main,px -r main.bc,foo, -r foo.bc,foo,px
+; RUN: FileCheck %s --check-prefix=MAIN --input-file=out.1
+; RUN: FileCheck %s --check-prefix=FOO --input-file=out.2
+
+; MAIN:      -O3 -mcpu=x86-64-v2 -mattr=+avx -relocation-model=static main.bc
+; MAIN-NEXT: {{.*}}foo.bc
+; FOO:       -O3 -mcpu=x86-64-v2 -mattr=+avx -relocation-model=static foo.bc
+
+; RUN: not llvm-lto2 run main.bc foo.bc -o out -thinlto-distributor=%python \
+; RUN:   -thinlto-distributor-arg=-c \
+; RUN:   -thinlto-distributor-arg="import sys; sys.exit(1)" \
+; RUN:   -r main.bc,main,px -r main.bc,foo, -r foo.bc,foo,px 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=ERR
+; ERR: ThinLTO distributor '{{.*}}' failed for {{.*}}.bc
+
+;--- distributor.py
+# Stands in for a remote compile: records the options it was given and the
+# modules the job imports from instead of producing a real object.
+import os
+import sys
+
+*opts, module, index, imports, obj = sys.argv[1:]
+if not os.path.exists(index):
+    sys.exit("missing index file " + index)
+with open(imports) as f:
+    imported = f.read()
+with open(obj, "w") as f:
+    f.write(" ".join(opts + [os.path.basename(module)]) + "\n")
+    f.write(imported)
+
+;--- main.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @foo()
+
+define void @main() {
+  call void @foo()
+  ret void
+}
+
+;--- foo.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @foo() {
+  ret void
+}
@@ -0,0 +1,65 @@
+; Test that -thinlto-parallel-import-computation produces the same import
+; lists and individual indexes as the serial computation.
+
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: mkdir serial parallel
+; RUN: opt -module-summary main.ll -o serial/main.bc
+; RUN: opt -module-summary foo.ll -o serial/foo.bc
+; RUN: opt -module-summary bar.ll -o serial/bar.bc
+; RUN: cp serial/main.bc serial/foo.bc serial/bar.bc parallel
+
+; RUN: cd %t/serial && llvm-lto2 run main.bc foo.bc bar.bc -o out \
+; RUN:   -thinlto-distributed-indexes -thinlto-emit-imports \
+; RUN:   -r main.bc,main,px -r main.bc,foo, -r main.bc,bar, \
+; RUN:   -r foo.bc,foo,px -r foo.bc,bar, -r bar.bc,bar,px
+; RUN: cd %t/parallel && llvm-lto2 run main.bc foo.bc bar.bc -o out \
+; RUN:   -thinlto-distributed-indexes -thinlto-emit-imports \
+; RUN:   -thinlto-parallel-import-computation \
+; RUN:   -r main.bc,main,px -r main.bc,foo, -r main.bc,bar, \
+; RUN:   -r foo.bc,foo,px -r foo.bc,bar, -r bar.bc,bar,px
+
+; RUN: cd %t
+; RUN: cmp serial/main.bc.imports parallel/main.bc.imports
+; RUN: cmp serial/foo.bc.imports parallel/foo.bc.imports
+; RUN: cmp serial/bar.bc.imports parallel/bar.bc.imports
+; RUN: cmp serial/main.bc.thinlto.bc parallel/main.bc.thinlto.bc
+; RUN: cmp serial/foo.bc.thinlto.bc parallel/foo.bc.thinlto.bc
+; RUN: cmp serial/bar.bc.thinlto.bc parallel/bar.bc.thinlto.bc
+
+; RUN: FileCheck %s --check-prefix=MAIN --input-file=parallel/main.bc.imports
+; RUN: FileCheck %s --check-prefix=FOO --input-file=parallel/foo.bc.imports
+; MAIN-DAG: foo.bc
+; MAIN-DAG: bar.bc
+; FOO:      bar.bc
+
+;--- main.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @foo()
+declare void @bar()
+
+define void @main() {
+  call void @foo()
+  call void @bar()
+  ret void
+}
+
+;--- foo.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @bar()
+
+define void @foo() {
+  call void @bar()
+  ret void
+}
+
+;--- bar.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @bar() {
+  ret void
+}
@@ -0,0 +1,35 @@
+; Test that the in-process backend still compiles every module when its
+; threads are pinned to NUMA nodes. On hosts with a single node the pinning
+; is a no-op.
+
+; RUN: rm -rf %t && split-file %s %t && cd %t
+; RUN: opt -module-summary main.ll -o main.bc
+; RUN: opt -module-summary foo.ll -o foo.bc
+
+; RUN: llvm-lto2 run main.bc foo.bc -o out -thinlto-threads=all \
+; RUN:   -thinlto-pin-to-numa-nodes \
+; RUN:   -r main.bc,main,px -r main.bc,foo, -r foo.bc,foo,px
+; RUN: llvm-nm out.1 | FileCheck %s --check-prefix=MAIN
+; RUN: llvm-nm out.2 | FileCheck %s --check-prefix=FOO
+
+; MAIN: T main
+; FOO:  T foo
+
+;--- main.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+declare void @foo()
+
+define void @main() {
+  call void @foo()
+  ret void
+}
+
+;--- foo.ll
+target datalayout = "e-m:e-p270:32:32-p271:32:32-p272:64:64-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define void @foo() {
+  ret void
+}
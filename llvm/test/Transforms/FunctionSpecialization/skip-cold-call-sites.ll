@@ -0,0 +1,71 @@
+; RUN: opt -passes="ipsccp<func-spec>" -force-specialization -S < %s \
+; RUN:   | FileCheck %s --check-prefix=ALL
+; RUN: opt -passes="ipsccp<func-spec>" -force-specialization \
+; RUN:   -funcspec-skip-cold-call-sites -S < %s \
+; RUN:   | FileCheck %s --check-prefix=SKIP
+; RUN: opt -passes="ipsccp<func-spec>" -force-specialization \
+; RUN:   -funcspec-skip-cold-call-sites -pass-remarks=function-specialization \
+; RUN:   -disable-output < %s 2>&1 | FileCheck %s --check-prefix=REMARK
+
+; The call in %cold is executed about once per thousand calls of @caller, so
+; with -funcspec-skip-cold-call-sites only the call in %hot is specialized.
+; The globals are constant, since the specializer ignores the addresses of
+; mutable globals unless -funcspec-on-address is given.
+
+@A = internal constant i32 1
+@B = internal constant i32 2
+
+declare void @use(i32)
+
+define internal void @compute(ptr %p) {
+entry:
+  %v = load i32, ptr %p
+  call void @use(i32 %v)
+  ret void
+}
+
+define void @caller(i1 %c) !prof !14 {
+entry:
+  br i1 %c, label %hot, label %cold, !prof !15
+
+hot:
+  call void @compute(ptr @A)
+  ret void
+
+cold:
+  call void @compute(ptr @B)
+  ret void
+}
+
+; ALL-LABEL: define void @caller(
+; ALL:       hot:
+; ALL-NEXT:    call void @compute.specialized.{{[0-9]+}}(ptr @A)
+; ALL:       cold:
+; ALL-NEXT:    call void @compute.specialized.{{[0-9]+}}(ptr @B)
+
+; SKIP-LABEL: define void @caller(
+; SKIP:       hot:
+; SKIP-NEXT:    call void @compute.specialized.{{[0-9]+}}(ptr @A)
+; SKIP:       cold:
+; SKIP-NEXT:    call void @compute(ptr @B)
+
+; REMARK:     remark: {{.*}}specialized compute as compute.specialized.{{[0-9]+}} with score {{[0-9]+}} for 1 call sites
+; REMARK-NOT: remark:
+
+!llvm.module.flags = !{!0}
+!0 = !{i32 1, !"ProfileSummary", !1}
+!1 = !{!2, !3, !4, !5, !6, !7, !8, !9}
+!2 = !{!"ProfileFormat", !"InstrProf"}
+!3 = !{!"TotalCount", i64 10000}
+!4 = !{!"MaxCount", i64 10}
+!5 = !{!"MaxInternalCount", i64 1}
+!6 = !{!"MaxFunctionCount", i64 1000}
+!7 = !{!"NumCounts", i64 3}
+!8 = !{!"NumFunctions", i64 3}
+!9 = !{!"DetailedSummary", !10}
+!10 = !{!11, !12, !13}
+!11 = !{i32 10000, i64 100, i32 1}
+!12 = !{i32 999000, i64 100, i32 1}
+!13 = !{i32 999999, i64 1, i32 2}
+!14 = !{!"function_entry_count", i64 1000}
+!15 = !{!"branch_weights", i32 1000, i32 1}
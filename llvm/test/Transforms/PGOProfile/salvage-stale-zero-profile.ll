@@ -0,0 +1,73 @@
+; Test that -pgo-salvage-stale-zero-profile keeps an all-zero profile whose
+; CFG hash no longer matches, and that stale profiles with counts are still
+; dropped.
+
+; RUN: split-file %s %t
+; RUN: llvm-profdata merge %t/profile.proftext -o %t/profile.profdata
+; RUN: opt < %t/main.ll -passes=pgo-instr-use -pgo-test-profile-file=%t/profile.profdata -S 2>&1 | FileCheck %s --check-prefixes=CHECK,DEFAULT
+; RUN: opt < %t/main.ll -passes=pgo-instr-use -pgo-test-profile-file=%t/profile.profdata -pgo-salvage-stale-zero-profile -S 2>&1 | FileCheck %s --check-prefixes=CHECK,SALVAGE
+
+; SALVAGE-NOT: never_run Hash
+; DEFAULT: warning: {{.*}}: function control flow change detected (hash mismatch) never_run Hash = {{[0-9]+}} up to 0 count discarded
+; CHECK:   warning: {{.*}}: function control flow change detected (hash mismatch) stale_hot Hash = {{[0-9]+}} up to 300 count discarded
+
+; CHECK-LABEL: define i32 @never_run(i32 %x)
+; DEFAULT-NOT: !prof
+; SALVAGE-SAME: !prof ![[ZERO:[0-9]+]]
+; CHECK-LABEL: define i32 @stale_hot(i32 %x)
+; CHECK-NOT:   !prof
+
+; SALVAGE: ![[ZERO]] = !{!"function_entry_count", i64 0}
+
+;--- main.ll
+target datalayout = "e-m:e-i64:64-f80:128-n8:16:32:64-S128"
+target triple = "x86_64-unknown-linux-gnu"
+
+define i32 @never_run(i32 %x) {
+entry:
+  %cmp = icmp sgt i32 %x, 0
+  br i1 %cmp, label %then, label %exit
+
+then:
+  %add = add i32 %x, 1
+  br label %exit
+
+exit:
+  %r = phi i32 [ %add, %then ], [ 0, %entry ]
+  ret i32 %r
+}
+
+define i32 @stale_hot(i32 %x) {
+entry:
+  %cmp = icmp sgt i32 %x, 0
+  br i1 %cmp, label %then, label %exit
+
+then:
+  %add = add i32 %x, 1
+  br label %exit
+
+exit:
+  %r = phi i32 [ %add, %then ], [ 0, %entry ]
+  ret i32 %r
+}
+
+;--- profile.proftext
+# IR level Instrumentation Flag
+:ir
+never_run
+# Func Hash:
+1
+# Num Counters:
+2
+# Counter Values:
+0
+0
+
+stale_hot
+# Func Hash:
+1
+# Num Counters:
+2
+# Counter Values:
+100
+200
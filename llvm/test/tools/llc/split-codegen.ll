@@ -0,0 +1,36 @@
+; REQUIRES: x86-registered-target
+
+;; Each partition is written to its own file and together they contain every
+;; function of the module.
+; RUN: rm -rf %t && mkdir %t
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -split-codegen=2 %s -o %t/out.s
+; RUN: cat %t/out.s %t/out.s.1 | FileCheck %s --check-prefix=SPLIT
+; SPLIT-DAG: {{^}}f:
+; SPLIT-DAG: {{^}}g:
+
+;; The partitions are compiled with the same code model as the whole module.
+; RUN: llc -mtriple=x86_64-unknown-linux-gnu -split-codegen=2 -code-model=large \
+; RUN:   %s -o %t/large.s
+; RUN: cat %t/large.s %t/large.s.1 | FileCheck %s --check-prefix=LARGE
+; LARGE: movabsq $var,
+
+; RUN: not llc -mtriple=x86_64-unknown-linux-gnu -split-codegen=2 %s -o - 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=STDOUT
+; STDOUT: error: -split-codegen requires an output file, not stdout
+
+; RUN: not llc -mtriple=x86_64-unknown-linux-gnu -split-codegen=2 %s \
+; RUN:   -o %t/dwo.o -split-dwarf-output=%t/dwo.dwo 2>&1 \
+; RUN:   | FileCheck %s --check-prefix=DWO
+; DWO: error: -split-codegen is not supported with -split-dwarf-output
+
+@var = global i32 0
+
+define i32 @f() {
+  %v = load i32, ptr @var
+  ret i32 %v
+}
+
+define void @g(i32 %x) {
+  store i32 %x, ptr @var
+  ret void
+}
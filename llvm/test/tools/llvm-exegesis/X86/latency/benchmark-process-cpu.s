@@ -0,0 +1,19 @@
+# REQUIRES: exegesis-can-execute-x86_64, exegesis-can-measure-latency, x86_64-linux
+
+## Check that the benchmarking subprocess can be pinned to a CPU, and that a
+## CPU it cannot run on is reported through the child's exit code.
+
+# RUN: llvm-exegesis -mtriple=x86_64-unknown-unknown -mode=latency \
+# RUN:   -snippets-file=%s -execution-mode=subprocess \
+# RUN:   --benchmark-process-cpu=0 | FileCheck %s --check-prefix=PINNED
+# PINNED: measurements:
+# PINNED: error: ''
+
+## CPU_SETSIZE - 1, which is not online on any realistic test machine.
+# RUN: llvm-exegesis -mtriple=x86_64-unknown-unknown -mode=latency \
+# RUN:   -snippets-file=%s -execution-mode=subprocess \
+# RUN:   --benchmark-process-cpu=1023 | FileCheck %s --check-prefix=INVALID
+# INVALID: error: 'Child benchmarking process exited with non-zero exit code: Failed to set CPU affinity of the benchmarking process'
+
+# LLVM-EXEGESIS-DEFREG RAX 0
+addq $1, %rax
@@ -22,6 +22,7 @@
 #include "llvm/CodeGen/MIRParser/MIRParser.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
 #include "llvm/IR/AutoUpgrade.h"
@@ -80,6 +81,12 @@ static cl::opt<std::string>
                          cl::desc(".dwo output filename"),
                          cl::value_desc("filename"));
 
+static cl::opt<unsigned> SplitCodeGen(
+    "split-codegen", cl::init(1u), cl::value_desc("N"),
+    cl::desc("Split the module into N partitions and generate code for them "
+             "in parallel. Partition 0 is written to the output file and "
+             "partition I to <output>.I"));
+
 static cl::opt<unsigned>
 TimeCompilations("time-compilations", cl::Hidden, cl::init(1u),
                  cl::value_desc("N"),
@@ -646,6 +653,59 @@ static int compileModule(char **argv, LLVMContext &Context) {
     WithColor::warning(errs(), argv[0])
         << ": warning: ignoring -mc-relax-all because filetype != obj";
 
+  if (SplitCodeGen > 1) {
+    if (MIR)
+      reportError("-split-codegen is not supported for MIR input",
+                  InputFilename);
+    if (Out->outputFilename() == "-")
+      reportError("-split-codegen requires an output file, not stdout");
+    if (DwoOut)
+      reportError("-split-codegen is not supported with -split-dwarf-output");
+
+    std::vector<std::unique_ptr<ToolOutputFile>> PartOuts;
+    SmallVector<raw_pwrite_stream *, 8> OSs = {&Out->os()};
+    sys::fs::OpenFlags OpenFlags =
+        codegen::getFileType() == CodeGenFileType::AssemblyFile
+            ? sys::fs::OF_TextWithCRLF
+            : sys::fs::OF_None;
+    for (unsigned I = 1; I != SplitCodeGen; ++I) {
+      std::string PartName = (Out->outputFilename() + "." + Twine(I)).str();
+      std::error_code EC;
+      PartOuts.push_back(
+          std::make_unique<ToolOutputFile>(PartName, EC, OpenFlags));
+      if (EC)
+        reportError(EC.message(), PartName);
+      OSs.push_back(&PartOuts.back()->os());
+    }
+
+    // Each partition gets its own target machine, which has to be configured
+    // exactly like the one for the whole module above.
+    std::optional<CodeModel::Model> PartitionCM = CM ? CM : M->getCodeModel();
+    std::string ObjectFilenameForDebug = Out->outputFilename();
+    auto CreatePartitionTM = [&] {
+      std::unique_ptr<TargetMachine> PartitionTM(TheTarget->createTargetMachine(
+          TheTriple.getTriple(), CPUStr, FeaturesStr, Options, RM, PartitionCM,
+          OLvl));
+      assert(PartitionTM && "Could not allocate target machine!");
+      if (std::optional<uint64_t> LDT =
+              codegen::getExplicitLargeDataThreshold())
+        PartitionTM->setLargeDataThreshold(*LDT);
+      if (codegen::getFloatABIForCalls() != FloatABI::Default)
+        PartitionTM->Options.FloatABIType = codegen::getFloatABIForCalls();
+      PartitionTM->Options.ObjectFilenameForDebug = ObjectFilenameForDebug;
+      return PartitionTM;
+    };
+
+    cl::PrintOptionValues();
+    splitCodeGen(*M, OSs, /*BCOSs=*/{}, CreatePartitionTM,
+                 codegen::getFileType());
+
+    Out->keep();
+    for (std::unique_ptr<ToolOutputFile> &PartOut : PartOuts)
+      PartOut->keep();
+    return 0;
+  }
+
   if (EnableNewPassManager || !PassPipeline.empty()) {
     return compileModuleWithNewPM(argv[0], std::move(M), std::move(MIR),
                                   std::move(Target), std::move(Out),
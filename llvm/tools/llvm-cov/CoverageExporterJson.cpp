@@ -296,18 +296,19 @@ json::Array renderFiles(const coverage::CoverageMapping &Coverage,
   return FileArray;
 }
 
-json::Array renderFunctions(
+void renderFunctions(
+    json::OStream &J,
     const iterator_range<coverage::FunctionRecordIterator> &Functions) {
-  json::Array FunctionArray;
-  for (const auto &F : Functions)
-    FunctionArray.push_back(
-        json::Object({{"name", F.Name},
-                      {"count", clamp_uint64_to_int64(F.ExecutionCount)},
-                      {"regions", renderRegions(F.CountedRegions)},
-                      {"branches", renderBranchRegions(F.CountedBranchRegions)},
-                      {"mcdc_records", renderMCDCRecords(F.MCDCRecords)},
-                      {"filenames", json::Array(F.Filenames)}}));
-  return FunctionArray;
+  J.array([&] {
+    for (const auto &F : Functions)
+      J.value(json::Object(
+          {{"name", F.Name},
+           {"count", clamp_uint64_to_int64(F.ExecutionCount)},
+           {"regions", renderRegions(F.CountedRegions)},
+           {"branches", renderBranchRegions(F.CountedBranchRegions)},
+           {"mcdc_records", renderMCDCRecords(F.MCDCRecords)},
+           {"filenames", json::Array(F.Filenames)}}));
+  });
 }
 
 } // end anonymous namespace
@@ -336,15 +337,30 @@ void CoverageExporterJson::renderRoot(ArrayRef<std::string> SourceFiles) {
     const StringRef FilenameB = *ObjB->getString("filename");
     return FilenameA.compare(FilenameB) < 0;
   });
-  auto Export = json::Object(
-      {{"files", std::move(Files)}, {"totals", renderSummary(Totals)}});
-  // Skip functions-level information  if necessary.
-  if (!Options.ExportSummaryOnly && !Options.SkipFunctions)
-    Export["functions"] = renderFunctions(Coverage.getCoveredFunctions());
-
-  auto ExportArray = json::Array({std::move(Export)});
 
-  OS << json::Object({{"version", LLVM_COVERAGE_EXPORT_JSON_STR},
-                      {"type", LLVM_COVERAGE_EXPORT_JSON_TYPE_STR},
-                      {"data", std::move(ExportArray)}});
+  // Stream the document rather than building it as a single json::Value, so
+  // that every file and function record can be released once it is written.
+  // Keys are emitted in sorted order, matching how json::Object prints.
+  json::OStream J(OS);
+  J.object([&] {
+    J.attributeArray("data", [&] {
+      J.object([&] {
+        J.attributeArray("files", [&] {
+          for (json::Value &File : Files) {
+            J.value(File);
+            File = nullptr;
+          }
+        });
+        // Skip functions-level information  if necessary.
+        if (!Options.ExportSummaryOnly && !Options.SkipFunctions) {
+          J.attributeBegin("functions");
+          renderFunctions(J, Coverage.getCoveredFunctions());
+          J.attributeEnd();
+        }
+        J.attribute("totals", renderSummary(Totals));
+      });
+    });
+    J.attribute("type", LLVM_COVERAGE_EXPORT_JSON_TYPE_STR);
+    J.attribute("version", LLVM_COVERAGE_EXPORT_JSON_STR);
+  });
 }
@@ -26,9 +26,9 @@ using namespace llvm;
 
 cl::OptionCategory DebuginfodFindCategory("llvm-debuginfod-find Options");
 
-cl::opt<std::string> InputBuildID(cl::Positional, cl::Required,
-                                  cl::desc("<input build_id>"), cl::init("-"),
-                                  cl::cat(DebuginfodFindCategory));
+cl::list<std::string> InputBuildIDs(cl::Positional, cl::OneOrMore,
+                                    cl::desc("<input build_id>..."),
+                                    cl::cat(DebuginfodFindCategory));
 
 static cl::opt<bool>
     FetchExecutable("executable", cl::init(false),
@@ -69,6 +69,7 @@ static cl::list<std::string> DebugFileDirectory(
 ExitOnError ExitOnErr;
 
 static std::string fetchDebugInfo(object::BuildIDRef BuildID);
+static int fetchDebugInfos(ArrayRef<object::BuildID> BuildIDs);
 
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
@@ -88,12 +89,24 @@ int main(int argc, char **argv) {
   if (FetchExecutable + FetchDebuginfo + (FetchSource != "") != 1)
     helpExit();
 
-  std::string IDString;
-  if (!tryGetFromHex(InputBuildID, IDString)) {
-    errs() << "Build ID " << InputBuildID << " is not a hex string.\n";
-    exit(1);
+  SmallVector<object::BuildID> IDs;
+  for (const std::string &InputBuildID : InputBuildIDs) {
+    std::string IDString;
+    if (!tryGetFromHex(InputBuildID, IDString)) {
+      errs() << "Build ID " << InputBuildID << " is not a hex string.\n";
+      exit(1);
+    }
+    IDs.emplace_back(IDString.begin(), IDString.end());
   }
-  object::BuildID ID(IDString.begin(), IDString.end());
+
+  if (IDs.size() > 1) {
+    if (!FetchDebuginfo || DumpToStdout) {
+      errs() << "Multiple build ids are only supported with --debuginfo.\n";
+      exit(1);
+    }
+    return fetchDebugInfos(IDs);
+  }
+  const object::BuildID &ID = IDs.front();
 
   std::string Path;
   if (FetchSource != "")
@@ -126,3 +139,38 @@ std::string fetchDebugInfo(object::BuildIDRef BuildID) {
          << " could not be found.\n";
   exit(1);
 }
+
+// Fetch the debug files of several build IDs, looking in the local build ID
+// directories first and fetching the remaining ones from debuginfod
+// concurrently. Prints one path per build ID, in order.
+int fetchDebugInfos(ArrayRef<object::BuildID> BuildIDs) {
+  object::BuildIDFetcher LocalFetcher(DebugFileDirectory);
+  SmallVector<std::optional<std::string>> Paths;
+  std::vector<object::BuildID> RemoteIDs;
+  for (const object::BuildID &BuildID : BuildIDs) {
+    Paths.push_back(LocalFetcher.fetch(BuildID));
+    if (!Paths.back())
+      RemoteIDs.push_back(BuildID);
+  }
+
+  std::vector<Expected<std::string>> RemotePaths = fetchDebuginfos(RemoteIDs);
+  int Result = 0;
+  auto RemotePath = RemotePaths.begin();
+  for (auto [BuildID, Path] : llvm::zip_equal(BuildIDs, Paths)) {
+    if (!Path) {
+      if (*RemotePath)
+        Path = std::move(**RemotePath);
+      else
+        consumeError(RemotePath->takeError());
+      ++RemotePath;
+    }
+    if (Path) {
+      outs() << *Path << "\n";
+      continue;
+    }
+    errs() << "Build ID " << llvm::toHex(BuildID, /*Lowercase=*/true)
+           << " could not be found.\n";
+    Result = 1;
+  }
+  return Result;
+}
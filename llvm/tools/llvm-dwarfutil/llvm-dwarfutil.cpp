@@ -9,6 +9,7 @@
 #include "DebugInfoLinker.h"
 #include "Error.h"
 #include "Options.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/DebugInfo/DWARF/DWARFVerifier.h"
 #include "llvm/MC/MCTargetOptionsCommandFlags.h"
@@ -94,6 +95,7 @@ static Error validateAndSetOptions(opt::InputArgList &Args, Options &Options) {
       Args.hasFlag(OPT_garbage_collection, OPT_no_garbage_collection, true);
   Options.Verbose = Args.hasArg(OPT_verbose);
   Options.Verify = Args.hasArg(OPT_verify);
+  Options.Statistics = Args.hasArg(OPT_statistics);
 
   if (opt::Arg *NumThreads = Args.getLastArg(OPT_threads))
     Options.NumThreads = atoi(NumThreads->getValue());
@@ -183,6 +185,68 @@ static Error setConfigToAddNewDebugSections(objcopy::ConfigManager &Config,
   return Error::success();
 }
 
+using DebugInfoBits = SmallString<10000>;
+
+static Error collectDebugSectionSizes(const ObjectFile &ObjFile,
+                                      StringMap<uint64_t> &Sizes) {
+  for (SectionRef Sec : ObjFile.sections()) {
+    Expected<StringRef> SecName = Sec.getName();
+    if (!SecName)
+      return SecName.takeError();
+
+    if (isDebugSection(*SecName))
+      Sizes[*SecName] += Sec.getSize();
+  }
+
+  return Error::success();
+}
+
+static Error printSectionSizeStatistics(ObjectFile &InputFile,
+                                        const DebugInfoBits &LinkedDebugInfo) {
+  StringMap<uint64_t> InputSizes;
+  if (Error Err = collectDebugSectionSizes(InputFile, InputSizes))
+    return Err;
+
+  Expected<std::unique_ptr<ObjectFile>> LinkedObjOrErr =
+      ObjectFile::createObjectFile(MemoryBufferRef(LinkedDebugInfo, ""));
+  if (!LinkedObjOrErr)
+    return LinkedObjOrErr.takeError();
+  StringMap<uint64_t> OutputSizes;
+  if (Error Err = collectDebugSectionSizes(**LinkedObjOrErr, OutputSizes))
+    return Err;
+
+  std::vector<StringRef> Names;
+  for (const auto &Entry : InputSizes)
+    Names.push_back(Entry.getKey());
+  for (const auto &Entry : OutputSizes)
+    if (!InputSizes.contains(Entry.getKey()))
+      Names.push_back(Entry.getKey());
+  llvm::sort(Names);
+
+  // The report goes to stderr so that it cannot interleave with the output
+  // file when that is written to stdout.
+  auto PrintRow = [](StringRef Name, uint64_t Input, uint64_t Output) {
+    double Saved = Input ? 100.0 * (double(Input) - double(Output)) / Input : 0;
+    errs() << formatv("{0,-24} {1,14} {2,14} {3,8:f1}%\n", Name, Input,
+                      Output, Saved);
+  };
+
+  errs() << formatv("{0,-24} {1,14} {2,14} {3,9}\n", "Section", "Input",
+                    "Output", "Saved");
+  uint64_t TotalInput = 0;
+  uint64_t TotalOutput = 0;
+  for (StringRef Name : Names) {
+    uint64_t Input = InputSizes.lookup(Name);
+    uint64_t Output = OutputSizes.lookup(Name);
+    PrintRow(Name, Input, Output);
+    TotalInput += Input;
+    TotalOutput += Output;
+  }
+  PrintRow("Total", TotalInput, TotalOutput);
+
+  return Error::success();
+}
+
 static Error verifyOutput(const Options &Opts) {
   if (Opts.OutputFileName == "-") {
     warning("verification skipped because writing to stdout");
@@ -308,8 +372,6 @@ static Error splitDebugIntoSeparateFile(const Options &Opts,
   return Error::success();
 }
 
-using DebugInfoBits = SmallString<10000>;
-
 static Error addSectionsFromLinkedData(objcopy::ConfigManager &Config,
                                        ObjectFile &InputFile,
                                        DebugInfoBits &LinkedDebugInfoBits) {
@@ -451,12 +513,21 @@ static Error applyCLOptions(const struct Options &Opts, ObjectFile &InputFile) {
     if (Error Err = linkDebugInfo(InputFile, Opts, OutStream))
       return Err;
 
+    if (Opts.Statistics)
+      if (Error Err = printSectionSizeStatistics(InputFile, LinkedDebugInfo))
+        return Err;
+
     if (Error Err =
             saveLinkedDebugInfo(Opts, InputFile, std::move(LinkedDebugInfo)))
       return Err;
 
     return Error::success();
-  } else if (Opts.BuildSeparateDebugFile) {
+  }
+
+  if (Opts.Statistics)
+    warning("statistics skipped because debug info is not linked");
+
+  if (Opts.BuildSeparateDebugFile) {
     if (Error Err = splitDebugIntoSeparateFile(Opts, InputFile))
       return Err;
   } else {
@@ -256,6 +256,12 @@ static cl::opt<BenchmarkRunner::ExecutionModeE> ExecutionMode(
                           "allows for the use of memory annotations")),
     cl::init(BenchmarkRunner::ExecutionModeE::InProcess));
 
+static cl::opt<int> BenchmarkProcessCPU(
+    "benchmark-process-cpu",
+    cl::desc("The CPU number that the benchmarking process should execute "
+             "on. Only supported in the subprocess execution mode"),
+    cl::cat(BenchmarkOptions), cl::init(-1));
+
 static cl::opt<unsigned> BenchmarkRepeatCount(
     "benchmark-repeat-count",
     cl::desc("The number of times to repeat measurements on the benchmark k "
@@ -418,8 +424,11 @@ static void runBenchmarkConfigurations(
         std::optional<StringRef> DumpFile;
         if (DumpObjectToDisk.getNumOccurrences())
           DumpFile = DumpObjectToDisk;
+        std::optional<int> BenchmarkCPU = std::nullopt;
+        if (BenchmarkProcessCPU != -1)
+          BenchmarkCPU = BenchmarkProcessCPU;
         auto [Err, BenchmarkResult] =
-            Runner.runConfiguration(std::move(RC), DumpFile);
+            Runner.runConfiguration(std::move(RC), DumpFile, BenchmarkCPU);
         if (Err) {
           // Errors from executing the snippets are fine.
           // All other errors are a framework issue and should fail.
@@ -487,6 +496,11 @@ void benchmarkMain() {
     ExitWithError("Dummy perf counters are not supported in the subprocess "
                   "execution mode.");
 
+  if (BenchmarkProcessCPU != -1 &&
+      ExecutionMode != BenchmarkRunner::ExecutionModeE::SubProcess)
+    ExitWithError("The --benchmark-process-cpu flag is only supported in the "
+                  "subprocess execution mode.");
+
   const std::unique_ptr<BenchmarkRunner> Runner =
       ExitOnErr(State.getExegesisTarget().createBenchmarkRunner(
           BenchmarkMode, State, BenchmarkPhaseSelector, ExecutionMode,
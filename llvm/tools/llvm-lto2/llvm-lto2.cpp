@@ -60,6 +60,12 @@ static cl::opt<std::string> OptPipeline("opt-pipeline",
                                         cl::desc("Optimizer Pipeline"),
                                         cl::value_desc("pipeline"));
 
+static cl::opt<std::string> PartitionOptPipeline(
+    "partition-opt-pipeline",
+    cl::desc("Optimizer pipeline to run on each regular LTO partition before "
+             "parallel code generation"),
+    cl::value_desc("pipeline"));
+
 static cl::opt<std::string> AAPipeline("aa-pipeline",
                                        cl::desc("Alias Analysis Pipeline"),
                                        cl::value_desc("aapipeline"));
@@ -97,12 +103,27 @@ static cl::opt<bool>
                                 "specified with -thinlto-emit-indexes or "
                                 "-thinlto-distributed-indexes"));
 
+static cl::opt<std::string> ThinLTODistributor(
+    "thinlto-distributor",
+    cl::desc("Run the ThinLTO backend jobs through this distributor program "
+             "instead of in-process"),
+    cl::value_desc("path"));
+
+static cl::list<std::string> ThinLTODistributorArgs(
+    "thinlto-distributor-arg",
+    cl::desc("Pass an argument to the ThinLTO distributor program"));
+
 // Default to using all available threads in the system, but using only one
 // thread per core (no SMT).
 // Use -thinlto-threads=all to use hardware_concurrency() instead, which means
 // to use all hardware threads or cores in the system.
 static cl::opt<std::string> Threads("thinlto-threads");
 
+static cl::opt<unsigned> Partitions(
+    "lto-partitions", cl::init(1),
+    cl::desc("Number of partitions to split regular LTO code generation "
+             "into (default: 1)"));
+
 static cl::list<std::string> SymbolResolutions(
     "r",
     cl::desc("Specify a symbol resolution: filename,symbolname,resolution\n"
@@ -322,6 +343,7 @@ static int run(int argc, char **argv) {
 
   // Run a custom pipeline, if asked for.
   Conf.OptPipeline = OptPipeline;
+  Conf.PartitionOptPipeline = PartitionOptPipeline;
   Conf.AAPipeline = AAPipeline;
 
   Conf.OptLevel = OptLevel - '0';
@@ -352,6 +374,11 @@ static int run(int argc, char **argv) {
                                             ThinLTOEmitImports,
                                             /*LinkedObjectsFile=*/nullptr,
                                             /*OnWrite=*/{});
+  else if (!ThinLTODistributor.empty())
+    Backend = createOutOfProcessThinBackend(
+        llvm::heavyweight_hardware_concurrency(Threads), ThinLTODistributor,
+        SmallVector<StringRef, 4>(ThinLTODistributorArgs.begin(),
+                                  ThinLTODistributorArgs.end()));
   else
     Backend = createInProcessThinBackend(
         llvm::heavyweight_hardware_concurrency(Threads),
@@ -387,7 +414,7 @@ static int run(int argc, char **argv) {
     return 1;
   }
 
-  LTO Lto(std::move(Conf), std::move(Backend), 1, LTOMode);
+  LTO Lto(std::move(Conf), std::move(Backend), Partitions, LTOMode);
 
   for (std::string F : InputFilenames) {
     std::unique_ptr<MemoryBuffer> MB = check(MemoryBuffer::getFile(F), F);
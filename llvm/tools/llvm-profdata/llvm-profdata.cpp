@@ -954,17 +954,21 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
     Pool.wait();
 
     // Merge the writer contexts together (~ lg(NumThreads) serial steps).
+    // A context is destroyed as soon as it has been merged, so that only one
+    // copy of each function's counters is alive at a time.
+    auto MergeAndFree = [&](unsigned DstIdx, unsigned SrcIdx) {
+      mergeWriterContexts(Contexts[DstIdx].get(), Contexts[SrcIdx].get());
+      Contexts[SrcIdx].reset();
+    };
     unsigned Mid = Contexts.size() / 2;
     unsigned End = Contexts.size();
     assert(Mid > 0 && "Expected more than one context");
     do {
       for (unsigned I = 0; I < Mid; ++I)
-        Pool.async(mergeWriterContexts, Contexts[I].get(),
-                   Contexts[I + Mid].get());
+        Pool.async(MergeAndFree, I, I + Mid);
       Pool.wait();
       if (End & 1) {
-        Pool.async(mergeWriterContexts, Contexts[0].get(),
-                   Contexts[End - 1].get());
+        Pool.async(MergeAndFree, 0, End - 1);
         Pool.wait();
       }
       End = Mid;
@@ -976,6 +980,9 @@ static void mergeInstrProfile(const WeightedFileVector &Inputs,
   // is equal to the number of inputs the merge failed.
   unsigned NumErrors = 0;
   for (std::unique_ptr<WriterContext> &WC : Contexts) {
+    // Merged contexts have already handed their errors to the first one.
+    if (!WC)
+      continue;
     for (auto &ErrorPair : WC->Errors) {
       ++NumErrors;
       warn(toString(std::move(ErrorPair.first)), ErrorPair.second);
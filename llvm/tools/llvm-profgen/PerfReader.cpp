@@ -579,14 +579,17 @@ bool PerfScriptReader::extractLBRStack(TraceStream &TraceIt,
     if (Token.size() == 0)
       continue;
 
-    SmallVector<StringRef, 8> Addresses;
-    Token.split(Addresses, "/");
+    // Only the source and target fields are used, so leave the prediction
+    // and cycle fields unsplit. A record without a target yields an empty
+    // DstStr, which fails to parse below.
+    auto [SrcStr, Rest] = Token.split('/');
+    StringRef DstStr = Rest.split('/').first;
     uint64_t Src;
     uint64_t Dst;
 
     // Stop at broken LBR records.
-    if (Addresses.size() < 2 || Addresses[0].substr(2).getAsInteger(16, Src) ||
-        Addresses[1].substr(2).getAsInteger(16, Dst)) {
+    if (SrcStr.substr(2).getAsInteger(16, Src) ||
+        DstStr.substr(2).getAsInteger(16, Dst)) {
       WarnInvalidLBR(TraceIt);
       break;
     }
@@ -569,6 +569,12 @@ int llvm_symbolizer_main(int argc, char **argv, const llvm::ToolContext &) {
 
   std::vector<std::string> InputAddresses = Args.getAllArgValues(OPT_INPUT);
   if (InputAddresses.empty()) {
+    // Reading requests from stdin keeps the process, and with it the parsed
+    // binaries and debug info, alive across requests. Clients that symbolize
+    // many addresses should keep one instance running behind a pipe rather
+    // than spawning one per request. The cached binaries are bounded by
+    // --cache-size and evicted in LRU order after each request. Output is
+    // flushed per request so that clients can wait on each reply.
     const int kMaxInputStringLength = 1024;
     char InputString[kMaxInputStringLength];
 
@@ -310,4 +310,52 @@ TEST(ConcurrentHashTableTest, AddStringEntriesParallelWithResize) {
               std::string::npos);
 }
 
+TEST(ConcurrentHashTableTest, FindEraseAndForEachParallel) {
+  PerThreadBumpPtrAllocator Allocator;
+  const size_t NumElements = 20000;
+  ConcurrentHashTableByPtr<std::string, String, PerThreadBumpPtrAllocator,
+                           ConcurrentHashTableInfoByPtr<
+                               std::string, String, PerThreadBumpPtrAllocator>>
+      HashTable(Allocator, 100);
+
+  parallelFor(0, NumElements, [&](size_t I) {
+    HashTable.insert(formatv("{0}", I));
+  });
+  EXPECT_EQ(HashTable.size(), NumElements);
+
+  // Check parallel lookup and removal of every other element.
+  parallelFor(0, NumElements, [&](size_t I) {
+    std::string StringForElement = formatv("{0}", I);
+    String *Entry = HashTable.find(StringForElement);
+    ASSERT_TRUE(Entry != nullptr);
+    EXPECT_TRUE(Entry->getKey() == StringForElement);
+    if (I % 2 == 0) {
+      EXPECT_EQ(HashTable.erase(StringForElement), Entry);
+      EXPECT_EQ(HashTable.erase(StringForElement), nullptr);
+    }
+  });
+  EXPECT_EQ(HashTable.size(), NumElements / 2);
+
+  // Check that the remaining elements are still reachable after removals
+  // shifted entries of their probe chains.
+  parallelFor(0, NumElements, [&](size_t I) {
+    String *Entry = HashTable.find(formatv("{0}", I));
+    EXPECT_EQ(Entry != nullptr, I % 2 == 1);
+  });
+
+  size_t NumVisited = 0;
+  HashTable.forEach([&](String &Entry) {
+    NumVisited++;
+    EXPECT_EQ(std::stoul(Entry.getKey()) % 2, 1u);
+  });
+  EXPECT_EQ(NumVisited, NumElements / 2);
+
+  // Removed elements can be inserted again.
+  parallelFor(0, NumElements, [&](size_t I) {
+    std::pair<String *, bool> Entry = HashTable.insert(formatv("{0}", I));
+    EXPECT_EQ(Entry.second, I % 2 == 0);
+  });
+  EXPECT_EQ(HashTable.size(), NumElements);
+}
+
 } // namespace
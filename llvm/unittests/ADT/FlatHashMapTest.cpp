@@ -0,0 +1,159 @@
+//===- llvm/unittest/ADT/FlatHashMapTest.cpp - FlatHashMap unit tests -----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/FlatHashMap.h"
+#include "llvm/ADT/DenseMap.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <string>
+
+using namespace llvm;
+
+namespace {
+
+TEST(FlatHashMapTest, EmptyMap) {
+  FlatHashMap<unsigned, unsigned> Map;
+  EXPECT_TRUE(Map.empty());
+  EXPECT_EQ(0u, Map.size());
+  EXPECT_TRUE(Map.begin() == Map.end());
+  EXPECT_FALSE(Map.contains(0));
+  EXPECT_TRUE(Map.find(0) == Map.end());
+  EXPECT_EQ(0u, Map.lookup(0));
+  EXPECT_FALSE(Map.erase(0));
+}
+
+TEST(FlatHashMapTest, InsertFindErase) {
+  FlatHashMap<unsigned, unsigned> Map;
+  auto [It, Inserted] = Map.insert({1, 10});
+  EXPECT_TRUE(Inserted);
+  EXPECT_EQ(1u, It->first);
+  EXPECT_EQ(10u, It->second);
+
+  auto [It2, Inserted2] = Map.insert({1, 20});
+  EXPECT_FALSE(Inserted2);
+  EXPECT_TRUE(It == It2);
+  EXPECT_EQ(10u, Map.lookup(1));
+
+  Map[2] = 20;
+  EXPECT_EQ(2u, Map.size());
+  EXPECT_EQ(20u, Map.at(2));
+  EXPECT_EQ(1u, Map.count(2));
+
+  EXPECT_TRUE(Map.erase(1));
+  EXPECT_FALSE(Map.contains(1));
+  EXPECT_EQ(1u, Map.size());
+  Map.erase(Map.find(2));
+  EXPECT_TRUE(Map.empty());
+}
+
+// The sentinel keys of DenseMapInfo are ordinary keys for FlatHashMap.
+TEST(FlatHashMapTest, SentinelKeys) {
+  FlatHashMap<int *, int> Map;
+  int *Empty = DenseMapInfo<int *>::getEmptyKey();
+  int *Tombstone = DenseMapInfo<int *>::getTombstoneKey();
+  Map[Empty] = 1;
+  Map[Tombstone] = 2;
+  EXPECT_EQ(1, Map.lookup(Empty));
+  EXPECT_EQ(2, Map.lookup(Tombstone));
+}
+
+TEST(FlatHashMapTest, ManyElementsMatchDenseMap) {
+  FlatHashMap<unsigned, unsigned> Map;
+  DenseMap<unsigned, unsigned> Ref;
+  for (unsigned I = 0; I != 10000; ++I) {
+    unsigned Key = I * 7919;
+    Map[Key] = I;
+    Ref[Key] = I;
+  }
+  // Erase every third element to exercise deleted buckets.
+  for (unsigned I = 0; I < 10000; I += 3) {
+    EXPECT_TRUE(Map.erase(I * 7919));
+    Ref.erase(I * 7919);
+  }
+  // Reinsert some of them.
+  for (unsigned I = 0; I < 10000; I += 6)
+    Map[I * 7919] = Ref[I * 7919] = I + 1;
+
+  EXPECT_EQ(Ref.size(), Map.size());
+  for (const auto &[Key, Value] : Ref) {
+    auto It = Map.find(Key);
+    ASSERT_TRUE(It != Map.end());
+    EXPECT_EQ(Value, It->second);
+  }
+  unsigned NumVisited = 0;
+  for (const auto &[Key, Value] : Map) {
+    EXPECT_EQ(Ref.lookup(Key), Value);
+    ++NumVisited;
+  }
+  EXPECT_EQ(Ref.size(), NumVisited);
+}
+
+// Repeated insertion and erasure must not fill the table with deleted markers
+// and grow it without bound.
+TEST(FlatHashMapTest, Churn) {
+  FlatHashMap<unsigned, unsigned> Map;
+  for (unsigned I = 0; I != 100000; ++I) {
+    Map[I] = I;
+    if (I >= 8)
+      EXPECT_TRUE(Map.erase(I - 8));
+  }
+  EXPECT_EQ(8u, Map.size());
+  EXPECT_LE(Map.getNumBuckets(), 32u);
+}
+
+TEST(FlatHashMapTest, Reserve) {
+  FlatHashMap<unsigned, unsigned> Map(100);
+  unsigned NumBuckets = Map.getNumBuckets();
+  EXPECT_GE(NumBuckets, 100u);
+  for (unsigned I = 0; I != 100; ++I)
+    Map[I] = I;
+  EXPECT_EQ(NumBuckets, Map.getNumBuckets());
+}
+
+TEST(FlatHashMapTest, CopyAndMove) {
+  FlatHashMap<unsigned, std::string> Map;
+  for (unsigned I = 0; I != 100; ++I)
+    Map[I] = std::to_string(I);
+
+  FlatHashMap<unsigned, std::string> Copy(Map);
+  EXPECT_EQ(100u, Copy.size());
+  EXPECT_EQ("42", Copy.lookup(42));
+
+  FlatHashMap<unsigned, std::string> Moved(std::move(Copy));
+  EXPECT_EQ(100u, Moved.size());
+  EXPECT_TRUE(Copy.empty());
+
+  Copy = Moved;
+  EXPECT_EQ("99", Copy.lookup(99));
+  Moved = std::move(Map);
+  EXPECT_EQ("7", Moved.lookup(7));
+
+  Moved.clear();
+  EXPECT_TRUE(Moved.empty());
+  EXPECT_FALSE(Moved.contains(7));
+}
+
+TEST(FlatHashMapTest, MoveOnlyValues) {
+  FlatHashMap<unsigned, std::unique_ptr<unsigned>> Map;
+  for (unsigned I = 0; I != 100; ++I)
+    Map.try_emplace(I, std::make_unique<unsigned>(I));
+  for (unsigned I = 0; I != 100; ++I)
+    EXPECT_EQ(I, *Map.find(I)->second);
+}
+
+TEST(FlatHashMapTest, ConstIterator) {
+  FlatHashMap<unsigned, unsigned> Map;
+  Map[3] = 4;
+  const auto &CMap = Map;
+  FlatHashMap<unsigned, unsigned>::const_iterator It = Map.find(3);
+  EXPECT_TRUE(It == CMap.find(3));
+  EXPECT_EQ(4u, It->second);
+  EXPECT_TRUE(CMap.find(5) == CMap.end());
+}
+
+} // namespace
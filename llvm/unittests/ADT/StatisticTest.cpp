@@ -9,6 +9,8 @@
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Support/raw_ostream.h"
 #include "gtest/gtest.h"
+#include <thread>
+#include <vector>
 using namespace llvm;
 
 using OptionalStatistic = std::optional<std::pair<StringRef, uint64_t>>;
@@ -18,6 +20,7 @@ namespace {
 STATISTIC(Counter, "Counts things");
 STATISTIC(Counter2, "Counts other things");
 ALWAYS_ENABLED_STATISTIC(AlwaysCounter, "Counts things always");
+SHARDED_STATISTIC(ShardedCounter, "Counts things from many threads");
 
 #if LLVM_ENABLE_STATS
 static void
@@ -169,4 +172,39 @@ TEST(StatisticTest, API) {
 #endif
 }
 
+TEST(StatisticTest, Sharded) {
+  EnableStatistics();
+  ResetStatistics();
+  EXPECT_EQ(ShardedCounter, 0u);
+
+  // Use more threads than shards so that some of them share a shard.
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I != ShardedStatistic::NumShards + 4; ++I)
+    Threads.emplace_back([] {
+      for (unsigned J = 0; J != 1000; ++J)
+        ++ShardedCounter;
+      ShardedCounter += 10;
+      --ShardedCounter;
+    });
+  for (std::thread &T : Threads)
+    T.join();
+  EXPECT_EQ(ShardedCounter, (ShardedStatistic::NumShards + 4) * 1009u);
+
+  // Sharded statistics are reported in every build.
+  auto Range = GetStatistics();
+  ASSERT_EQ(Range.size(), 1u);
+  EXPECT_EQ(Range[0].first, "ShardedCounter");
+  EXPECT_EQ(Range[0].second, (ShardedStatistic::NumShards + 4) * 1009u);
+
+  std::string JSON;
+  raw_string_ostream OS(JSON);
+  PrintStatisticsJSON(OS);
+  EXPECT_NE(JSON.find("\"unittest.ShardedCounter\": 20180"),
+            std::string::npos);
+
+  ResetStatistics();
+  EXPECT_EQ(ShardedCounter, 0u);
+  EXPECT_TRUE(GetStatistics().empty());
+}
+
 } // end anonymous namespace
@@ -7,11 +7,13 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/BinaryFormat/Dwarf.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/DebugInfo/DWARF/DWARFCompileUnit.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/ObjectYAML/DWARFEmitter.h"
 #include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
+#include <thread>
 
 using namespace llvm;
 using namespace llvm::dwarf;
@@ -643,4 +645,97 @@ TEST(DWARFDie, getDeclFileSpecificationAcrossCUBoundary) {
   EXPECT_EQ(DeclFile, Ref);
 }
 
+#if LLVM_ENABLE_THREADS
+TEST(DWARFDie, ConcurrentExtractionInThreadSafeContext) {
+  const char *yamldata = R"(
+    debug_abbrev:
+      - Table:
+          - Code:            0x00000001
+            Tag:             DW_TAG_compile_unit
+            Children:        DW_CHILDREN_yes
+            Attributes:
+              - Attribute:       DW_AT_name
+                Form:            DW_FORM_string
+          - Code:            0x00000002
+            Tag:             DW_TAG_subprogram
+            Children:        DW_CHILDREN_no
+            Attributes:
+              - Attribute:       DW_AT_name
+                Form:            DW_FORM_string
+    debug_info:
+      - Version:         4
+        AddrSize:        4
+        Entries:
+          - AbbrCode:        0x00000001
+            Values:
+              - CStr:            cu1
+          - AbbrCode:        0x00000002
+            Values:
+              - CStr:            f1
+          - AbbrCode:        0x00000002
+            Values:
+              - CStr:            g1
+          - AbbrCode:        0x00000000
+      - Version:         4
+        AddrSize:        4
+        Entries:
+          - AbbrCode:        0x00000001
+            Values:
+              - CStr:            cu2
+          - AbbrCode:        0x00000002
+            Values:
+              - CStr:            f2
+          - AbbrCode:        0x00000002
+            Values:
+              - CStr:            g2
+          - AbbrCode:        0x00000002
+            Values:
+              - CStr:            h2
+          - AbbrCode:        0x00000000
+  )";
+  Expected<StringMap<std::unique_ptr<MemoryBuffer>>> Sections =
+      DWARFYAML::emitDebugSections(StringRef(yamldata),
+                                   /*IsLittleEndian=*/true,
+                                   /*Is64BitAddrSize=*/false);
+  ASSERT_THAT_EXPECTED(Sections, Succeeded());
+  std::unique_ptr<DWARFContext> Ctx = DWARFContext::create(
+      *Sections, 4, /*isLittleEndian=*/true, WithColor::defaultErrorHandler,
+      WithColor::defaultWarningHandler, /*ThreadSafe=*/true);
+  ASSERT_EQ(Ctx->getNumCompileUnits(), 2u);
+
+  // Every thread first asks for the unit DIE only and keeps it, then walks
+  // all DIEs of the unit. The unit DIE a thread holds must remain the one
+  // stored in the unit, i.e. completing the extraction must not move it.
+  constexpr unsigned NumThreads = 8;
+  struct Result {
+    const DWARFDebugInfoEntry *UnitDIEs[2] = {};
+    unsigned NumChildren[2] = {};
+  };
+  std::vector<Result> Results(NumThreads);
+  std::vector<std::thread> Threads;
+  for (unsigned T = 0; T != NumThreads; ++T)
+    Threads.emplace_back([&, T] {
+      for (unsigned I = 0; I != 2; ++I) {
+        DWARFUnit *CU = Ctx->getUnitAtIndex(I);
+        DWARFDie UnitDie = CU->getUnitDIE(/*ExtractUnitDIEOnly=*/true);
+        Results[T].UnitDIEs[I] = UnitDie.getDebugInfoEntry();
+        for (DWARFDie Child : CU->getUnitDIE(/*ExtractUnitDIEOnly=*/false)
+                                  .children())
+          if (Child.getTag() == DW_TAG_subprogram)
+            ++Results[T].NumChildren[I];
+      }
+    });
+  for (std::thread &Thread : Threads)
+    Thread.join();
+
+  for (const Result &R : Results) {
+    for (unsigned I = 0; I != 2; ++I)
+      EXPECT_EQ(R.UnitDIEs[I],
+                Ctx->getUnitAtIndex(I)->getUnitDIE().getDebugInfoEntry());
+    EXPECT_EQ(R.NumChildren[0], 2u);
+    EXPECT_EQ(R.NumChildren[1], 3u);
+  }
+}
+#endif
+
 } // end anonymous namespace
@@ -67,3 +67,33 @@ TEST(DebuginfodClient, CacheMiss) {
   // A cache miss with no possible URLs should not create the cache directory.
   EXPECT_FALSE(sys::fs::exists(CacheDir));
 }
+
+// Check that fetching several debug binaries at once returns the result for
+// each build ID in order, including repeated ones.
+TEST(DebuginfodClient, FetchDebuginfos) {
+  SmallString<32> CacheDir;
+  ASSERT_NO_ERROR(
+      sys::fs::createUniqueDirectory("debuginfod-unittest", CacheDir));
+  setenv("DEBUGINFOD_CACHE_PATH", CacheDir.c_str(), /*replace=*/1);
+  setenv("DEBUGINFOD_URLS", "", /*replace=*/1);
+  HTTPClient::initialize();
+
+  object::BuildID CachedID = {0xab, 0xcd};
+  object::BuildID MissingID = {0xef};
+  SmallString<64> CachedFilePath(CacheDir);
+  sys::path::append(CachedFilePath,
+                    "llvmcache-" + getDebuginfodCacheKey(
+                                       getDebuginfodDebuginfoUrlPath(CachedID)));
+  std::error_code EC;
+  raw_fd_ostream OF(CachedFilePath, EC);
+  ASSERT_NO_ERROR(EC);
+  OF << "contents\n";
+  OF.close();
+
+  std::vector<Expected<std::string>> Paths =
+      fetchDebuginfos({CachedID, MissingID, CachedID});
+  ASSERT_EQ(Paths.size(), 3u);
+  EXPECT_THAT_EXPECTED(Paths[0], HasValue(std::string(CachedFilePath)));
+  EXPECT_THAT_EXPECTED(Paths[1], Failed<StringError>());
+  EXPECT_THAT_EXPECTED(Paths[2], HasValue(std::string(CachedFilePath)));
+}
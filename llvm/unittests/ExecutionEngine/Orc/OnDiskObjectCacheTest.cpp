@@ -0,0 +1,91 @@
+//===-- OnDiskObjectCacheTest.cpp - Unit tests for the on-disk cache ------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ExecutionEngine/Orc/OnDiskObjectCache.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+static std::unique_ptr<Module> makeModule(LLVMContext &Ctx, StringRef FnName) {
+  auto M = std::make_unique<Module>("M", Ctx);
+  Function::Create(FunctionType::get(Type::getVoidTy(Ctx), false),
+                   GlobalValue::ExternalLinkage, FnName, *M);
+  return M;
+}
+
+TEST(OnDiskObjectCacheTest, RoundTrip) {
+  unittest::TempDir Dir("orc-object-cache", /*Unique=*/true);
+  JITTargetMachineBuilder JTMB((Triple("x86_64-unknown-linux-gnu")));
+  auto Cache = OnDiskObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+
+  LLVMContext Ctx;
+  auto M = makeModule(Ctx, "foo");
+  EXPECT_EQ((*Cache)->getObject(M.get()), nullptr);
+  (*Cache)->notifyObjectCompiled(M.get(),
+                                 MemoryBufferRef("object bytes", "obj"));
+
+  // An identical module in a new context hits, a different one misses.
+  LLVMContext Ctx2;
+  auto Same = makeModule(Ctx2, "foo");
+  auto Obj = (*Cache)->getObject(Same.get());
+  ASSERT_NE(Obj, nullptr);
+  EXPECT_EQ(Obj->getBuffer(), "object bytes");
+  EXPECT_EQ((*Cache)->getObject(makeModule(Ctx2, "bar").get()), nullptr);
+
+  // The code generation configuration is part of the key.
+  JTMB.setCPU("skylake");
+  auto OtherCache = OnDiskObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(OtherCache, Succeeded());
+  EXPECT_EQ((*OtherCache)->getObject(Same.get()), nullptr);
+}
+
+TEST(OnDiskObjectCacheTest, TargetOptionsAreKeyed) {
+  unittest::TempDir Dir("orc-object-cache", /*Unique=*/true);
+  JITTargetMachineBuilder JTMB((Triple("x86_64-unknown-linux-gnu")));
+  auto Cache = OnDiskObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(Cache, Succeeded());
+
+  LLVMContext Ctx;
+  auto M = makeModule(Ctx, "foo");
+  EXPECT_EQ((*Cache)->getObject(M.get()), nullptr);
+  (*Cache)->notifyObjectCompiled(M.get(),
+                                 MemoryBufferRef("object bytes", "obj"));
+
+  // Options that change the generated code must not reuse the object.
+  JTMB.getOptions().FloatABIType = FloatABI::Soft;
+  auto SoftFloatCache = OnDiskObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(SoftFloatCache, Succeeded());
+  EXPECT_EQ((*SoftFloatCache)->getObject(M.get()), nullptr);
+
+  JTMB.getOptions().FloatABIType = FloatABI::Default;
+  JTMB.getOptions().FunctionSections = true;
+  auto SectionsCache = OnDiskObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(SectionsCache, Succeeded());
+  EXPECT_EQ((*SectionsCache)->getObject(M.get()), nullptr);
+
+  // Options that do not affect code generation still hit.
+  JTMB.getOptions().FunctionSections = false;
+  JTMB.getOptions().ObjectFilenameForDebug = "other.o";
+  auto SameCache = OnDiskObjectCache::Create(Dir.path(), JTMB);
+  ASSERT_THAT_EXPECTED(SameCache, Succeeded());
+  EXPECT_NE((*SameCache)->getObject(M.get()), nullptr);
+}
+
+} // namespace
@@ -8,7 +8,9 @@
 
 #include "llvm/IR/ModuleSummaryIndex.h"
 #include "llvm/AsmParser/Parser.h"
+#include "llvm/IR/FlatSummaryIndex.h"
 #include "llvm/Support/SourceMgr.h"
+#include "llvm/Testing/Support/Error.h"
 #include "gtest/gtest.h"
 
 using namespace llvm;
@@ -54,4 +56,59 @@ Versions: 0 MIB:
 		AllocType 2 StackIds: 0, 1, 2, 4
 )");
 }
+
+TEST(ModuleSummaryIndexTest, FlatSummaryIndex) {
+  std::unique_ptr<ModuleSummaryIndex> Index = makeLLVMIndex(R"Summary(
+^0 = module: (path: "b.o", hash: (0, 0, 0, 0, 0))
+^1 = module: (path: "a.o", hash: (0, 0, 0, 0, 0))
+^2 = gv: (guid: 10, summaries: (variable: (module: ^1, flags: (linkage: internal), varFlags: (readonly: 1, writeonly: 0, constant: 0))))
+^3 = gv: (guid: 20, summaries: (function: (module: ^0, flags: (linkage: external, live: 1), insts: 5, refs: (^2))))
+^4 = gv: (guid: 30, summaries: (function: (module: ^1, flags: (linkage: linkonce_odr), insts: 7, calls: ((callee: ^3)), refs: (^2)), function: (module: ^0, flags: (linkage: linkonce_odr), insts: 7, calls: ((callee: ^3)))))
+)Summary");
+  ASSERT_NE(Index, nullptr);
+
+  std::string Data;
+  raw_string_ostream OS(Data);
+  writeFlatSummaryIndex(*Index, OS);
+  OS.flush();
+
+  Expected<FlatSummaryIndex> FlatOrErr =
+      FlatSummaryIndex::create(MemoryBufferRef(Data, "flat"));
+  ASSERT_THAT_EXPECTED(FlatOrErr, Succeeded());
+  FlatSummaryIndex &Flat = *FlatOrErr;
+
+  ASSERT_EQ(Flat.getNumModules(), 2u);
+  EXPECT_EQ(Flat.getModulePath(0), "a.o");
+  EXPECT_EQ(Flat.getModulePath(1), "b.o");
+  ASSERT_EQ(Flat.guids().size(), 3u);
+  EXPECT_FALSE(Flat.findGUID(15));
+
+  std::optional<uint32_t> F20 = Flat.findGUID(20);
+  ASSERT_TRUE(F20);
+  auto [Begin, End] = Flat.getSummaryRange(*F20);
+  ASSERT_EQ(End - Begin, 1u);
+  const flatsummary::SummaryEntry &S20 = Flat.getSummary(Begin);
+  EXPECT_EQ(S20.Module, 1u);
+  EXPECT_EQ(S20.getLinkage(), GlobalValue::ExternalLinkage);
+  EXPECT_EQ(S20.getKind(), GlobalValueSummary::FunctionKind);
+  EXPECT_TRUE(S20.isLive());
+  EXPECT_EQ(S20.InstCount, 5u);
+  EXPECT_TRUE(Flat.calls(Begin).empty());
+  ASSERT_EQ(Flat.refs(Begin).size(), 1u);
+  EXPECT_EQ(Flat.guids()[Flat.refs(Begin)[0]], 10u);
+
+  std::optional<uint32_t> F30 = Flat.findGUID(30);
+  ASSERT_TRUE(F30);
+  std::tie(Begin, End) = Flat.getSummaryRange(*F30);
+  ASSERT_EQ(End - Begin, 2u);
+  for (uint32_t I = Begin; I != End; ++I) {
+    ASSERT_EQ(Flat.calls(I).size(), 1u);
+    EXPECT_EQ(Flat.calls(I)[0], *F20);
+  }
+  EXPECT_EQ(Flat.refs(Begin).size() + Flat.refs(Begin + 1).size(), 1u);
+
+  Data.resize(Data.size() - 1);
+  EXPECT_THAT_EXPECTED(FlatSummaryIndex::create(MemoryBufferRef(Data, "flat")),
+                       Failed());
+}
 } // end anonymous namespace
@@ -7,6 +7,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Support/Allocator.h"
+#include "llvm/Support/Memory.h"
 #include "gtest/gtest.h"
 #include <cstdlib>
 
@@ -258,4 +259,24 @@ TEST(AllocatorTest, TestBigAlignment) {
   EXPECT_GT(MockSlabAllocator::GetLastSlabSize(), 4096u);
 }
 
+// Check that slabs can be mapped directly from the OS.
+TEST(AllocatorTest, TestMappedMemorySlabs) {
+  BumpPtrAllocatorImpl<sys::MappedMemoryAllocator, 1 << 21> Alloc;
+  // Both fit into the first slab together with any sanitizer red zones.
+  char *A = static_cast<char *>(Alloc.Allocate(1 << 18, 64));
+  char *B = static_cast<char *>(Alloc.Allocate(1 << 18, 64));
+  // A custom sized slab.
+  char *C = static_cast<char *>(Alloc.Allocate(1 << 22, 16));
+  A[0] = A[(1 << 18) - 1] = 1;
+  B[0] = B[(1 << 18) - 1] = 2;
+  C[0] = C[(1 << 22) - 1] = 3;
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(A) % 64);
+  EXPECT_EQ(2U, Alloc.GetNumSlabs());
+  EXPECT_EQ(1, A[0]);
+  EXPECT_EQ(2, B[(1 << 18) - 1]);
+  EXPECT_EQ(3, C[0]);
+  Alloc.Reset();
+  EXPECT_EQ(1U, Alloc.GetNumSlabs());
+}
+
 }  // anonymous namespace
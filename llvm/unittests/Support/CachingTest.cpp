@@ -0,0 +1,63 @@
+//===- CachingTest.cpp ----------------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/Caching.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Testing/Support/Error.h"
+#include "llvm/Testing/Support/SupportHelpers.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+using llvm::unittest::TempDir;
+
+TEST(SharedCache, HitFromOtherHost) {
+  TempDir Root("shared-cache", /*Unique=*/true);
+  SmallString<128> SharedDir(Root.path()), HostA(Root.path()),
+      HostB(Root.path());
+  sys::path::append(SharedDir, "shared");
+  sys::path::append(HostA, "a");
+  sys::path::append(HostB, "b");
+
+  std::string Added;
+  auto AddBuffer = [&](size_t Task, const Twine &ModuleName,
+                       std::unique_ptr<MemoryBuffer> MB) {
+    Added = MB->getBuffer().str();
+  };
+
+  // Host A misses everywhere and produces the entry.
+  Expected<FileCache> CacheA =
+      sharedCache("test", "Thin", HostA, SharedDir, AddBuffer);
+  ASSERT_THAT_EXPECTED(CacheA, Succeeded());
+  Expected<AddStreamFn> AddStream = (*CacheA)(0, "key", "mod");
+  ASSERT_THAT_EXPECTED(AddStream, Succeeded());
+  ASSERT_TRUE(bool(*AddStream));
+  {
+    Expected<std::unique_ptr<CachedFileStream>> Stream = (*AddStream)(0, "mod");
+    ASSERT_THAT_EXPECTED(Stream, Succeeded());
+    *(*Stream)->OS << "object";
+  }
+  EXPECT_EQ(Added, "object");
+  SmallString<128> SharedEntry(SharedDir);
+  sys::path::append(SharedEntry, "llvmcache-key");
+  EXPECT_TRUE(sys::fs::exists(SharedEntry));
+
+  // Host B hits in the shared directory and populates its local cache.
+  Added.clear();
+  Expected<FileCache> CacheB =
+      sharedCache("test", "Thin", HostB, SharedDir, AddBuffer);
+  ASSERT_THAT_EXPECTED(CacheB, Succeeded());
+  AddStream = (*CacheB)(0, "key", "mod");
+  ASSERT_THAT_EXPECTED(AddStream, Succeeded());
+  EXPECT_FALSE(bool(*AddStream));
+  EXPECT_EQ(Added, "object");
+  SmallString<128> LocalEntry(HostB);
+  sys::path::append(LocalEntry, "llvmcache-key");
+  EXPECT_TRUE(sys::fs::exists(LocalEntry));
+}
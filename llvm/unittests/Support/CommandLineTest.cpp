@@ -11,6 +11,7 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Config/config.h"
+#include "llvm/Config/llvm-config.h"
 #include "llvm/Support/Allocator.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
@@ -28,6 +29,7 @@
 #include <fstream>
 #include <stdlib.h>
 #include <string>
+#include <thread>
 
 using namespace llvm;
 using llvm::unittest::TempDir;
@@ -2329,4 +2331,63 @@ TEST(CommandLineTest, HelpWithEmptyCategory) {
   cl::ResetCommandLineParser();
 }
 
+TEST(CommandLineTest, DeferredRegistration) {
+  cl::ResetCommandLineParser();
+  cl::DeferOptionRegistrationForTesting();
+
+  StackOption<int> Opt("deferred-opt", cl::init(0));
+  // The option is only queued until the option tables are needed.
+  auto &TopLevelOpts = cl::SubCommand::getTopLevel().OptionsMap;
+  EXPECT_FALSE(TopLevelOpts.contains("deferred-opt"));
+
+  const char *args[] = {"prog", "-deferred-opt=3"};
+  EXPECT_TRUE(cl::ParseCommandLineOptions(std::size(args), args, StringRef(),
+                                          &llvm::nulls()));
+  EXPECT_EQ(3, Opt);
+  EXPECT_TRUE(TopLevelOpts.contains("deferred-opt"));
+}
+
+TEST(CommandLineTest, RemovePendingOption) {
+  cl::ResetCommandLineParser();
+  cl::DeferOptionRegistrationForTesting();
+
+  {
+    StackOption<bool> Removed("removed-opt");
+  }
+  StackOption<bool> Kept("kept-opt");
+
+  // The destroyed option must have been dropped from the queue, rather than
+  // registered as a dangling pointer when the queue is drained.
+  StringMap<cl::Option *> &Map = cl::getRegisteredOptions();
+  EXPECT_FALSE(Map.contains("removed-opt"));
+  ASSERT_TRUE(Map.contains("kept-opt"));
+  EXPECT_EQ(&Kept, Map["kept-opt"]);
+}
+
+#if LLVM_ENABLE_THREADS
+TEST(CommandLineTest, ConcurrentMaterialization) {
+  cl::ResetCommandLineParser();
+  cl::DeferOptionRegistrationForTesting();
+
+  StackOption<bool> Opt1("concurrent-opt1");
+  StackOption<bool> Opt2("concurrent-opt2");
+
+  // The first queries of the option tables may race; each of them must see
+  // the fully drained queue.
+  constexpr unsigned NumThreads = 4;
+  bool Found[NumThreads] = {};
+  std::vector<std::thread> Threads;
+  for (unsigned I = 0; I != NumThreads; ++I)
+    Threads.emplace_back([&Found, I] {
+      StringMap<cl::Option *> &Map = cl::getRegisteredOptions();
+      Found[I] =
+          Map.contains("concurrent-opt1") && Map.contains("concurrent-opt2");
+    });
+  for (std::thread &T : Threads)
+    T.join();
+  for (unsigned I = 0; I != NumThreads; ++I)
+    EXPECT_TRUE(Found[I]) << "thread " << I;
+}
+#endif
+
 } // anonymous namespace
@@ -127,6 +127,37 @@ TEST_F(MemoryBufferTest, getOpenFile) {
   }
 }
 
+TEST_F(MemoryBufferTest, getFiles) {
+  std::vector<std::string> Paths;
+  FileRemover Cleanups[8];
+  for (unsigned I = 0; I != 8; ++I) {
+    int FD;
+    SmallString<64> TestPath;
+    ASSERT_EQ(sys::fs::createTemporaryFile("MemoryBufferTest_getFiles", "temp",
+                                           FD, TestPath),
+              std::error_code());
+    Cleanups[I].setFile(TestPath);
+    raw_fd_ostream OF(FD, /*shouldClose*/ true);
+    OF << "file" << I;
+    OF.close();
+    Paths.push_back(std::string(TestPath));
+  }
+  SmallString<64> MissingPath(Paths.back());
+  MissingPath += ".missing";
+  Paths.push_back(std::string(MissingPath));
+
+  std::vector<ErrorOr<OwningBuffer>> MBs = MemoryBuffer::getFiles(Paths);
+  ASSERT_EQ(Paths.size(), MBs.size());
+  for (unsigned I = 0; I != 8; ++I) {
+    ASSERT_NO_ERROR(MBs[I].getError());
+    EXPECT_EQ("file" + std::to_string(I), MBs[I].get()->getBuffer());
+    EXPECT_EQ(Paths[I], MBs[I].get()->getBufferIdentifier());
+  }
+  EXPECT_EQ(std::errc::no_such_file_or_directory, MBs.back().getError());
+
+  EXPECT_TRUE(MemoryBuffer::getFiles({}).empty());
+}
+
 TEST_F(MemoryBufferTest, NullTerminator4K) {
   // Test that a file with size that is a multiple of the page size can be null
   // terminated correctly by MemoryBuffer.
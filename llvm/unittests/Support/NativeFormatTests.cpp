@@ -161,6 +161,14 @@ TEST(NativeFormatTest, IntegerTests) {
   EXPECT_EQ("100", format_number(100, IntegerStyle::Integer));
   EXPECT_EQ("1000", format_number(1000, IntegerStyle::Integer));
   EXPECT_EQ("1234567890", format_number(1234567890, IntegerStyle::Integer));
+  EXPECT_EQ("9", format_number(9, IntegerStyle::Integer));
+  EXPECT_EQ("99", format_number(99, IntegerStyle::Integer));
+  EXPECT_EQ("-99", format_number(-99, IntegerStyle::Integer));
+  EXPECT_EQ("12345", format_number(12345, IntegerStyle::Integer));
+  EXPECT_EQ("18446744073709551615",
+            format_number(UINT64_MAX, IntegerStyle::Integer));
+  EXPECT_EQ("-9223372036854775808",
+            format_number(INT64_MIN, IntegerStyle::Integer));
 }
 
 TEST(NativeFormatTest, CommaTests) {
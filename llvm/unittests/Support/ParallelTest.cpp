@@ -15,6 +15,8 @@
 #include "llvm/Support/ThreadPool.h"
 #include "gtest/gtest.h"
 #include <array>
+#include <condition_variable>
+#include <mutex>
 #include <random>
 
 uint32_t array[1024 * 1024];
@@ -103,6 +105,65 @@ TEST(Parallel, TaskGroupSequentialFor) {
   EXPECT_EQ(Count, 500ul);
 }
 
+#if LLVM_ENABLE_THREADS
+TEST(Parallel, TaskGroupPriority) {
+  // Keep every worker busy while the tasks of both groups are queued, so that
+  // the order in which they are picked up only depends on their priority.
+  const size_t NumWorkers = parallel::getThreadCount();
+  const size_t NumTasks = 4 * NumWorkers;
+  std::mutex Mutex;
+  std::condition_variable Cond;
+  size_t NumBlocked = 0;
+  bool Released = false;
+
+  size_t NumHighStarted = 0;
+  size_t NumHighStartedBeforeNormal = NumTasks + 1;
+  size_t NumNormalStarted = 0;
+  {
+    parallel::TaskGroup Blockers;
+    parallel::TaskGroup Normal;
+    parallel::TaskGroup High(parallel::TaskPriority::High);
+    EXPECT_EQ(High.getPriority(), parallel::TaskPriority::High);
+
+    for (size_t I = 0; I < NumWorkers; ++I)
+      Blockers.spawn([&]() {
+        std::unique_lock<std::mutex> Lock(Mutex);
+        ++NumBlocked;
+        Cond.notify_all();
+        Cond.wait(Lock, [&] { return Released; });
+      });
+    {
+      std::unique_lock<std::mutex> Lock(Mutex);
+      Cond.wait(Lock, [&] { return NumBlocked == NumWorkers; });
+    }
+
+    for (size_t I = 0; I < NumTasks; ++I) {
+      Normal.spawn([&]() {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        if (NumNormalStarted++ == 0)
+          NumHighStartedBeforeNormal = NumHighStarted;
+      });
+      High.spawn([&]() {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        ++NumHighStarted;
+      });
+    }
+
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      Released = true;
+    }
+    Cond.notify_all();
+  }
+  EXPECT_EQ(NumHighStarted, NumTasks);
+  EXPECT_EQ(NumNormalStarted, NumTasks);
+  // A normal task is only picked up once no high priority task is queued.
+  // The other workers may still be about to start the last high priority
+  // tasks they took.
+  EXPECT_GE(NumHighStartedBeforeNormal + NumWorkers - 1, NumTasks);
+}
+#endif
+
 #if LLVM_ENABLE_THREADS
 TEST(Parallel, NestedTaskGroup) {
   // This test checks:
@@ -50,6 +50,18 @@ TEST(Threading, NumPhysicalCoresSupported) {
   ASSERT_GT(Num, 0);
 }
 
+#if LLVM_ENABLE_THREADS
+TEST(Threading, PinToNUMANodes) {
+  ThreadPoolStrategy S = hardware_concurrency();
+  S.PinToNUMANodes = true;
+  unsigned Count = S.compute_thread_count();
+  ASSERT_GE(get_cpus(), 1u);
+  for (unsigned I = 0; I < Count; ++I)
+    if (std::optional<unsigned> Socket = S.compute_cpu_socket(I))
+      EXPECT_LT(*Socket, get_cpus());
+}
+#endif
+
 TEST(Threading, NumPhysicalCoresUnsupported) {
   if (isThreadingSupportedArchAndOS())
     GTEST_SKIP();
@@ -16,6 +16,8 @@
 
 #include "llvm/Support/TimeProfiler.h"
 #include "gtest/gtest.h"
+#include <chrono>
+#include <thread>
 
 using namespace llvm;
 
@@ -65,6 +67,18 @@ TEST(TimeProfiler, Async_Begin_End_Smoke) {
   ASSERT_TRUE(json.find(R"("detail":"detail")") != std::string::npos);
 }
 
+TEST(TimeProfiler, Scope_Memory_Smoke) {
+  timeTraceProfilerInitialize(/*TimeTraceGranularity=*/0, "test",
+                              /*TraceMemory=*/true);
+
+  { TimeTraceScope scope("event", "detail"); }
+
+  std::string json = teardownProfiler();
+  ASSERT_TRUE(json.find(R"("name":"event")") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("malloc delta bytes":)") != std::string::npos);
+  ASSERT_TRUE(json.find(R"("ph":"C")") != std::string::npos);
+}
+
 TEST(TimeProfiler, Begin_End_Disabled) {
   // Nothing should be observable here. The test is really just making sure
   // we've not got a stray nullptr deref.
@@ -72,4 +86,35 @@ TEST(TimeProfiler, Begin_End_Disabled) {
   timeTraceProfilerEnd();
 }
 
+#if LLVM_ENABLE_THREADS
+TEST(TimeProfiler, Sampling_Smoke) {
+  timeTraceSamplingProfilerInitialize(/*SampleIntervalUs=*/100);
+  EXPECT_TRUE(timeTraceSamplingProfilerEnabled());
+
+  // Stay inside the scopes until the sampler has recorded them, rather than
+  // for a fixed time the sampler thread may not get scheduled in. The
+  // samples may also contain "outer" alone from before "inner" was pushed.
+  auto HasNestedSample = [] {
+    SmallVector<char, 1024> Buffer;
+    raw_svector_ostream OS(Buffer);
+    timeTraceSamplingProfilerWrite(OS);
+    return OS.str().starts_with("outer;inner ") ||
+           OS.str().contains("\nouter;inner ");
+  };
+  bool Sampled = false;
+  {
+    TimeTraceScope Outer("outer");
+    TimeTraceScope Inner("inner", "detail");
+    auto Deadline = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+    while (!(Sampled = HasNestedSample()) &&
+           std::chrono::steady_clock::now() < Deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(Sampled);
+
+  timeTraceSamplingProfilerCleanup();
+  EXPECT_FALSE(timeTraceSamplingProfilerEnabled());
+}
+#endif
+
 } // namespace
@@ -1044,6 +1044,65 @@ TEST(ProxyFileSystemTest, Basic) {
   EXPECT_FALSE(Local);
 }
 
+TEST(CachingStatFileSystemTest, Basic) {
+  IntrusiveRefCntPtr<DummyFileSystem> Base(new DummyFileSystem());
+  ASSERT_FALSE(Base->setCurrentWorkingDirectory("/"));
+  IntrusiveRefCntPtr<vfs::CachingStatFileSystem> CFS(
+      new vfs::CachingStatFileSystem(Base));
+
+  Base->addRegularFile("/a");
+  ErrorOr<vfs::Status> Stat = CFS->status("/a");
+  ASSERT_FALSE(Stat.getError());
+  EXPECT_EQ(1u, CFS->getNumCachedEntries());
+
+  // Relative and absolute spellings share an entry, but keep their names.
+  ErrorOr<vfs::Status> RelStat = CFS->status("./a");
+  ASSERT_FALSE(RelStat.getError());
+  EXPECT_EQ("./a", RelStat->getName());
+  EXPECT_TRUE(RelStat->equivalent(*Stat));
+  EXPECT_EQ(1u, CFS->getNumCachedEntries());
+
+  // Failed lookups are cached until invalidated.
+  EXPECT_FALSE(CFS->exists("/b"));
+  Base->addRegularFile("/b");
+  EXPECT_FALSE(CFS->exists("/b"));
+  CFS->invalidate("/b");
+  EXPECT_TRUE(CFS->exists("/b"));
+
+  // Replacing a file is noticed when it is opened.
+  Base->addRegularFile("/a");
+  EXPECT_TRUE(CFS->status("/a")->equivalent(*Stat));
+  ASSERT_FALSE(CFS->openFileForRead("/a").getError());
+  ErrorOr<vfs::Status> NewStat = CFS->status("/a");
+  ASSERT_FALSE(NewStat.getError());
+  EXPECT_FALSE(NewStat->equivalent(*Stat));
+
+  CFS->invalidateAll();
+  EXPECT_EQ(0u, CFS->getNumCachedEntries());
+}
+
+TEST(CachingStatFileSystemTest, ExternalNames) {
+  IntrusiveRefCntPtr<vfs::InMemoryFileSystem> BaseFS(
+      new vfs::InMemoryFileSystem);
+  BaseFS->addFile("//root/foo/a", 0,
+                  MemoryBuffer::getMemBuffer("contents of a"));
+  IntrusiveRefCntPtr<vfs::FileSystem> RemappedFS(
+      vfs::RedirectingFileSystem::create({{"//root/bar/a", "//root/foo/a"}},
+                                         /*UseExternalNames=*/true, *BaseFS)
+          .release());
+  IntrusiveRefCntPtr<vfs::CachingStatFileSystem> CFS(
+      new vfs::CachingStatFileSystem(RemappedFS));
+
+  // The miss and the hit that follows it both report the external name.
+  for (int I = 0; I < 2; ++I) {
+    ErrorOr<vfs::Status> S = CFS->status("//root/bar/a");
+    ASSERT_FALSE(S.getError());
+    EXPECT_EQ("//root/foo/a", S->getName());
+    EXPECT_TRUE(S->ExposesExternalVFSPath);
+  }
+  EXPECT_EQ(1u, CFS->getNumCachedEntries());
+}
+
 class InMemoryFileSystemTest : public ::testing::Test {
 protected:
   llvm::vfs::InMemoryFileSystem FS;
@@ -0,0 +1,60 @@
+//===- unittest/TableGen/RecordKeeperTest.cpp - RecordKeeper tests --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/TableGen/Parser.h"
+#include "llvm/TableGen/Record.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+std::vector<StringRef> names(ArrayRef<Record *> Defs) {
+  std::vector<StringRef> Names;
+  for (const Record *Def : Defs)
+    Names.push_back(Def->getName());
+  return Names;
+}
+
+TEST(RecordKeeper, DerivedDefinitions) {
+  const char *TdSource = R"td(
+    class A;
+    class B;
+    def AB : A, B;
+    def OnlyA : A;
+    def BA : B, A;
+    def OnlyB : B;
+  )td";
+
+  SourceMgr SrcMgr;
+  SrcMgr.AddNewSourceBuffer(
+      MemoryBuffer::getMemBuffer(TdSource, "test_buffer"), SMLoc());
+  RecordKeeper Records;
+  ASSERT_FALSE(TableGenParseFile(SrcMgr, Records));
+
+  using Names = std::vector<StringRef>;
+  EXPECT_EQ(names(Records.getAllDerivedDefinitions("A")),
+            (Names{"AB", "BA", "OnlyA"}));
+  EXPECT_EQ(names(Records.getAllDerivedDefinitions({"A", "B"})),
+            (Names{"AB", "BA"}));
+  EXPECT_EQ(names(Records.getAllDerivedDefinitions({"B", "A"})),
+            (Names{"AB", "BA"}));
+
+  // Backends may add defs after the lists above were cached. Multi-class
+  // queries must still find them.
+  auto AC = std::make_unique<Record>("AC", ArrayRef<SMLoc>(), Records);
+  AC->addSuperClass(Records.getClass("A"), SMRange());
+  AC->addSuperClass(Records.getClass("B"), SMRange());
+  Records.addDef(std::move(AC));
+  EXPECT_EQ(names(Records.getAllDerivedDefinitions({"A", "B"})),
+            (Names{"AB", "AC", "BA"}));
+}
+
+} // namespace
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cinttypes>
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -133,11 +134,60 @@ public:
   void sort() {
     if (isSorted)
       return;
-    std::sort(elements.begin(), elements.end(), getElementLT());
+    if (!radixSort())
+      std::sort(elements.begin(), elements.end(), getElementLT());
     isSorted = true;
   }
 
 private:
+  /// Sorts elements by their row-major linearized coordinates, which yields
+  /// the same order as `ElementLT` but only ever looks at plain integer keys
+  /// instead of chasing coordinate pointers in every comparison. Uses a
+  /// byte-wise LSD radix sort, skipping bytes that are identical across all
+  /// keys. Returns false, leaving the elements untouched, if the linearized
+  /// coordinates do not fit in 64 bits.
+  bool radixSort() {
+    const uint64_t dimRank = getRank();
+    uint64_t volume = 1;
+    for (uint64_t d = 0; d < dimRank; ++d) {
+      if (dimSizes[d] > UINT64_MAX / volume)
+        return false;
+      volume *= dimSizes[d];
+    }
+    const uint64_t maxKey = volume - 1;
+
+    const size_t nse = elements.size();
+    std::vector<uint64_t> keys;
+    keys.reserve(nse);
+    for (const Element<V> &e : elements) {
+      uint64_t key = 0;
+      for (uint64_t d = 0; d < dimRank; ++d)
+        key = key * dimSizes[d] + e.coords[d];
+      keys.push_back(key);
+    }
+
+    std::vector<uint64_t> scratchKeys(nse);
+    std::vector<Element<V>> scratchElements(elements);
+    for (unsigned shift = 0; shift < 64 && (maxKey >> shift) != 0;
+         shift += 8) {
+      size_t offsets[257] = {0};
+      for (uint64_t key : keys)
+        ++offsets[((key >> shift) & 0xff) + 1];
+      if (offsets[((keys[0] >> shift) & 0xff) + 1] == nse)
+        continue;
+      for (unsigned b = 1; b < 257; ++b)
+        offsets[b] += offsets[b - 1];
+      for (size_t i = 0; i < nse; ++i) {
+        const size_t pos = offsets[(keys[i] >> shift) & 0xff]++;
+        scratchKeys[pos] = keys[i];
+        scratchElements[pos] = elements[i];
+      }
+      keys.swap(scratchKeys);
+      elements.swap(scratchElements);
+    }
+    return true;
+  }
+
   const std::vector<uint64_t> dimSizes; // per-dimension sizes
   std::vector<Element<V>> elements;     // all COO elements
   std::vector<uint64_t> coordinates;    // shared coordinate pool
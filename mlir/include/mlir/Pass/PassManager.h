@@ -418,6 +418,14 @@ public:
   /// unintentionally included in the timing results.
   void enableTiming();
 
+  /// Add an instrumentation that records the execution of each pass and
+  /// analysis as a section of the LLVM time trace profiler (see
+  /// llvm/Support/TimeProfiler.h), using the name of the operation it runs on
+  /// as section detail. Sections are only recorded on threads on which the
+  /// profiler has been initialized, and are written out by whoever initialized
+  /// it.
+  void enableTimeTrace();
+
   //===--------------------------------------------------------------------===//
   // Pass Statistics
 
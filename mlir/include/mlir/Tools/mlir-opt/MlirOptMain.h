@@ -187,6 +187,29 @@ public:
   /// Reproducer file generation (no crash required).
   StringRef getReproducerFilename() const { return generateReproducerFileFlag; }
 
+  /// Set the file to write a time trace of the pass pipeline to, in Chrome
+  /// "Trace Event" format. No trace is recorded if empty.
+  MlirOptMainConfig &setTimeTraceFile(StringRef file) {
+    timeTraceFileFlag = file;
+    return *this;
+  }
+  StringRef getTimeTraceFile() const { return timeTraceFileFlag; }
+
+  /// Set the minimum duration, in microseconds, of sections to record in the
+  /// time trace.
+  MlirOptMainConfig &setTimeTraceGranularity(unsigned granularity) {
+    timeTraceGranularityFlag = granularity;
+    return *this;
+  }
+  unsigned getTimeTraceGranularity() const { return timeTraceGranularityFlag; }
+
+  /// Set whether to record heap usage along with the time trace.
+  MlirOptMainConfig &timeTraceMemory(bool trace) {
+    timeTraceMemoryFlag = trace;
+    return *this;
+  }
+  bool shouldTimeTraceMemory() const { return timeTraceMemoryFlag; }
+
 protected:
   /// Allow operation with no registered dialects.
   /// This option is for convenience during testing only and discouraged in
@@ -248,6 +271,15 @@ protected:
 
   /// The reproducer output filename (no crash required).
   std::string generateReproducerFileFlag = "";
+
+  /// The time trace output filename. No trace is recorded if empty.
+  std::string timeTraceFileFlag = "";
+
+  /// The minimum duration of sections recorded in the time trace.
+  unsigned timeTraceGranularityFlag = 500;
+
+  /// Record heap usage along with the time trace.
+  bool timeTraceMemoryFlag = false;
 };
 
 /// This defines the function type used to setup the pass manager. This can be
@@ -111,6 +111,16 @@ public:
       return ((uintptr_t)ptr & (alignment - 1)) != 0;
     };
 
+    // The writer computes alignment padding relative to the start of the
+    // buffer, so the padding only lines up if the buffer itself is at least as
+    // aligned as the data within it. Detect this upfront instead of reporting a
+    // confusing padding error (or silently misparsing) below.
+    if (LLVM_UNLIKELY(isUnaligned(buffer.begin()))) {
+      return emitError("expected bytecode buffer to be aligned to ", alignment,
+                       ", but got pointer: '0x" +
+                           llvm::utohexstr((uintptr_t)buffer.begin()) + "'");
+    }
+
     // Shift the reader position to the next alignment boundary.
     while (isUnaligned(dataIt)) {
       uint8_t padding;
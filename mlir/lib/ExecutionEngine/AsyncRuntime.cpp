@@ -16,14 +16,16 @@
 #include <atomic>
 #include <cassert>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 
 #include "llvm/ADT/StringMap.h"
-#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 
 using namespace mlir::runtime;
 
@@ -38,6 +40,159 @@ namespace {
 // Forward declare class defined below.
 class RefCounted;
 
+// -------------------------------------------------------------------------- //
+// A work-stealing scheduler for async tasks and coroutine resumptions.
+//
+// Every worker thread owns a task queue. Tasks submitted from a worker thread
+// (e.g. nested `async.execute` regions, or coroutines resumed from a task) go
+// to the back of that worker's queue, and the worker takes its own tasks from
+// the back as well, so that recently spawned tasks run while their data is
+// still hot in the cache. Tasks submitted from outside the scheduler go to a
+// shared queue. Idle workers take tasks from the front of the shared queue or
+// of other workers' queues. Unlike a thread pool with a single FIFO queue,
+// workers only contend for a lock when they run out of work of their own.
+// -------------------------------------------------------------------------- //
+
+class WorkStealingScheduler {
+public:
+  explicit WorkStealingScheduler(unsigned numWorkers)
+      : queues(numWorkers + 1) {
+    for (std::unique_ptr<Queue> &queue : queues)
+      queue = std::make_unique<Queue>();
+    workers.reserve(numWorkers);
+    for (unsigned i = 0; i < numWorkers; ++i)
+      workers.emplace_back([this, i] { runWorker(i); });
+  }
+
+  ~WorkStealingScheduler() {
+    wait();
+    {
+      std::unique_lock<std::mutex> lock(mu);
+      shuttingDown = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread &worker : workers)
+      worker.join();
+  }
+
+  unsigned getNumWorkers() const { return workers.size(); }
+
+  // Schedules `task` for execution on one of the worker threads.
+  void async(std::function<void()> task) {
+    numUnfinished.fetch_add(1);
+
+    Queue &queue =
+        currentScheduler == this ? *queues[currentWorker] : getSharedQueue();
+    {
+      std::unique_lock<std::mutex> lock(queue.mu);
+      queue.tasks.push_back(std::move(task));
+    }
+
+    // Only take the global lock if there are workers that may be waiting for
+    // work. This is paired with the check in `runWorker`: either the idle
+    // worker sees the new task, or this thread sees the idle worker.
+    numQueued.fetch_add(1);
+    if (numIdle.load() > 0) {
+      { std::unique_lock<std::mutex> lock(mu); }
+      workAvailable.notify_one();
+    }
+  }
+
+  // Waits for the completion of all scheduled tasks, including the tasks that
+  // they schedule in turn.
+  void wait() {
+    std::unique_lock<std::mutex> lock(mu);
+    allFinished.wait(lock, [this] { return numUnfinished.load() == 0; });
+  }
+
+private:
+  struct Queue {
+    std::mutex mu;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  Queue &getSharedQueue() { return *queues.back(); }
+
+  // Takes a task from the back of the worker's own queue, or from the front
+  // of the shared queue or another worker's queue.
+  bool tryTake(unsigned worker, std::function<void()> &task) {
+    auto tryTakeFrom = [&](Queue &queue, bool fromBack) {
+      std::unique_lock<std::mutex> lock(queue.mu);
+      if (queue.tasks.empty())
+        return false;
+      if (fromBack) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+      } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+      }
+      return true;
+    };
+
+    if (tryTakeFrom(*queues[worker], /*fromBack=*/true))
+      return true;
+    for (size_t i = 1, e = queues.size(); i < e; ++i)
+      if (tryTakeFrom(*queues[(worker + i) % e], /*fromBack=*/false))
+        return true;
+    return false;
+  }
+
+  void runWorker(unsigned worker) {
+    currentScheduler = this;
+    currentWorker = worker;
+
+    std::function<void()> task;
+    while (true) {
+      if (numQueued.load() > 0 && tryTake(worker, task)) {
+        numQueued.fetch_sub(1);
+        task();
+        task = nullptr;
+        if (numUnfinished.fetch_sub(1) == 1) {
+          { std::unique_lock<std::mutex> lock(mu); }
+          allFinished.notify_all();
+        }
+        continue;
+      }
+
+      // Go to sleep until new tasks are scheduled.
+      std::unique_lock<std::mutex> lock(mu);
+      numIdle.fetch_add(1);
+      workAvailable.wait(
+          lock, [this] { return shuttingDown || numQueued.load() > 0; });
+      numIdle.fetch_sub(1);
+      if (shuttingDown && numQueued.load() == 0)
+        return;
+    }
+  }
+
+  // The queues owned by each worker, followed by the shared queue.
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> workers;
+
+  // The number of tasks sitting in any of the queues.
+  std::atomic<int64_t> numQueued{0};
+  // The number of tasks that were scheduled but have not finished running.
+  std::atomic<int64_t> numUnfinished{0};
+  // The number of workers that are (about to go) waiting for new tasks.
+  std::atomic<int64_t> numIdle{0};
+
+  // Guards the transitions of workers to and from the idle state, and of the
+  // scheduler to the idle or shut down state.
+  std::mutex mu;
+  std::condition_variable workAvailable;
+  std::condition_variable allFinished;
+  bool shuttingDown = false;
+
+  // The scheduler and worker index of the current thread, if it is a worker.
+  static thread_local WorkStealingScheduler *currentScheduler;
+  static thread_local unsigned currentWorker;
+};
+
+thread_local WorkStealingScheduler *WorkStealingScheduler::currentScheduler =
+    nullptr;
+thread_local unsigned WorkStealingScheduler::currentWorker = 0;
+
 // -------------------------------------------------------------------------- //
 // AsyncRuntime orchestrates all async operations and Async runtime API is built
 // on top of the default runtime instance.
@@ -45,10 +200,12 @@ class RefCounted;
 
 class AsyncRuntime {
 public:
-  AsyncRuntime() : numRefCountedObjects(0) {}
+  AsyncRuntime()
+      : numRefCountedObjects(0),
+        scheduler(llvm::hardware_concurrency().compute_thread_count()) {}
 
   ~AsyncRuntime() {
-    threadPool.wait(); // wait for the completion of all async tasks
+    scheduler.wait(); // wait for the completion of all async tasks
     assert(getNumRefCountedObjects() == 0 &&
            "all ref counted objects must be destroyed");
   }
@@ -57,7 +214,7 @@ public:
     return numRefCountedObjects.load(std::memory_order_relaxed);
   }
 
-  llvm::ThreadPoolInterface &getThreadPool() { return threadPool; }
+  WorkStealingScheduler &getScheduler() { return scheduler; }
 
 private:
   friend class RefCounted;
@@ -72,7 +229,7 @@ private:
   }
 
   std::atomic<int64_t> numRefCountedObjects;
-  llvm::DefaultThreadPool threadPool;
+  WorkStealingScheduler scheduler;
 };
 
 // -------------------------------------------------------------------------- //
@@ -394,7 +551,7 @@ extern "C" ValueStorage mlirAsyncRuntimeGetValueStorage(AsyncValue *value) {
 
 extern "C" void mlirAsyncRuntimeExecute(CoroHandle handle, CoroResume resume) {
   auto *runtime = getDefaultAsyncRuntime();
-  runtime->getThreadPool().async([handle, resume]() { (*resume)(handle); });
+  runtime->getScheduler().async([handle, resume]() { (*resume)(handle); });
 }
 
 extern "C" void mlirAsyncRuntimeAwaitTokenAndExecute(AsyncToken *token,
@@ -437,7 +594,7 @@ extern "C" void mlirAsyncRuntimeAwaitAllInGroupAndExecute(AsyncGroup *group,
 }
 
 extern "C" int64_t mlirAsyncRuntimGetNumWorkerThreads() {
-  return getDefaultAsyncRuntime()->getThreadPool().getMaxConcurrency();
+  return getDefaultAsyncRuntime()->getScheduler().getNumWorkers();
 }
 
 //===----------------------------------------------------------------------===//
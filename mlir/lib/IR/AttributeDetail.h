@@ -115,18 +115,17 @@ struct DenseIntOrFPElementsAttrStorage : public DenseElementsAttributeStorage {
     assert(((data.size() / storageSize) == numElements) &&
            "data does not hold expected number of elements");
 
-    // Create the initial hash value with just the first element.
-    auto firstElt = data.take_front(storageSize);
-    auto hashVal = llvm::hash_value(firstElt);
-
-    // Check to see if this storage represents a splat. If it doesn't then
-    // combine the hash for the data starting with the first non splat element.
-    for (size_t i = storageSize, e = data.size(); i != e; i += storageSize)
-      if (memcmp(data.data(), &data[i], storageSize))
-        return KeyTy(ty, data, llvm::hash_combine(hashVal, data.drop_front(i)));
+    // Check to see if this storage represents a splat, i.e. if every element
+    // matches the one before it. Comparing the buffer against itself shifted
+    // by one element does this in a single pass, instead of comparing each
+    // element separately. If it isn't a splat, hash the whole buffer.
+    if (memcmp(data.data(), data.data() + storageSize,
+               data.size() - storageSize))
+      return KeyTy(ty, data, llvm::hash_value(data));
 
     // Otherwise, this is a splat so just return the hash of the first element.
-    return KeyTy(ty, firstElt, hashVal, /*isSplat=*/true);
+    auto firstElt = data.take_front(storageSize);
+    return KeyTy(ty, firstElt, llvm::hash_value(firstElt), /*isSplat=*/true);
   }
 
   /// Construct a key with a set of boolean data.
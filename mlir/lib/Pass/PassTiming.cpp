@@ -10,6 +10,7 @@
 #include "mlir/Pass/PassManager.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/TimeProfiler.h"
 
 #include <chrono>
 #include <optional>
@@ -137,6 +138,42 @@ struct PassTiming : public PassInstrumentation {
     activeTimers.pop_back();
   }
 };
+
+//===----------------------------------------------------------------------===//
+// PassTimeTrace
+//===----------------------------------------------------------------------===//
+
+/// Records the execution of passes and analyses as sections of the LLVM time
+/// trace profiler. The profiler keeps a separate stack of sections per thread,
+/// so unlike `PassTiming` this does not need to track any state itself.
+struct PassTimeTrace : public PassInstrumentation {
+  void runBeforePass(Pass *pass, Operation *op) override {
+    // Adaptors only fan out to the nested pipelines, whose passes are traced
+    // individually.
+    if (isa<OpToOpPassAdaptor>(pass))
+      return;
+    llvm::timeTraceProfilerBegin(pass->getName(),
+                                 op->getName().getStringRef());
+  }
+
+  void runAfterPass(Pass *pass, Operation *) override {
+    if (!isa<OpToOpPassAdaptor>(pass))
+      llvm::timeTraceProfilerEnd();
+  }
+
+  void runAfterPassFailed(Pass *pass, Operation *op) override {
+    runAfterPass(pass, op);
+  }
+
+  void runBeforeAnalysis(StringRef name, TypeID, Operation *op) override {
+    llvm::timeTraceProfilerBegin(("(A) " + name).str(),
+                                 op->getName().getStringRef());
+  }
+
+  void runAfterAnalysis(StringRef, TypeID, Operation *) override {
+    llvm::timeTraceProfilerEnd();
+  }
+};
 } // namespace
 
 //===----------------------------------------------------------------------===//
@@ -166,3 +203,9 @@ void PassManager::enableTiming() {
   tm->setEnabled(true);
   enableTiming(std::move(tm));
 }
+
+/// Add an instrumentation that records the execution of passes and analyses
+/// in the LLVM time trace profiler.
+void PassManager::enableTimeTrace() {
+  addInstrumentation(std::make_unique<PassTimeTrace>());
+}
@@ -2037,21 +2037,23 @@ void ByteCodeExecutor::executeRecordMatch(
     return;
   }
 
-  // Create a fused location containing the locations of each of the
-  // operations used in the match. This will be used as the location for
-  // created operations during the rewrite that don't already have an
-  // explicit location set.
+  matches.emplace_back(patterns[patternIndex], benefit);
+  PDLByteCode::MatchResult &match = matches.back();
+
+  // Record the locations of each of the operations used in the match. These
+  // are fused into the location used for created operations during the
+  // rewrite that don't already have an explicit location set.
   unsigned numMatchLocs = read();
-  SmallVector<Location, 4> matchLocs;
-  matchLocs.reserve(numMatchLocs);
+  match.locations.reserve(numMatchLocs);
   for (unsigned i = 0; i != numMatchLocs; ++i)
-    matchLocs.push_back(read<Operation *>()->getLoc());
-  Location matchLoc = rewriter.getFusedLoc(matchLocs);
+    match.locations.push_back(read<Operation *>()->getLoc());
 
-  LLVM_DEBUG(llvm::dbgs() << "  * Benefit: " << benefit.getBenefit() << "\n"
-                          << "  * Location: " << matchLoc << "\n");
-  matches.emplace_back(matchLoc, patterns[patternIndex], benefit);
-  PDLByteCode::MatchResult &match = matches.back();
+  LLVM_DEBUG({
+    llvm::dbgs() << "  * Benefit: " << benefit.getBenefit() << "\n"
+                 << "  * Locations: ";
+    llvm::interleaveComma(match.locations, llvm::dbgs());
+    llvm::dbgs() << "\n";
+  });
 
   // Record all of the inputs to the match. If any of the inputs are ranges, we
   // will also need to remap the range pointer to memory stored in the match
@@ -2366,8 +2368,8 @@ LogicalResult PDLByteCode::rewrite(PatternRewriter &rewriter,
       state.allocatedValueRangeMemory, state.loopIndex, uniquedData,
       rewriterByteCode, state.currentPatternBenefits, patterns,
       constraintFunctions, rewriteFunctions);
-  LogicalResult result =
-      executor.execute(rewriter, /*matches=*/nullptr, match.location);
+  LogicalResult result = executor.execute(rewriter, /*matches=*/nullptr,
+                                          rewriter.getFusedLoc(match.locations));
 
   if (configSet)
     configSet->notifyRewriteEnd(rewriter);
@@ -132,16 +132,17 @@ public:
   /// Each successful match returns a MatchResult, which contains information
   /// necessary to execute the rewriter and indicates the originating pattern.
   struct MatchResult {
-    MatchResult(Location loc, const PDLByteCodePattern &pattern,
-                PatternBenefit benefit)
-        : location(loc), pattern(&pattern), benefit(benefit) {}
+    MatchResult(const PDLByteCodePattern &pattern, PatternBenefit benefit)
+        : pattern(&pattern), benefit(benefit) {}
     MatchResult(const MatchResult &) = delete;
     MatchResult &operator=(const MatchResult &) = delete;
     MatchResult(MatchResult &&other) = default;
     MatchResult &operator=(MatchResult &&) = default;
 
-    /// The location of operations to be replaced.
-    Location location;
+    /// The locations of the operations to be replaced. These are only fused
+    /// into a single location if the match is actually rewritten, as most
+    /// recorded matches are never applied.
+    SmallVector<Location, 4> locations;
     /// Memory values defined in the matcher that are passed to the rewriter.
     SmallVector<const void *> values;
     /// Memory used for the range input values.
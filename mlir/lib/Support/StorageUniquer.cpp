@@ -12,6 +12,9 @@
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
 #include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
+
+#include <algorithm>
 
 using namespace mlir;
 using namespace mlir::detail;
@@ -245,6 +248,22 @@ private:
 };
 } // namespace
 
+/// Return the number of shards to use for each parametric storage uniquer.
+/// With a fixed number of shards, threads start to contend on the shard locks
+/// once there are more threads than shards, so this scales with the number of
+/// hardware threads. Shards are allocated lazily, so unused ones only cost a
+/// pointer.
+static size_t getNumParametricStorageShards() {
+#if LLVM_ENABLE_THREADS != 0
+  static const size_t numShards = std::clamp<size_t>(
+      llvm::PowerOf2Ceil(llvm::hardware_concurrency().compute_thread_count()),
+      8, 256);
+  return numShards;
+#else
+  return 0;
+#endif
+}
+
 namespace mlir {
 namespace detail {
 /// This is the implementation of the StorageUniquer class.
@@ -380,7 +399,8 @@ auto StorageUniquer::getParametricStorageTypeImpl(
 void StorageUniquer::registerParametricStorageTypeImpl(
     TypeID id, function_ref<void(BaseStorage *)> destructorFn) {
   impl->parametricUniquers.try_emplace(
-      id, std::make_unique<ParametricStorageUniquer>(destructorFn));
+      id, std::make_unique<ParametricStorageUniquer>(
+              destructorFn, getNumParametricStorageShards()));
 }
 
 /// Implementation for getting an instance of a derived type with default
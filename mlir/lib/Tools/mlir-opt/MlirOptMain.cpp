@@ -38,6 +38,7 @@
 #include "mlir/Tools/Plugins/DialectPlugin.h"
 #include "mlir/Tools/Plugins/PassPlugin.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Alignment.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/InitLLVM.h"
@@ -47,6 +48,7 @@
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/StringSaver.h"
 #include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/ToolOutputFile.h"
 
 using namespace mlir;
@@ -172,6 +174,25 @@ struct MlirOptMainConfigCLOptions : public MlirOptMainConfig {
             cl::location(generateReproducerFileFlag), cl::init(""),
             cl::value_desc("filename"));
 
+    static cl::opt<std::string, /*ExternalStorage=*/true> timeTraceFile(
+        "mlir-time-trace",
+        cl::desc("Write a time trace of the pass pipeline in Chrome "
+                 "\"Trace Event\" format to the provided filename"),
+        cl::location(timeTraceFileFlag), cl::init(""),
+        cl::value_desc("filename"));
+
+    static cl::opt<unsigned, /*ExternalStorage=*/true> timeTraceGranularity(
+        "mlir-time-trace-granularity",
+        cl::desc("Minimum time granularity (in microseconds) traced by "
+                 "--mlir-time-trace"),
+        cl::location(timeTraceGranularityFlag), cl::init(500));
+
+    static cl::opt<bool, /*ExternalStorage=*/true> timeTraceMemory(
+        "mlir-time-trace-memory",
+        cl::desc("Record heap usage of each section traced by "
+                 "--mlir-time-trace"),
+        cl::location(timeTraceMemoryFlag), cl::init(false));
+
     /// Set the callback to load a pass plugin.
     passPlugins.setCallback([&](const std::string &pluginPath) {
       auto plugin = PassPlugin::load(pluginPath);
@@ -397,6 +418,8 @@ performActions(raw_ostream &os,
   pm.enableVerifier(config.shouldVerifyPasses());
   if (failed(applyPassManagerCLOptions(pm)))
     return failure();
+  if (llvm::timeTraceProfilerEnabled())
+    pm.enableTimeTrace();
   pm.enableTiming(timing);
   if (config.shouldRunReproducer() && failed(reproOptions.apply(pm)))
     return failure();
@@ -542,14 +565,33 @@ LogicalResult mlir::MlirOptMain(llvm::raw_ostream &outputStream,
   if (threadPoolCtx.isMultithreadingEnabled())
     threadPool = &threadPoolCtx.getThreadPool();
 
+  // Set up the time trace profiler if requested. Only the main thread is
+  // traced, so the trace covers nested pipelines that run on worker threads
+  // only with --mlir-disable-threading.
+  StringRef timeTraceFile = config.getTimeTraceFile();
+  if (!timeTraceFile.empty())
+    llvm::timeTraceProfilerInitialize(config.getTimeTraceGranularity(),
+                                      "mlir-opt",
+                                      config.shouldTimeTraceMemory());
+
   auto chunkFn = [&](std::unique_ptr<MemoryBuffer> chunkBuffer,
                      raw_ostream &os) {
     return processBuffer(os, std::move(chunkBuffer), config, registry,
                          threadPool);
   };
-  return splitAndProcessBuffer(std::move(buffer), chunkFn, outputStream,
-                               config.inputSplitMarker(),
-                               config.outputSplitMarker());
+  LogicalResult result = splitAndProcessBuffer(
+      std::move(buffer), chunkFn, outputStream, config.inputSplitMarker(),
+      config.outputSplitMarker());
+
+  if (!timeTraceFile.empty()) {
+    if (llvm::Error error = llvm::timeTraceProfilerWrite(
+            timeTraceFile, /*FallbackFileName=*/"")) {
+      llvm::errs() << toString(std::move(error)) << "\n";
+      result = failure();
+    }
+    llvm::timeTraceProfilerCleanup();
+  }
+  return result;
 }
 
 LogicalResult mlir::MlirOptMain(int argc, char **argv,
@@ -572,9 +614,12 @@ LogicalResult mlir::MlirOptMain(int argc, char **argv,
     llvm::errs() << "(processing input from stdin now, hit ctrl-c/ctrl-d to "
                     "interrupt)\n";
 
-  // Set up the input file.
+  // Set up the input file. Bytecode resource blobs are referenced in place
+  // from the input buffer, which requires the buffer to be at least as aligned
+  // as the blobs it contains. Large files are mmap'd and thus page aligned
+  // anyway, so give buffers that end up copied into memory the same guarantee.
   std::string errorMessage;
-  auto file = openInputFile(inputFilename, &errorMessage);
+  auto file = openInputFile(inputFilename, llvm::Align(4096), &errorMessage);
   if (!file) {
     llvm::errs() << errorMessage << "\n";
     return failure();
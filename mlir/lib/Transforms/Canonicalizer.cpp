@@ -15,6 +15,7 @@
 
 #include "mlir/Pass/Pass.h"
 #include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/Statistic.h"
 
 namespace mlir {
 #define GEN_PASS_DEF_CANONICALIZER
@@ -24,6 +25,20 @@ namespace mlir {
 using namespace mlir;
 
 namespace {
+/// A rewrite listener that tallies the work done by the greedy driver, so that
+/// it can be reported through the pass statistics.
+struct StatisticsListener : public RewriterBase::Listener {
+  void notifyPatternEnd(const Pattern &pattern,
+                        LogicalResult status) override {
+    ++(succeeded(status) ? numPatternApplications : numPatternFailures);
+  }
+  void notifyOperationErased(Operation *op) override { ++numOpsErased; }
+
+  unsigned numPatternApplications = 0;
+  unsigned numPatternFailures = 0;
+  unsigned numOpsErased = 0;
+};
+
 /// Canonicalize operations in nested regions.
 struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
   Canonicalizer() = default;
@@ -59,11 +74,29 @@ struct Canonicalizer : public impl::CanonicalizerBase<Canonicalizer> {
     return success();
   }
   void runOnOperation() override {
-    LogicalResult converged =
-        applyPatternsAndFoldGreedily(getOperation(), *patterns, config);
+    GreedyRewriteConfig runConfig = config;
+#if LLVM_ENABLE_STATS
+    // Observing the driver makes it invoke the pattern callbacks for every
+    // operation, so only do so when statistics can actually be reported. A
+    // listener provided by the user takes precedence.
+    StatisticsListener listener;
+    if (!runConfig.listener)
+      runConfig.listener = &listener;
+#endif // LLVM_ENABLE_STATS
+    bool changed = false;
+    LogicalResult converged = applyPatternsAndFoldGreedily(
+        getOperation(), *patterns, runConfig, &changed);
+#if LLVM_ENABLE_STATS
+    numPatternApplications += listener.numPatternApplications;
+    numPatternFailures += listener.numPatternFailures;
+    numOpsErased += listener.numOpsErased;
+#endif // LLVM_ENABLE_STATS
     // Canonicalization is best-effort. Non-convergence is not a pass failure.
     if (testConvergence && failed(converged))
-      signalPassFailure();
+      return signalPassFailure();
+    // If nothing changed, neither analyses nor the verifier need to rerun.
+    if (!changed)
+      markAllAnalysesPreserved();
   }
   GreedyRewriteConfig config;
   std::shared_ptr<const FrozenRewritePatternSet> patterns;
@@ -36,12 +36,13 @@ struct ControlFlowSink : public impl::ControlFlowSinkBase<ControlFlowSink> {
 
 void ControlFlowSink::runOnOperation() {
   auto &domInfo = getAnalysis<DominanceInfo>();
+  size_t numSunkOps = 0;
   getOperation()->walk([&](RegionBranchOpInterface branch) {
     SmallVector<Region *> regionsToSink;
     // Get the regions are that known to be executed at most once.
     getSinglyExecutedRegionsToSink(branch, regionsToSink);
     // Sink side-effect free operations.
-    numSunk = controlFlowSink(
+    numSunkOps += controlFlowSink(
         regionsToSink, domInfo,
         [](Operation *op, Region *) { return isMemoryEffectFree(op); },
         [](Operation *op, Region *region) {
@@ -51,6 +52,9 @@ void ControlFlowSink::runOnOperation() {
           op->moveBefore(&region->front(), region->front().begin());
         });
   });
+  numSunk += numSunkOps;
+  if (numSunkOps == 0)
+    markAllAnalysesPreserved();
 }
 
 std::unique_ptr<Pass> mlir::createControlFlowSinkPass() {
@@ -63,6 +63,7 @@ void SymbolDCE::runOnOperation() {
 
   // After computing the liveness, delete all of the symbols that were found to
   // be dead.
+  bool changed = false;
   symbolTableOp->walk([&](Operation *nestedSymbolTable) {
     if (!nestedSymbolTable->hasTrait<OpTrait::SymbolTable>())
       return;
@@ -71,10 +72,13 @@ void SymbolDCE::runOnOperation() {
         if (isa<SymbolOpInterface>(&op) && !liveSymbols.count(&op)) {
           op.erase();
           ++numDCE;
+          changed = true;
         }
       }
     }
   });
+  if (!changed)
+    markAllAnalysesPreserved();
 }
 
 /// Compute the liveness of the symbols within the given symbol table.
@@ -821,6 +821,9 @@ private:
 
 LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
   bool continueRewrites = false;
+  // Whether populating a worklist CSE'd or hoisted a constant. These changes
+  // are made by the folder directly and would otherwise go unreported.
+  bool constantsChanged = false;
   int64_t iteration = 0;
   MLIRContext *ctx = getContext();
   do {
@@ -839,9 +842,18 @@ LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
       // Check for existing constants when populating the worklist. This avoids
       // accidentally reversing the constant order during processing.
       Attribute constValue;
-      if (matchPattern(op, m_Constant(&constValue)))
-        if (!folder.insertKnownConstant(op, constValue))
-          return true;
+      if (!matchPattern(op, m_Constant(&constValue)))
+        return false;
+      Block *oldBlock = op->getBlock();
+      Operation *oldPrevNode = op->getPrevNode();
+      Location oldLoc = op->getLoc();
+      if (!folder.insertKnownConstant(op, constValue)) {
+        constantsChanged = true;
+        return true;
+      }
+      if (op->getBlock() != oldBlock || op->getPrevNode() != oldPrevNode ||
+          op->getLoc() != oldLoc)
+        constantsChanged = true;
       return false;
     };
 
@@ -878,7 +890,7 @@ LogicalResult RegionPatternRewriteDriver::simplify(bool *changed) && {
   } while (continueRewrites);
 
   if (changed)
-    *changed = iteration > 1;
+    *changed = iteration > 1 || constantsChanged;
 
   // Whether the rewrite converges, i.e. wasn't changed in the last iteration.
   return success(!continueRewrites);
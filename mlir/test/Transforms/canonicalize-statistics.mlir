@@ -0,0 +1,17 @@
+// RUN: mlir-opt %s -pass-pipeline='builtin.module(func.func(canonicalize))' \
+// RUN:   -mlir-pass-statistics -mlir-pass-statistics-display=list \
+// RUN:   -o /dev/null 2>&1 | FileCheck %s
+
+// Pass statistics are only collected when LLVM_ENABLE_STATS is set.
+// REQUIRES: asserts
+
+// CHECK-LABEL: Pass statistics report
+// CHECK: Canonicalizer
+// CHECK-DAG: (S) 1 num-ops-erased - Number of operations erased
+// CHECK-DAG: (S) {{[0-9]+}} num-pattern-applications - Number of successful pattern applications
+// CHECK-DAG: (S) {{[0-9]+}} num-pattern-failures - Number of pattern applications that failed to match
+
+func.func @dead_constant() {
+  %0 = arith.constant 1 : i32
+  return
+}
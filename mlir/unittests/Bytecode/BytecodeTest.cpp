@@ -16,7 +16,9 @@
 
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/Endian.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/MemoryBufferRef.h"
+#include "llvm/Support/SourceMgr.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -89,6 +91,77 @@ TEST(Bytecode, MultiModuleWithResource) {
   checkResourceAttribute(*roundTripModule);
 }
 
+TEST(Bytecode, ResourceBlobReferencesBuffer) {
+  MLIRContext context;
+  ParserConfig parseConfig(&context);
+  OwningOpRef<Operation *> module =
+      parseSourceString<Operation *>(irWithResources, parseConfig);
+  ASSERT_TRUE(module);
+
+  std::string buffer;
+  llvm::raw_string_ostream ostream(buffer);
+  ASSERT_TRUE(succeeded(writeBytecodeToFile(module.get(), ostream)));
+  ostream.flush();
+
+  // Parse the bytecode out of a source manager that owns an aligned copy of
+  // it, which allows the reader to reference resource blobs in place.
+  auto sourceMgr = std::make_shared<llvm::SourceMgr>();
+  std::unique_ptr<llvm::WritableMemoryBuffer> ownedBuffer =
+      llvm::WritableMemoryBuffer::getNewUninitMemBuffer(
+          buffer.size(), "bytecode", llvm::Align(0x20));
+  ASSERT_TRUE(ownedBuffer);
+  llvm::copy(buffer, ownedBuffer->getBufferStart());
+  StringRef bufferData = ownedBuffer->getBuffer();
+  sourceMgr->AddNewSourceBuffer(std::move(ownedBuffer), SMLoc());
+
+  Block block;
+  ASSERT_TRUE(succeeded(parseSourceFile(sourceMgr, &block, parseConfig)));
+
+  if (llvm::endianness::native == llvm::endianness::big)
+    GTEST_SKIP();
+
+  Attribute attr = block.front().getDiscardableAttr("bytecode.test");
+  auto denseResourceAttr = dyn_cast_or_null<DenseI32ResourceElementsAttr>(attr);
+  ASSERT_TRUE(denseResourceAttr);
+  AsmResourceBlob *blob = denseResourceAttr.getRawHandle().getBlob();
+  ASSERT_TRUE(blob);
+  const char *blobData = blob->getData().data();
+  EXPECT_TRUE(blobData >= bufferData.begin() && blobData < bufferData.end());
+}
+
+TEST(Bytecode, UnderalignedBuffer) {
+  MLIRContext context;
+  ParserConfig parseConfig(&context);
+  OwningOpRef<Operation *> module =
+      parseSourceString<Operation *>(irWithResources, parseConfig);
+  ASSERT_TRUE(module);
+
+  std::string buffer;
+  llvm::raw_string_ostream ostream(buffer);
+  ASSERT_TRUE(succeeded(writeBytecodeToFile(module.get(), ostream)));
+  ostream.flush();
+
+  // Place the bytecode one byte past an aligned address, so that the buffer
+  // is not aligned enough for the resources it contains.
+  constexpr size_t kAlignment = 0x20;
+  size_t bufferSize = buffer.size();
+  buffer.reserve(bufferSize + kAlignment);
+  size_t pad = (~(uintptr_t)buffer.data() + 1 & kAlignment - 1) + 1;
+  buffer.insert(0, pad, ' ');
+  StringRef misalignedBuffer(buffer.data() + pad, bufferSize);
+
+  std::string diagnostic;
+  ScopedDiagnosticHandler handler(&context, [&](Diagnostic &diag) {
+    diagnostic = diag.str();
+    return success();
+  });
+  OwningOpRef<Operation *> roundTripModule =
+      parseSourceString<Operation *>(misalignedBuffer, parseConfig);
+  EXPECT_FALSE(roundTripModule);
+  EXPECT_THAT(diagnostic,
+              ::testing::StartsWith("expected bytecode buffer to be aligned"));
+}
+
 namespace {
 /// A custom operation for the purpose of showcasing how discardable attributes
 /// are handled in absence of properties.
@@ -0,0 +1,125 @@
+//===- AsyncRuntime.cpp -----------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/ExecutionEngine/AsyncRuntime.h"
+#include "llvm/Support/Threading.h"
+
+#include "gmock/gmock.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace ::mlir::runtime;
+
+namespace {
+
+// A binary tree of tasks. Every task schedules its two children from the
+// worker thread it runs on, so that they go through the worker-local queues,
+// and the last task to finish emplaces `done`.
+struct TaskTree {
+  static constexpr unsigned kDepth = 14;
+  static constexpr int64_t kNumTasks = (int64_t(1) << (kDepth + 1)) - 1;
+
+  struct Node {
+    TaskTree *tree;
+    unsigned depth;
+  };
+
+  TaskTree() : done(mlirAsyncRuntimeCreateToken()) {
+    for (unsigned i = 0; i <= kDepth; ++i)
+      nodes[i] = {this, i};
+  }
+
+  static void run(void *handle) {
+    Node *node = static_cast<Node *>(handle);
+    TaskTree *tree = node->tree;
+    if (node->depth > 0) {
+      Node *child = &tree->nodes[node->depth - 1];
+      mlirAsyncRuntimeExecute(child, &TaskTree::run);
+      mlirAsyncRuntimeExecute(child, &TaskTree::run);
+    }
+    if (tree->numFinished.fetch_add(1) + 1 == kNumTasks)
+      mlirAsyncRuntimeEmplaceToken(tree->done);
+  }
+
+  Node nodes[kDepth + 1];
+  std::atomic<int64_t> numFinished{0};
+  AsyncToken *done;
+};
+
+// Tasks submitted from the main thread, which go through the shared queue.
+struct ExternalTasks {
+  static constexpr int64_t kNumTasks = 1000;
+
+  ExternalTasks() : done(mlirAsyncRuntimeCreateToken()) {}
+
+  static void run(void *handle) {
+    ExternalTasks *tasks = static_cast<ExternalTasks *>(handle);
+    {
+      std::lock_guard<std::mutex> lock(tasks->mu);
+      tasks->threadIds.insert(std::this_thread::get_id());
+    }
+    if (tasks->numFinished.fetch_add(1) + 1 == kNumTasks)
+      mlirAsyncRuntimeEmplaceToken(tasks->done);
+  }
+
+  std::mutex mu;
+  std::set<std::thread::id> threadIds;
+  std::atomic<int64_t> numFinished{0};
+  AsyncToken *done;
+};
+
+} // namespace
+
+TEST(AsyncRuntime, numWorkerThreads) {
+  EXPECT_EQ(mlirAsyncRuntimGetNumWorkerThreads(),
+            int64_t(llvm::hardware_concurrency().compute_thread_count()));
+}
+
+TEST(AsyncRuntime, runsNestedTasks) {
+  TaskTree tree;
+  mlirAsyncRuntimeExecute(&tree.nodes[TaskTree::kDepth], &TaskTree::run);
+  mlirAsyncRuntimeAwaitToken(tree.done);
+  EXPECT_EQ(tree.numFinished.load(), TaskTree::kNumTasks);
+  EXPECT_FALSE(mlirAsyncRuntimeIsTokenError(tree.done));
+  mlirAsyncRuntimeDropRef(tree.done, 1);
+}
+
+TEST(AsyncRuntime, runsExternalTasksOnWorkers) {
+  ExternalTasks tasks;
+  for (int64_t i = 0; i < ExternalTasks::kNumTasks; ++i)
+    mlirAsyncRuntimeExecute(&tasks, &ExternalTasks::run);
+  mlirAsyncRuntimeAwaitToken(tasks.done);
+  EXPECT_EQ(tasks.numFinished.load(), ExternalTasks::kNumTasks);
+  mlirAsyncRuntimeDropRef(tasks.done, 1);
+
+  std::lock_guard<std::mutex> lock(tasks.mu);
+  EXPECT_EQ(tasks.threadIds.count(std::this_thread::get_id()), 0u);
+  EXPECT_LE(int64_t(tasks.threadIds.size()),
+            mlirAsyncRuntimGetNumWorkerThreads());
+}
+
+TEST(AsyncRuntime, schedulesAwaitersOfTokens) {
+  // Awaiters are resumed on the thread that emplaces the token. Like lowered
+  // coroutines do, they hop back onto the scheduler from there.
+  ExternalTasks tasks;
+  AsyncToken *ready = mlirAsyncRuntimeCreateToken();
+  auto schedule = [](void *handle) {
+    mlirAsyncRuntimeExecute(handle, &ExternalTasks::run);
+  };
+  for (int64_t i = 0; i < ExternalTasks::kNumTasks; ++i)
+    mlirAsyncRuntimeAwaitTokenAndExecute(ready, &tasks, schedule);
+  EXPECT_EQ(tasks.numFinished.load(), 0);
+  mlirAsyncRuntimeEmplaceToken(ready);
+  mlirAsyncRuntimeAwaitToken(tasks.done);
+  EXPECT_EQ(tasks.numFinished.load(), ExternalTasks::kNumTasks);
+  mlirAsyncRuntimeDropRef(ready, 1);
+  mlirAsyncRuntimeDropRef(tasks.done, 1);
+}
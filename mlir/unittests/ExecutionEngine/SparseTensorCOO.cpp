@@ -0,0 +1,63 @@
+//===- SparseTensorCOO.cpp --------------------------------------*- C++ -*-===//
+//
+// This file is licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/ExecutionEngine/SparseTensor/COO.h"
+
+#include "gmock/gmock.h"
+
+#include <random>
+
+using namespace ::mlir::sparse_tensor;
+
+/// Checks that the elements of `coo` are sorted and hold the coordinates and
+/// value that were added together.
+static void expectSorted(const SparseTensorCOO<double> &coo) {
+  const std::vector<Element<double>> &elements = coo.getElements();
+  const uint64_t rank = coo.getRank();
+  ElementLT<double> lt = coo.getElementLT();
+  for (size_t i = 0; i < elements.size(); ++i) {
+    uint64_t linear = 0;
+    for (uint64_t d = 0; d < rank; ++d)
+      linear = linear * coo.getDimSizes()[d] + elements[i].coords[d];
+    EXPECT_EQ(elements[i].value, static_cast<double>(linear));
+    if (i > 0)
+      EXPECT_FALSE(lt(elements[i], elements[i - 1]));
+  }
+}
+
+TEST(SparseTensorCOO, sort) {
+  std::mt19937_64 rng(42);
+  const std::vector<uint64_t> dimSizes = {300, 1000, 7};
+  SparseTensorCOO<double> coo(dimSizes);
+  for (unsigned i = 0; i < 10000; ++i) {
+    std::vector<uint64_t> coords = {rng() % dimSizes[0], rng() % dimSizes[1],
+                                    rng() % dimSizes[2]};
+    coo.add(coords, static_cast<double>((coords[0] * dimSizes[1] + coords[1]) *
+                                            dimSizes[2] +
+                                        coords[2]));
+  }
+  coo.sort();
+  EXPECT_EQ(coo.getElements().size(), 10000u);
+  expectSorted(coo);
+}
+
+// The linearized coordinates of this tensor do not fit in 64 bits, which
+// requires falling back to comparing coordinates directly.
+TEST(SparseTensorCOO, sortLargeVolume) {
+  const uint64_t big = uint64_t(1) << 40;
+  SparseTensorCOO<double> coo({big, big});
+  coo.add({big - 1, 0}, 3.0);
+  coo.add({0, big - 1}, 2.0);
+  coo.add({0, 1}, 1.0);
+  coo.sort();
+  const std::vector<Element<double>> &elements = coo.getElements();
+  ASSERT_EQ(elements.size(), 3u);
+  EXPECT_EQ(elements[0].value, 1.0);
+  EXPECT_EQ(elements[1].value, 2.0);
+  EXPECT_EQ(elements[2].value, 3.0);
+}
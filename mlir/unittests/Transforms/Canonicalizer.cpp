@@ -6,6 +6,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Parser/Parser.h"
 #include "mlir/Pass/PassManager.h"
@@ -83,4 +84,64 @@ TEST(CanonicalizerTest, TestDisablePatterns) {
   EXPECT_FALSE(module->lookupSymbol("A"));
 }
 
+/// Runs the greedy driver without any patterns on `code` and returns whether
+/// it reported a change. Only the folder's constant handling can apply.
+static bool runEmptyPatternSet(MLIRContext &context, StringRef code,
+                               OwningOpRef<ModuleOp> &module) {
+  module = parseSourceString<ModuleOp>(code, &context);
+  EXPECT_TRUE(module);
+  bool changed = true;
+  EXPECT_TRUE(succeeded(applyPatternsAndFoldGreedily(
+      *module, FrozenRewritePatternSet(RewritePatternSet(&context)),
+      GreedyRewriteConfig(), &changed)));
+  return changed;
+}
+
+TEST(CanonicalizerTest, TestConstantCSEReportsChange) {
+  MLIRContext context;
+  context.getOrLoadDialect<TestDialect>();
+  context.getOrLoadDialect<arith::ArithDialect>();
+
+  const char *const code = R"mlir(
+    %0 = arith.constant 1 : i32
+    %1 = arith.constant 1 : i32
+    "test.use"(%0, %1) : (i32, i32) -> ()
+  )mlir";
+
+  OwningOpRef<ModuleOp> module;
+  EXPECT_TRUE(runEmptyPatternSet(context, code, module));
+  EXPECT_EQ(llvm::range_size(module->getOps<arith::ConstantOp>()), 1u);
+}
+
+TEST(CanonicalizerTest, TestConstantHoistingReportsChange) {
+  MLIRContext context;
+  context.getOrLoadDialect<TestDialect>();
+  context.getOrLoadDialect<arith::ArithDialect>();
+
+  const char *const code = R"mlir(
+    "test.foo"() : () -> ()
+    %0 = arith.constant 1 : i32
+    "test.use"(%0) : (i32) -> ()
+  )mlir";
+
+  OwningOpRef<ModuleOp> module;
+  EXPECT_TRUE(runEmptyPatternSet(context, code, module));
+  EXPECT_TRUE(isa<arith::ConstantOp>(module->getBody()->front()));
+}
+
+TEST(CanonicalizerTest, TestCanonicalConstantsReportNoChange) {
+  MLIRContext context;
+  context.getOrLoadDialect<TestDialect>();
+  context.getOrLoadDialect<arith::ArithDialect>();
+
+  const char *const code = R"mlir(
+    %0 = arith.constant 1 : i32
+    %1 = arith.constant 2 : i32
+    "test.use"(%0, %1) : (i32, i32) -> ()
+  )mlir";
+
+  OwningOpRef<ModuleOp> module;
+  EXPECT_FALSE(runEmptyPatternSet(context, code, module));
+}
+
 } // end anonymous namespace
@@ -237,14 +237,16 @@ public:
 
     NodeTy *NodePtr = nullptr;
 
-    // Try to get a node from FreeList
+    // Try to get a node from FreeList. The nodes of a bucket are all of the
+    // same power-of-two size class, so take the smallest node that is large
+    // enough rather than only a node of exactly the requested size.
     {
       const int B = findBucket(Size);
       FreeListTy &List = FreeLists[B];
 
       NodeTy TempNode(Size, nullptr);
       std::lock_guard<std::mutex> LG(FreeListLocks[B]);
-      const auto Itr = List.find(TempNode);
+      const auto Itr = List.lower_bound(TempNode);
 
       if (Itr != List.end()) {
         NodePtr = &Itr->get();
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "kmp.h"
+#include "kmp_affinity.h"
 #include "kmp_i18n.h"
 #include "kmp_itt.h"
 #include "kmp_stats.h"
@@ -3216,6 +3217,42 @@ static kmp_task_t *__kmp_remove_my_task(kmp_info_t *thread, kmp_int32 gtid,
   return task;
 }
 
+#if KMP_AFFINITY_SUPPORTED
+// Number of random victims outside of the thief's locality domain that are
+// skipped before any victim is accepted.  Preferring victims in the same NUMA
+// domain (or socket, if the NUMA level is not part of the topology) keeps the
+// data touched by stolen tasks local to the domain on multi-socket systems.
+#define KMP_TASK_STEAL_LOCAL_TRIES 3
+
+// A locality domain is identified by the (socket, NUMA) pair of the thread's
+// topology ids.  Topology ids are sub-ids that restart under each parent, so
+// a NUMA id alone is not unique when a socket has several NUMA domains.  The
+// NUMA id is unknown when the topology has no NUMA level, in which case the
+// socket alone identifies the domain.
+
+// __kmp_task_has_locality_domain: return true if the thread is bound within a
+// single locality domain, false if that is unknown or its affinity mask spans
+// several domains.
+static inline bool __kmp_task_has_locality_domain(const kmp_info_t *thread) {
+  const int *ids = thread->th.th_topology_ids.ids;
+  if (ids[KMP_HW_NUMA] == kmp_hw_thread_t::MULTIPLE_ID ||
+      ids[KMP_HW_SOCKET] == kmp_hw_thread_t::MULTIPLE_ID)
+    return false;
+  return ids[KMP_HW_NUMA] != kmp_hw_thread_t::UNKNOWN_ID ||
+         ids[KMP_HW_SOCKET] != kmp_hw_thread_t::UNKNOWN_ID;
+}
+
+// __kmp_task_same_locality_domain: return true if both threads are bound to
+// the same locality domain.  Only meaningful if the first thread has one.
+static inline bool __kmp_task_same_locality_domain(const kmp_info_t *thread,
+                                                   const kmp_info_t *other) {
+  const int *ids = thread->th.th_topology_ids.ids;
+  const int *other_ids = other->th.th_topology_ids.ids;
+  return ids[KMP_HW_SOCKET] == other_ids[KMP_HW_SOCKET] &&
+         ids[KMP_HW_NUMA] == other_ids[KMP_HW_NUMA];
+}
+#endif // KMP_AFFINITY_SUPPORTED
+
 // __kmp_steal_task: remove a task from another thread's deque
 // Assume that calling thread has already checked existence of
 // task_team thread_data before calling this routine.
@@ -3418,6 +3455,10 @@ static inline int __kmp_execute_tasks_template(
           asleep = 0;
         } else if (!new_victim) { // no recent steals and we haven't already
           // used a new victim; select a random thread
+#if KMP_AFFINITY_SUPPORTED
+          bool prefer_local = __kmp_task_has_locality_domain(thread);
+          int remote_tries = 0;
+#endif
           do { // Find a different thread to steal work from.
             // Pick a random thread. Initial plan was to cycle through all the
             // threads, and only return if we tried to steal from every thread,
@@ -3428,6 +3469,16 @@ static inline int __kmp_execute_tasks_template(
             }
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;
+#if KMP_AFFINITY_SUPPORTED
+            // Prefer a victim in our own locality domain, but give up after a
+            // few tries so that remote domains are still stolen from.
+            if (prefer_local && remote_tries < KMP_TASK_STEAL_LOCAL_TRIES &&
+                !__kmp_task_same_locality_domain(thread, other_thread)) {
+              ++remote_tries;
+              asleep = 1;
+              continue;
+            }
+#endif
             // There is a slight chance that __kmp_enable_tasking() did not wake
             // up all threads waiting at the barrier.  If victim is sleeping,
             // then wake it up. Since we were going to pay the cache miss